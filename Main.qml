@@ -2,7 +2,7 @@ import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
 import QtQuick.Effects
-import "components" as Components
+import EvolveUI.Components as Components
 
 ApplicationWindow {
     id: root
@@ -27,6 +27,8 @@ ApplicationWindow {
     Components.ETheme {
         id: theme
     }
+    // 延迟创建的组件内部同名属性会遮住 id，经由根对象传入
+    readonly property var appTheme: theme
 
     color: theme.primaryColor
 
@@ -451,13 +453,15 @@ ApplicationWindow {
         anchors.rightMargin: -24
         padding: 30
 
-        // 插入内容
-        Components.EPlaylist {
-            width: parent.width
-            height: parent.height - 60
-            theme: theme
-            model: otherLoader.item ? otherLoader.item.musicPlayerRef.playlistModelRef : null
-            playerRef: otherLoader.item ? otherLoader.item.musicPlayerRef : null
+        // 插入内容：播放列表会扫描音乐目录并启动监控，首次打开（或空闲预热）时才创建
+        contentComponent: Component {
+            Components.EPlaylist {
+                width: parent.width
+                height: parent.height - 60
+                theme: root.appTheme
+                model: otherLoader.item ? otherLoader.item.musicPlayerRef.playlistModelRef : null
+                playerRef: otherLoader.item ? otherLoader.item.musicPlayerRef : null
+            }
         }
     }
 
@@ -477,52 +481,58 @@ ApplicationWindow {
 
     Components.EAnimatedWindow {
         id: animationWrapper2
-        Column {
-            spacing: 8
-            anchors.centerIn: parent
-
-            Components.EDataTable {
-                width: 650
-                height: 400
-                selectable: true
-
-                headers: [
-                    { key: "index", label: "序号" },
-                    { key: "name", label: "姓名" },
-                    { key: "age", label: "年龄" },
-                    { key: "city", label: "城市" },
-                    { key: "email", label: "邮箱" },
-                    { key: "about", label: "简介" }
-                ]
-
-                model: ListModel {
-                    ListElement { name: "张三"; age: 25; city: "北京"; email: "zhangsan@example.com"; about: "热爱编程与开源项目，业余时间写技术博客，喜欢跑步和咖啡。"; checked: false }
-                    ListElement { name: "李四"; age: 30; city: "上海"; email: "lisi@example.com"; about: "前端开发工程师，专注用户体验与响应式设计，热衷于探索新框架。"; checked: false }
-                    ListElement { name: "王五"; age: 28; city: "广州"; email: "wangwu@example.com"; about: "全栈开发者，擅长Node.js与Python，周末常去爬山，是个户外运动爱好者。"; checked: false }
-                    ListElement { name: "赵六"; age: 32; city: "深圳"; email: "zhaoliu@example.com"; about: "AI算法工程师，研究机器学习与计算机视觉，业余玩吉他和摄影。"; checked: false }
-                    ListElement { name: "张三"; age: 25; city: "北京"; email: "zhangsan@example.com"; about: "热爱编程与开源项目，业余时间写技术博客，喜欢跑步和咖啡。"; checked: false }
-                    ListElement { name: "李四"; age: 30; city: "上海"; email: "lisi@example.com"; about: "前端开发工程师，专注用户体验与响应式设计，热衷于探索新框架。"; checked: false }
-                    ListElement { name: "王五"; age: 28; city: "广州"; email: "wangwu@example.com"; about: "全栈开发者，擅长Node.js与Python，周末常去爬山，是个户外运动爱好者。"; checked: false }
-                    ListElement { name: "赵六"; age: 32; city: "深圳"; email: "zhaoliu@example.com"; about: "AI算法工程师，研究机器学习与计算机视觉，业余玩吉他和摄影。"; checked: false }
-                    ListElement { name: "张三"; age: 25; city: "北京"; email: "zhangsan@example.com"; about: "热爱编程与开源项目，业余时间写技术博客，喜欢跑步和咖啡。"; checked: false }
-                    ListElement { name: "李四"; age: 30; city: "上海"; email: "lisi@example.com"; about: "前端开发工程师，专注用户体验与响应式设计，热衷于探索新框架。"; checked: false }
-                    ListElement { name: "王五"; age: 28; city: "广州"; email: "wangwu@example.com"; about: "全栈开发者，擅长Node.js与Python，周末常去爬山，是个户外运动爱好者。"; checked: false }
-                    ListElement { name: "赵六"; age: 32; city: "深圳"; email: "zhaoliu@example.com"; about: "AI算法工程师，研究机器学习与计算机视觉，业余玩吉他和摄影。"; checked: false }
-                }
-
-                onRowClicked: {
-                    console.log("点击行：", index, rowData.name)
-                }
+        // 数据表窗口：首次打开时才创建
+        contentComponent: Component {
+            // 加载器会把根项撑满窗口，居中排列放在内层
+            Item {
+                Column {
+                    spacing: 8
+                    anchors.centerIn: parent
 
-                onCheckStateChanged: {
-                    console.log("勾选状态改变：", index, rowData.name, "checked =", isChecked)
+                    Components.EDataTable {
+                        width: 650
+                        height: 400
+                        selectable: true
+
+                        headers: [
+                            { key: "index", label: "序号" },
+                            { key: "name", label: "姓名" },
+                            { key: "age", label: "年龄" },
+                            { key: "city", label: "城市" },
+                            { key: "email", label: "邮箱" },
+                            { key: "about", label: "简介" }
+                        ]
+
+                        model: ListModel {
+                            ListElement { name: "张三"; age: 25; city: "北京"; email: "zhangsan@example.com"; about: "热爱编程与开源项目，业余时间写技术博客，喜欢跑步和咖啡。"; checked: false }
+                            ListElement { name: "李四"; age: 30; city: "上海"; email: "lisi@example.com"; about: "前端开发工程师，专注用户体验与响应式设计，热衷于探索新框架。"; checked: false }
+                            ListElement { name: "王五"; age: 28; city: "广州"; email: "wangwu@example.com"; about: "全栈开发者，擅长Node.js与Python，周末常去爬山，是个户外运动爱好者。"; checked: false }
+                            ListElement { name: "赵六"; age: 32; city: "深圳"; email: "zhaoliu@example.com"; about: "AI算法工程师，研究机器学习与计算机视觉，业余玩吉他和摄影。"; checked: false }
+                            ListElement { name: "张三"; age: 25; city: "北京"; email: "zhangsan@example.com"; about: "热爱编程与开源项目，业余时间写技术博客，喜欢跑步和咖啡。"; checked: false }
+                            ListElement { name: "李四"; age: 30; city: "上海"; email: "lisi@example.com"; about: "前端开发工程师，专注用户体验与响应式设计，热衷于探索新框架。"; checked: false }
+                            ListElement { name: "王五"; age: 28; city: "广州"; email: "wangwu@example.com"; about: "全栈开发者，擅长Node.js与Python，周末常去爬山，是个户外运动爱好者。"; checked: false }
+                            ListElement { name: "赵六"; age: 32; city: "深圳"; email: "zhaoliu@example.com"; about: "AI算法工程师，研究机器学习与计算机视觉，业余玩吉他和摄影。"; checked: false }
+                            ListElement { name: "张三"; age: 25; city: "北京"; email: "zhangsan@example.com"; about: "热爱编程与开源项目，业余时间写技术博客，喜欢跑步和咖啡。"; checked: false }
+                            ListElement { name: "李四"; age: 30; city: "上海"; email: "lisi@example.com"; about: "前端开发工程师，专注用户体验与响应式设计，热衷于探索新框架。"; checked: false }
+                            ListElement { name: "王五"; age: 28; city: "广州"; email: "wangwu@example.com"; about: "全栈开发者，擅长Node.js与Python，周末常去爬山，是个户外运动爱好者。"; checked: false }
+                            ListElement { name: "赵六"; age: 32; city: "深圳"; email: "zhaoliu@example.com"; about: "AI算法工程师，研究机器学习与计算机视觉，业余玩吉他和摄影。"; checked: false }
+                        }
+
+                        onRowClicked: {
+                            console.log("点击行：", index, rowData.name)
+                        }
+
+                        onCheckStateChanged: {
+                            console.log("勾选状态改变：", index, rowData.name, "checked =", isChecked)
+                        }
+                    }
+
+                    Components.ECardWithTextArea{
+                        width: 300
+                        height: 200
+                    }
                 }
             }
-
-            Components.ECardWithTextArea{
-                width: 300
-                height: 200
-            }
         }
     }
 
@@ -534,6 +544,8 @@ ApplicationWindow {
 
         // 统一入口：从源组件读取音乐信息并打开动画窗口
         function openFrom(sourceItem) {
+            ensureContent()
+            var musicContent = contentItem
             if (sourceItem) {
                 musicContent.coverImage = sourceItem.coverImage || ""
                 musicContent.coverIsDefault = !!sourceItem.coverImageIsDefault
@@ -549,11 +561,33 @@ ApplicationWindow {
             open(sourceItem)
         }
 
-        // 提取后的内容组件（与 Aboutme 用法一致）
-        Components.MusicWindow {
-            id: musicContent
-            anchors.fill: parent
-            theme: theme
+        // 提取后的内容组件，首次打开（或空闲预热）时才创建
+        contentComponent: Component {
+            Components.MusicWindow {
+                anchors.fill: parent
+                theme: root.appTheme
+            }
+        }
+    }
+
+    // 首帧呈现后空闲预热延迟创建的抽屉/窗口，首次打开时无需再等待实例化
+    property bool prewarmOnIdle: true
+    property bool _prewarmArmed: false
+    Connections {
+        target: root
+        enabled: root.prewarmOnIdle && !root._prewarmArmed
+        function onFrameSwapped() {
+            root._prewarmArmed = true
+            prewarmTimer.start()
+        }
+    }
+    Timer {
+        id: prewarmTimer
+        interval: 1500
+        onTriggered: {
+            drawer1.prewarm()
+            animationWrapper2.prewarm()
+            musicAnimationWindow.prewarm()
         }
     }
 
@@ -570,6 +604,8 @@ ApplicationWindow {
         height: 38
         borderRadius: 14
         blurSource: contentWrapper
+        // 只在滚动或切页动画期间定时重新截取，停下后再补一次；静止画面只剩纹理采样（尺寸变化由缓存自行跟踪）
+        liveBlur: flickable.moving || pageEnterAnim.running
         blurAmount: 1.2
         blurMax: 32
         borderColor: Qt.rgba(theme.borderColor.r, theme.borderColor.g, theme.borderColor.b, theme.borderColor.a * 0.6)
@@ -585,6 +621,15 @@ ApplicationWindow {
         Behavior on scale { NumberAnimation { duration: 250; easing.type: Easing.OutCubic } }
         Behavior on y { NumberAnimation { duration: 250; easing.type: Easing.OutCubic } }
 
+        Connections {
+            target: flickable
+            function onMovementEnded() { titleButtonsPanel.invalidateBlur() }
+        }
+        Connections {
+            target: pageEnterAnim
+            function onFinished() { titleButtonsPanel.invalidateBlur() }
+        }
+
         Row {
             id: titleButtonsRow
             spacing: 8
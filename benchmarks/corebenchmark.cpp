@@ -0,0 +1,293 @@
+// 实现文件：核心性能基准 —— 生成合成曲库，测量扫描、增量重扫、歌词查找与元数据吞吐，输出 JSON
+// 用法：evolveui-core-bench [--sizes 1000,10000,100000] [--output result.json] [--work-dir DIR] [--keep]
+#include "benchmarks/librarygenerator.h"
+#include "core/metadataindex.h"
+#include "core/music.h"
+
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+
+#include <algorithm>
+#include <functional>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif !defined(Q_OS_LINUX)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+const int kWaitTimeoutMs = 600000;
+const int kWatchTimeoutMs = 10000;
+const int kLyricsSample = 2000;
+const int kViewportRows = 12;
+
+// 进程峰值常驻内存（KB）；随规模递增运行，每项反映到该规模为止的峰值
+qint64 peakRssKb()
+{
+#if defined(Q_OS_LINUX)
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly)) return -1;
+    for (const QByteArray &line : status.readAll().split('\n')) {
+        if (line.startsWith("VmHWM:")) return line.mid(6).trimmed().split(' ').value(0).toLongLong();
+    }
+    return -1;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return -1;
+    return qint64(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+    return qint64(usage.ru_maxrss / 1024);     // macOS 以字节为单位
+#endif
+}
+
+// 运行事件循环直到条件成立或超时；返回条件是否成立
+bool waitFor(const std::function<bool()> &done, int timeoutMs)
+{
+    if (done()) return true;
+    QElapsedTimer clock;
+    clock.start();
+    QEventLoop loop;
+    QTimer poll;
+    poll.setInterval(1);
+    QObject::connect(&poll, &QTimer::timeout, &loop, [&]() {
+        if (done() || clock.elapsed() > timeoutMs) loop.quit();
+    });
+    poll.start();
+    loop.exec();
+    return done();
+}
+
+double msSince(const QElapsedTimer &clock)
+{
+    return clock.nsecsElapsed() / 1e6;
+}
+
+double perSecond(int count, double ms)
+{
+    return ms > 0.0 ? count * 1000.0 / ms : 0.0;
+}
+
+QJsonObject runSize(const QString &workDir, int size)
+{
+    QJsonObject result;
+    result.insert(QStringLiteral("files"), size);
+    const QString root = workDir + QStringLiteral("/library-%1").arg(size);
+
+    QElapsedTimer clock;
+    clock.start();
+    const LibraryGenerator::Summary generated = LibraryGenerator::generate(root, size);
+    result.insert(QStringLiteral("generateMs"), msSince(clock));
+    result.insert(QStringLiteral("generatedTracks"), generated.tracks);
+    result.insert(QStringLiteral("lyricsFiles"), generated.lyrics);
+    result.insert(QStringLiteral("directories"), generated.directories);
+    result.insert(QStringLiteral("bytes"), generated.bytes);
+
+    // 扫描：首次遍历（刚生成，目录项多半仍在系统缓存中）与再次遍历
+    QStringList files;
+    {
+        MusicLibrary library;
+        clock.restart();
+        files = library.scanMusicFiles(root);
+        result.insert(QStringLiteral("scanColdMs"), msSince(clock));
+    }
+    {
+        MusicLibrary library;
+        clock.restart();
+        files = library.scanMusicFiles(root);
+        result.insert(QStringLiteral("scanWarmMs"), msSince(clock));
+    }
+    result.insert(QStringLiteral("scannedFiles"), int(files.size()));
+    {
+        MusicLibrary library;
+        bool finished = false;
+        QObject::connect(&library, &MusicLibrary::scanFinished, [&finished]() { finished = true; });
+        clock.restart();
+        library.scanMusicFilesAsync(root);
+        waitFor([&finished]() { return finished; }, kWaitTimeoutMs);
+        result.insert(QStringLiteral("scanAsyncMs"), msSince(clock));
+    }
+
+    // 增量重扫：从文件落盘到 fileAdded/fileRemoved 发出的延迟（含 SCAN_DELAY_MS 合并窗口）
+    {
+        MusicLibrary library;
+        library.scanMusicFiles(root);
+        clock.restart();
+        library.startWatchingSingle(root);
+        result.insert(QStringLiteral("watchSetupMs"), msSince(clock));
+
+        QString added;
+        QString removed;
+        QObject::connect(&library, &MusicLibrary::fileAdded, [&added](const QString &path) { added = path; });
+        QObject::connect(&library, &MusicLibrary::fileRemoved, [&removed](const QString &path) { removed = path; });
+        const QString target = generated.albumDirs.value(generated.albumDirs.size() / 2)
+                               + QStringLiteral("/99 - Rescan Probe.mp3");
+        clock.restart();
+        LibraryGenerator::writeTrack(target, QStringLiteral("Rescan Probe"), QStringLiteral("Probe"),
+                                     QStringLiteral("Probe"), QByteArray());
+        const bool addSeen = waitFor([&]() { return added == target; }, kWatchTimeoutMs);
+        result.insert(QStringLiteral("rescanAddLatencyMs"), addSeen ? msSince(clock) : -1.0);
+
+        clock.restart();
+        QFile::remove(target);
+        const bool removeSeen = waitFor([&]() { return removed == target; }, kWatchTimeoutMs);
+        result.insert(QStringLiteral("rescanRemoveLatencyMs"), removeSeen ? msSince(clock) : -1.0);
+        library.stopWatching();
+    }
+
+    // 元数据预取：索引为空时全部排入后台，随即提交列表中部的一屏可见行，
+    // 测量可见行越过后台队列完成的延迟，再等全部读完；再次预取由共享的元数据存储直接应答
+    {
+        MusicLibrary library;
+        const QStringList visible = files.mid(files.size() / 2, kViewportRows);
+        const QSet<QString> visibleSet(visible.cbegin(), visible.cend());
+        int ready = 0;
+        int visibleReady = 0;
+        QObject::connect(&library, &MusicLibrary::metadataReady,
+                         [&ready, &visibleReady, &visibleSet](const QString &source) {
+                             ++ready;
+                             if (visibleSet.contains(source)) ++visibleReady;
+                         });
+        clock.restart();
+        library.prefetchMetadata(files);
+        library.prefetchViewport(visible, QStringList());
+        waitFor([&]() { return visibleReady >= visible.size(); }, kWaitTimeoutMs);
+        result.insert(QStringLiteral("viewportFillMs"), msSince(clock));
+        waitFor([&]() { return ready >= files.size(); }, kWaitTimeoutMs);
+        const double ms = msSince(clock);
+        result.insert(QStringLiteral("prefetchMs"), ms);
+        result.insert(QStringLiteral("prefetchFilesPerSec"), perSecond(ready, ms));
+    }
+    {
+        MusicLibrary library;
+        clock.restart();
+        library.prefetchMetadata(files);
+        const double ms = msSince(clock);
+        result.insert(QStringLiteral("prefetchWarmMs"), ms);
+        result.insert(QStringLiteral("prefetchWarmFilesPerSec"), perSecond(int(files.size()), ms));
+    }
+
+    // 歌词查找（在预取之后，索引已有记录）：首次需要列举目录，第二次命中索引里记录的 lyricsPath
+    {
+        MusicLibrary library;
+        const int step = std::max(1, int(files.size()) / kLyricsSample);
+        QStringList sources;
+        for (int i = 0; i < files.size(); i += step) sources.append(QUrl::fromLocalFile(files.at(i)).toString());
+        int found = 0;
+        clock.restart();
+        for (const QString &source : std::as_const(sources)) {
+            if (!library.findLyricsFileForSource(source).isEmpty()) ++found;
+        }
+        const double coldMs = msSince(clock);
+        clock.restart();
+        for (const QString &source : std::as_const(sources)) library.findLyricsFileForSource(source);
+        const double warmMs = msSince(clock);
+        const int n = std::max(1, int(sources.size()));
+        result.insert(QStringLiteral("lyricsLookups"), int(sources.size()));
+        result.insert(QStringLiteral("lyricsFound"), found);
+        result.insert(QStringLiteral("lyricsLookupColdUs"), coldMs * 1000.0 / n);
+        result.insert(QStringLiteral("lyricsLookupWarmUs"), warmMs * 1000.0 / n);
+    }
+
+    result.insert(QStringLiteral("peakRssKb"), peakRssKb());
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // 无显示环境下运行：默认使用 offscreen 平台
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("EvolveUICoreBenchmark"));
+    // 索引与封面缓存写入测试专用目录，不污染真实缓存，并在开始前清空保证首轮为冷状态
+    QStandardPaths::setTestModeEnabled(true);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("EvolveUI core benchmark"));
+    parser.addHelpOption();
+    QCommandLineOption sizesOption({ QStringLiteral("s"), QStringLiteral("sizes") },
+                                   QStringLiteral("Comma-separated library sizes."), QStringLiteral("list"),
+                                   QStringLiteral("1000,10000"));
+    QCommandLineOption outputOption({ QStringLiteral("o"), QStringLiteral("output") },
+                                    QStringLiteral("JSON output file (default: stdout)."), QStringLiteral("file"));
+    QCommandLineOption workDirOption(QStringLiteral("work-dir"),
+                                     QStringLiteral("Directory for generated libraries (default: temp)."),
+                                     QStringLiteral("dir"));
+    QCommandLineOption keepOption(QStringLiteral("keep"), QStringLiteral("Keep generated libraries."));
+    parser.addOptions({ sizesOption, outputOption, workDirOption, keepOption });
+    parser.process(app);
+
+    QList<int> sizes;
+    for (const QString &part : parser.value(sizesOption).split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        const int size = part.trimmed().toInt();
+        if (size > 0) sizes.append(size);
+    }
+    std::sort(sizes.begin(), sizes.end());
+
+    QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).removeRecursively();
+
+    QTemporaryDir tempDir(parser.isSet(workDirOption)
+                              ? parser.value(workDirOption) + QStringLiteral("/evolveui-bench-XXXXXX")
+                              : QDir::tempPath() + QStringLiteral("/evolveui-bench-XXXXXX"));
+    if (!tempDir.isValid()) {
+        qCritical("Cannot create work directory: %s", qPrintable(tempDir.errorString()));
+        return 1;
+    }
+    tempDir.setAutoRemove(!parser.isSet(keepOption));
+
+    QJsonArray results;
+    for (int size : std::as_const(sizes)) {
+        qInfo("Running %d files...", size);
+        const QJsonObject result = runSize(tempDir.path(), size);
+        qInfo("  scan %.1f ms, prefetch %.0f files/s, peak RSS %lld KB",
+              result.value(QStringLiteral("scanColdMs")).toDouble(),
+              result.value(QStringLiteral("prefetchFilesPerSec")).toDouble(),
+              result.value(QStringLiteral("peakRssKb")).toInteger());
+        results.append(result);
+    }
+    MetadataIndex::instance().flush();
+
+    QJsonObject report;
+    report.insert(QStringLiteral("benchmark"), QStringLiteral("evolveui-core"));
+    report.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert(QStringLiteral("qtVersion"), QString::fromLatin1(qVersion()));
+    report.insert(QStringLiteral("platform"), QSysInfo::prettyProductName());
+    report.insert(QStringLiteral("cpuCores"), QThread::idealThreadCount());
+    if (parser.isSet(keepOption)) report.insert(QStringLiteral("workDir"), tempDir.path());
+    report.insert(QStringLiteral("results"), results);
+
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+    if (parser.isSet(outputOption)) {
+        QFile out(parser.value(outputOption));
+        if (!out.open(QIODevice::WriteOnly) || out.write(json) != json.size()) {
+            qCritical("Cannot write %s", qPrintable(parser.value(outputOption)));
+            return 1;
+        }
+    } else {
+        QFile out;
+        out.open(stdout, QIODevice::WriteOnly);
+        out.write(json);
+    }
+    return 0;
+}
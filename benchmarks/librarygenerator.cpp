@@ -0,0 +1,147 @@
+// 实现文件：LibraryGenerator —— ID3v2.3 标签与 MPEG 帧拼装、目录与歌词布局
+#include "benchmarks/librarygenerator.h"
+
+#include <QBuffer>
+#include <QColor>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+
+namespace {
+
+// MPEG-1 Layer III，128 kbps，44.1 kHz，无填充：每帧 417 字节
+const char kFrameHeader[4] = { char(0xFF), char(0xFB), char(0x90), char(0x64) };
+const int kFrameBytes = 417;
+const int kFramesPerTrack = 24;
+
+void appendBe32(QByteArray &out, quint32 v)
+{
+    out.append(char(v >> 24)).append(char(v >> 16)).append(char(v >> 8)).append(char(v));
+}
+
+void appendSyncsafe(QByteArray &out, quint32 v)
+{
+    out.append(char((v >> 21) & 0x7F)).append(char((v >> 14) & 0x7F))
+       .append(char((v >> 7) & 0x7F)).append(char(v & 0x7F));
+}
+
+void appendFrame(QByteArray &tag, const char *id, const QByteArray &body)
+{
+    tag.append(id, 4);
+    appendBe32(tag, quint32(body.size()));
+    tag.append(2, '\0');
+    tag.append(body);
+}
+
+QByteArray textBody(const QString &text)
+{
+    // 编码 1：带 BOM 的 UTF-16LE，中文标题也能原样往返
+    QByteArray body(1, '\x01');
+    body.append(char(0xFF)).append(char(0xFE));
+    body.append(reinterpret_cast<const char *>(text.utf16()), text.size() * 2);
+    return body;
+}
+
+QByteArray pictureBody(const QByteArray &png)
+{
+    QByteArray body(1, '\0');
+    body.append("image/png").append('\0');
+    body.append('\x03');                // 封面（正面）
+    body.append('\0');                  // 空描述
+    body.append(png);
+    return body;
+}
+
+} // namespace
+
+qint64 LibraryGenerator::writeTrack(const QString &path, const QString &title, const QString &artist,
+                                    const QString &album, const QByteArray &coverPng)
+{
+    QByteArray frames;
+    appendFrame(frames, "TIT2", textBody(title));
+    appendFrame(frames, "TPE1", textBody(artist));
+    appendFrame(frames, "TALB", textBody(album));
+    if (!coverPng.isEmpty()) appendFrame(frames, "APIC", pictureBody(coverPng));
+
+    QByteArray data("ID3\x03\x00\x00", 6);
+    appendSyncsafe(data, quint32(frames.size()));
+    data.append(frames);
+    for (int i = 0; i < kFramesPerTrack; ++i) {
+        data.append(kFrameHeader, 4);
+        data.append(kFrameBytes - 4, '\0');
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return -1;
+    return file.write(data);
+}
+
+qint64 LibraryGenerator::writeLyrics(const QString &path, const QString &title)
+{
+    QByteArray lrc = "[ti:" + title.toUtf8() + "]\n";
+    for (int i = 0; i < 40; ++i) {
+        lrc += QStringLiteral("[%1:%2.00]第 %3 行歌词\n")
+                   .arg(i * 5 / 60, 2, 10, QLatin1Char('0'))
+                   .arg(i * 5 % 60, 2, 10, QLatin1Char('0'))
+                   .arg(i + 1)
+                   .toUtf8();
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return -1;
+    return file.write(lrc);
+}
+
+QByteArray LibraryGenerator::coverPng(int seed)
+{
+    QImage image(64, 64, QImage::Format_RGB32);
+    image.fill(QColor::fromHsv((seed * 37) % 360, 160, 80 + (seed * 13) % 160));
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return png;
+}
+
+LibraryGenerator::Summary LibraryGenerator::generate(const QString &root, int trackCount, const Layout &layout)
+{
+    Summary summary;
+    QDir rootDir(root);
+    if (!rootDir.mkpath(QStringLiteral("."))) return summary;
+
+    const int tracksPerArtist = layout.tracksPerAlbum * layout.albumsPerArtist;
+    QString albumDir;
+    QByteArray cover;
+    for (int i = 0; i < trackCount; ++i) {
+        const int artist = i / tracksPerArtist;
+        const int album = i / layout.tracksPerAlbum;
+        const int track = i % layout.tracksPerAlbum;
+        const QString artistName = QStringLiteral("Artist %1").arg(artist, 4, 10, QLatin1Char('0'));
+        const QString albumName = QStringLiteral("Album %1").arg(album, 5, 10, QLatin1Char('0'));
+
+        if (track == 0) {
+            if (i % tracksPerArtist == 0) ++summary.directories;
+            albumDir = root + QLatin1Char('/') + artistName + QLatin1Char('/') + albumName;
+            QDir().mkpath(albumDir);
+            ++summary.directories;
+            summary.albumDirs.append(albumDir);
+            cover = layout.covers ? coverPng(album) : QByteArray();
+        }
+
+        const QString title = QStringLiteral("曲目 %1").arg(i);
+        const QString base = albumDir + QLatin1Char('/')
+                             + QStringLiteral("%1 - %2").arg(track + 1, 2, 10, QLatin1Char('0')).arg(title);
+        const qint64 written = writeTrack(base + QStringLiteral(".mp3"), title, artistName, albumName, cover);
+        if (written < 0) continue;
+        summary.bytes += written;
+        ++summary.tracks;
+
+        if (layout.lyricsEvery > 0 && i % layout.lyricsEvery == 0) {
+            const qint64 lrc = writeLyrics(base + QStringLiteral(".lrc"), title);
+            if (lrc > 0) {
+                summary.bytes += lrc;
+                ++summary.lyrics;
+            }
+        }
+    }
+    return summary;
+}
@@ -0,0 +1,41 @@
+// benchmarks/librarygenerator.h
+#ifndef BENCHMARKS_LIBRARYGENERATOR_H
+#define BENCHMARKS_LIBRARYGENERATOR_H
+
+// 合成曲库生成器：艺术家/专辑两级嵌套目录，曲目为带 ID3v2.3 标签（标题、艺术家、专辑、封面）的
+// 极短 MP3 帧流，部分曲目附同名 .lrc；TagReader 与 LibraryScanner 按真实文件处理
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+class LibraryGenerator
+{
+public:
+    struct Layout
+    {
+        int tracksPerAlbum = 10;
+        int albumsPerArtist = 10;
+        int lyricsEvery = 2;        // 每 N 首附一个 .lrc；0 表示不生成
+        bool covers = true;         // 每张专辑的曲目嵌入同一张封面（按内容去重的典型场景）
+    };
+
+    struct Summary
+    {
+        int tracks = 0;
+        int lyrics = 0;
+        int directories = 0;
+        qint64 bytes = 0;
+        QStringList albumDirs;      // 供增删文件的重扫测试选取目标目录
+    };
+
+    static Summary generate(const QString &root, int trackCount, const Layout &layout = Layout());
+
+    // 写入单首曲目；coverPng 为空时不嵌入封面
+    static qint64 writeTrack(const QString &path, const QString &title, const QString &artist,
+                             const QString &album, const QByteArray &coverPng);
+    static qint64 writeLyrics(const QString &path, const QString &title);
+    // 由 seed 决定颜色的小尺寸 PNG，不同专辑得到不同的内容哈希
+    static QByteArray coverPng(int seed);
+};
+
+#endif // BENCHMARKS_LIBRARYGENERATOR_H
@@ -0,0 +1,630 @@
+// 实现文件：组件渲染基准 —— QQuickRenderControl 离屏逐帧渲染每个组件与页面，按脚本驱动交互，
+// 统计帧耗时分位数、场景图节点、图层/离屏缓冲与纹理内存，输出 JSON
+// 用法：evolveui-render-bench [--backend software|llvmpipe] [--frames 120] [--size 800x600]
+//                            [--only EBarChart,EPlaylist] [--output result.json]
+#include "core/qmltypes.h"
+#include "core/coverimageprovider.h"
+#include "core/networkfetcher.h"
+
+#include <QAnimationDriver>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMouseEvent>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickRenderControl>
+#include <QQuickRenderTarget>
+#include <QQuickWindow>
+#include <QRegularExpression>
+#include <QSGImageNode>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+#include <QSet>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QUrl>
+#include <QWheelEvent>
+#include <QtQml/QQmlExtensionPlugin>
+
+#include <private/qquickitem_p.h>       // 场景图节点树只能经由私有接口取得
+#include <rhi/qrhi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+Q_IMPORT_QML_PLUGIN(EvolveUI_ComponentsPlugin)
+
+namespace {
+
+const int kWarmupFrames = 5;
+
+// 固定步长的动画时钟：每帧前进 16 ms，动画进度与渲染快慢无关，各次运行可比
+class StepAnimationDriver : public QAnimationDriver
+{
+public:
+    void step()
+    {
+        m_elapsed += FRAME_MS;
+        advance();
+    }
+    qint64 elapsed() const override { return m_elapsed; }
+
+private:
+    static const int FRAME_MS = 16;
+    qint64 m_elapsed = 0;
+};
+
+struct FrameTime
+{
+    qint64 polishNs = 0;
+    qint64 syncNs = 0;
+    qint64 renderNs = 0;
+    qint64 totalNs = 0;
+};
+
+// 一个组件一套离屏窗口与渲染目标，互不共享纹理与图元缓存
+class OffscreenView
+{
+public:
+    OffscreenView(const QSize &size, bool useRhi)
+        : m_size(size)
+        , m_useRhi(useRhi)
+    {
+    }
+
+    ~OffscreenView()
+    {
+        if (m_window) m_window->setRenderTarget(QQuickRenderTarget());
+        m_target.reset();
+        m_pass.reset();
+        m_depthStencil.reset();
+        m_texture.reset();
+        m_window.reset();
+        m_control.reset();
+    }
+
+    bool initialize(QString *error)
+    {
+        m_control = std::make_unique<QQuickRenderControl>();
+        m_window = std::make_unique<QQuickWindow>(m_control.get());
+        m_window->setGeometry(QRect(QPoint(), m_size));
+        m_window->contentItem()->setSize(m_size);
+
+        if (!m_useRhi) {
+            m_image = QImage(m_size, QImage::Format_ARGB32_Premultiplied);
+            m_window->setRenderTarget(QQuickRenderTarget::fromPaintDevice(&m_image));
+            return true;
+        }
+
+        if (!m_control->initialize()) {
+            *error = QStringLiteral("QQuickRenderControl::initialize() failed");
+            return false;
+        }
+        QRhi *rhi = m_control->rhi();
+        m_texture.reset(rhi->newTexture(QRhiTexture::RGBA8, m_size, 1, QRhiTexture::RenderTarget));
+        m_depthStencil.reset(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, m_size, 1));
+        if (!m_texture->create() || !m_depthStencil->create()) {
+            *error = QStringLiteral("Cannot create offscreen render target");
+            return false;
+        }
+        QRhiTextureRenderTargetDescription description { QRhiColorAttachment(m_texture.get()) };
+        description.setDepthStencilBuffer(m_depthStencil.get());
+        m_target.reset(rhi->newTextureRenderTarget(description));
+        m_pass.reset(m_target->newCompatibleRenderPassDescriptor());
+        m_target->setRenderPassDescriptor(m_pass.get());
+        if (!m_target->create()) {
+            *error = QStringLiteral("Cannot create offscreen render target");
+            return false;
+        }
+        m_window->setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(m_target.get()));
+        return true;
+    }
+
+    QQuickWindow *window() const { return m_window.get(); }
+
+    FrameTime renderFrame()
+    {
+        FrameTime frame;
+        QElapsedTimer timer;
+        timer.start();
+        m_control->polishItems();
+        frame.polishNs = timer.nsecsElapsed();
+        m_control->beginFrame();
+        m_control->sync();
+        frame.syncNs = timer.nsecsElapsed() - frame.polishNs;
+        m_control->render();
+        // 离屏帧在 endFrame 中提交并等待完成，计时包含实际的光栅化
+        m_control->endFrame();
+        frame.totalNs = timer.nsecsElapsed();
+        frame.renderNs = frame.totalNs - frame.polishNs - frame.syncNs;
+        return frame;
+    }
+
+private:
+    QSize m_size;
+    bool m_useRhi;
+    std::unique_ptr<QQuickRenderControl> m_control;
+    std::unique_ptr<QQuickWindow> m_window;
+    QImage m_image;
+    std::unique_ptr<QRhiTexture> m_texture;
+    std::unique_ptr<QRhiRenderBuffer> m_depthStencil;
+    std::unique_ptr<QRhiTextureRenderTarget> m_target;
+    std::unique_ptr<QRhiRenderPassDescriptor> m_pass;
+};
+
+// ---------------------- 场景统计 ----------------------
+struct SceneStats
+{
+    int nodes = 0;
+    int geometryNodes = 0;
+    int clipNodes = 0;
+    int transformNodes = 0;
+    int opacityNodes = 0;
+    int renderNodes = 0;
+    int items = 0;
+    int visibleItems = 0;
+    int layers = 0;                 // layer.enabled 的项
+    int effectSources = 0;          // ShaderEffectSource（含 MultiEffect 内部创建的）
+    int multiEffects = 0;
+    int canvases = 0;
+    int textures = 0;
+    qint64 textureBytes = 0;        // 图片节点引用的纹理，按纹理去重
+    qint64 offscreenBytes = 0;      // 图层、ShaderEffectSource 与 Canvas 的离屏缓冲（按尺寸与采样数估算）
+
+    QJsonObject toJson() const
+    {
+        QJsonObject o;
+        o.insert(QStringLiteral("nodes"), nodes);
+        o.insert(QStringLiteral("geometryNodes"), geometryNodes);
+        o.insert(QStringLiteral("clipNodes"), clipNodes);
+        o.insert(QStringLiteral("transformNodes"), transformNodes);
+        o.insert(QStringLiteral("opacityNodes"), opacityNodes);
+        o.insert(QStringLiteral("renderNodes"), renderNodes);
+        o.insert(QStringLiteral("items"), items);
+        o.insert(QStringLiteral("visibleItems"), visibleItems);
+        o.insert(QStringLiteral("layers"), layers);
+        o.insert(QStringLiteral("effectSources"), effectSources);
+        o.insert(QStringLiteral("multiEffects"), multiEffects);
+        o.insert(QStringLiteral("canvases"), canvases);
+        o.insert(QStringLiteral("textures"), textures);
+        o.insert(QStringLiteral("textureBytes"), textureBytes);
+        o.insert(QStringLiteral("offscreenBytes"), offscreenBytes);
+        o.insert(QStringLiteral("textureMemoryBytes"), textureBytes + offscreenBytes);
+        return o;
+    }
+};
+
+qint64 rgbaBytes(const QSizeF &size, int samples = 1)
+{
+    return qint64(std::ceil(size.width())) * qint64(std::ceil(size.height())) * 4 * std::max(1, samples);
+}
+
+void countNodes(QSGNode *node, SceneStats &stats, QSet<const QSGTexture *> &seen)
+{
+    ++stats.nodes;
+    switch (node->type()) {
+    case QSGNode::GeometryNodeType: {
+        ++stats.geometryNodes;
+        const QSGTexture *texture = nullptr;
+        if (auto *image = dynamic_cast<QSGImageNode *>(node)) {
+            texture = image->texture();
+        } else if (auto *simple = dynamic_cast<QSGSimpleTextureNode *>(node)) {
+            texture = simple->texture();
+        }
+        if (texture && !seen.contains(texture)) {
+            seen.insert(texture);
+            ++stats.textures;
+            stats.textureBytes += rgbaBytes(texture->textureSize());
+        }
+        break;
+    }
+    case QSGNode::ClipNodeType:
+        ++stats.clipNodes;
+        break;
+    case QSGNode::TransformNodeType:
+        ++stats.transformNodes;
+        break;
+    case QSGNode::OpacityNodeType:
+        ++stats.opacityNodes;
+        break;
+    case QSGNode::RenderNodeType:
+        ++stats.renderNodes;
+        break;
+    default:
+        break;
+    }
+    for (QSGNode *child = node->firstChild(); child; child = child->nextSibling()) countNodes(child, stats, seen);
+}
+
+void countItems(QQuickItem *item, SceneStats &stats)
+{
+    ++stats.items;
+    if (item->isVisible()) ++stats.visibleItems;
+
+    // layer 是分组属性，经元对象读取即可，无需私有接口
+    QObject *layer = item->property("layer").value<QObject *>();
+    if (layer && layer->property("enabled").toBool()) {
+        ++stats.layers;
+        QSizeF size = layer->property("textureSize").toSize();
+        if (size.isEmpty()) size = item->size();
+        const int samples = layer->property("samples").toInt();
+        stats.offscreenBytes += rgbaBytes(size, samples);
+        if (samples > 1) stats.offscreenBytes += rgbaBytes(size);      // 多重采样另需一份解析纹理
+    }
+    if (item->inherits("QQuickShaderEffectSource")) {
+        ++stats.effectSources;
+        QSizeF size = item->property("textureSize").toSize();
+        if (size.isEmpty()) {
+            if (auto *source = item->property("sourceItem").value<QQuickItem *>()) size = source->size();
+        }
+        stats.offscreenBytes += rgbaBytes(size, item->property("samples").toInt());
+    } else if (item->inherits("QQuickMultiEffect")) {
+        ++stats.multiEffects;
+    } else if (item->inherits("QQuickCanvasItem")) {
+        ++stats.canvases;
+        stats.offscreenBytes += rgbaBytes(item->size());
+    }
+    for (QQuickItem *child : item->childItems()) countItems(child, stats);
+}
+
+SceneStats sceneStats(QQuickWindow *window)
+{
+    SceneStats stats;
+    QSet<const QSGTexture *> seen;
+    // 同步之后内容项的节点即整棵场景图（根节点之下只有它）
+    if (QSGNode *root = QQuickItemPrivate::get(window->contentItem())->itemNode()) countNodes(root, stats, seen);
+    for (QQuickItem *child : window->contentItem()->childItems()) countItems(child, stats);
+    return stats;
+}
+
+// ---------------------- 交互脚本 ----------------------
+// 除通用的 idle 与 hover 外，个别组件追加专属交互；extra 写在组件内部，host 写在外层宿主中
+struct ComponentScript
+{
+    const char *name;
+    const char *extra;
+    const char *host;
+    const char *interaction;
+};
+
+const ComponentScript kScripts[] = {
+    { "EAnimatedWindow", "",
+      "Rectangle { id: openSource; x: 40; y: 40; width: 160; height: 120; radius: 24; color: \"#4a7bd0\" }\n"
+      "    function openWindow() { component.open(openSource) }",
+      "open" },
+    { "EPlaylist",
+      "Component.onCompleted: {\n"
+      "            var files = []\n"
+      "            for (var i = 0; i < 2000; ++i) files.push(\"/evolveui-render-bench/曲目 \" + i + \".mp3\")\n"
+      "            setFiles(files)\n"
+      "        }",
+      "", "scroll" },
+    { "EList", "", "", "scroll" },
+    { "EDataTable", "", "", "scroll" },
+    { "EDropdown", "", "", "scroll" },
+};
+
+// 主题对象本身不可见，作为每个宿主的 theme 提供
+const char *const kSkipped[] = { "ETheme" };
+
+const ComponentScript *scriptFor(const QString &name)
+{
+    for (const ComponentScript &script : kScripts) {
+        if (name == QLatin1String(script.name)) return &script;
+    }
+    return nullptr;
+}
+
+struct Target
+{
+    QString name;
+    QString kind;               // component / page
+    QString typeName;           // 宿主中使用的类型名
+    QString qmlText;            // 用于判断是否声明了同名属性
+};
+
+QList<Target> discoverTargets(const QString &pagesDir)
+{
+    QList<Target> targets;
+    const QDir components(QStringLiteral(":/qt/qml/EvolveUI/Components"));
+    for (const QString &file : components.entryList({ QStringLiteral("*.qml") }, QDir::Files, QDir::Name)) {
+        const QString name = file.chopped(4);
+        if (std::any_of(std::begin(kSkipped), std::end(kSkipped), [&](const char *s) { return name == QLatin1String(s); }))
+            continue;
+        QFile f(components.filePath(file));
+        f.open(QIODevice::ReadOnly);
+        targets.append({ name, QStringLiteral("component"), name, QString::fromUtf8(f.readAll()) });
+    }
+    const QDir pages(pagesDir);
+    for (const QString &file : pages.entryList({ QStringLiteral("*.qml") }, QDir::Files, QDir::Name)) {
+        const QString name = file.chopped(4);
+        QFile f(pages.filePath(file));
+        f.open(QIODevice::ReadOnly);
+        targets.append({ name, QStringLiteral("page"), QStringLiteral("Pages.") + name, QString::fromUtf8(f.readAll()) });
+    }
+    return targets;
+}
+
+bool declares(const QString &qmlText, const QString &property)
+{
+    const QRegularExpression re(QStringLiteral("^\\s*property\\s+\\w+\\s+%1\\b").arg(property),
+                                QRegularExpression::MultilineOption);
+    return re.match(qmlText).hasMatch();
+}
+
+// 与 Main.qml 相同的上下文：宿主持有主题，组件内部同名属性遮住 id 时经由 appTheme 传入
+QByteArray hostSource(const Target &target, const ComponentScript *script, const QSize &size, const QString &pagesDir)
+{
+    QStringList properties;
+    if (declares(target.qmlText, QStringLiteral("theme"))) properties << QStringLiteral("theme: host.appTheme");
+    if (declares(target.qmlText, QStringLiteral("viewportWidth"))) properties << QStringLiteral("viewportWidth: host.width");
+    if (script && *script->extra) properties << QString::fromUtf8(script->extra);
+
+    QString source = QStringLiteral("import QtQuick\nimport EvolveUI.Components\n");
+    if (target.kind == QLatin1String("page"))
+        source += QStringLiteral("import \"%1\" as Pages\n").arg(QUrl::fromLocalFile(pagesDir).toString());
+    source += QStringLiteral("Item {\n"
+                             "    id: host\n"
+                             "    width: %1\n"
+                             "    height: %2\n"
+                             "    ETheme { id: theme }\n"
+                             "    readonly property var appTheme: theme\n"
+                             "    property Item target: component\n")
+                  .arg(size.width())
+                  .arg(size.height());
+    if (script && *script->host) source += QStringLiteral("    %1\n").arg(QString::fromUtf8(script->host));
+    source += QStringLiteral("    %1 {\n        id: component\n").arg(target.typeName);
+    for (const QString &p : std::as_const(properties)) source += QStringLiteral("        %1\n").arg(p);
+    source += QStringLiteral("    }\n}\n");
+    return source.toUtf8();
+}
+
+// ---------------------- 运行 ----------------------
+double percentile(std::vector<qint64> sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    std::sort(sorted.begin(), sorted.end());
+    const size_t rank = size_t(std::ceil(p * double(sorted.size())));
+    return double(sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1]) / 1e6;
+}
+
+void sendMouseMove(QQuickWindow *window, const QPointF &pos)
+{
+    QMouseEvent event(QEvent::MouseMove, pos, pos, Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(window, &event);
+}
+
+void sendWheel(QQuickWindow *window, const QPointF &pos, int delta)
+{
+    QWheelEvent event(pos, pos, QPoint(), QPoint(0, delta), Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+    QCoreApplication::sendEvent(window, &event);
+}
+
+QRectF targetRect(QQuickItem *host, const QSize &size)
+{
+    QRectF rect(0, 0, size.width(), size.height());
+    if (auto *target = host->property("target").value<QQuickItem *>()) {
+        const QRectF mapped = target->mapRectToScene(QRectF(0, 0, target->width(), target->height()));
+        if (!mapped.isEmpty()) rect = mapped.intersected(rect);
+    }
+    return rect.isEmpty() ? QRectF(0, 0, size.width(), size.height()) : rect;
+}
+
+// interaction：idle / hover（逐行扫过组件区域）/ scroll（滚轮先下后上）/ open（首帧调用宿主的 openWindow）
+QJsonObject runScenario(OffscreenView &view, StepAnimationDriver &driver, QQuickItem *host,
+                        const QString &interaction, int frames, const QSize &size)
+{
+    QQuickWindow *window = view.window();
+    const QRectF area = targetRect(host, size);
+    const int rows = 4;
+    std::vector<qint64> totals;
+    totals.reserve(frames);
+    qint64 polish = 0;
+    qint64 sync = 0;
+    qint64 render = 0;
+    bool ok = true;
+
+    for (int i = 0; i < frames; ++i) {
+        const double t = frames > 1 ? double(i) / (frames - 1) : 0.0;
+        if (interaction == QLatin1String("hover")) {
+            const int row = std::min(rows - 1, int(t * rows));
+            const double x = std::fmod(t * rows, 1.0);
+            sendMouseMove(window, QPointF(area.left() + 1 + x * (area.width() - 2),
+                                          area.top() + (row + 0.5) * area.height() / rows));
+        } else if (interaction == QLatin1String("scroll")) {
+            if (i % 2 == 0) sendWheel(window, area.center(), i < frames / 2 ? -120 : 120);
+        } else if (interaction == QLatin1String("open") && i == 0) {
+            ok = QMetaObject::invokeMethod(host, "openWindow");
+        }
+        driver.step();
+        QCoreApplication::processEvents();
+        const FrameTime frame = view.renderFrame();
+        totals.push_back(frame.totalNs);
+        polish += frame.polishNs;
+        sync += frame.syncNs;
+        render += frame.renderNs;
+    }
+    if (interaction == QLatin1String("hover")) sendMouseMove(window, QPointF(-1, -1));
+
+    QJsonObject result;
+    if (!ok) result.insert(QStringLiteral("error"), QStringLiteral("interaction failed"));
+    const double n = std::max<size_t>(totals.size(), 1);
+    qint64 sum = 0;
+    for (qint64 v : totals) sum += v;
+    result.insert(QStringLiteral("frames"), frames);
+    result.insert(QStringLiteral("meanMs"), double(sum) / n / 1e6);
+    result.insert(QStringLiteral("p50Ms"), percentile(totals, 0.50));
+    result.insert(QStringLiteral("p90Ms"), percentile(totals, 0.90));
+    result.insert(QStringLiteral("p99Ms"), percentile(totals, 0.99));
+    result.insert(QStringLiteral("maxMs"), percentile(totals, 1.0));
+    result.insert(QStringLiteral("meanPolishMs"), double(polish) / n / 1e6);
+    result.insert(QStringLiteral("meanSyncMs"), double(sync) / n / 1e6);
+    result.insert(QStringLiteral("meanRenderMs"), double(render) / n / 1e6);
+    result.insert(QStringLiteral("scene"), sceneStats(window).toJson());
+    return result;
+}
+
+QJsonObject runTarget(QQmlEngine &engine, const Target &target, bool useRhi, int frames, const QSize &size,
+                      const QString &pagesDir)
+{
+    QJsonObject result;
+    result.insert(QStringLiteral("name"), target.name);
+    result.insert(QStringLiteral("kind"), target.kind);
+
+    const ComponentScript *script = scriptFor(target.name);
+    OffscreenView view(size, useRhi);
+    QString error;
+    if (!view.initialize(&error)) {
+        result.insert(QStringLiteral("error"), error);
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QQmlComponent component(&engine);
+    component.setData(hostSource(target, script, size, pagesDir),
+                      QUrl::fromLocalFile(QStringLiteral(EVOLVEUI_SOURCE_DIR "/benchmarks/") + target.name
+                                          + QStringLiteral("Host.qml")));
+    std::unique_ptr<QObject> object(component.isReady() ? component.create() : nullptr);
+    auto *host = qobject_cast<QQuickItem *>(object.get());
+    if (!host) {
+        result.insert(QStringLiteral("error"), component.errorString().trimmed());
+        return result;
+    }
+    host->setParentItem(view.window()->contentItem());
+    result.insert(QStringLiteral("createMs"), double(timer.nsecsElapsed()) / 1e6);
+
+    // 首帧包含纹理上传与着色器准备，单独记录；随后预热几帧再计时
+    StepAnimationDriver driver;
+    driver.install();
+    QCoreApplication::processEvents();
+    result.insert(QStringLiteral("firstFrameMs"), double(view.renderFrame().totalNs) / 1e6);
+    for (int i = 0; i < kWarmupFrames; ++i) {
+        driver.step();
+        QCoreApplication::processEvents();
+        view.renderFrame();
+    }
+
+    QStringList interactions { QStringLiteral("idle"), QStringLiteral("hover") };
+    if (script) interactions.append(QString::fromLatin1(script->interaction));
+    QJsonObject scenarios;
+    for (const QString &interaction : std::as_const(interactions))
+        scenarios.insert(interaction, runScenario(view, driver, host, interaction, frames, size));
+    result.insert(QStringLiteral("scenarios"), scenarios);
+
+    driver.uninstall();
+    // 宿主须先于窗口销毁
+    object.reset();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // 后端须在创建 QGuiApplication 之前确定：软件光栅化可在 offscreen 平台运行，
+    // llvmpipe 走 OpenGL，需要平台提供 GL 上下文（Linux CI 上可配合 xvfb）
+    bool useRhi = false;
+    for (int i = 1; i < argc; ++i) {
+        const QByteArray arg(argv[i]);
+        if (arg == "--backend" && i + 1 < argc) useRhi = qstrcmp(argv[i + 1], "llvmpipe") == 0;
+        else if (arg.startsWith("--backend=")) useRhi = arg.mid(10) == "llvmpipe";
+    }
+    if (useRhi) {
+        qputenv("LIBGL_ALWAYS_SOFTWARE", "1");
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::OpenGL);
+    } else {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    }
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("EvolveUIRenderBenchmark"));
+    QStandardPaths::setTestModeEnabled(true);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("EvolveUI component render benchmark"));
+    parser.addHelpOption();
+    QCommandLineOption backendOption(QStringLiteral("backend"), QStringLiteral("software or llvmpipe."),
+                                     QStringLiteral("name"), QStringLiteral("software"));
+    QCommandLineOption framesOption({ QStringLiteral("f"), QStringLiteral("frames") },
+                                    QStringLiteral("Frames per interaction."), QStringLiteral("count"),
+                                    QStringLiteral("120"));
+    QCommandLineOption sizeOption(QStringLiteral("size"), QStringLiteral("Viewport size."), QStringLiteral("WxH"),
+                                  QStringLiteral("800x600"));
+    QCommandLineOption onlyOption(QStringLiteral("only"), QStringLiteral("Comma-separated component/page names."),
+                                  QStringLiteral("list"));
+    QCommandLineOption outputOption({ QStringLiteral("o"), QStringLiteral("output") },
+                                    QStringLiteral("JSON output file (default: stdout)."), QStringLiteral("file"));
+    parser.addOptions({ backendOption, framesOption, sizeOption, onlyOption, outputOption });
+    parser.process(app);
+
+    const QString backend = parser.value(backendOption);
+    if (backend != QLatin1String("software") && backend != QLatin1String("llvmpipe")) {
+        qCritical("Unknown backend %s", qPrintable(backend));
+        return 1;
+    }
+    const int frames = std::max(1, parser.value(framesOption).toInt());
+    const QStringList dims = parser.value(sizeOption).split(QLatin1Char('x'));
+    const QSize size(std::max(1, dims.value(0).toInt()), std::max(1, dims.value(1).toInt()));
+    const QStringList only = parser.value(onlyOption).split(QLatin1Char(','), Qt::SkipEmptyParts);
+    const QString pagesDir = QDir::cleanPath(QStringLiteral(EVOLVEUI_SOURCE_DIR "/pages"));
+
+    QmlTypes::registerAll();
+    CachedNetworkAccessManagerFactory networkFactory;
+    QQmlEngine engine;
+    engine.setNetworkAccessManagerFactory(&networkFactory);
+    engine.addImageProvider(QStringLiteral("cover"), new CoverImageProvider);
+
+    QJsonArray results;
+    for (const Target &target : discoverTargets(pagesDir)) {
+        if (!only.isEmpty() && !only.contains(target.name)) continue;
+        qInfo("Rendering %s...", qPrintable(target.name));
+        const QJsonObject result = runTarget(engine, target, backend == QLatin1String("llvmpipe"), frames, size, pagesDir);
+        if (result.contains(QStringLiteral("error"))) {
+            qWarning("  %s", qPrintable(result.value(QStringLiteral("error")).toString()));
+        } else {
+            const QJsonObject idle = result.value(QStringLiteral("scenarios")).toObject().value(QStringLiteral("idle")).toObject();
+            qInfo("  idle p50 %.2f ms, p99 %.2f ms, %d nodes",
+                  idle.value(QStringLiteral("p50Ms")).toDouble(), idle.value(QStringLiteral("p99Ms")).toDouble(),
+                  idle.value(QStringLiteral("scene")).toObject().value(QStringLiteral("nodes")).toInt());
+        }
+        results.append(result);
+    }
+
+    QJsonObject report;
+    report.insert(QStringLiteral("benchmark"), QStringLiteral("evolveui-render"));
+    report.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert(QStringLiteral("qtVersion"), QString::fromLatin1(qVersion()));
+    report.insert(QStringLiteral("platform"), QSysInfo::prettyProductName());
+    report.insert(QStringLiteral("backend"), backend);
+    report.insert(QStringLiteral("width"), size.width());
+    report.insert(QStringLiteral("height"), size.height());
+    report.insert(QStringLiteral("framesPerInteraction"), frames);
+    report.insert(QStringLiteral("results"), results);
+
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+    if (parser.isSet(outputOption)) {
+        QFile out(parser.value(outputOption));
+        if (!out.open(QIODevice::WriteOnly) || out.write(json) != json.size()) {
+            qCritical("Cannot write %s", qPrintable(parser.value(outputOption)));
+            return 1;
+        }
+    } else {
+        QFile out;
+        out.open(stdout, QIODevice::WriteOnly);
+        out.write(json);
+    }
+    return 0;
+}
@@ -40,6 +40,9 @@ Item {
     property bool dismissOnOverlay: false
 
     default property alias contentData: contentArea.data  // 允许外部添加子项
+    // 延迟创建的内容：首次 open() 或 prewarm() 时才实例化，启动时不占用创建时间
+    property Component contentComponent: null
+    readonly property Item contentItem: contentLoader.item
 
     // 初始按钮颜色
     property color buttonColor: theme.secondaryColor
@@ -59,8 +62,23 @@ Item {
     })
 
     // ===== 对外接口函数  =====
+    // 同步创建延迟内容；预热中的异步创建会被立即补完
+    function ensureContent() {
+        if (!contentComponent) return;
+        contentLoader.asynchronous = false;
+        contentLoader.active = true;
+    }
+
+    // 空闲时在后台分帧创建延迟内容
+    function prewarm() {
+        if (!contentComponent || contentLoader.active) return;
+        contentLoader.asynchronous = true;
+        contentLoader.active = true;
+    }
+
     function open(source, txt = "") {
         if (isAnimating || state === "fullscreenState") return;
+        ensureContent();
 
         isAnimating = true;
         startState.sourceItem = source;
@@ -243,7 +261,14 @@ Item {
                 id: contentArea
                 anchors.fill: parent
                 // 外部的内容会自动加到这里
+
+                Loader {
+                    id: contentLoader
+                    anchors.fill: parent
+                    active: false
+                    sourceComponent: animationWrapper.contentComponent
                 }
+            }
 
             EButton {
                 iconCharacter: "\uf078"
@@ -3,6 +3,7 @@ import QtQuick
 import QtQuick.Layouts
 import QtQuick.Controls
 import QtQuick.Effects
+import EvolveUI.Core 1.0
 
 Rectangle {
     id: root
@@ -35,9 +36,19 @@ Rectangle {
     // 兼容单数据系列格式
     property var dataPoints: []
     
+    // 实时数据源：ChartSeries 列表，非空时优先于 dataSeries / dataPoints
+    property list<ChartSeries> liveSeries
+
     // 内部计算属性：合并的数据系列
     readonly property var effectiveDataSeries: {
-        if (dataPoints && dataPoints.length > 0) {
+        if (liveSeries.length > 0) {
+            // 只保留名称与颜色供图例/提示使用，数据点由 dataPoint() 按需读取
+            var live = [];
+            for (var s = 0; s < liveSeries.length; s++) {
+                live.push({ name: liveSeries[s].name, color: liveSeries[s].color, data: [] });
+            }
+            return live;
+        } else if (dataPoints && dataPoints.length > 0) {
             // 使用旧格式
             return [{
                 name: "Data",
@@ -83,23 +94,26 @@ Rectangle {
     property int topPadding: 90
 
     // === 计算属性 ===
-    property real maxValue: {
-        var max = 0;
-        var series = root.effectiveDataSeries;
-        for (var s = 0; s < series.length; s++) {
-            var data = series[s].data;
-            for (var i = 0; i < data.length; i++) {
-                if (data[i].value > max) {
-                    max = data[i].value;
-                }
-            }
-        }
-        return max;
-    }
+    // 最大值由 ChartItem 在解析数据时一并求出
+    readonly property real maxValue: chart.maxValue
 
     property real chartWidth: width - chartPadding * 2
     property real chartHeight: height - topPadding - chartPadding - (legend.visible ? 60 : 0)
 
+    // 取第 seriesIndex 个系列的第 index 个数据点；实时数据源按需构造，越界返回 undefined
+    function dataPoint(seriesIndex, index) {
+        if (seriesIndex < 0 || index < 0) return undefined;
+        if (liveSeries.length > 0) {
+            var live = liveSeries[seriesIndex];
+            if (!live || index >= live.count) return undefined;
+            live.revision; // 建立绑定依赖，数据推进时提示框随之刷新
+            var x = live.xAt(index);
+            return { x: x, month: String(x), label: String(x), value: live.yAt(index) };
+        }
+        var series = effectiveDataSeries[seriesIndex];
+        return series && index < series.data.length ? series.data[index] : undefined;
+    }
+
     // === 背景与阴影 ===
     Rectangle {
         id: background
@@ -209,227 +223,18 @@ Rectangle {
         anchors.margins: root.chartPadding
 
         // === 绘制区域图表 ===
-        Canvas {
-            id: chartCanvas
+        // 场景图原生绘制：大数据量时按像素宽度降采样，悬停只重新三角化缓存点
+        ChartItem {
+            id: chart
             anchors.fill: parent
             anchors.margins: 8  // 增加边距确保完整的圆形数据点可见
             anchors.bottomMargin: legend.visible ? 100 : 40  // 为横轴标签和图例留出空间
-            
-            // 绘制区域路径的函数
-            function drawAreaPath(ctx, points, lineStyle) {
-                switch(lineStyle) {
-                    case EAreaChart.LineStyle.Linear:
-                        // 直线连接
-                        for (var i = 1; i < points.length; i++) {
-                            ctx.lineTo(points[i].x, points[i].y);
-                        }
-                        break;
-                    case EAreaChart.LineStyle.Step:
-                        // 阶梯连接
-                        for (var j = 1; j < points.length; j++) {
-                            ctx.lineTo(points[j].x, points[j-1].y); // 水平线
-                            ctx.lineTo(points[j].x, points[j].y);   // 垂直线
-                        }
-                        break;
-                    case EAreaChart.LineStyle.Smooth:
-                    default:
-                        // 平滑曲线 - 使用Catmull-Rom样条
-                        if (points.length > 2) {
-                            // 第一段：从第一个点到第二个点
-                            var cp1x = points[0].x + (points[1].x - points[0].x) * 0.25;
-                            var cp1y = points[0].y;
-                            var cp2x = points[1].x - (points[2].x - points[0].x) * 0.25;
-                            var cp2y = points[1].y - (points[2].y - points[0].y) * 0.25;
-                            ctx.bezierCurveTo(cp1x, cp1y, cp2x, cp2y, points[1].x, points[1].y);
-                            
-                            // 中间段：使用Catmull-Rom样条
-                            for (var k = 2; k < points.length - 1; k++) {
-                                var p0 = points[k-2];
-                                var p1 = points[k-1];
-                                var p2 = points[k];
-                                var p3 = points[k+1];
-                                
-                                // Catmull-Rom控制点计算
-                                var cp1x_cat = p1.x + (p2.x - p0.x) / 6;
-                                var cp1y_cat = p1.y + (p2.y - p0.y) / 6;
-                                var cp2x_cat = p2.x - (p3.x - p1.x) / 6;
-                                var cp2y_cat = p2.y - (p3.y - p1.y) / 6;
-                                
-                                ctx.bezierCurveTo(cp1x_cat, cp1y_cat, cp2x_cat, cp2y_cat, p2.x, p2.y);
-                            }
-                            
-                            // 最后一段：到最后一个点
-                            if (points.length > 2) {
-                                var lastIdx = points.length - 1;
-                                var cp1x_last = points[lastIdx-1].x + (points[lastIdx].x - points[lastIdx-2].x) * 0.25;
-                                var cp1y_last = points[lastIdx-1].y + (points[lastIdx].y - points[lastIdx-2].y) * 0.25;
-                                var cp2x_last = points[lastIdx].x - (points[lastIdx].x - points[lastIdx-1].x) * 0.25;
-                                var cp2y_last = points[lastIdx].y;
-                                ctx.bezierCurveTo(cp1x_last, cp1y_last, cp2x_last, cp2y_last, points[lastIdx].x, points[lastIdx].y);
-                            }
-                        } else if (points.length === 2) {
-                            // 只有两个点时，使用简单的二次曲线
-                            var midX = (points[0].x + points[1].x) / 2;
-                            var midY = (points[0].y + points[1].y) / 2;
-                            ctx.quadraticCurveTo(midX, points[0].y, points[1].x, points[1].y);
-                        } else {
-                            // 只有一个点时，直接连线
-                            ctx.lineTo(points[0].x, points[0].y);
-                        }
-                        break;
-                }
-            }
-            
-            // 绘制线条路径的函数
-            function drawLinePath(ctx, points, lineStyle) {
-                switch(lineStyle) {
-                    case EAreaChart.LineStyle.Linear:
-                        // 直线连接
-                        for (var i = 1; i < points.length; i++) {
-                            ctx.lineTo(points[i].x, points[i].y);
-                        }
-                        break;
-                    case EAreaChart.LineStyle.Step:
-                        // 阶梯连接
-                        for (var j = 1; j < points.length; j++) {
-                            ctx.lineTo(points[j].x, points[j-1].y); // 水平线
-                            ctx.lineTo(points[j].x, points[j].y);   // 垂直线
-                        }
-                        break;
-                    case EAreaChart.LineStyle.Smooth:
-                    default:
-                        // 平滑曲线 - 使用相同的Catmull-Rom算法
-                        if (points.length > 2) {
-                            // 第一段：从第一个点到第二个点
-                            var cp1x_line = points[0].x + (points[1].x - points[0].x) * 0.25;
-                            var cp1y_line = points[0].y;
-                            var cp2x_line = points[1].x - (points[2].x - points[0].x) * 0.25;
-                            var cp2y_line = points[1].y - (points[2].y - points[0].y) * 0.25;
-                            ctx.bezierCurveTo(cp1x_line, cp1y_line, cp2x_line, cp2y_line, points[1].x, points[1].y);
-                            
-                            // 中间段：使用Catmull-Rom样条
-                            for (var k = 2; k < points.length - 1; k++) {
-                                var p0_line = points[k-2];
-                                var p1_line = points[k-1];
-                                var p2_line = points[k];
-                                var p3_line = points[k+1];
-                                
-                                // Catmull-Rom控制点计算
-                                var cp1x_cat_line = p1_line.x + (p2_line.x - p0_line.x) / 6;
-                                var cp1y_cat_line = p1_line.y + (p2_line.y - p0_line.y) / 6;
-                                var cp2x_cat_line = p2_line.x - (p3_line.x - p1_line.x) / 6;
-                                var cp2y_cat_line = p2_line.y - (p3_line.y - p1_line.y) / 6;
-                                
-                                ctx.bezierCurveTo(cp1x_cat_line, cp1y_cat_line, cp2x_cat_line, cp2y_cat_line, p2_line.x, p2_line.y);
-                            }
-                            
-                            // 最后一段：到最后一个点
-                            if (points.length > 2) {
-                                var lastIdx_line = points.length - 1;
-                                var cp1x_last_line = points[lastIdx_line-1].x + (points[lastIdx_line].x - points[lastIdx_line-2].x) * 0.25;
-                                var cp1y_last_line = points[lastIdx_line-1].y + (points[lastIdx_line].y - points[lastIdx_line-2].y) * 0.25;
-                                var cp2x_last_line = points[lastIdx_line].x - (points[lastIdx_line].x - points[lastIdx_line-1].x) * 0.25;
-                                var cp2y_last_line = points[lastIdx_line].y;
-                                ctx.bezierCurveTo(cp1x_last_line, cp1y_last_line, cp2x_last_line, cp2y_last_line, points[lastIdx_line].x, points[lastIdx_line].y);
-                            }
-                        } else if (points.length === 2) {
-                            // 只有两个点时，使用简单的二次曲线
-                            var midX_line = (points[0].x + points[1].x) / 2;
-                            var midY_line = (points[0].y + points[1].y) / 2;
-                            ctx.quadraticCurveTo(midX_line, points[0].y, points[1].x, points[1].y);
-                        } else if (points.length === 1) {
-                            // 只有一个点时，不需要绘制线条
-                        } else {
-                            // 多个点时，直接连线
-                            for (var l = 1; l < points.length; l++) {
-                                ctx.lineTo(points[l].x, points[l].y);
-                            }
-                        }
-                        break;
-                }
-            }
-            
-            onPaint: {
-                var ctx = getContext("2d");
-                ctx.clearRect(0, 0, width, height);
-                
-                var series = root.effectiveDataSeries;
-                if (series.length === 0 || series[0].data.length === 0) return;
-
-                // 使用第一个系列的数据长度作为基准
-                var dataLength = series[0].data.length;
-                var stepX = width / dataLength;
-                var chartHeight = height - 16; // 为顶部和底部的数据点留出空间
-                
-                // 为每个数据系列绘制图表
-                for (var seriesIndex = 0; seriesIndex < series.length; seriesIndex++) {
-                    var currentSeries = series[seriesIndex];
-                    var data = currentSeries.data;
-                    
-                    // 创建路径点 - 居中对齐
-                    var points = [];
-                    for (var i = 0; i < data.length; i++) {
-                        var x = stepX * i + stepX / 2; // 居中对齐
-                        var y = 8 + chartHeight - (data[i].value / root.maxValue) * chartHeight;
-                        points.push({x: x, y: y});
-                    }
-
-                    // 绘制区域填充
-                    ctx.beginPath();
-                    ctx.moveTo(points[0].x, 8 + chartHeight); // 从底部开始
-                    ctx.lineTo(points[0].x, points[0].y); // 到第一个数据点
-                    
-                    // 根据线条样式绘制不同的曲线
-                    drawAreaPath(ctx, points, root.lineStyle);
-                    
-                    // 回到底部完成区域
-                    ctx.lineTo(points[points.length-1].x, 8 + chartHeight);
-                    ctx.closePath();
-                    
-                    // 填充区域 - 使用系列颜色的透明版本
-                    var seriesColor = currentSeries.color;
-                    var color = Qt.color(seriesColor);
-                    ctx.fillStyle = Qt.rgba(color.r, color.g, color.b, 0.3);
-                    ctx.fill();
-
-                    // 绘制边界线
-                    ctx.beginPath();
-                    ctx.moveTo(points[0].x, points[0].y);
-                    
-                    drawLinePath(ctx, points, root.lineStyle);
-                    
-                    ctx.strokeStyle = seriesColor;
-                    ctx.lineWidth = 2;
-                    ctx.stroke();
-
-                    // 绘制数据点 - 只在悬停时显示
-                    if (root.hoveredIndex >= 0 && root.hoveredIndex < points.length) {
-                        var hoveredPoint = points[root.hoveredIndex];
-                        
-                        // 绘制外圆
-                        ctx.beginPath();
-                        ctx.arc(hoveredPoint.x, hoveredPoint.y, 5, 0, 2 * Math.PI);
-                        ctx.fillStyle = seriesColor;
-                        ctx.fill();
-                        
-                        // 绘制内圆
-                        ctx.beginPath();
-                        ctx.arc(hoveredPoint.x, hoveredPoint.y, 3, 0, 2 * Math.PI);
-                        ctx.fillStyle = "white";
-                        ctx.fill();
-                    }
-                }
-            }
-
-            // 当数据改变时重新绘制
-            Connections {
-                target: root
-                function onDataPointsChanged() { chartCanvas.requestPaint(); }
-                function onDataSeriesChanged() { chartCanvas.requestPaint(); }
-                function onAreaColorChanged() { chartCanvas.requestPaint(); }
-                function onLineColorChanged() { chartCanvas.requestPaint(); }
-                function onHoveredIndexChanged() { chartCanvas.requestPaint(); }
-            }
+            type: ChartItem.Area
+            series: root.effectiveDataSeries
+            sources: root.liveSeries
+            lineStyle: root.lineStyle
+            hoveredIndex: root.hoveredIndex
+            verticalPadding: 8
         }
 
         // === 交互层 ===
@@ -450,22 +255,16 @@ Rectangle {
             onPositionChanged: function(mouse) {
                 hideTimer.stop();
                 
-                var series = root.effectiveDataSeries;
-                if (series.length === 0 || series[0].data.length === 0) return;
+                if (chart.pointCount === 0) return;
                 
-                // 使用与绘制相同的坐标计算方式
-                var dataLength = series[0].data.length;
-                var stepX = chartCanvas.width / dataLength;
-                var index = Math.floor(mouse.x / stepX);
-                index = Math.max(0, Math.min(index, dataLength - 1));
+                // 按屏幕 x 二分查找最近的数据点
+                var index = chart.indexAt(mouse.x - chart.x);
+                if (index < 0) return;
                 
                 // 计算目标位置
-                var baseX = root.chartPadding + index * stepX + stepX / 2;
-                var targetX = Math.max(10, Math.min(baseX - tooltip.width/2, root.width - tooltip.width - 10));
-                
-                var dataValue = series[0].data[index].value;
-                var dataY = root.topPadding + root.chartHeight - (dataValue / root.maxValue) * root.chartHeight;
-                var targetY = Math.max(10, dataY - tooltip.height - 10);
+                var point = chart.mapToItem(root, chart.pointPosition(0, index));
+                var targetX = Math.max(10, Math.min(point.x - tooltip.width/2, root.width - tooltip.width - 10));
+                var targetY = Math.max(10, point.y - tooltip.height - 10);
                 
                 // 如果之前是隐藏状态，直接设置位置不显示动画
                 if (root.hoveredIndex === -1) {
@@ -478,7 +277,7 @@ Rectangle {
                 
                 if (index !== root.hoveredIndex) {
                     root.hoveredIndex = index;
-                    root.pointHovered(index, series[0].data[index]);
+                    root.pointHovered(index, root.dataPoint(0, index));
                 }
             }
             
@@ -488,9 +287,9 @@ Rectangle {
             
             onClicked: function(mouse) {
                 if (root.hoveredIndex >= 0) {
-                    var series = root.effectiveDataSeries;
-                    if (series.length > 0 && series[0].data.length > root.hoveredIndex) {
-                        root.pointClicked(root.hoveredIndex, series[0].data[root.hoveredIndex]);
+                    var data = root.dataPoint(0, root.hoveredIndex);
+                    if (data !== undefined) {
+                        root.pointClicked(root.hoveredIndex, data);
                     }
                 }
             }
@@ -499,17 +298,25 @@ Rectangle {
 
     // === X轴标签 ===
     Row {
+        id: axisRow
         anchors.bottom: parent.bottom
         anchors.left: parent.left
         anchors.right: parent.right
         anchors.margins: root.chartPadding
         anchors.bottomMargin: legend.visible ? 75 : 15
 
+        // 数据点很多时按步长抽取标签，保证每个标签至少 40px 宽
+        readonly property int pointCount: chart.pointCount
+        readonly property int labelStride: Math.max(1, Math.ceil(pointCount * 40 / Math.max(1, root.chartWidth)))
+
         Repeater {
-            model: root.effectiveDataSeries.length > 0 ? root.effectiveDataSeries[0].data : []
+            model: Math.ceil(axisRow.pointCount / axisRow.labelStride)
             delegate: Text {
-                width: root.chartWidth / (root.effectiveDataSeries.length > 0 ? root.effectiveDataSeries[0].data.length : 1)
-                text: modelData.month
+                width: root.chartWidth * axisRow.labelStride / Math.max(1, axisRow.pointCount)
+                text: {
+                    var data = root.dataPoint(0, index * axisRow.labelStride);
+                    return data && data.month !== undefined ? data.month : "";
+                }
                 font.pixelSize: root.fontSize - 2
                 color: root.subtitleColor
                 horizontalAlignment: Text.AlignHCenter
@@ -554,7 +361,10 @@ Rectangle {
             spacing: 4
 
             Text {
-                text: root.hoveredIndex >= 0 && root.effectiveDataSeries.length > 0 ? root.effectiveDataSeries[0].data[root.hoveredIndex].label : ""
+                text: {
+                    var data = root.dataPoint(0, root.hoveredIndex);
+                    return data !== undefined ? data.label : "";
+                }
                 font.pixelSize: root.fontSize - 1
                 color: root.tooltipTextColor
                 font.bold: true
@@ -585,7 +395,10 @@ Rectangle {
                     }
 
                     Text {
-                        text: root.hoveredIndex >= 0 && modelData.data.length > root.hoveredIndex ? modelData.data[root.hoveredIndex].value : ""
+                        text: {
+                            var data = root.dataPoint(index, root.hoveredIndex);
+                            return data !== undefined ? data.value : "";
+                        }
                         font.pixelSize: root.fontSize - 1
                         color: root.tooltipTextColor
                         font.bold: true
@@ -634,12 +447,4 @@ Rectangle {
             }
         }
     }
-
-    // 监听线条样式变化
-    Connections {
-        target: root
-        function onLineStyleChanged() {
-            chartCanvas.requestPaint();
-        }
-    }
 }
@@ -3,6 +3,7 @@ import QtQuick
 import QtQuick.Layouts
 import QtQuick.Controls
 import QtQuick.Effects
+import EvolveUI.Core 1.0
 
 Rectangle {
     id: root
@@ -35,9 +36,19 @@ Rectangle {
     // 兼容单数据系列格式
     property var dataPoints: []
     
+    // 实时数据源：ChartSeries 列表，非空时优先于 dataSeries / dataPoints
+    property list<ChartSeries> liveSeries
+
     // 内部计算属性：合并的数据系列
     readonly property var effectiveDataSeries: {
-        if (dataPoints && dataPoints.length > 0) {
+        if (liveSeries.length > 0) {
+            // 只保留名称与颜色供图例/提示使用，数据点由 dataPoint() 按需读取
+            var live = [];
+            for (var s = 0; s < liveSeries.length; s++) {
+                live.push({ name: liveSeries[s].name, color: liveSeries[s].color, data: [] });
+            }
+            return live;
+        } else if (dataPoints && dataPoints.length > 0) {
             // 使用旧格式
             return [{
                 name: "Data",
@@ -76,23 +87,26 @@ Rectangle {
     property real groupSpacing: 0.3 // 组间距比例 (0-1)
 
     // === 计算属性 ===
-    property real maxValue: {
-        var max = 0;
-        var series = root.effectiveDataSeries;
-        for (var s = 0; s < series.length; s++) {
-            var data = series[s].data;
-            for (var i = 0; i < data.length; i++) {
-                if (data[i].value > max) {
-                    max = data[i].value;
-                }
-            }
-        }
-        return max > 0 ? max : 100; // 避免除以0
-    }
+    // 最大值由 ChartItem 在解析数据时一并求出（无数据时为 100，避免除以0）
+    readonly property real maxValue: chart.maxValue
 
     property real chartWidth: width - chartPadding * 2
     property real chartHeight: height - topPadding - chartPadding - (legend.visible ? 60 : 0)
 
+    // 取第 seriesIndex 个系列的第 index 个数据点；实时数据源按需构造，越界返回 undefined
+    function dataPoint(seriesIndex, index) {
+        if (seriesIndex < 0 || index < 0) return undefined;
+        if (liveSeries.length > 0) {
+            var live = liveSeries[seriesIndex];
+            if (!live || index >= live.count) return undefined;
+            live.revision; // 建立绑定依赖，数据推进时提示框随之刷新
+            var x = live.xAt(index);
+            return { x: x, label: String(x), value: live.yAt(index) };
+        }
+        var series = effectiveDataSeries[seriesIndex];
+        return series && index < series.data.length ? series.data[index] : undefined;
+    }
+
     // === 背景与阴影 ===
     Rectangle {
         id: background
@@ -140,111 +154,20 @@ Rectangle {
         anchors.margins: root.chartPadding
 
         // === 绘制柱状图 ===
-        Canvas {
-            id: chartCanvas
+        // 场景图原生绘制：柱子窄于 2px 时按像素列取最大值合并
+        ChartItem {
+            id: chart
             anchors.fill: parent
             anchors.margins: 8
             anchors.bottomMargin: legend.visible ? 100 : 40
-            
-            property var barRects: [] // 存储柱子的区域用于鼠标检测
-
-            onPaint: {
-                var ctx = getContext("2d");
-                ctx.clearRect(0, 0, width, height);
-                
-                var series = root.effectiveDataSeries;
-                if (series.length === 0 || series[0].data.length === 0) return;
-
-                var dataLength = series[0].data.length;
-                var seriesCount = series.length;
-                var chartH = height;
-                
-                // 计算宽度
-                // 每一组数据的总宽度 (包含组间距)
-                var groupTotalWidth = width / dataLength;
-                // 实际的一组数据的宽度 (减去组间距)
-                var groupWidth = groupTotalWidth * (1 - root.groupSpacing);
-                // 单个柱子的宽度 (减去柱间距)
-                var barWidth = (groupWidth / seriesCount) * (1 - (seriesCount > 1 ? root.barSpacing : 0));
-                
-                // 居中偏移
-                var groupOffsetX = (groupTotalWidth - groupWidth) / 2;
-                var barStepX = groupWidth / seriesCount;
-                var barOffsetX = (barStepX - barWidth) / 2;
-
-                barRects = []; // 重置点击区域
-
-                // 绘制参考线 (Grid)
-                ctx.beginPath();
-                ctx.strokeStyle = Qt.rgba(root.textColor.r, root.textColor.g, root.textColor.b, 0.1);
-                ctx.lineWidth = 1;
-                for (var j = 0; j <= 5; j++) {
-                    var lineY = chartH * (j / 5);
-                    ctx.moveTo(0, lineY);
-                    ctx.lineTo(width, lineY);
-                }
-                ctx.stroke();
-
-                // 绘制柱子
-                for (var i = 0; i < dataLength; i++) {
-                    var groupX = i * groupTotalWidth + groupOffsetX;
-
-                    for (var s = 0; s < seriesCount; s++) {
-                        var data = series[s].data[i];
-                        var val = data.value;
-                        var barHeight = (val / root.maxValue) * chartH;
-                        var x = groupX + s * barStepX + barOffsetX;
-                        var y = chartH - barHeight;
-
-                        // 记录区域用于交互
-                        barRects.push({
-                            x: x,
-                            y: y,
-                            w: barWidth,
-                            h: barHeight,
-                            seriesIndex: s,
-                            dataIndex: i,
-                            value: val,
-                            label: data.label
-                        });
-
-                        // 绘制柱体
-                        ctx.fillStyle = series[s].color;
-                        
-                        // 如果是悬停状态，改变透明度或亮度
-                        if (root.hoveredSeriesIndex === s && root.hoveredDataIndex === i) {
-                            ctx.globalAlpha = 0.8;
-                        } else {
-                            ctx.globalAlpha = 1.0;
-                        }
-
-                        // 圆角矩形绘制
-                        var r = Math.min(barWidth / 2, 5);
-                        ctx.beginPath();
-                        ctx.moveTo(x + r, y);
-                        ctx.lineTo(x + barWidth - r, y);
-                        ctx.quadraticCurveTo(x + barWidth, y, x + barWidth, y + r);
-                        ctx.lineTo(x + barWidth, y + barHeight);
-                        ctx.lineTo(x, y + barHeight);
-                        ctx.lineTo(x, y + r);
-                        ctx.quadraticCurveTo(x, y, x + r, y);
-                        ctx.closePath();
-                        ctx.fill();
-                    }
-                }
-                ctx.globalAlpha = 1.0;
-            }
-
-            // 当数据改变时重新绘制
-            Connections {
-                target: root
-                function onDataPointsChanged() { chartCanvas.requestPaint(); }
-                function onDataSeriesChanged() { chartCanvas.requestPaint(); }
-                function onEffectiveDataSeriesChanged() { chartCanvas.requestPaint(); }
-                function onTextColorChanged() { chartCanvas.requestPaint(); }
-                function onHoveredSeriesIndexChanged() { chartCanvas.requestPaint(); }
-                function onHoveredDataIndexChanged() { chartCanvas.requestPaint(); }
-            }
+            type: ChartItem.Bar
+            series: root.effectiveDataSeries
+            sources: root.liveSeries
+            hoveredSeries: root.hoveredSeriesIndex
+            hoveredIndex: root.hoveredDataIndex
+            barSpacing: root.barSpacing
+            groupSpacing: root.groupSpacing
+            gridColor: Qt.rgba(root.textColor.r, root.textColor.g, root.textColor.b, 0.1)
         }
 
         // === 交互层 ===
@@ -266,51 +189,31 @@ Rectangle {
             onPositionChanged: function(mouse) {
                 hideTimer.stop();
                 
-                var rects = chartCanvas.barRects;
-                var found = false;
+                // 转换坐标到图表坐标系，按组宽直接算出命中的柱子
+                var hit = chart.barAt(mouse.x - chart.x, mouse.y - chart.y);
                 
-                // 转换坐标到canvas坐标系
-                var canvasX = mouse.x - chartCanvas.x;
-                var canvasY = mouse.y - chartCanvas.y;
-
-                for (var i = 0; i < rects.length; i++) {
-                    var r = rects[i];
-                    if (canvasX >= r.x && canvasX <= r.x + r.w &&
-                        canvasY >= r.y && canvasY <= r.y + r.h) {
-                        
-                        // 计算目标位置
-                        var tooltipX = chartCanvas.x + r.x + r.w/2 - tooltip.width/2;
-                        var tooltipY = chartCanvas.y + r.y - tooltip.height - 5;
-                        
-                        // 边界限制
-                        var targetX = Math.max(0, Math.min(tooltipX, root.width - tooltip.width));
-                        var targetY = tooltipY;
-                        
-                        // 如果之前是隐藏状态，直接设置位置不显示动画
-                        if (root.hoveredSeriesIndex === -1) {
-                            tooltip.x = targetX;
-                            tooltip.y = targetY;
-                        } else {
-                            // 否则让 Behavior 处理动画
-                            tooltip.x = targetX;
-                            tooltip.y = targetY;
-                        }
+                if (hit.series >= 0) {
+                    var top = chart.mapToItem(chartArea, chart.pointPosition(hit.series, hit.index));
+                    
+                    // 计算目标位置
+                    var tooltipX = top.x - tooltip.width/2;
+                    var tooltipY = top.y - tooltip.height - 5;
+                    
+                    // 边界限制
+                    var targetX = Math.max(0, Math.min(tooltipX, root.width - tooltip.width));
+                    var targetY = tooltipY;
+                    
+                    // 隐藏状态下 Behavior 未启用，位置直接跳转；显示时由 Behavior 处理动画
+                    tooltip.x = targetX;
+                    tooltip.y = targetY;
 
-                        if (root.hoveredSeriesIndex !== r.seriesIndex || root.hoveredDataIndex !== r.dataIndex) {
-                            root.hoveredSeriesIndex = r.seriesIndex;
-                            root.hoveredDataIndex = r.dataIndex;
-                            root.pointHovered(r.seriesIndex, r.dataIndex, root.effectiveDataSeries[r.seriesIndex].data[r.dataIndex]);
-                        }
-                        
-                        found = true;
-                        break;
+                    if (root.hoveredSeriesIndex !== hit.series || root.hoveredDataIndex !== hit.index) {
+                        root.hoveredSeriesIndex = hit.series;
+                        root.hoveredDataIndex = hit.index;
+                        root.pointHovered(hit.series, hit.index, root.dataPoint(hit.series, hit.index));
                     }
-                }
-                
-                if (!found) {
-                    // 只有当不在任何柱子上时才启动隐藏计时器
-                    // 但为了体验，我们可以让它保持显示直到移出区域或者超时
-                    // 这里简化：如果不在柱子上，启动计时器
+                } else {
+                    // 不在任何柱子上时启动隐藏计时器
                     if (!hideTimer.running) hideTimer.start();
                 }
             }
@@ -321,8 +224,7 @@ Rectangle {
             
             onClicked: function(mouse) {
                 if (root.hoveredSeriesIndex >= 0 && root.hoveredDataIndex >= 0) {
-                    var series = root.effectiveDataSeries;
-                    var data = series[root.hoveredSeriesIndex].data[root.hoveredDataIndex];
+                    var data = root.dataPoint(root.hoveredSeriesIndex, root.hoveredDataIndex);
                     root.pointClicked(root.hoveredSeriesIndex, root.hoveredDataIndex, data);
                 }
             }
@@ -366,7 +268,8 @@ Rectangle {
                 text: {
                     if (root.hoveredSeriesIndex >= 0 && root.hoveredDataIndex >= 0) {
                         var series = root.effectiveDataSeries[root.hoveredSeriesIndex];
-                        var item = series.data[root.hoveredDataIndex];
+                        var item = root.dataPoint(root.hoveredSeriesIndex, root.hoveredDataIndex);
+                        if (!series || item === undefined) return "";
                         return (series.name ? series.name + "\n" : "") + (item.label || "") + ": " + item.value;
                     }
                     return "";
@@ -378,25 +281,29 @@ Rectangle {
 
     // === X轴标签 ===
     Row {
+        id: axisRow
         anchors.bottom: parent.bottom
         anchors.left: parent.left
         anchors.right: parent.right
         anchors.margins: root.chartPadding
         anchors.bottomMargin: legend.visible ? 75 : 15
         
+        // 数据点很多时按步长抽取标签，保证每个标签至少 40px 宽
+        readonly property int pointCount: chart.pointCount
+        readonly property int labelStride: Math.max(1, Math.ceil(pointCount * 40 / Math.max(1, root.chartWidth)))
+        
         Repeater {
-            model: root.effectiveDataSeries.length > 0 ? root.effectiveDataSeries[0].data.length : 0
+            model: Math.ceil(axisRow.pointCount / axisRow.labelStride)
             
             Item {
-                width: (root.width - root.chartPadding * 2) / (root.effectiveDataSeries[0].data.length || 1)
+                width: (root.width - root.chartPadding * 2) * axisRow.labelStride / (axisRow.pointCount || 1)
                 height: 20
                 
                 Text {
                     anchors.centerIn: parent
                     text: {
-                        var series = root.effectiveDataSeries;
-                        if (series.length > 0 && series[0].data.length > index) {
-                            var item = series[0].data[index];
+                        var item = root.dataPoint(0, index * axisRow.labelStride);
+                        if (item !== undefined) {
                             return item.label || item.month || "";
                         }
                         return "";
@@ -1,7 +1,7 @@
 // EBlurCard
 import QtQuick
 import QtQuick.Controls
-import QtQuick.Effects
+import EvolveUI.Core 1.0
 
 Item {
     id: root
@@ -15,6 +15,11 @@ Item {
     property real borderRadius: 24
     property color borderColor: "transparent"
     property real borderWidth: 0
+    // 源内容持续变化（列表滚动、动画）时打开，定时重新截取
+    property bool liveBlur: false
+
+    // 源内容变化但没有可观察的信号时（如滚动停止），手动触发一次重新模糊
+    function invalidateBlur() { backdrop.invalidate() }
 
     default property alias content: contentItem.data
 
@@ -29,38 +34,15 @@ Item {
         enabled: root.dragable
     }
 
-    // --- 捕获背景内容 ---
-    ShaderEffectSource {
-        id: effectSource
-        anchors.fill: parent
-        sourceItem: root.blurSource
-        sourceRect: Qt.rect(root.x, root.y, root.width, root.height)
-        visible: false
-    }
-
-    // === 创建遮罩 ===
-    Item {
-        id: maskItem
+    // --- 模糊背景 ---
+    // 源只在内容/尺寸变化时降采样模糊一次，多张卡片共用同一份结果；卡片移动只换取样区域
+    BlurBackdrop {
+        id: backdrop
         anchors.fill: parent
-        layer.enabled: true
-        layer.smooth: true
-        visible: false
-        Rectangle {
-            anchors.fill: parent
-            radius: root.borderRadius
-            color: "white"  // 必须是不透明色，否则遮罩无效
-        }
-    }
-    // === 启用遮罩 ===
-    MultiEffect {
-        anchors.fill: effectSource
-        source: effectSource
-        autoPaddingEnabled: false
-        blurEnabled: true
-        blurMax: root.blurMax
-        blur: root.blurAmount
-        maskEnabled: true
-        maskSource: maskItem
+        source: root.blurSource
+        radius: root.blurMax * root.blurAmount
+        cornerRadius: root.borderRadius
+        live: root.liveBlur && root.visible && root.opacity > 0
     }
 
     // ====叠加主题色, 避免过亮/过透明 ====
@@ -3,6 +3,7 @@ import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
 import QtQuick.Effects
+import EvolveUI.Core 1.0
 
 Item {
     id: root
@@ -159,29 +160,25 @@ Item {
         }
     }
 
-    // ==== 生命周期 ====
-    Component.onCompleted: fetchBingImages()
+    // ==== 数据：Bing 图片（磁盘缓存 6 小时，离线时沿用上次结果）====
+    NetworkResource {
+        id: bingImages
+        url: "https://www.bing.com/HPImageArchive.aspx?format=js&idx=0&n=5&mkt=en-US"
+        ttl: 6 * 60 * 60 * 1000
+        onLoaded: {
+            var images = value && value.images ? value.images : []
+            var urls = []
+            for (var i = 0; i < images.length; i++) {
+                urls.push("https://www.bing.com" + images[i].url)
+            }
+            if (urls.length > 0)
+                root.model = urls
+        }
+        onFailed: console.log("Failed to fetch Bing images: " + errorString)
+    }
 
     // ==== 函数：获取 Bing 图片 ====
     function fetchBingImages() {
-        var xhr = new XMLHttpRequest()
-        var url = "https://www.bing.com/HPImageArchive.aspx?format=js&idx=0&n=5&mkt=en-US&_=" + new Date().getTime()
-        xhr.open("GET", url)
-        xhr.onreadystatechange = function() {
-            if (xhr.readyState === XMLHttpRequest.DONE) {
-                if (xhr.status === 200) {
-                    var response = JSON.parse(xhr.responseText)
-                    var images = response.images
-                    var urls = []
-                    for (var i = 0; i < images.length; i++) {
-                        urls.push("https://www.bing.com" + images[i].url)
-                    }
-                    root.model = urls
-                } else {
-                    console.log("Failed to fetch Bing images, status: " + xhr.status)
-                }
-            }
-        }
-        xhr.send()
+        bingImages.refresh()
     }
 }
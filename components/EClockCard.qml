@@ -1,6 +1,7 @@
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Effects
+import EvolveUI.Core 1.0
 
 Item {
     id: root
@@ -80,41 +81,33 @@ Item {
         return "\uf0c2" // 默认 cloud
     }
 
+    // 地址随 key/地区/语言/单位变化时自动重新获取；缓存 15 分钟内直接复用，离线时沿用上次结果
+    NetworkResource {
+        id: weatherResource
+        url: root.weatherApiUrl
+        ttl: 15 * 60 * 1000
+        autoLoad: root.useNetworkWeather && root.weatherApiKey !== "" && root.weatherLocation !== ""
+        onLoaded: {
+            const res = value && value.results && value.results[0]
+            if (res && res.now) {
+                // 更新温度与图标（心知：now.temperature 为字符串）
+                root.temperature = Math.round(Number(res.now.temperature))
+                root.weatherCode = Number(res.now.code)
+                root.weatherIcon = mapWeatherToIcon(res.now.text, root.weatherCode)
+            } else {
+                console.warn("[Weather] Invalid payload format")
+            }
+        }
+        onFailed: console.warn("[Weather] Request failed:", httpStatus, errorString)
+    }
+
     function fetchWeather() {
         if (!useNetworkWeather) return
         if (!weatherApiKey || !weatherLocation) {
             console.warn("[Weather] Missing apiKey or location")
             return
         }
-        try {
-            const xhr = new XMLHttpRequest()
-            xhr.open("GET", weatherApiUrl)
-            xhr.onreadystatechange = function() {
-                if (xhr.readyState === XMLHttpRequest.DONE) {
-                    if (xhr.status === 200) {
-                        try {
-                            const payload = JSON.parse(xhr.responseText)
-                            const res = payload && payload.results && payload.results[0]
-                            if (res && res.now) {
-                                // 更新温度与图标（心知：now.temperature 为字符串）
-                                root.temperature = Math.round(Number(res.now.temperature))
-                                root.weatherCode = Number(res.now.code)
-                                root.weatherIcon = mapWeatherToIcon(res.now.text, root.weatherCode)
-                            } else {
-                                console.warn("[Weather] Invalid payload format")
-                            }
-                        } catch (e) {
-                            console.error("[Weather] Parse error:", e)
-                        }
-                    } else {
-                        console.warn("[Weather] Request failed:", xhr.status)
-                    }
-                }
-            }
-            xhr.send()
-        } catch (err) {
-            console.error("[Weather] Fetch error:", err)
-        }
+        weatherResource.reload()
     }
 
     // 每秒更新时间
@@ -244,10 +237,4 @@ Item {
         function onTextColorChanged() {}
     }
 
-    // API 参数变化时触发天气更新
-    onWeatherLocationChanged: if (useNetworkWeather) fetchWeather()
-    onWeatherApiKeyChanged: if (useNetworkWeather) fetchWeather()
-    onWeatherLanguageChanged: if (useNetworkWeather) fetchWeather()
-    onWeatherUnitChanged: if (useNetworkWeather) fetchWeather()
-    Component.onCompleted: if (useNetworkWeather) fetchWeather()
 }
\ No newline at end of file
@@ -3,6 +3,7 @@ import QtQuick
 import QtQuick.Layouts
 import QtQuick.Controls
 import QtQuick.Effects
+import EvolveUI.Core 1.0
 
 Rectangle {
     id: root
@@ -37,80 +38,44 @@ Rectangle {
     property color checkmarkColor: theme.focusColor
     property int boxSize: 20
 
+    // === 数据模型 ===
+    // 列式存储 + 后台排序筛选；model（ListModel）变化后自动重新导入，也可直接调用 tableModel.setRows()
+    property alias tableModel: tableModel
+    property bool sortable: true
+
+    DataTableModel {
+        id: tableModel
+        headers: root.headers
+        sourceModel: root.model
+        onViewChanged: root.calculateColumnWidths()
+        onHeadersChanged: root.calculateColumnWidths()
+    }
+
     // === 动态列宽数组 ===
     property var columnWidths: []
 
-    TextMetrics {
-        id: textMetrics
-        font.pixelSize: root.fontSize
-    }
-
     // === 响应式表头全选状态 ===
-    property string headerCheckState: "none" // none / all / partial
-
-    onModelChanged: updateHeaderCheckState()
-    onCheckStateChanged: updateHeaderCheckState()
+    readonly property string headerCheckState: tableModel.checkState // none / all / partial
 
-    function updateHeaderCheckState() {
-        if (!model || model.count === 0) {
-            headerCheckState = "none";
-            return;
-        }
-
-        var checkedCount = 0;
-        var totalCount = model.count;
-
-        for (var i = 0; i < totalCount; i++) {
-            if (model.get(i).checked === true) {
-                checkedCount++;
-                if (checkedCount === totalCount) break;
-            }
-        }
+    property int hoveredRow: -1
+    property int pressedRow: -1
 
-        if (checkedCount === totalCount) {
-            headerCheckState = "all";
-        } else if (checkedCount > 0) {
-            headerCheckState = "partial";
-        } else {
-            headerCheckState = "none";
-        }
-    }
-
-    // === 计算列宽 ===
+    // === 计算列宽：抽样测量，行数再多也只测固定数量的单元格 ===
     function calculateColumnWidths() {
-        var widths = [];
-        var i, row, col;
-        var value;
-
-        // 初始化默认宽度
-        for (i = 0; i < headers.length; i++) {
-            widths.push(80);
-        }
-
-        // 计算表头宽度
-        for (i = 0; i < headers.length; i++) {
-            textMetrics.text = headers[i].label;
-            widths[i] = Math.max(widths[i], textMetrics.width + cellPadding * 2);
-        }
-
-        // 计算数据行宽度
-        if (model && model.count > 0) {
-            for (row = 0; row < model.count; row++) {
-                var rowObj = model.get(row);
-                for (col = 0; col < headers.length; col++) {
-                    var key = headers[col].key;
-                    value = rowObj[key] !== undefined ? String(rowObj[key]) : "-";
-                    textMetrics.text = value;
-                    widths[col] = Math.max(widths[col], textMetrics.width + cellPadding * 2);
-                }
-            }
-        }
+        columnWidths = tableModel.estimateColumnWidths(Qt.font({ pixelSize: root.fontSize }), cellPadding);
+        dataView.forceLayout();
+    }
 
-        columnWidths = widths;
+    // 点击行：切换勾选并发出信号；rowData 为该行的快照对象
+    function activateRow(row) {
+        pressedRow = -1;
+        tableModel.toggleChecked(row);
+        var rowData = tableModel.get(row);
+        root.checkStateChanged(row, rowData, rowData.checked);
+        root.rowClicked(row, rowData);
     }
 
     Component.onCompleted: calculateColumnWidths();
-    onHeadersChanged: calculateColumnWidths();
 
     // === 背景与阴影===
     Rectangle {
@@ -128,219 +93,237 @@ Rectangle {
             shadowVerticalOffset: theme.shadowYOffset
         }
 
-        // === 滚动区域（现在由 background 裁剪）===
-        Flickable {
-            id: flick
+        // === 表格区域（由 background 裁剪）===
+        Item {
+            id: tableArea
             anchors.fill: parent
             anchors.margins: 10
             clip: true
-            flickableDirection: Flickable.HorizontalFlick
-            contentWidth: (root.selectable ? 40 : 0) + columnWidths.reduce(function(a, b) { return a + b; }, 0)
-            contentHeight: flick.height
 
-            Column {
-                width: flick.contentWidth
+            // === 表头 ===
+            Row {
+                id: headerRow
+                height: root.headerHeight
+                spacing: 0
+                z: 1
 
-                // === 表头 ===
-                Row {
-                    id: headerRow
-                    height: root.headerHeight
-                    spacing: 0
+                // 全选复选框列（固定，不随横向滚动）
+                Rectangle {
+                    visible: root.selectable
+                    width: 40
+                    height: parent.height
+                    color: root.backgroundVisible ? root.headerColor : "transparent"
 
-                    // 全选复选框列
                     Rectangle {
-                        visible: root.selectable
-                        width: 40
-                        height: parent.height
-                        color: root.backgroundVisible ? root.headerColor : "transparent"
+                        id: headerCheckbox
+                        anchors.centerIn: parent
+                        width: root.boxSize
+                        height: root.boxSize
+                        radius: root.boxSize * 0.25
+                        border.color: root.checkmarkColor
+                        border.width: 2
 
-                        Rectangle {
-                            id: headerCheckbox
-                            anchors.centerIn: parent
-                            width: root.boxSize
-                            height: root.boxSize
-                            radius: root.boxSize * 0.25
-                            border.color: root.checkmarkColor
-                            border.width: 2
-
-                            color: root.headerCheckState === "all" ? root.checkmarkColor :
-                                   root.headerCheckState === "partial" ? root.checkmarkColor : "transparent"
-
-                            Behavior on color { ColorAnimation { duration: 150 } }
-
-                            Text {
-                                anchors.centerIn: parent
-                                visible: root.headerCheckState === "all"
-                                text: "\u2713"
-                                color: root.rowColor
-                                font.pixelSize: 16
-                                Behavior on opacity { NumberAnimation { duration: 120 } }
-                            }
+                        color: root.headerCheckState === "all" ? root.checkmarkColor :
+                               root.headerCheckState === "partial" ? root.checkmarkColor : "transparent"
 
-                            Text {
-                                anchors.centerIn: parent
-                                visible: root.headerCheckState === "partial"
-                                text: "\u2212"
-                                color: root.rowColor
-                                font.pixelSize: 18
-                                font.bold: true
-                                Behavior on opacity { NumberAnimation { duration: 120 } }
-                            }
+                        Behavior on color { ColorAnimation { duration: 150 } }
 
-                            MouseArea {
-                                anchors.fill: parent
-                                cursorShape: Qt.PointingHandCursor
-                                onClicked: {
-                                    var newState = root.headerCheckState !== "all";
-                                    for (var i = 0; i < root.model.count; i++) {
-                                        root.model.setProperty(i, "checked", newState);
-                                    }
-                                    root.updateHeaderCheckState();
-                                }
-                            }
+                        Text {
+                            anchors.centerIn: parent
+                            visible: root.headerCheckState === "all"
+                            text: "\u2713"
+                            color: root.rowColor
+                            font.pixelSize: 16
+                            Behavior on opacity { NumberAnimation { duration: 120 } }
                         }
-                    }
 
-                    // 数据列头
-                    Repeater {
-                        model: root.headers
-                        delegate: Rectangle {
-                            width: root.columnWidths[index]
-                            height: parent.height
-                            color: root.backgroundVisible ? root.headerColor : "transparent"
-
-                            Text {
-                                anchors.centerIn: parent
-                                text: modelData.label
-                                font.pixelSize: root.fontSize
-                                font.bold: true
-                                color: root.headerTextColor
-                                elide: Text.ElideRight
-                            }
+                        Text {
+                            anchors.centerIn: parent
+                            visible: root.headerCheckState === "partial"
+                            text: "\u2212"
+                            color: root.rowColor
+                            font.pixelSize: 18
+                            font.bold: true
+                            Behavior on opacity { NumberAnimation { duration: 120 } }
+                        }
+
+                        MouseArea {
+                            anchors.fill: parent
+                            cursorShape: Qt.PointingHandCursor
+                            // 位图整字填充，不再逐行 setProperty
+                            onClicked: tableModel.setAllChecked(root.headerCheckState !== "all")
                         }
                     }
                 }
 
-                // === 数据区 ===
-                ListView {
-                    id: tableView
-                    width: flick.contentWidth
-                    height: flick.height - headerRow.height
-                    spacing: 2
-                    model: root.model
+                // 数据列头：随表格横向滚动
+                Item {
+                    width: tableArea.width - (root.selectable ? 40 : 0)
+                    height: parent.height
                     clip: true
 
-                    delegate: Rectangle {
-                        id: rowContainer
-                        width: tableView.width
-                        height: root.rowHeight
-                        radius: root.radius * 0.5
-
-                        property bool checked: (model.checked !== undefined) ? model.checked : false
-                        property var rowData: model
-                        property bool hovered: false
-
-                        color: root.backgroundVisible ? (hovered ? root.hoverColor : root.rowColor) : "transparent"
-                        opacity: 1.0
-
-                        Behavior on color { ColorAnimation { duration: 150 } }
-                        Behavior on opacity { NumberAnimation { duration: 100 } }
-
-                        transform: Scale {
-                            id: scale
-                            origin.x: rowContainer.width / 2
-                            origin.y: rowContainer.height / 2
-                        }
-
-                        ParallelAnimation {
-                            id: restoreAnimation
-                            SpringAnimation { target: scale; property: "xScale"; to: 1.0; spring: 2.5; damping: 0.25 }
-                            SpringAnimation { target: scale; property: "yScale"; to: 1.0; spring: 2.5; damping: 0.25 }
-                        }
-
-                        Row {
-                            anchors.fill: parent
-                            spacing: 0
+                    Row {
+                        x: -dataView.contentX
+                        height: parent.height
 
-                            // 单行复选框
-                            Rectangle {
-                                visible: root.selectable
-                                width: 40
+                        Repeater {
+                            model: root.headers
+                            delegate: Rectangle {
+                                width: root.columnWidths[index] !== undefined ? root.columnWidths[index] : 80
                                 height: parent.height
-                                color: "transparent"
+                                color: root.backgroundVisible ? root.headerColor : "transparent"
 
-                                Rectangle {
-                                    id: checkboxRect
+                                readonly property var sortKey: tableModel.sortKeys.length > 0 ? tableModel.sortKeys[0] : null
+                                readonly property bool sorted: sortKey !== null && sortKey.key === modelData.key
+
+                                Text {
                                     anchors.centerIn: parent
-                                    width: root.boxSize
-                                    height: root.boxSize
-                                    radius: root.boxSize * 0.25
-                                    border.color: root.checkmarkColor
-                                    border.width: 2
-                                    color: rowContainer.checked ? root.checkmarkColor : "transparent"
-                                    Behavior on color { ColorAnimation { duration: 150 } }
-
-                                    Text {
-                                        anchors.centerIn: parent
-                                        visible: rowContainer.checked
-                                        text: "\u2713"
-                                        color: root.rowColor
-                                        font.pixelSize: 16
-                                    }
+                                    text: modelData.label + (parent.sorted ? (parent.sortKey.ascending ? " \u25B4" : " \u25BE") : "")
+                                    font.pixelSize: root.fontSize
+                                    font.bold: true
+                                    color: root.headerTextColor
+                                    elide: Text.ElideRight
                                 }
-                            }
 
-                            // 数据列
-                            Repeater {
-                                model: root.headers
-                                delegate: Rectangle {
-                                    width: root.columnWidths[index]
-                                    height: parent.height
-                                    color: "transparent"
-
-                                    Text {
-                                        anchors.centerIn: parent
-                                        text: rowData[modelData.key] !== undefined ? rowData[modelData.key] : "-"
-                                        color: root.textColor
-                                        font.pixelSize: root.fontSize
-                                        elide: Text.ElideRight
-                                    }
+                                MouseArea {
+                                    anchors.fill: parent
+                                    enabled: root.sortable
+                                    cursorShape: Qt.PointingHandCursor
+                                    onClicked: tableModel.sortBy(modelData.key)
                                 }
                             }
                         }
+                    }
+                }
+            }
 
-                        // 点击整行交互
-                        MouseArea {
-                            anchors.fill: parent
-                            hoverEnabled: true
-                            cursorShape: Qt.PointingHandCursor
+            // === 单行复选框列：与数据区纵向同步滚动 ===
+            TableView {
+                id: checkView
+                visible: root.selectable
+                anchors.top: headerRow.bottom
+                anchors.left: parent.left
+                anchors.bottom: parent.bottom
+                width: root.selectable ? 40 : 0
+                clip: true
+                interactive: false
+                model: tableModel
+                rowSpacing: 2
+                syncView: dataView
+                syncDirection: Qt.Vertical
+                // 只显示第 0 列
+                columnWidthProvider: function(column) { return column === 0 ? 40 : 0 }
+                rowHeightProvider: function(row) { return root.rowHeight }
+
+                delegate: Rectangle {
+                    required property int row
+                    required property bool checked
+                    implicitWidth: 40
+                    implicitHeight: root.rowHeight
+                    color: root.backgroundVisible ? (root.hoveredRow === row ? root.hoverColor : root.rowColor) : "transparent"
+                    opacity: root.pressedRow === row ? 0.85 : 1.0
+
+                    Behavior on color { ColorAnimation { duration: 150 } }
+                    Behavior on opacity { NumberAnimation { duration: 100 } }
+
+                    // 按下时整行纵向收缩；单元格各自缩放会在列间留缝，因此只缩放 y
+                    transform: Scale {
+                        origin.y: root.rowHeight / 2
+                        yScale: root.pressedRow === row ? root.pressedScale : 1.0
+                        Behavior on yScale { SpringAnimation { spring: 2.5; damping: 0.25 } }
+                    }
 
-                            onEntered: rowContainer.hovered = true
-                            onExited: rowContainer.hovered = false
+                    Rectangle {
+                        anchors.centerIn: parent
+                        width: root.boxSize
+                        height: root.boxSize
+                        radius: root.boxSize * 0.25
+                        border.color: root.checkmarkColor
+                        border.width: 2
+                        color: checked ? root.checkmarkColor : "transparent"
+                        Behavior on color { ColorAnimation { duration: 150 } }
 
-                            onPressed: {
-                                scale.xScale = root.pressedScale
-                                scale.yScale = root.pressedScale
-                                rowContainer.opacity = 0.85
-                            }
+                        Text {
+                            anchors.centerIn: parent
+                            visible: checked
+                            text: "\u2713"
+                            color: root.rowColor
+                            font.pixelSize: 16
+                        }
+                    }
 
-                            onReleased: {
-                                var newCheckedState = !rowContainer.checked;
-                                var currentRowData = root.model.get(index);
+                    MouseArea {
+                        anchors.fill: parent
+                        hoverEnabled: true
+                        cursorShape: Qt.PointingHandCursor
+                        onEntered: root.hoveredRow = row
+                        onExited: if (root.hoveredRow === row) root.hoveredRow = -1
+                        onPressed: root.pressedRow = row
+                        onReleased: root.activateRow(row)
+                        onCanceled: root.pressedRow = -1
+                    }
+                }
+            }
 
-                                restoreAnimation.restart();
-                                rowContainer.opacity = 1.0;
+            // === 数据区：TableView 只实例化可见单元格 ===
+            TableView {
+                id: dataView
+                anchors.top: headerRow.bottom
+                anchors.left: checkView.right
+                anchors.right: parent.right
+                anchors.bottom: parent.bottom
+                clip: true
+                model: tableModel
+                rowSpacing: 2
+                boundsBehavior: Flickable.StopAtBounds
+                columnWidthProvider: function(column) {
+                    return root.columnWidths[column] !== undefined ? root.columnWidths[column] : 80
+                }
+                rowHeightProvider: function(row) { return root.rowHeight }
+
+                ScrollBar.vertical: ScrollBar { }
+                ScrollBar.horizontal: ScrollBar { }
+
+                delegate: Rectangle {
+                    required property int row
+                    required property string display
+                    implicitWidth: 80
+                    implicitHeight: root.rowHeight
+                    color: root.backgroundVisible ? (root.hoveredRow === row ? root.hoverColor : root.rowColor) : "transparent"
+                    opacity: root.pressedRow === row ? 0.85 : 1.0
+
+                    Behavior on color { ColorAnimation { duration: 150 } }
+                    Behavior on opacity { NumberAnimation { duration: 100 } }
+
+                    // 按下时整行纵向收缩；单元格各自缩放会在列间留缝，因此只缩放 y
+                    transform: Scale {
+                        origin.y: root.rowHeight / 2
+                        yScale: root.pressedRow === row ? root.pressedScale : 1.0
+                        Behavior on yScale { SpringAnimation { spring: 2.5; damping: 0.25 } }
+                    }
 
-                                root.model.setProperty(index, "checked", newCheckedState);
-                                root.checkStateChanged(index, currentRowData, newCheckedState);
-                                root.rowClicked(index, currentRowData);
-                            }
+                    Text {
+                        anchors.fill: parent
+                        anchors.leftMargin: root.cellPadding
+                        anchors.rightMargin: root.cellPadding
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                        text: display
+                        color: root.textColor
+                        font.pixelSize: root.fontSize
+                        elide: Text.ElideRight
+                    }
 
-                            onCanceled: {
-                                restoreAnimation.restart();
-                                rowContainer.opacity = 1.0;
-                            }
-                        }
+                    // 点击整行交互
+                    MouseArea {
+                        anchors.fill: parent
+                        hoverEnabled: true
+                        cursorShape: Qt.PointingHandCursor
+                        onEntered: root.hoveredRow = row
+                        onExited: if (root.hoveredRow === row) root.hoveredRow = -1
+                        onPressed: root.pressedRow = row
+                        onReleased: root.activateRow(row)
+                        onCanceled: root.pressedRow = -1
                     }
                 }
             }
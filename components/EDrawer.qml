@@ -28,12 +28,30 @@ Item {
 
     // === 插槽：用户内容 ===
     default property alias content: contentLayout.data
+    // 延迟创建的内容：首次打开或 prewarm() 时才实例化
+    property Component contentComponent: null
+    readonly property Item contentItem: contentLoader.item
 
     // === 对外方法 ===
     function open()   { root.opened = true }
     function close()  { root.opened = false }
     function toggle() { root.opened = !root.opened }
 
+    // 空闲时在后台分帧创建延迟内容
+    function prewarm() {
+        if (!contentComponent || contentLoader.active) return
+        contentLoader.asynchronous = true
+        contentLoader.active = true
+    }
+
+    // 打开时同步补完（预热中的异步创建会被立即完成）
+    onOpenedChanged: {
+        if (opened && contentComponent) {
+            contentLoader.asynchronous = false
+            contentLoader.active = true
+        }
+    }
+
     // === 抽屉 ===
     Item {
         id: drawerContent
@@ -83,6 +101,15 @@ Item {
             anchors.fill: parent
             spacing: columnspacing
             anchors.margins: root.padding
+
+            Loader {
+                id: contentLoader
+                width: contentLayout.width
+                height: contentLayout.height
+                visible: status === Loader.Ready
+                active: false
+                sourceComponent: root.contentComponent
+            }
         }
 
         // === 动画 ===
@@ -1,6 +1,7 @@
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Effects
+import EvolveUI.Core 1.0
 
 Item {
     id: root
@@ -62,7 +63,7 @@ Item {
             anchors.fill: parent
             source: root.bingImageUrl
             fillMode: Image.PreserveAspectCrop
-            cache: false
+            cache: true
             visible: false
             antialiasing: true
             smooth: true
@@ -183,7 +184,7 @@ Item {
             cursorShape: Qt.PointingHandCursor
             onClicked: {
                 // 同时刷新文案与背景图片
-                fetchQuote()
+                fetchQuote(true)
                 fetchBingImage()
             }
         }
@@ -214,96 +215,65 @@ Item {
         }
     }
 
-    // === Hitokoto 拉取 ===
-    function fetchQuote() {
+    // === Hitokoto 拉取（缓存期与刷新周期一致，重启不会重复请求） ===
+    NetworkResource {
+        id: quoteResource
+        url: root.quoteApiUrl
+        ttl: root.quoteRefreshIntervalMs
+        autoLoad: root.useNetworkQuote
+        onLoaded: {
+            root.quoteText = value.hitokoto || "(无内容)"
+            root.quoteFrom = value.from || ""
+            root.quoteFromWho = value.from_who || ""
+        }
+        onFailed: console.warn("[Hitokoto] Request failed:", httpStatus, errorString)
+    }
+
+    function fetchQuote(force) {
         if (!useNetworkQuote) return
-        try {
-            const xhr = new XMLHttpRequest()
-            xhr.open("GET", quoteApiUrl + "&_=" + Date.now())
-            xhr.onreadystatechange = function() {
-                if (xhr.readyState === XMLHttpRequest.DONE) {
-                    if (xhr.status === 200) {
-                        try {
-                            const payload = JSON.parse(xhr.responseText)
-                            root.quoteText = payload.hitokoto || "(无内容)"
-                            root.quoteFrom = payload.from || ""
-                            root.quoteFromWho = payload.from_who || ""
-                        } catch (e) {
-                            console.error("[Hitokoto] Parse error:", e)
-                        }
-                    } else {
-                        console.warn("[Hitokoto] Request failed:", xhr.status)
-                    }
-                }
-            }
-            xhr.send()
-        } catch (err) {
-            console.error("[Hitokoto] Fetch error:", err)
+        if (force) quoteResource.refresh()
+        else quoteResource.reload()
+    }
+
+    // === 随机背景：只取跳转后的直链，确保外部打开与当前显示一致 ===
+    NetworkResource {
+        id: acgResource
+        url: root.acgApiUrl
+        kind: NetworkResource.Location
+        onLoaded: {
+            root.bingImageUrl = value
+            root.imageDirectUrl = value
+        }
+        onFailed: {
+            console.warn("[ACG] Request failed:", httpStatus, errorString)
+            // 无法获取直链则仍使用随机端点
+            root.bingImageUrl = root.acgApiUrl
+            root.imageDirectUrl = root.acgApiUrl
         }
     }
 
-    // === Bing 背景拉取 ===
     function fetchBingImage() {
-        // 先尝试获取最终跳转后的直链，确保外部打开与当前显示一致
-        try {
-            const xhr = new XMLHttpRequest()
-            xhr.open("GET", root.acgApiUrl + "?_=" + Date.now())
-            xhr.onreadystatechange = function() {
-                if (xhr.readyState === XMLHttpRequest.DONE) {
-                    if (xhr.status === 200) {
-                        const finalUrl = xhr.responseURL || ""
-                        if (finalUrl && finalUrl.length > 0) {
-                            root.bingImageUrl = finalUrl
-                            root.imageDirectUrl = finalUrl
-                        } else {
-                            // 无法获取直链则仍使用随机端点
-                            const url = root.acgApiUrl + "?_=" + Date.now()
-                            root.bingImageUrl = url
-                            root.imageDirectUrl = url
-                        }
-                    } else {
-                        console.warn("[ACG] Request failed:", xhr.status)
-                    }
-                }
-            }
-            xhr.send()
-        } catch (err) {
-            console.error("[ACG] XHR error:", err)
-            const url = root.acgApiUrl + "?_=" + Date.now()
-            root.bingImageUrl = url
-            root.imageDirectUrl = url
-        }
+        acgResource.refresh()
     }
 
     // Bing 回退：当 loliapi 返回 WebP 且环境未部署解码插件时触发
-    function fetchBingImageFallback() {
-        try {
-            const xhr = new XMLHttpRequest()
-            const url = "https://www.bing.com/HPImageArchive.aspx?format=js&idx=0&n=1&mkt=en-US&_=" + Date.now()
-            xhr.open("GET", url)
-            xhr.onreadystatechange = function() {
-                if (xhr.readyState === XMLHttpRequest.DONE) {
-                    if (xhr.status === 200) {
-                        try {
-                            const res = JSON.parse(xhr.responseText)
-                            if (res && res.images && res.images.length > 0) {
-                                const rel = res.images[0].url
-                                const direct = "https://www.bing.com" + rel
-                                root.bingImageUrl = direct
-                                root.imageDirectUrl = direct
-                            }
-                        } catch (e) {
-                            console.error("[Bing Fallback] Parse error:", e)
-                        }
-                    } else {
-                        console.warn("[Bing Fallback] Request failed:", xhr.status)
-                    }
-                }
+    NetworkResource {
+        id: bingFallbackResource
+        url: "https://www.bing.com/HPImageArchive.aspx?format=js&idx=0&n=1&mkt=en-US"
+        ttl: 6 * 60 * 60 * 1000
+        autoLoad: false
+        onLoaded: {
+            if (value && value.images && value.images.length > 0) {
+                const direct = "https://www.bing.com" + value.images[0].url
+                root.bingImageUrl = direct
+                root.imageDirectUrl = direct
             }
-            xhr.send()
-        } catch (err) {
-            console.error("[Bing Fallback] Fetch error:", err)
         }
+        onFailed: console.warn("[Bing Fallback] Request failed:", httpStatus, errorString)
+    }
+
+    function fetchBingImageFallback() {
+        bingFallbackResource.reload()
     }
 
     // 每 12 小时刷新一句话
@@ -321,10 +291,4 @@ Item {
         repeat: true
         onTriggered: fetchBingImage()
     }
-
-    // 生命周期
-    Component.onCompleted: {
-        if (useNetworkQuote) fetchQuote()
-        fetchBingImage()
-    }
 }
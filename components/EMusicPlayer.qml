@@ -3,9 +3,9 @@ import QtQuick
 import QtQuick.Layouts
 import QtQuick.Controls
 import QtQuick.Effects
-import QtMultimedia
 import AudioMetadata 1.0
 import MusicLibrary 1.0
+import EvolveUI.Core 1.0
 
 Rectangle {
     id: root
@@ -19,6 +19,8 @@ Rectangle {
     property bool coverImageIsDefault: false
     property bool isPlaying: false
     property real progress: 0.0  // 0.0 - 1.0
+    property bool waveformEnabled: true   // 进度条显示音频波形（后台生成并缓存）
+    property bool spectrumEnabled: true   // 卡片底部显示实时频谱
     property int duration: 0     // 总时长（秒）
     property int position: 0     // 当前位置（秒）
     // 毫秒级进度，用于歌词精确同步
@@ -31,51 +33,36 @@ Rectangle {
             src = decodeURIComponent(p.substring(8))
         }
         if (musicLibrary && musicLibrary.isValidMusicFile && !musicLibrary.isValidMusicFile(src)) return
-        if (root.playlistModelRef && typeof root.playlistModelRef.get === "function") {
-            var found = -1
-            for (var i = 0; i < root.playlistModelRef.count; i++) {
-                var it = root.playlistModelRef.get(i)
-                if (it && (it.source === src || it.source === p)) { found = i; break }
-            }
-            if (found >= 0) { playAt(found); return }
-        }
-        mediaPlayer.stop()
+        // 路径 -> 行号由 C++ 模型哈希索引，无需遍历
+        var found = playlistModel.indexOf(src)
+        if (found < 0) found = playlistModel.indexOf(p)
+        if (found >= 0) { playAt(found); return }
         if (root.source === src) {
             root.source = ""
         }
         root.source = src
-        mediaPlayer.play()
+        playbackEngine.play()
     }
 
+    // 批量追加：模型内部去重并一次性插入
     function addSources(sources) {
-        if (!sources || !playlistModel) return
-        for (var i = 0; i < sources.length; i++) {
-            var s = sources[i]
-            if (typeof s === 'string' && s.indexOf('file:///') === 0) s = decodeURIComponent(s.substring(8))
-            var exists = false
-            for (var j = 0; j < playlistModel.count; j++) {
-                var it = playlistModel.get(j)
-                if (it && it.source === s) { exists = true; break }
-            }
-            if (!exists) playlistModel.append({ source: s })
-        }
+        if (!sources) return
+        playlistModel.appendSources(sources)
         if (!root.isPlaying && playlistModel.count > 0) {
-            root.source = playlistModel.get(0).source
+            root.source = playlistModel.sourceAt(0)
         }
     }
 
     function resetSources(sources) {
-        if (!playlistModel) return
-        playlistModel.clear()
-        addSources(sources)
+        playlistModel.setSources(sources || [])
         if (playlistModel.count > 0) {
             currentIndex = 0
-            root.source = playlistModel.get(0).source
+            root.source = playlistModel.sourceAt(0)
         }
     }
 
     function stopPlayback() {
-        if (mediaPlayer) mediaPlayer.stop()
+        playbackEngine.stop()
         root.source = ""
         root.songTitle = "未知歌曲"
         root.artistName = "未知艺术家"
@@ -90,9 +77,15 @@ Rectangle {
         // 播放模式：0=循环，1=单曲循环，2=随机
         property int playMode: 0
     
-    // 音乐显色（用于主题动态强调色）
-    property color coverProminentColor: theme.defaultFocusColor // 采样得到的不透明主色（初始为默认强调色）
+    // 音乐显色（用于主题动态强调色）：封面取色完成前及无封面时为默认强调色
+    property color coverProminentColor: coverPalette.ready ? coverPalette.accent : theme.defaultFocusColor
     property color previousFocusColor: theme.focusColor   // 播放前的主题强调色
+
+    // 从专辑封面取色：工作线程计算，结果按封面哈希缓存
+    CoverPalette {
+        id: coverPalette
+        source: root.coverImageIsDefault ? "" : root.coverImage
+    }
     
     // 自动读取元数据
     property bool autoReadMetadata: true
@@ -112,16 +105,12 @@ Rectangle {
     signal seekPositionChanged(real newPosition)
 
     // 允许外部触发：封面点击等
-    onPlayClicked: {
-        if (mediaPlayer) mediaPlayer.play()
-    }
-    onPauseClicked: {
-        if (mediaPlayer) mediaPlayer.pause()
-    }
+    onPlayClicked: playbackEngine.play()
+    onPauseClicked: playbackEngine.pause()
     // 外部进度条拖动：newPosition 为 0.0-1.0 比例
     onSeekPositionChanged: function(newPosition) {
-        if (mediaPlayer && mediaPlayer.duration > 0) {
-            mediaPlayer.position = Math.max(0, Math.min(1, newPosition)) * mediaPlayer.duration
+        if (playbackEngine.duration > 0) {
+            playbackEngine.seek(Math.max(0, Math.min(1, newPosition)) * playbackEngine.duration)
         }
     }
     
@@ -139,7 +128,6 @@ Rectangle {
         }
         
         onCoverImageUrlChanged: {
-            // 移除时间戳，防止生成不可复用的纹理资源导致内存增长
             const url = coverImageUrl.toString()
             if (url.length === 0) {
                 // 无封面：标记默认并清空封面 URL（封面用图标显示）
@@ -147,82 +135,57 @@ Rectangle {
                 root.coverImage = ""
             } else {
                 root.coverImageIsDefault = false
-                // 由于 C++ 始终写入同一临时文件路径，如果不改变字符串，Image 可能复用首次的纹理
-                root.coverImage = url + "?v=" + Date.now()
+                // image://cover/<hash> 按内容寻址，同一封面复用同一纹理，可放心缓存
+                root.coverImage = url
             }
         }
-        
-        onDurationChanged: {
-            root.duration = duration
-        }
     }
 
-    
-    // 媒体播放器
-    MediaPlayer {
-        id: mediaPlayer
+    // 播放引擎：输出设备只打开一次，下一首提前解码并在样本级衔接
+    PlaybackEngine {
+        id: playbackEngine
         source: root.source
-        audioOutput: AudioOutput {
-            volume: theme.musicVolume
-        }
-        
-        onSourceChanged: {
-            console.log("音频源已更改:", source)
-            if (source != "") {
-                console.log("开始播放音频")
-            }
-        }
-        
-        Component.onCompleted: {
-            console.log("MediaPlayer组件已加载，音频源:", source)
-            if (source != "") {
-                console.log("自动开始播放")
-            }
-        }
-        
-        onErrorOccurred: function(error, errorString) {
-            console.error("MediaPlayer错误:", error, errorString)
-        }
-        
-        onPlaybackStateChanged: {
-            console.log("播放状态改变:", playbackState)
-            if (playbackState === MediaPlayer.PlayingState) {
-                root.isPlaying = true
-                console.log("正在播放")
-            } else if (playbackState === MediaPlayer.PausedState) {
-                root.isPlaying = false
-                console.log("已暂停")
-            } else if (playbackState === MediaPlayer.StoppedState) {
-                root.isPlaying = false
-                console.log("已停止")
-            }
+        nextSource: root.nextSource
+        volume: theme.musicVolume
+        // 随机播放时曲目互不相关，按单曲归一；顺序/单曲循环时保留专辑内的相对响度
+        normalization: root.playMode === 2 ? PlaybackEngine.TrackGain : PlaybackEngine.AlbumGain
+
+        onErrorOccurred: function(source, message) {
+            console.error("播放错误:", source, message)
         }
-        
+
+        onPlayingChanged: root.isPlaying = playing
+
         onPositionChanged: {
-            // MediaPlayer.position 为毫秒
+            // position 为毫秒
             root.positionMs = position
             root.position = Math.floor(position / 1000)
-            if (duration > 0) {
+            // 拖动进度条期间保持手指位置，松开后再跟随播放进度
+            if (duration > 0 && !progressTrack.dragging) {
                 root.progress = position / duration
             }
         }
-        
-        
 
-        onMediaStatusChanged: {
-            if (mediaStatus === MediaPlayer.EndOfMedia) {
-                if (root.playMode === 1) {
-                    mediaPlayer.position = 0
-                    mediaPlayer.play()
-                } else if (root.playMode === 2) {
-                    root.playRandom()
-                } else {
-                    root.playNext()
-                }
+        onDurationChanged: root.duration = Math.floor(duration / 1000)
+
+        // 已无缝衔接到预备的下一首：同步索引与音源（音源相同，不会触发重新加载）
+        onTrackAdvanced: {
+            var i = playlistModel.indexOf(source)
+            if (i >= 0) currentIndex = i
+            root.source = source
+        }
+
+        // 没有预备下一首（列表为空等）时才会走到这里
+        onEndOfMedia: {
+            if (root.playMode === 1) {
+                playbackEngine.seek(0)
+                playbackEngine.play()
+            } else {
+                root.playNext()
             }
         }
     }
-    // === 样式属性 ===
+
     property real radius: 20
     property int itemHeight: 80
     property int itemFontSize: 15
@@ -263,41 +226,15 @@ Rectangle {
             smooth: true
         }
 
-        // 原始专辑封面图像，隐藏
-        Image {
-            id: backgroundAlbumCoverSource
+        // 模糊专辑封面：按降采样尺寸解码并模糊一次，与全屏播放页同一封面时共用缓存
+        BlurBackdrop {
+            id: backgroundAlbumCover
             anchors.fill: parent
             // 无元数据时不加载壁纸，背景仍使用纯色叠加
-            source: root.coverImageIsDefault ? "" : root.coverImage
-            fillMode: Image.PreserveAspectCrop
-            cache: false
-            asynchronous: false
-            sourceSize: Qt.size(Math.round(width * 0.5), Math.round(height * 0.5))
-            visible: false
-            antialiasing: true
-            smooth: true
-            mipmap: false
-        }
-
-        MultiEffect {
-            id: backgroundAlbumCover
-            source: backgroundAlbumCoverSource
-            anchors.fill: backgroundContainer
+            imageSource: root.coverImageIsDefault ? "" : root.coverImage
             visible: !root.coverImageIsDefault && root.coverImage !== "" && root.backgroundVisible
-            
-            // 模糊效果
-            blurEnabled: true
-            blur: 1.0
-            blurMax: 32
-            blurMultiplier: 2.0
-            // 参考 EBlurCard：避免边缘溢出
-            autoPaddingEnabled: false
-            
-            // 圆角遮罩
-            maskEnabled: true
-            maskSource: backgroundMask
-            maskThresholdMin: 0.5
-            maskSpreadAtMin: 1.0
+            radius: 64
+            cornerRadius: root.radius
         }
 
         // 参考 EBlurCard：叠加半透明主题色，避免过亮/过透明
@@ -311,125 +248,6 @@ Rectangle {
             opacity: 1.0
         }
 
-        // 从专辑封面取色（柔和浅色）
-        Canvas {
-            id: coverColorSampler
-            width: 32; height: 32
-            visible: false
-            contextType: "2d"
-
-            onPaint: {
-                var ctx = getContext("2d")
-                ctx.clearRect(0, 0, width, height)
-                if (root.coverImage !== "" && coverSource.status === Image.Ready) {
-                    // 将封面绘制到 Canvas
-                    ctx.drawImage(coverSource, 0, 0, width, height)
-                    var data = ctx.getImageData(0, 0, width, height).data
-
-                    // 构建色相直方图，选取高饱和度中等亮度的主色
-                    var bins = 36 // 10° 为一档
-                    var counts = new Array(bins)
-                    var sumR = new Array(bins)
-                    var sumG = new Array(bins)
-                    var sumB = new Array(bins)
-                    for (var bIndex = 0; bIndex < bins; bIndex++) {
-                        counts[bIndex] = 0; sumR[bIndex] = 0; sumG[bIndex] = 0; sumB[bIndex] = 0
-                    }
-
-                    for (var i = 0; i < data.length; i += 4) {
-                        var a = data[i + 3]
-                        if (a === 0) continue
-                        var r = data[i], g = data[i + 1], b = data[i + 2]
-                        var hsv = rgbToHsv(r, g, b)
-                        // 放宽筛选条件，让更多颜色进入候选，最后再统一调整亮度
-                        if (hsv.s > 0.15 && hsv.v > 0.15 && hsv.v < 0.95) {
-                            var bin = Math.floor((hsv.h / 360.0) * bins)
-                            if (bin < 0) bin = 0
-                            if (bin >= bins) bin = bins - 1
-                            counts[bin]++
-                            sumR[bin] += r
-                            sumG[bin] += g
-                            sumB[bin] += b
-                        }
-                    }
-
-                    var bestBin = -1
-                    var bestCount = 0
-                    for (var j = 0; j < bins; j++) {
-                        if (counts[j] > bestCount) { bestCount = counts[j]; bestBin = j }
-                    }
-
-                    var outR, outG, outB
-                    if (bestBin >= 0 && bestCount > 0) {
-                        outR = sumR[bestBin] / bestCount
-                        outG = sumG[bestBin] / bestCount
-                        outB = sumB[bestBin] / bestCount
-                    } else {
-                        // 回退：取整体平均色
-                        var totalR = 0, totalG = 0, totalB = 0, totalN = 0
-                        for (var k = 0; k < data.length; k += 4) {
-                            var aa = data[k + 3]
-                            if (aa > 0) {
-                                totalR += data[k]
-                                totalG += data[k + 1]
-                                totalB += data[k + 2]
-                                totalN++
-                            }
-                        }
-                        if (totalN > 0) {
-                            outR = totalR / totalN
-                            outG = totalG / totalN
-                            outB = totalB / totalN
-                        } else {
-                            // 都失败时退回主题色
-                            outR = theme.focusColor.r * 255
-                            outG = theme.focusColor.g * 255
-                            outB = theme.focusColor.b * 255
-                        }
-                    }
-
-                    // === 优化：基于 HSL 调整亮度，避免过暗或过亮 ===
-                    var hsl = rgbToHsl(outR, outG, outB)
-                    
-                    // 目标亮度范围：0.35 - 0.75
-                    var targetL = Math.max(0.35, Math.min(0.75, hsl.l))
-                    
-                    // 如果原色有一定饱和度但被调亮了，可能变灰，适当补一点饱和度
-                    if (hsl.s > 0.1) {
-                         // 保持至少 0.3 的饱和度，防止颜色太灰
-                         hsl.s = Math.max(hsl.s, 0.3)
-                    }
-                    
-                    hsl.l = targetL
-                    var finalRgb = hslToRgb(hsl.h, hsl.s, hsl.l)
-
-                    // 设置波纹颜色（半透明）与主题显色（不透明）
-                    var accent = Qt.rgba(finalRgb.r / 255.0, finalRgb.g / 255.0, finalRgb.b / 255.0, 1.0)
-                    root.coverProminentColor = accent
-                }
-            }
-        }
-
-        
-
-        // 圆角遮罩
-        Item {
-            id: backgroundMask
-            anchors.fill: backgroundAlbumCoverSource
-            layer.enabled: true
-            layer.smooth: true
-            layer.samples: 4
-            visible: false
-
-            Rectangle {
-                anchors.fill: parent
-                radius: root.radius
-                color: "black"
-                antialiasing: true
-                smooth: true
-            }
-        }
-        
         // 横向渐变遮罩（左透明到右纯色）
         Rectangle {
             id: gradientOverlay
@@ -439,9 +257,6 @@ Rectangle {
             visible: root.backgroundVisible
             antialiasing: true
             smooth: true
-            layer.enabled: true
-            layer.smooth: true
-            layer.samples: 4
 
             gradient: Gradient {
                 orientation: Gradient.Horizontal
@@ -450,6 +265,20 @@ Rectangle {
             }
         }
 
+        // 实时频谱：沿卡片底部铺开，避开两侧圆角
+        SpectrumItem {
+            anchors.left: parent.left
+            anchors.right: parent.right
+            anchors.bottom: parent.bottom
+            anchors.leftMargin: root.radius
+            anchors.rightMargin: root.radius
+            height: parent.height * 0.45
+            visible: root.spectrumEnabled && root.backgroundVisible
+            engine: playbackEngine
+            bandCount: 48
+            color: Qt.rgba(theme.focusColor.r, theme.focusColor.g, theme.focusColor.b, 0.25)
+        }
+
         // 点击整卡背景打开动画窗口（以整个组件为起点）
         MouseArea {
             id: cardClickArea
@@ -500,8 +329,8 @@ Rectangle {
                 source: root.coverImageIsDefault ? "" : root.coverImage
                 anchors.fill: parent
                 fillMode: Image.PreserveAspectCrop
-                cache: false
-                asynchronous: false
+                cache: true
+                asynchronous: true
                 sourceSize: Qt.size(Math.round(width * 0.6), Math.round(height * 0.6))
                 visible: false
                 antialiasing: true
@@ -642,16 +471,31 @@ Rectangle {
                 Rectangle {
                     id: progressTrack
                     Layout.fillWidth: true
-                    height: 6
-                    radius: height / 2
-                    color: Qt.rgba(theme.textColor.r, theme.textColor.g, theme.textColor.b, 0.2)
+                    // 波形就绪后进度条换成波形显示，未就绪时保持细条
+                    readonly property bool showWaveform: root.waveformEnabled && waveform.ready
+                    Layout.preferredHeight: showWaveform ? 24 : 6
+                    height: Layout.preferredHeight
+                    radius: showWaveform ? 0 : height / 2
+                    color: showWaveform ? "transparent" : Qt.rgba(theme.textColor.r, theme.textColor.g, theme.textColor.b, 0.2)
                     antialiasing: true
                     smooth: true
                     property bool dragging: false
 
+                // 波形：后台解码生成峰值，按 root.progress 区分已播放部分
+                WaveformItem {
+                    id: waveform
+                    anchors.fill: parent
+                    visible: progressTrack.showWaveform
+                    source: root.waveformEnabled ? root.source : ""
+                    progress: root.progress
+                    color: Qt.rgba(theme.textColor.r, theme.textColor.g, theme.textColor.b, 0.25)
+                    playedColor: theme.focusColor
+                }
+
                 // 填充条：直接绑定到 root.progress，避免中间变量和定时器
                 Rectangle {
                     id: progressFillColor
+                    visible: !progressTrack.showWaveform
                     width: progressTrack.width * root.progress
                     height: progressTrack.height
                     anchors.verticalCenter: progressTrack.verticalCenter
@@ -692,25 +536,26 @@ Rectangle {
                     hoverEnabled: true
                     cursorShape: Qt.PointingHandCursor
 
-                    function setProgressAt(px) {
+                    // 拖动中只更新显示；松开时才跳转一次，跳转由 onSeekPositionChanged 执行
+                    function setProgressAt(px, commit) {
                         var newProgress = Math.max(0, Math.min(1, px / progressTrack.width))
-                        root.progress = newProgress // 直接设置，触发 MediaPlayer 更新
-                        mediaPlayer.position = newProgress * mediaPlayer.duration
-                        root.seekPositionChanged(newProgress)
+                        root.progress = newProgress
+                        if (commit) root.seekPositionChanged(newProgress)
                     }
 
                     onPressed: function(mouse) {
                         progressTrack.dragging = true
-                        setProgressAt(mouse.x)
+                        setProgressAt(mouse.x, false)
                     }
                     onPositionChanged: function(mouse) {
-                        if (pressed) setProgressAt(mouse.x)
+                        if (pressed) setProgressAt(mouse.x, false)
                     }
                     onReleased: function(mouse) {
-                        setProgressAt(mouse.x)
+                        setProgressAt(mouse.x, true)
                         progressTrack.dragging = false
                         progressFillColor.opacity = 0.7
                     }
+                    onCanceled: progressTrack.dragging = false
                 }
             }
 
@@ -851,11 +696,9 @@ Rectangle {
                                 
                                 if (root.isPlaying) {
                                     console.log("暂停播放")
-                                    mediaPlayer.pause()
                                     root.pauseClicked()
                                 } else {
                                     console.log("开始播放")
-                                    mediaPlayer.play()
                                     root.playClicked()
                                 }
                             }
@@ -994,76 +837,10 @@ Rectangle {
         return mins + ":" + (secs < 10 ? "0" : "") + secs
     }
 
-    // 辅助函数：RGB -> HSV（h:0-360, s/v:0-1）
-    function rgbToHsv(r, g, b) {
-        r /= 255; g /= 255; b /= 255
-        var max = Math.max(r, g, b), min = Math.min(r, g, b)
-        var h, s, v = max
-        var d = max - min
-        s = max === 0 ? 0 : d / max
-        if (max === min) {
-            h = 0
-        } else {
-            switch (max) {
-            case r: h = (g - b) / d + (g < b ? 6 : 0); break
-            case g: h = (b - r) / d + 2; break
-            case b: h = (r - g) / d + 4; break
-            }
-            h *= 60
-        }
-        return { h: h, s: s, v: v }
-    }
-
-    // 辅助函数：RGB -> HSL
-    function rgbToHsl(r, g, b) {
-        r /= 255; g /= 255; b /= 255
-        var max = Math.max(r, g, b), min = Math.min(r, g, b)
-        var h, s, l = (max + min) / 2
-
-        if (max === min) {
-            h = s = 0 // achromatic
-        } else {
-            var d = max - min
-            s = l > 0.5 ? d / (2 - max - min) : d / (max + min)
-            switch (max) {
-                case r: h = (g - b) / d + (g < b ? 6 : 0); break
-                case g: h = (b - r) / d + 2; break
-                case b: h = (r - g) / d + 4; break
-            }
-            h /= 6
-        }
-        return { h: h, s: s, l: l }
-    }
-
-    // 辅助函数：HSL -> RGB
-    function hslToRgb(h, s, l) {
-        var r, g, b
-
-        if (s === 0) {
-            r = g = b = l // achromatic
-        } else {
-            var hue2rgb = function(p, q, t) {
-                if (t < 0) t += 1
-                if (t > 1) t -= 1
-                if (t < 1/6) return p + (q - p) * 6 * t
-                if (t < 1/2) return q
-                if (t < 2/3) return p + (q - p) * (2/3 - t) * 6
-                return p
-            }
-
-            var q = l < 0.5 ? l * (1 + s) : l + s - l * s
-            var p = 2 * l - q
-            r = hue2rgb(p, q, h + 1/3)
-            g = hue2rgb(p, q, h)
-            b = hue2rgb(p, q, h - 1/3)
-        }
-
-        return { r: Math.round(r * 255), g: Math.round(g * 255), b: Math.round(b * 255) }
-    }
-    
     // 自动播放列表管理
     property int currentIndex: 0
-    ListModel { id: playlistModel }
+    // C++ 播放列表模型，EPlaylist 与 MusicWindow 经 playlistModelRef 共用
+    PlaylistModel { id: playlistModel; library: musicLibrary }
 
     MusicLibrary { 
         id: musicLibrary 
@@ -1074,9 +851,31 @@ Rectangle {
             updatePlaylistFromFiles(newFiles)
         }
         
+        // 异步扫描分批到达：首批到达即可设置音源，无需等待整棵目录树遍历完成
+        onScanBatch: function(files) {
+            var wasEmpty = playlistModel.count === 0
+            playlistModel.appendSources(files)
+            if (wasEmpty && playlistModel.count > 0 && !root.isPlaying) {
+                currentIndex = 0
+                root.source = playlistModel.sourceAt(0)
+            }
+        }
+
+        onScanFinished: function(count, elapsedMs) {
+            if (count === 0) {
+                console.warn("未找到音乐文件（项目根目录和Windows音乐文件夹）")
+            }
+            // 扫描完成后再启动文件监控，保证增量对比基于完整列表
+            if (!musicLibrary.isWatching()) {
+                musicLibrary.startWatching()
+                console.log("已启动音乐文件监控，监控状态:", musicLibrary.isWatching())
+            }
+        }
+
         onFileAdded: function(filePath) {
             console.log("新增音乐文件:", filePath)
-            // 可以在这里添加单个文件到播放列表
+            // 增量追加到播放列表末尾，不影响当前播放位置
+            playlistModel.appendSources([filePath])
         }
         
         onFileRemoved: function(filePath) {
@@ -1084,7 +883,7 @@ Rectangle {
             // 检查当前播放的文件是否被删除
             if (root.source === filePath) {
                 console.log("当前播放的文件被删除，停止播放")
-                mediaPlayer.stop()
+                playbackEngine.stop()
                 root.source = ""
                 root.songTitle = "未知歌曲"
                 root.artistName = "未知艺术家"
@@ -1097,39 +896,31 @@ Rectangle {
             }
             
             // 从播放列表中移除该文件
-            for (var i = 0; i < playlistModel.count; i++) {
-                if (playlistModel.get(i).source === filePath) {
-                    console.log("从播放列表移除文件，索引:", i)
-                    playlistModel.remove(i)
-                    
-                    // 调整当前索引
-                    if (i <= currentIndex && currentIndex > 0) {
-                        currentIndex--
-                    }
-                    break
+            var i = playlistModel.indexOf(filePath)
+            if (i >= 0) {
+                console.log("从播放列表移除文件，索引:", i)
+                playlistModel.remove(i)
+                
+                // 调整当前索引
+                if (i <= currentIndex && currentIndex > 0) {
+                    currentIndex--
                 }
             }
         }
     }
 
     function loadProjectPlaylist() {
-        // 使用新的API，优先读取项目音乐，如果没有则读取Windows音乐文件夹
-        const files = musicLibrary.scanAllAvailableMusic(true)
-        updatePlaylistFromFiles(files)
-        
-        // 启动文件监控
-        musicLibrary.startWatching()
-        console.log("已启动音乐文件监控，监控状态:", musicLibrary.isWatching())
+        // 异步并行扫描项目音乐与Windows音乐文件夹，结果经 onScanBatch 分批追加
+        playlistModel.clear()
+        musicLibrary.scanAllAvailableMusicAsync(true)
     }
     
     function updatePlaylistFromFiles(files) {
-        playlistModel.clear()
-        for (var i = 0; i < files.length; i++) {
-            playlistModel.append({ source: files[i] })
-        }
+        // 整表替换：一次模型重置
+        playlistModel.setSources(files)
         if (playlistModel.count > 0) {
             currentIndex = 0
-            root.source = playlistModel.get(0).source
+            root.source = playlistModel.sourceAt(0)
             console.log("已加载播放列表，共", playlistModel.count, "首：", root.source)
             console.log("缓存文件数量:", musicLibrary.getCachedFileCount())
         } else {
@@ -1140,7 +931,7 @@ Rectangle {
     function playAt(index) {
         if (index >= 0 && index < playlistModel.count) {
             currentIndex = index
-            var newSource = playlistModel.get(index).source
+            var newSource = playlistModel.sourceAt(index)
             
             // 检查文件是否存在
             if (musicLibrary.isValidMusicFile && !musicLibrary.isValidMusicFile(newSource)) {
@@ -1156,15 +947,13 @@ Rectangle {
                 return
             }
             
-            // 切换前停止播放
-            mediaPlayer.stop()
-
-            // 设置新音源并开始播放
+            // 同一首从头重播；否则只替换解码源，输出设备保持打开
             if (root.source === newSource) {
-                root.source = ""
+                playbackEngine.seek(0)
+            } else {
+                root.source = newSource
             }
-            root.source = newSource
-            mediaPlayer.play()
+            playbackEngine.play()
         }
     }
 
@@ -1184,19 +973,38 @@ Rectangle {
 
     function playRandom() {
         if (playlistModel.count === 0) return
+        // 使用已预解码的随机选择，手动切到下一首时也能立即出声
+        var next = shuffleNext
+        if (next < 0 || next >= playlistModel.count || (next === currentIndex && playlistModel.count > 1)) {
+            pickShuffleNext()
+            next = shuffleNext
+        }
+        playAt(next)
+    }
+
+    // 随机模式的下一首在当前曲开始时即选定，供引擎预解码
+    property int shuffleNext: -1
+    function pickShuffleNext() {
         var next = currentIndex
         if (playlistModel.count > 1) {
             do {
                 next = Math.floor(Math.random() * playlistModel.count)
             } while (next === currentIndex)
         }
-        playAt(next)
+        shuffleNext = next
     }
 
+    // 预备的下一首：单曲循环为当前曲，随机为预选曲目，否则为列表下一首
+    readonly property string nextSource: {
+        if (playlistModel.count === 0 || root.source === "") return ""
+        if (root.playMode === 1) return root.source
+        var i = root.playMode === 2 ? shuffleNext : (currentIndex + 1) % playlistModel.count
+        return i >= 0 && i < playlistModel.count ? playlistModel.sourceAt(i) : ""
+    }
+    onCurrentIndexChanged: pickShuffleNext()
+
     Component.onCompleted: {
         loadProjectPlaylist()
-        // 初始化/更新取色
-        coverColorSampler.requestPaint()
     }
 
     
@@ -1204,27 +1012,6 @@ Rectangle {
     onNextClicked: playNext()
     onPreviousClicked: playPrev()
 
-    // 当封面变更时，重新取色
-    onCoverImageChanged: colorSampleTimer.restart()
-
-    // 延迟触发取色，保证资源已加载
-    Timer {
-        id: colorSampleTimer
-        interval: 200
-        repeat: false
-        onTriggered: coverColorSampler.requestPaint()
-    }
-
-    // 当封面图加载完成时，触发重绘取色
-    Connections {
-        target: coverSource
-        function onStatusChanged() {
-            if (coverSource.status === Image.Ready) {
-                coverColorSampler.requestPaint()
-            }
-        }
-    }
-
     // 播放时应用封面主色到主题；暂停/停止时回到默认强调色
     onIsPlayingChanged: function() {
         if (root.isPlaying) {
@@ -3,6 +3,7 @@ import QtQuick
 import QtQuick.Layouts
 import QtQuick.Controls
 import QtQuick.Effects
+import EvolveUI.Core 1.0
 
 Rectangle {
     id: root
@@ -84,14 +85,8 @@ Rectangle {
     property int topPadding: 90
 
     // === 计算属性 ===
-    property real totalValue: {
-        var total = 0;
-        var data = root.effectiveData;
-        for (var i = 0; i < data.length; i++) {
-            total += data[i].value;
-        }
-        return total > 0 ? total : 1;
-    }
+    // 总和由 ChartItem 在解析数据时一并求出（无数据时为 1）
+    readonly property real totalValue: chart.totalValue
 
     // === 背景与阴影 ===
     Rectangle {
@@ -159,7 +154,7 @@ Rectangle {
                     value: targetOffset
                 }
 
-                onCurrentOffsetChanged: chartCanvas.requestPaint()
+                onCurrentOffsetChanged: chart.setSliceOffset(index, currentOffset)
             }
         }
     }
@@ -172,107 +167,32 @@ Rectangle {
         anchors.margins: root.chartPadding
         anchors.bottomMargin: legend.visible ? 100 : root.chartPadding
 
-        Canvas {
-            id: chartCanvas
+        // 场景图原生绘制：扇区三角化为单个几何节点，外扩动画不再重跑 JS 绘制
+        ChartItem {
+            id: chart
             anchors.fill: parent
-            
-            property var sliceRects: [] // 存储每个扇区的信息用于交互
-
-            onPaint: {
-                var ctx = getContext("2d");
-                ctx.clearRect(0, 0, width, height);
-                
-                var data = root.effectiveData;
-                if (data.length === 0) return;
-
-                var centerX = width / 2;
-                var centerY = height / 2;
-                // 半径取宽高中较小值的一半，留出一些边距
-                var maxRadius = Math.min(width, height) / 2 - 20;
-                
-                var currentAngle = -Math.PI / 2; // 从12点钟方向开始
-                var total = root.totalValue;
-                
-                sliceRects = [];
-
-                for (var i = 0; i < data.length; i++) {
-                    var item = data[i];
-                    var sliceAngle = (item.value / total) * (Math.PI * 2);
-                    var endAngle = currentAngle + sliceAngle;
-                    
-                    // 确定半径 (hover效果)
-                    var r = maxRadius;
-                    
-                    // 获取动画偏移量
-                    var animator = sliceAnimators.itemAt(i);
-                    if (animator) {
-                        r += animator.currentOffset;
-                    }
-                    
-                    // 绘制扇区
-                    ctx.beginPath();
-                    ctx.moveTo(centerX, centerY);
-                    // 如果是环形图，需要处理路径
-                    if (root.innerRadius > 0) {
-                        // 环形图稍微复杂，简单实现：画扇形，然后最后再盖住中间
-                        // 或者使用 arc + lineTo
-                        ctx.arc(centerX, centerY, r, currentAngle, endAngle, false);
-                        ctx.arc(centerX, centerY, root.innerRadius, endAngle, currentAngle, true); // 反向画内圆
-                    } else {
-                        ctx.arc(centerX, centerY, r, currentAngle, endAngle, false);
-                        ctx.lineTo(centerX, centerY);
-                    }
-                    ctx.closePath();
-                    
-                    ctx.fillStyle = item.color;
-                    ctx.fill();
-                    ctx.strokeStyle = root.backgroundColor; // 扇区间隔线
-                    ctx.lineWidth = 2;
-                    ctx.stroke();
-
-                    // 记录角度信息用于交互
-                    sliceRects.push({
-                        startAngle: currentAngle,
-                        endAngle: endAngle,
-                        innerRadius: root.innerRadius,
-                        outerRadius: r,
-                        index: i,
-                        data: item
-                    });
-
-                    // 绘制标签 (如果空间足够)
-                    if (root.showLabels && sliceAngle > 0.1) {
-                        var midAngle = currentAngle + sliceAngle / 2;
-                        var labelRadius = root.innerRadius > 0 ? (r + root.innerRadius) / 2 : r * 0.7;
-                        var lx = centerX + Math.cos(midAngle) * labelRadius;
-                        var ly = centerY + Math.sin(midAngle) * labelRadius;
-                        
-                        ctx.fillStyle = "white"; // 假设深色背景或深色扇区
-                        // 简单的亮度判断来决定文字颜色? 暂时统一白色或黑色
-                        // 这里为了简单，如果颜色太亮用黑色，太暗用白色，或者统一白色带阴影
-                        ctx.font = "bold 12px sans-serif";
-                        ctx.textAlign = "center";
-                        ctx.textBaseline = "middle";
-                        
-                        // 显示百分比
-                        var percent = Math.round((item.value / total) * 100) + "%";
-                        ctx.fillText(percent, lx, ly);
-                    }
+            type: ChartItem.Pie
+            series: [{ name: "", data: root.effectiveData }]
+            innerRadius: root.innerRadius
+            outerMargin: 20 // 半径取宽高中较小值的一半，留出一些边距
+            separatorColor: root.backgroundColor // 扇区间隔线
+        }
 
-                    currentAngle = endAngle;
-                }
-                
-                // 如果是环形图，中间是空的，不用额外处理，因为arc路径已经处理了
-            }
+        // === 扇区标签 (如果空间足够) ===
+        Repeater {
+            model: root.showLabels ? root.effectiveData.length : 0
 
-            // 当数据改变时重新绘制
-            Connections {
-                target: root
-                function onDataPointsChanged() { chartCanvas.requestPaint(); }
-                function onDataSeriesChanged() { chartCanvas.requestPaint(); }
-                function onEffectiveDataChanged() { chartCanvas.requestPaint(); }
-                function onBackgroundColorChanged() { chartCanvas.requestPaint(); }
-                function onHoveredIndexChanged() { chartCanvas.requestPaint(); }
+            Text {
+                readonly property var labelPos: chart.sliceLabelPositions[index]
+                readonly property real fraction: root.effectiveData[index].value / chart.totalValue
+                visible: labelPos !== undefined && fraction * Math.PI * 2 > 0.1
+                x: labelPos ? chart.x + labelPos.x - width / 2 : 0
+                y: labelPos ? chart.y + labelPos.y - height / 2 : 0
+                // 显示百分比
+                text: Math.round(fraction * 100) + "%"
+                color: "white"
+                font.pixelSize: 12
+                font.bold: true
             }
         }
 
@@ -283,61 +203,11 @@ Rectangle {
             hoverEnabled: true
             
             onPositionChanged: function(mouse) {
-                var slices = chartCanvas.sliceRects;
-                var centerX = chartCanvas.width / 2;
-                var centerY = chartCanvas.height / 2;
-                var dx = mouse.x - centerX;
-                var dy = mouse.y - centerY;
-                var dist = Math.sqrt(dx*dx + dy*dy);
-                
-                // 计算角度 (-PI ~ PI) -> (0 ~ 2PI)
-                var angle = Math.atan2(dy, dx);
-                // 调整角度以匹配绘制逻辑 (-PI/2 start)
-                // atan2 返回 y,x。 0 是 3点钟。
-                // 绘制是从 -PI/2 (12点) 开始顺时针。
-                
-                // 统一转为 0~2PI，从12点顺时针
-                // atan2: 0(3点), PI/2(6点), PI/-PI(9点), -PI/2(12点)
-                // 目标: 0(12点), PI/2(3点), PI(6点), 3PI/2(9点)
-                
-                var normalizedAngle = angle + Math.PI/2; // -PI/2 -> 0
-                if (normalizedAngle < 0) normalizedAngle += Math.PI * 2;
-                
-                var found = false;
-                for (var i = 0; i < slices.length; i++) {
-                    var s = slices[i];
-                    // 检查半径
-                    if (dist >= s.innerRadius && dist <= s.outerRadius) {
-                        // 检查角度
-                        // s.startAngle 和 s.endAngle 是基于 -PI/2 为起点的弧度值(可能是负数或大于2PI累加)
-                        // 我们需要将鼠标角度也转换到同样的参考系，或者将slice角度规范化
-                        
-                        // 简单做法：把slice的 start/end 也转为 0-2PI 相对 12点
-                        var start = s.startAngle + Math.PI/2;
-                        var end = s.endAngle + Math.PI/2;
-                        
-                        // 处理跨越 2PI 的情况 (应该不会，因为我们是累加的)
-                        // 但为了保险，我们直接用相对值比较
-                        // 实际上，我们在绘制时是从 -PI/2 开始累加正值的。
-                        // 所以 startAngle 范围是 [-PI/2, 3PI/2] (一圈)
-                        
-                        // 让鼠标角度适应这个范围
-                        var mouseA = angle;
-                        if (mouseA < -Math.PI/2) mouseA += Math.PI * 2;
-                        
-                        if (mouseA >= s.startAngle && mouseA < s.endAngle) {
-                            if (root.hoveredIndex !== s.index) {
-                                root.hoveredIndex = s.index;
-                                root.pointHovered(s.index, s.data);
-                            }
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                
-                if (!found) {
-                    root.hoveredIndex = -1;
+                // 按累计角度二分查找扇区，半径范围包含悬停外扩量
+                var index = chart.sliceAt(mouse.x - chart.x, mouse.y - chart.y);
+                if (index !== root.hoveredIndex) {
+                    root.hoveredIndex = index;
+                    if (index >= 0) root.pointHovered(index, root.effectiveData[index]);
                 }
             }
             
@@ -2,6 +2,7 @@ import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
 import MusicLibrary 1.0
+import EvolveUI.Core 1.0
 import QtQuick.Dialogs
 
 Item {
@@ -15,39 +16,52 @@ Item {
     property int currentIndex: playerRef && typeof playerRef.currentIndex === "number" ? playerRef.currentIndex : -1
     property var metaCache: ({})
     MusicLibrary { id: musicLib }
-    ListModel { id: fileModel }
-    property var prefetchQueue: []
+    // 传入 EMusicPlayer 的 PlaylistModel 时直接共用同一实例；独立使用时用自有模型
+    PlaylistModel { id: ownModel; library: musicLib }
+    readonly property bool sharedModel: !!model && typeof model.appendSources === "function"
+    readonly property var playlist: sharedModel ? model : ownModel
+    readonly property var activeLibrary: (playlist && playlist.library) ? playlist.library : musicLib
+    // 搜索：C++ 倒排索引随音乐库的扫描与增删自动更新，结果单独放入 searchModel
+    MusicSearch { id: searchEngine; library: root.activeLibrary }
+    ListModel { id: searchModel }
+    property string searchQuery: ""
+    readonly property bool searching: searchQuery.trim().length > 0
     property bool singleFolderMode: false
     property bool initialPrefetchDone: false
     property var removedSources: []
-    Timer {
-        id: sequentialPrefetchTimer
-        interval: 280
-        repeat: true
-        running: false
-        onTriggered: {
-            if (prefetchQueue.length === 0) { running = false; return }
-            var next = prefetchQueue.shift()
-            if (next) musicLib.prefetchMetadata([next])
-        }
-    }
+    // 后台预取：C++ 侧在线程池中读取，始终排在可见行之后
     function schedulePrefetch(srcs) {
         if (!srcs || srcs.length === 0) return
-        for (var i = 0; i < srcs.length; i++) prefetchQueue.push(srcs[i])
         initialPrefetchDone = true
-        if (!sequentialPrefetchTimer.running) sequentialPrefetchTimer.start()
+        activeLibrary.prefetchMetadata(srcs)
     }
+    // 视口变化时提交可见行与附近行（上下各一屏）；行距取自实际布局，滚出范围的请求由 C++ 侧取消
     function scheduleVisiblePrefetch() {
-        var rowH = 56
-        var start = Math.max(0, Math.floor(listView.contentY / rowH) - 2)
-        var vis = Math.ceil(listView.height / rowH) + 4
-        var end = Math.min(fileModel.count - 1, start + vis)
-        var batch = []
-        for (var i = start; i <= end; i++) {
-            var it = fileModel.get(i)
-            if (it && (!it.artist || it.artist.length === 0)) batch.push(it.source)
+        var count = listView.count
+        var first = 0
+        var last = -1
+        // 布局尚未完成时不猜测行高：contentHeight 就绪后会再次提交
+        if (count > 0 && listView.contentHeight > 0) {
+            var pitch = (listView.contentHeight + listView.spacing) / count
+            var top = listView.contentY - listView.originY
+            first = Math.max(0, Math.floor(top / pitch))
+            last = Math.min(count - 1, Math.floor((top + listView.height) / pitch))
+        }
+        if (!searching) {
+            // 模型只为尚无元数据的行发起请求
+            playlist.setViewport(first, last)
+            return
         }
-        schedulePrefetch(batch)
+        var span = last - first + 1
+        var visible = []
+        var nearby = []
+        for (var i = Math.max(0, first - span); i <= Math.min(count - 1, last + span); i++) {
+            var it = searchModel.get(i)
+            if (!it || (it.artist && it.artist.length > 0)) continue
+            if (i >= first && i <= last) visible.push(it.source)
+            else nearby.push(it.source)
+        }
+        activeLibrary.prefetchViewport(visible, nearby)
     }
     function toLocalPath(s) {
         if (!s) return ""
@@ -60,60 +74,70 @@ Item {
         return t
     }
     function appendUniqueSources(srcs) {
-        for (var i = 0; i < srcs.length; i++) {
-            var s = toLocalPath(srcs[i])
-            var exists = false
-            for (var j = 0; j < fileModel.count; j++) { if (fileModel.get(j).source === s) { exists = true; break } }
-            if (!exists) {
-                var m = musicLib.getMetadata(s)
-                var t = (m && m.title && m.title.length > 0) ? m.title : baseName(s)
-                var a = (m && m.artist) ? m.artist : ""
-                fileModel.append({ source: s, title: t, artist: a })
-            }
-        }
+        var list = []
+        for (var i = 0; i < srcs.length; i++) list.push(toLocalPath(srcs[i]))
+        // 模型内部按路径哈希去重，一次批量插入
+        playlist.appendSources(list)
     }
     function setFiles(files) {
-        fileModel.clear()
+        Trace.begin("playlist.setFiles")
+        var list = []
         for (var i = 0; i < files.length; i++) {
-            var s2 = files[i]
-            if (removedSources.indexOf(s2) >= 0) continue
-            var m2 = musicLib.getMetadata(s2)
-            var t2 = (m2 && m2.title && m2.title.length > 0) ? m2.title : baseName(s2)
-            var a2 = (m2 && m2.artist) ? m2.artist : ""
-            fileModel.append({ source: s2, title: t2, artist: a2 })
+            if (removedSources.indexOf(files[i]) < 0) list.push(files[i])
         }
-        schedulePrefetch(files)
+        playlist.setSources(list)
+        scheduleVisiblePrefetch()
+        Trace.end("playlist.setFiles")
     }
 
     function removeItem(idx) {
-        if (idx < 0 || idx >= fileModel.count) return
-        var it = fileModel.get(idx)
-        var src = it && it.source ? it.source : ""
+        if (idx < 0 || idx >= playlist.count) return
+        var src = playlist.sourceAt(idx)
         if (removedSources.indexOf(src) < 0) removedSources.push(src)
-        fileModel.remove(idx)
-        if (playerRef && playerRef.playlistModelRef && typeof playerRef.playlistModelRef.get === "function") {
-            var pm = playerRef.playlistModelRef
-            var found = -1
-            for (var i2 = 0; i2 < pm.count; i2++) { var pit = pm.get(i2); if (pit && pit.source === src) { found = i2; break } }
-            if (found >= 0 && typeof pm.remove === "function") {
-                pm.remove(found)
-                if (typeof playerRef.currentIndex === "number") {
-                    if (found === playerRef.currentIndex) {
-                        if (pm.count > 0 && typeof playerRef.playAt === "function") {
-                            var nextIdx = Math.min(found, pm.count - 1)
-                            playerRef.playAt(nextIdx)
-                        } else {
-                            playerRef.currentIndex = -1
-                            if (playerRef && typeof playerRef.stopPlayback === "function") playerRef.stopPlayback()
-                        }
-                    } else if (found < playerRef.currentIndex) {
-                        playerRef.currentIndex = playerRef.currentIndex - 1
-                    }
+        playlist.remove(idx)
+        // 共用模型时行号即播放器索引，只需修正当前播放位置
+        if (sharedModel && playerRef && typeof playerRef.currentIndex === "number") {
+            if (idx === playerRef.currentIndex) {
+                if (playlist.count > 0 && typeof playerRef.playAt === "function") {
+                    playerRef.playAt(Math.min(idx, playlist.count - 1))
+                } else {
+                    playerRef.currentIndex = -1
+                    if (typeof playerRef.stopPlayback === "function") playerRef.stopPlayback()
                 }
+            } else if (idx < playerRef.currentIndex) {
+                playerRef.currentIndex = playerRef.currentIndex - 1
             }
         }
     }
 
+    function runSearch() {
+        searchModel.clear()
+        if (!searching) return
+        Trace.begin("playlist.search")
+        var paths = searchEngine.search(searchQuery, 200)
+        for (var i = 0; i < paths.length; i++) {
+            var s = paths[i]
+            if (removedSources.indexOf(s) >= 0) continue
+            var m = activeLibrary.getMetadata(s)
+            searchModel.append({ source: s, title: (m && m.title && m.title.length > 0) ? m.title : baseName(s), artist: (m && m.artist) ? m.artist : "" })
+        }
+        Trace.end("playlist.search")
+    }
+    onSearchQueryChanged: runSearch()
+    Connections {
+        target: searchEngine
+        function onIndexChanged() { if (searching) runSearch() }
+    }
+
+    function removeSource(src) {
+        for (var i = 0; i < searchModel.count; i++) {
+            if (searchModel.get(i).source === src) { searchModel.remove(i); break }
+        }
+        var row = playlist.indexOf(src)
+        if (row >= 0) { removeItem(row); return }
+        if (removedSources.indexOf(src) < 0) removedSources.push(src)
+    }
+
     function baseName(p) {
         if (!p || typeof p !== "string") return "未知"
         var seg = p.split(/[\\/]/).pop()
@@ -133,17 +157,26 @@ Item {
             color: theme ? theme.textColor : "#ffffff"
         }
 
+        EInput {
+            id: searchInput
+            width: root.width
+            height: 36
+            fontSize: 14
+            placeholderText: "搜索歌曲 / 歌手 / 专辑 / 拼音首字母"
+            onTextChanged: root.searchQuery = text
+        }
+
         ListView {
             id: listView
             width: root.width
-            height: Math.max(0, root.height - titleText.height - spacing)
+            height: Math.max(0, root.height - titleText.height - searchInput.height - spacing * 2)
             spacing: 6
             boundsBehavior: Flickable.StopAtBounds
             reuseItems: true
             cacheBuffer: height * 1.5
             clip: false
-            model: fileModel
-            currentIndex: playerRef ? playerRef.currentIndex : currentIndex
+            model: searching ? searchModel : playlist
+            currentIndex: searching ? -1 : (playerRef ? playerRef.currentIndex : currentIndex)
             property int scalePulse: 0
             highlightFollowsCurrentItem: true
             highlightMoveDuration: 320
@@ -183,13 +216,20 @@ Item {
 
             Behavior on contentY { NumberAnimation { duration: 220; easing.type: Easing.OutCubic } }
             onContentYChanged: scheduleVisiblePrefetch()
+            onContentHeightChanged: scheduleVisiblePrefetch()
+            onHeightChanged: scheduleVisiblePrefetch()
 
             delegate: Item { id: rowItem
                 width: listView.width
                 height: 56
-                readonly property bool isActive: (playerRef && typeof playerRef.currentIndex === "number") ? (index === playerRef.currentIndex) : (index === currentIndex)
-                readonly property var itemObj: (index >= 0 && index < fileModel.count) ? fileModel.get(index) : ({})
-                readonly property string itemSource: itemObj && itemObj.source ? itemObj.source : ""
+                // PlaylistModel 与 searchModel 提供相同的角色
+                required property int index
+                required property string source
+                required property string title
+                required property string artist
+                readonly property bool isActive: searching ? (playerRef && playerRef.source === itemSource)
+                                                           : ((playerRef && typeof playerRef.currentIndex === "number") ? (index === playerRef.currentIndex) : (index === currentIndex))
+                readonly property string itemSource: source || ""
                 property bool hovered: false
                 opacity: 1.0
                 transform: Translate { id: slideTransform; x: 0 }
@@ -205,7 +245,7 @@ Item {
                         NumberAnimation { target: slideTransform; property: "x"; to: listView.width; duration: 220; easing.type: Easing.OutCubic }
                         NumberAnimation { target: rowItem; property: "opacity"; to: 0.0; duration: 200; easing.type: Easing.OutQuad }
                     }
-                    ScriptAction { script: { root.removeItem(index) } }
+                    ScriptAction { script: { root.removeSource(itemSource) } }
                 }
 
                 Rectangle {
@@ -236,7 +276,7 @@ Item {
                         property bool inView: (infoBlock.y + infoBlock.height) > listView.contentY && infoBlock.y < (listView.contentY + listView.height)
                         Text {
                             id: titleLabel
-                            text: (itemObj && itemObj.title && itemObj.title.length > 0) ? itemObj.title : baseName(itemSource)
+                            text: (rowItem.title && rowItem.title.length > 0) ? rowItem.title : baseName(itemSource)
                             font.pixelSize: 14
                             font.bold: isActive
                             color: theme ? theme.textColor : "#ffffff"
@@ -248,7 +288,7 @@ Item {
 
                         Text {
                             id: artistLabel
-                            text: (itemObj && itemObj.artist && itemObj.artist.length > 0) ? itemObj.artist : "未知艺术家"
+                            text: (rowItem.artist && rowItem.artist.length > 0) ? rowItem.artist : "未知艺术家"
                             font.pixelSize: 12
                             color: theme ? Qt.darker(theme.textColor, 1.2) : "#dddddd"
                             elide: Text.ElideRight
@@ -300,16 +340,9 @@ Item {
                     onExited: hovered = false
                     onClicked: {
                         if (typeof deleteArea !== 'undefined' && deleteArea.containsMouse) return
-                        var fp = itemSource
-                        var used = false
-                        if (playerRef && playerRef.playlistModelRef && typeof playerRef.playlistModelRef.get === "function" && typeof playerRef.playAt === "function") {
-                            var pm = playerRef.playlistModelRef
-                            var found = -1
-                            for (var i2 = 0; i2 < pm.count; i2++) { var it = pm.get(i2); if (it && it.source === fp) { found = i2; break } }
-                            if (found >= 0) { playerRef.playAt(found); used = true }
-                        }
-                        if (!used && playerRef && typeof playerRef.playSourcePath === "function") playerRef.playSourcePath(fp)
-                        currentIndex = index
+                        // 播放器按路径哈希定位所在行，不在列表中时直接播放该文件
+                        if (playerRef && typeof playerRef.playSourcePath === "function") playerRef.playSourcePath(itemSource)
+                        if (!searching) currentIndex = index
                     }
                 }
             }
@@ -318,52 +351,23 @@ Item {
         Item {
             width: root.width
             height: 80
-            visible: fileModel.count === 0
+            visible: listView.count === 0
             Rectangle {
                 anchors.centerIn: parent
                 width: Math.min(240, root.width - 40)
                 height: 36
                 radius: 10
                 color: theme ? Qt.rgba(theme.secondaryColor.r, theme.secondaryColor.g, theme.secondaryColor.b, 0.9) : "#2b2b2b"
-                Text { anchors.centerIn: parent; text: "未找到音乐文件"; font.pixelSize: 14; color: theme ? theme.textColor : "#ffffff" }
-            }
-        }
-        Connections {
-            target: musicLib
-            function onMetadataReady(src, meta) {
-                for (var i = 0; i < fileModel.count; i++) {
-                    var it = fileModel.get(i)
-                    if (it && it.source === src) {
-                        fileModel.set(i, {
-                            source: it.source,
-                            title: (meta && meta.title) ? meta.title : it.title,
-                            artist: (meta && meta.artist) ? meta.artist : it.artist
-                        })
-                        break
-                    }
-                }
+                Text { anchors.centerIn: parent; text: searching ? "没有匹配的歌曲" : "未找到音乐文件"; font.pixelSize: 14; color: theme ? theme.textColor : "#ffffff" }
             }
         }
     }
     Component.onCompleted: {
-        fileModel.clear()
-        var srcs = []
-        if (model && model.count && model.count > 0) {
-            for (var i = 0; i < model.count; i++) {
-                var s = model.get(i).source
-                fileModel.append({ source: s, title: baseName(s), artist: "" })
-                srcs.push(s)
-            }
-        } else {
-            var files2 = musicLib.scanAllAvailableMusic(true)
-            for (var k = 0; k < files2.length; k++) {
-                var ss = files2[k]
-                fileModel.append({ source: ss, title: baseName(ss), artist: "" })
-                srcs.push(ss)
-            }
-            musicLib.startWatching()
+        // 共用播放器模型时由播放器负责扫描，这里只补齐可见行的元数据
+        if (!sharedModel) {
+            // 异步扫描：结果经 onScanBatch 分批追加，完成后再启动监控
+            musicLib.scanAllAvailableMusicAsync(true)
         }
-        schedulePrefetch(srcs)
         scheduleVisiblePrefetch()
     }
 
@@ -375,9 +379,9 @@ Item {
         onAccepted: {
             var arr = []
             for (var i = 0; i < importFilesDialog.selectedFiles.length; i++) arr.push(toLocalPath(importFilesDialog.selectedFiles[i]))
-            appendUniqueSources(arr)
+            if (sharedModel && playerRef && typeof playerRef.addSources === 'function') playerRef.addSources(arr)
+            else appendUniqueSources(arr)
             schedulePrefetch(arr)
-            if (playerRef && typeof playerRef.addSources === 'function') playerRef.addSources(arr)
         }
     }
     FolderDialog {
@@ -388,12 +392,10 @@ Item {
             var list = musicLib.scanOnlyDirectory(url)
             console.log("选择文件夹 URL:", url, "文件数:", list.length)
             removedSources = []
-            fileModel.clear()
-            appendUniqueSources(list)
-            musicLib.prefetchMetadata(list)
-            scheduleVisiblePrefetch()
-            if (playerRef && typeof playerRef.resetSources === 'function') playerRef.resetSources(list)
+            if (sharedModel && playerRef && typeof playerRef.resetSources === 'function') playerRef.resetSources(list)
+            else playlist.setSources(list)
             singleFolderMode = true
+            scheduleVisiblePrefetch()
         }
     }
 
@@ -507,7 +509,28 @@ Item {
     Connections {
         target: musicLib
         function onMusicFilesChanged(newFiles) {
-            if (!singleFolderMode) setFiles(newFiles)
+            if (!singleFolderMode && !sharedModel) setFiles(newFiles)
+        }
+        function onScanBatch(files) {
+            var list = []
+            for (var i = 0; i < files.length; i++) {
+                if (removedSources.indexOf(files[i]) < 0) list.push(files[i])
+            }
+            playlist.appendSources(list)
+            schedulePrefetch(list)
+        }
+        // 文件监控的增量变化：逐条追加/移除，不重建整个列表
+        function onFileAdded(filePath) {
+            if (removedSources.indexOf(filePath) >= 0) return
+            playlist.appendSources([filePath])
+            schedulePrefetch([filePath])
+        }
+        function onFileRemoved(filePath) {
+            removeItem(playlist.indexOf(filePath))
+        }
+        function onScanFinished(count, elapsedMs) {
+            if (!musicLib.isWatching()) musicLib.startWatching()
+            scheduleVisiblePrefetch()
         }
     }
 }
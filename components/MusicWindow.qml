@@ -4,6 +4,7 @@ import QtQuick.Controls
 import QtQuick.Effects
 //  C++ 侧读取歌词
 import MusicLibrary 1.0
+import EvolveUI.Core 1.0
 
     Item {
         id: root
@@ -21,11 +22,35 @@ import MusicLibrary 1.0
     property string title: "未知歌曲"
     property string artist: "未知艺术家"
     property var sourceItem: null
-    // 歌词数据：解析自 LRC，[{ t:毫秒, text:字符串 }]
-        property var lyricsEntries: []
+    // 与播放器、播放列表共用的 PlaylistModel，用于显示下一首
+    readonly property var playlistModel: sourceItem && sourceItem.playlistModelRef ? sourceItem.playlistModelRef : null
+    property string upNextText: ""
+    function updateUpNext() {
+        if (!playlistModel || !sourceItem || playlistModel.count < 2 || sourceItem.playMode === 2) {
+            upNextText = ""
+            return
+        }
+        var next = playlistModel.get((sourceItem.currentIndex + 1) % playlistModel.count)
+        upNextText = (next.artist && next.artist.length > 0) ? (next.title + " - " + next.artist) : next.title
+    }
+    onPlaylistModelChanged: updateUpNext()
+    Connections {
+        target: playlistModel
+        ignoreUnknownSignals: true
+        function onCountChanged() { updateUpNext() }
+        function onDataChanged() { updateUpNext() }
+        function onModelReset() { updateUpNext() }
+    }
+    Connections {
+        target: sourceItem
+        ignoreUnknownSignals: true
+        function onCurrentIndexChanged() { updateUpNext() }
+        function onPlayModeChanged() { updateUpNext() }
+    }
+    // 歌词数据：由 C++ LyricsDocument 解析 LRC（按路径 + mtime 缓存）
         property int currentLyricIndex: -1
-        property bool lyricsAvailable: false
-        property string lyricsFilePath: ""
+        readonly property bool lyricsAvailable: lyricsDoc.available
+        readonly property string lyricsFilePath: lyricsDoc.path
         property bool isLyricScrolling: false
     // 封面显示控制：
     property string displayCoverImage: ""
@@ -34,8 +59,6 @@ import MusicLibrary 1.0
     property int coverFadeDuration: 1920
     property string circleCoverImage: ""
     property int coverCircleTex: 340
-        property int coverTexW: 256
-        property int coverTexH: 144
 
     // 首次进入或外部赋值 sourceItem 时，初始化文案/歌词/封面
         onSourceItemChanged: {
@@ -45,9 +68,7 @@ import MusicLibrary 1.0
             displayCoverIsDefault = true
             displayCoverImage = ""
             pendingCoverUrl = ""
-            lyricsEntries = []
-            lyricsAvailable = false
-            lyricsFilePath = ""
+            lyricsDoc.source = ""
             currentLyricIndex = -1
             return
         }
@@ -74,7 +95,6 @@ import MusicLibrary 1.0
                 circleCoverImage = sourceItem.coverImage
             } else {
                 pendingCoverUrl = sourceItem.coverImage
-                nextCoverLoader.source = pendingCoverUrl
             }
         }
 
@@ -109,108 +129,44 @@ import MusicLibrary 1.0
         id: musicLib
     }
 
-    // 解析 LRC 文本为时间戳 + 行文本
-    function parseLrc(lrcText) {
-        var entries = []
-        var offsetMs = 0
-        var lines = lrcText.split(/\r?\n/)
-        for (var i = 0; i < lines.length; i++) {
-            var line = lines[i].trim()
-            if (line.length === 0) continue
-
-            // 处理 offset 标签
-            var offsetMatch = line.match(/^\[offset:([-+]?\d+)\]$/i)
-            if (offsetMatch) {
-                offsetMs = parseInt(offsetMatch[1]) || 0
-                continue
-            }
-
-            // 匹配多个时间戳的行，如 [00:12.34][00:15.00]歌词
-            var tsRegex = /\[(\d{1,2}):(\d{1,2})(?:[.:](\d{1,3}))?\]/g
-            var textPart = line.replace(tsRegex, "").trim()
-            if (textPart.length === 0) continue
-
-            var m
-            tsRegex.lastIndex = 0
-            while ((m = tsRegex.exec(line)) !== null) {
-                var mm = parseInt(m[1]) || 0
-                var ss = parseInt(m[2]) || 0
-                var cs = m[3] ? m[3] : "0"
-                // 归一化毫秒（支持两位/三位小数）
-                var ms = 0
-                if (cs.length === 3) ms = parseInt(cs)
-                else if (cs.length === 2) ms = parseInt(cs) * 10
-                else ms = parseInt(cs) * 100
-                var t = mm * 60000 + ss * 1000 + ms + offsetMs
-                if (t < 0) t = 0
-                entries.push({ t: t, text: textPart })
-            }
-        }
-        // 按时间排序并去重空白
-        entries.sort(function(a, b) { return a.t - b.t })
-        return entries
+    LyricsDocument {
+        id: lyricsDoc
+        library: musicLib
     }
 
-    // 根据音源路径推断并加载同名 .lrc 文件
+    // 根据音源路径加载同名 .lrc 文件（同一音源重复打开时只做一次 stat 校验缓存）
     function loadLyricsForSource(src) {
         if (!src || src.length === 0) {
-            lyricsEntries = []
-            lyricsAvailable = false
-            lyricsFilePath = ""
+            lyricsDoc.source = ""
             currentLyricIndex = -1
             return
         }
 
-        // 使用 C++ 侧读取歌词文本
-        var raw = musicLib.loadLyricsText(src)
-        var lrcFileUrl = musicLib.findLyricsFileForSource(src)
-        if (raw && raw.length > 0) {
-            var parsed = parseLrc(raw)
-            if (parsed && parsed.length > 0) {
-                lyricsEntries = parsed
-                lyricsAvailable = true
-                lyricsFilePath = lrcFileUrl
-                // 加载完成后，立即根据当前播放进度定位到对应歌词行，避免重新打开时回到顶部
-                if (sourceItem && typeof sourceItem.positionMs === "number") {
-                    updateLyricIndex(sourceItem.positionMs)
-                    // 在视图下一帧确保定位到当前索引
-                    Qt.callLater(function() {
-                        if (lyricList && currentLyricIndex >= 0) {
-                            lyricList.positionViewAtIndex(currentLyricIndex, ListView.Center)
-                        }
-                    })
+        if (lyricsDoc.source === src) lyricsDoc.reload()
+        else lyricsDoc.source = src
+        currentLyricIndex = -1
+        // 加载完成后，立即根据当前播放进度定位到对应歌词行，避免重新打开时回到顶部
+        if (lyricsAvailable && sourceItem && typeof sourceItem.positionMs === "number") {
+            updateLyricIndex(sourceItem.positionMs)
+            // 在视图下一帧确保定位到当前索引
+            Qt.callLater(function() {
+                if (lyricList && currentLyricIndex >= 0) {
+                    lyricList.positionViewAtIndex(currentLyricIndex, ListView.Center)
                 }
-                return
-            }
+            })
         }
-
-        // 未找到或解析失败：清空并显示占位
-        lyricsEntries = []
-        lyricsAvailable = false
-        lyricsFilePath = lrcFileUrl
-        currentLyricIndex = -1
     }
 
     // 移除 QML 端文件回退读取，统一走 C++ 端
 
     // 根据毫秒进度更新当前歌词行
     function updateLyricIndex(posMs) {
-        if (!lyricsAvailable || lyricsEntries.length === 0) {
+        if (!lyricsAvailable) {
             currentLyricIndex = -1
             return
         }
-        // 从当前索引向前后逼近，避免每次线性扫描
-        var idx = currentLyricIndex
-        if (idx < 0) idx = 0
-        // 向后推进
-        while (idx + 1 < lyricsEntries.length && lyricsEntries[idx + 1].t <= posMs) {
-            idx++
-        }
-        // 如播放进度回退，向前退
-        while (idx > 0 && lyricsEntries[idx].t > posMs) {
-            idx--
-        }
-        currentLyricIndex = idx
+        // 二分定位；首行开始前仍停留在第一行
+        currentLyricIndex = Math.max(0, lyricsDoc.indexForPosition(posMs))
     }
 
     // 格式化时间（秒 -> mm:ss）
@@ -240,50 +196,27 @@ import MusicLibrary 1.0
         radius: 20
     }
 
-    // 原始专辑封面图像源（隐藏，仅用于 MultiEffect 模糊）
-    Image {
-        id: fullscreenCoverSource
-        anchors.fill: parent
-        visible: false
-        source: displayCoverIsDefault ? "" : displayCoverImage
-        fillMode: Image.PreserveAspectCrop
-        cache: true
-        asynchronous: false
-        antialiasing: true
-        smooth: true
-        mipmap: false
-        sourceSize: Qt.size(coverTexW, coverTexH)
-    }
-    Image {
-        id: fullscreenCoverSourceNext
+    // 模糊封面背景：封面解码到降采样尺寸后只模糊一次，之后每帧仅采样纹理
+    BlurBackdrop {
+        id: fullscreenCoverBlur
         anchors.fill: parent
-        visible: false
-        source: ""
-        fillMode: Image.PreserveAspectCrop
-        cache: true
-        asynchronous: false
-        antialiasing: true
-        smooth: true
-        mipmap: false
-        sourceSize: Qt.size(coverTexW, coverTexH)
+        imageSource: displayCoverIsDefault ? "" : displayCoverImage
+        radius: 192
+        downsample: 8
+        visible: (!displayCoverIsDefault && displayCoverImage !== "") || fullscreenCoverBlurNext.visible
+        opacity: (!displayCoverIsDefault && displayCoverImage !== "") ? 1 : 0
     }
-
-    // 下一个封面预加载（隐藏），准备好后再切换
-    Image {
-        id: nextCoverLoader
+    // 下一张封面：模糊结果就绪后再交叉淡入，避免闪白
+    BlurBackdrop {
+        id: fullscreenCoverBlurNext
         anchors.fill: parent
+        imageSource: pendingCoverUrl
+        radius: 192
+        downsample: 8
         visible: false
-        source: pendingCoverUrl
-        fillMode: Image.PreserveAspectCrop
-        cache: true
-        asynchronous: false
-        antialiasing: true
-        smooth: true
-        mipmap: false
-        sourceSize: Qt.size(coverTexW, coverTexH)
-        onStatusChanged: {
-            if (status === Image.Ready && pendingCoverUrl && pendingCoverUrl.length > 0) {
-                fullscreenCoverSourceNext.source = pendingCoverUrl
+        opacity: 0
+        onReadyChanged: {
+            if (ready && pendingCoverUrl && pendingCoverUrl.length > 0) {
                 fullscreenCoverBlurNext.visible = true
                 fullscreenCoverBlurNext.opacity = 0
                 coverCrossFadeAnim.restart()
@@ -292,32 +225,6 @@ import MusicLibrary 1.0
         }
     }
 
-    // 模糊封面背景
-    MultiEffect {
-        id: fullscreenCoverBlur
-        anchors.fill: parent
-        source: fullscreenCoverSource
-        visible: (!displayCoverIsDefault && displayCoverImage !== "") || fullscreenCoverBlurNext.visible
-        opacity: (!displayCoverIsDefault && displayCoverImage !== "") ? 1 : 0
-        blurEnabled: true
-        blur: 1.0
-        blurMax: 64
-        blurMultiplier: 2.0
-        autoPaddingEnabled: false
-    }
-    MultiEffect {
-        id: fullscreenCoverBlurNext
-        anchors.fill: parent
-        source: fullscreenCoverSourceNext
-        visible: false
-        opacity: 0
-        blurEnabled: true
-        blur: 1.0
-        blurMax: 64
-        blurMultiplier: 2.0
-        autoPaddingEnabled: false
-    }
-
     ParallelAnimation {
         id: coverCrossFadeAnim
         running: false
@@ -327,11 +234,9 @@ import MusicLibrary 1.0
             if (fullscreenCoverBlurNext.visible && fullscreenCoverBlurNext.opacity >= 1) {
                 displayCoverImage = pendingCoverUrl
                 displayCoverIsDefault = false
-                fullscreenCoverSource.source = displayCoverImage
                 fullscreenCoverBlur.opacity = 1
                 fullscreenCoverBlurNext.opacity = 0
                 fullscreenCoverBlurNext.visible = false
-                fullscreenCoverSourceNext.source = ""
                 pendingCoverUrl = ""
             }
         }
@@ -352,10 +257,6 @@ import MusicLibrary 1.0
         z: 1
         antialiasing: true
         smooth: true
-        layer.enabled: true
-        layer.smooth: true
-        layer.samples: 8
-        layer.textureSize: Qt.size(Math.round(width), Math.round(height))
         gradient: Gradient {
             orientation: Gradient.Horizontal
             GradientStop { position: 0.00; color: Qt.rgba(theme.secondaryColor.r, theme.secondaryColor.g, theme.secondaryColor.b, 0.00) }
@@ -413,7 +314,7 @@ import MusicLibrary 1.0
             source: circleCoverImage
             fillMode: Image.PreserveAspectCrop
             cache: true
-            asynchronous: false
+            asynchronous: true
             visible: false
             antialiasing: true
             smooth: true
@@ -613,6 +514,14 @@ import MusicLibrary 1.0
                     elide: Text.ElideRight
                     width: parent.width
                 }
+                Text {
+                    visible: upNextText.length > 0
+                    text: "下一首：" + upNextText
+                    font.pixelSize: 14
+                    color: theme ? Qt.darker(theme.textColor, 1.6) : "#999999"
+                    elide: Text.ElideRight
+                    width: parent.width
+                }
             }
 
             // 随播放滚动显示歌词（优先使用 LRC）
@@ -627,7 +536,7 @@ import MusicLibrary 1.0
                 clip: false
                 spacing: 10
                 boundsBehavior: Flickable.StopAtBounds
-                model: lyricsAvailable ? lyricsEntries : [ { text: "未找到歌词" } ]
+                model: lyricsAvailable ? lyricsDoc : 1
                 currentIndex: currentLyricIndex
                 reuseItems: true
                 // 高亮移动与范围：将当前行保持在视图偏上的位置
@@ -726,7 +635,7 @@ import MusicLibrary 1.0
                             anchors.verticalCenter: parent.verticalCenter
                             anchors.left: parent.left
                             width: parent.width
-                            text: modelData.text
+                            text: lyricsAvailable ? model.text : "未找到歌词"
                             wrapMode: Text.NoWrap
                             horizontalAlignment: Text.AlignLeft
                             font.pixelSize: 24
@@ -741,11 +650,9 @@ import MusicLibrary 1.0
                             id: fillMask
                             anchors.verticalCenter: parent.verticalCenter
                             anchors.left: parent.left
-                            // 根据歌词进度动态填充：本行开始到下一行开始的区间
-                            readonly property real lineStart: (index >= 0 && index < lyricsEntries.length) ? lyricsEntries[index].t : 0
-                            readonly property real lineEnd: (index + 1 < lyricsEntries.length) ? lyricsEntries[index + 1].t : (sourceItem ? sourceItem.duration : lineStart + 3000)
+                            // 根据歌词进度动态填充：有逐字时间时按字推进，否则按本行到下一行的区间线性推进
                             readonly property real posMs: (sourceItem && sourceItem.positionMs) ? sourceItem.positionMs : 0
-                            readonly property real ratio: isActive ? Math.max(0, Math.min(1, (posMs - lineStart) / Math.max(1, lineEnd - lineStart))) : 0
+                            readonly property real ratio: (isActive && lyricsAvailable) ? lyricsDoc.lineProgress(index, posMs, sourceItem ? sourceItem.duration * 1000 : -1) : 0
                             width: Math.ceil(fillText.paintedWidth * ratio)
                             height: parent.height
                             clip: true
@@ -755,7 +662,7 @@ import MusicLibrary 1.0
                                 anchors.verticalCenter: parent.verticalCenter
                                 anchors.left: parent.left
                                 width: parent.width + 0.1
-                                text: modelData.text
+                                text: lyricsAvailable ? model.text : "未找到歌词"
                                 wrapMode: Text.NoWrap
                                 horizontalAlignment: Text.AlignLeft
                                 font.pixelSize: baseText.font.pixelSize + 0.1
@@ -788,7 +695,6 @@ import MusicLibrary 1.0
                         } else {
                             // 后续切换仍走预加载，避免闪白
                             pendingCoverUrl = sourceItem.coverImage
-                            nextCoverLoader.source = pendingCoverUrl
                         }
                         circleCoverImage = sourceItem.coverImage
                     }
@@ -800,7 +706,7 @@ import MusicLibrary 1.0
                         pendingCoverUrl = ""
                         circleCoverImage = ""
                     }
-                    // 当为 false 时，不立即切换，等待 nextCoverLoader 加载完毕
+                    // 当为 false 时，不立即切换，等待下一张封面模糊完成
                 }
                 function onSongTitleChanged() {
                     title = sourceItem.songTitle
@@ -0,0 +1,581 @@
+// 实现文件：BlurBackdrop —— 降采样截取、三遍盒式模糊、共享缓存与圆角纹理几何
+#include "core/blurbackdrop.h"
+#include "core/covercache.h"
+#include "core/coverpalette.h"
+
+#include <QCoreApplication>
+#include <QImageReader>
+#include <QMetaMethod>
+#include <QQuickItemGrabResult>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGTexture>
+#include <QSGTextureMaterial>
+#include <QTimer>
+#include <QUrl>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const int kLongSideStep = 64;       // 图片源解码长边的档位，尺寸相近的卡片共用同一份结果
+const int kMaxCornerSegments = 16;
+
+QString localPath(const QString &source)
+{
+    if (source.startsWith(QLatin1String("file:"))) return QUrl(source).toLocalFile();
+    if (source.startsWith(QLatin1String("qrc:"))) return source.mid(3);
+    return source;
+}
+
+// 三个盒式滤波叠加逼近给定 sigma 的高斯核，返回各遍的半径
+void boxRadii(qreal sigma, int radii[3])
+{
+    const int passes = 3;
+    const qreal ideal = std::sqrt(12.0 * sigma * sigma / passes + 1.0);
+    int lower = int(std::floor(ideal));
+    if (lower % 2 == 0) --lower;
+    const int upper = lower + 2;
+    const qreal m = (12.0 * sigma * sigma - passes * lower * lower - 4.0 * passes * lower - 3.0 * passes)
+                    / (-4.0 * lower - 4.0);
+    const int smaller = qRound(m);
+    for (int i = 0; i < passes; ++i) radii[i] = ((i < smaller ? lower : upper) - 1) / 2;
+}
+
+// 沿一行（step = 1）或一列（step = 宽度）做滑动窗口均值，边缘按最近像素延伸
+void boxLine(const quint32 *in, quint32 *out, int length, int step, int radius)
+{
+    const int window = 2 * radius + 1;
+    int sum[4] = { 0, 0, 0, 0 };
+    for (int i = -radius; i <= radius; ++i) {
+        const quint32 p = in[qBound(0, i, length - 1) * step];
+        for (int c = 0; c < 4; ++c) sum[c] += int((p >> (c * 8)) & 0xff);
+    }
+    for (int i = 0; i < length; ++i) {
+        quint32 value = 0;
+        for (int c = 0; c < 4; ++c) value |= quint32((sum[c] + window / 2) / window) << (c * 8);
+        out[i * step] = value;
+        const quint32 add = in[std::min(i + radius + 1, length - 1) * step];
+        const quint32 sub = in[std::max(i - radius, 0) * step];
+        for (int c = 0; c < 4; ++c) sum[c] += int((add >> (c * 8)) & 0xff) - int((sub >> (c * 8)) & 0xff);
+    }
+}
+
+} // namespace
+
+// ---------------- BlurCache ----------------
+
+BlurCache &BlurCache::instance()
+{
+    static QPointer<BlurCache> cache;
+    if (!cache) cache = new BlurCache(QCoreApplication::instance());
+    return *cache;
+}
+
+BlurCache::BlurCache(QObject *parent)
+    : QObject(parent)
+{
+    // 模糊只在源变化时发生，单线程足够，也避免同一帧内多个条目争抢 CPU
+    m_pool.setMaxThreadCount(1);
+}
+
+BlurCache::~BlurCache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+BlurCache::EntryPtr BlurCache::acquire(const QString &key, QQuickWindow *window)
+{
+    if (const EntryPtr existing = m_entries.value(key)) {
+        ++existing->users;
+        return existing;
+    }
+    auto entry = std::make_shared<Entry>();
+    entry->key = key;
+    entry->window = window;
+    entry->users = 1;
+    m_entries.insert(key, entry);
+    if (window) {
+        // 场景图销毁（窗口关闭、图形设备重建）时纹理随之失效，在渲染线程上直接删除
+        Entry *raw = entry.get();
+        entry->connections << connect(window, &QQuickWindow::sceneGraphInvalidated, this, [raw]() {
+            QMutexLocker lock(&raw->textureMutex);
+            delete raw->texture;
+            raw->texture = nullptr;
+            raw->textureRevision = 0;
+        }, Qt::DirectConnection);
+    }
+    return entry;
+}
+
+BlurCache::EntryPtr BlurCache::acquireItem(QQuickItem *item, QQuickWindow *window, int radius, int downsample)
+{
+    if (!item) return nullptr;
+    const QString key = QStringLiteral("item:%1:%2:%3:%4")
+                            .arg(quintptr(item)).arg(quintptr(window)).arg(radius).arg(downsample);
+    const bool fresh = !m_entries.contains(key);
+    const EntryPtr entry = acquire(key, window);
+    if (!fresh) return entry;
+
+    entry->item = item;
+    entry->radius = radius;
+    entry->downsample = downsample;
+    // 尺寸变化、图片切换或加载完成时才重新模糊；位置/缩放只影响各卡片的取样区域
+    const QMetaMethod slot = staticMetaObject.method(staticMetaObject.indexOfSlot("onItemChanged()"));
+    const QMetaObject *meta = item->metaObject();
+    for (int i = 0; i < meta->methodCount(); ++i) {
+        const QMetaMethod method = meta->method(i);
+        if (method.methodType() != QMetaMethod::Signal) continue;
+        const QByteArray name = method.name();
+        if (name == "widthChanged" || name == "heightChanged" || name == "statusChanged" || name == "sourceChanged")
+            entry->connections << connect(item, method, this, slot);
+    }
+    start(entry);
+    return entry;
+}
+
+BlurCache::EntryPtr BlurCache::acquireImage(const QString &url, QQuickWindow *window, int radius, int longSide)
+{
+    if (url.isEmpty() || longSide <= 0) return nullptr;
+    const QString key = QStringLiteral("image:%1:%2:%3:%4").arg(url).arg(quintptr(window)).arg(radius).arg(longSide);
+    const bool fresh = !m_entries.contains(key);
+    const EntryPtr entry = acquire(key, window);
+    if (!fresh) return entry;
+
+    entry->url = url;
+    entry->radius = radius;
+    entry->longSide = longSide;
+    start(entry);
+    return entry;
+}
+
+void BlurCache::release(const EntryPtr &entry)
+{
+    if (!entry || --entry->users > 0) return;
+    for (const QMetaObject::Connection &connection : std::as_const(entry->connections)) disconnect(connection);
+    entry->connections.clear();
+    delete entry->liveTimer;
+    entry->liveTimer = nullptr;
+    ++entry->generation;
+    dropTexture(*entry);
+    if (m_entries.value(entry->key) == entry) m_entries.remove(entry->key);
+}
+
+void BlurCache::setLive(const EntryPtr &entry, bool live, int interval)
+{
+    if (!entry) return;
+    entry->liveUsers = std::max(0, entry->liveUsers + (live ? 1 : -1));
+    if (entry->liveUsers == 0) {
+        if (entry->liveTimer) entry->liveTimer->stop();
+        return;
+    }
+    if (!entry->liveTimer) {
+        entry->liveTimer = new QTimer(this);
+        std::weak_ptr<Entry> weak = entry;
+        connect(entry->liveTimer, &QTimer::timeout, this, [this, weak]() {
+            if (const EntryPtr locked = weak.lock()) invalidate(locked);
+        });
+    }
+    interval = std::max(16, interval);
+    if (!entry->liveTimer->isActive() || interval < entry->liveTimer->interval()) entry->liveTimer->start(interval);
+}
+
+void BlurCache::invalidate(const EntryPtr &entry)
+{
+    if (!entry || entry->users <= 0) return;
+    // 处理中再次失效只记一次，完成后立即补做，不会堆积
+    if (entry->busy) {
+        entry->pending = true;
+        return;
+    }
+    start(entry);
+}
+
+void BlurCache::onItemChanged()
+{
+    QObject *item = sender();
+    for (const EntryPtr &entry : std::as_const(m_entries)) {
+        if (entry->item == item) invalidate(entry);
+    }
+}
+
+void BlurCache::start(const EntryPtr &entry)
+{
+    entry->busy = true;
+    entry->pending = false;
+    const quint64 generation = ++entry->generation;
+    const QString key = entry->key;
+
+    if (!entry->url.isEmpty()) {
+        const QString url = entry->url;
+        const int longSide = entry->longSide;
+        const int radius = entry->radius;
+        m_pool.start([this, key, generation, url, longSide, radius]() {
+            QImage image;
+            const QString hash = CoverPalette::coverHash(url);
+            if (!hash.isEmpty()) {
+                image = CoverCache::instance().image(hash, longSide);
+            } else {
+                QImageReader reader(localPath(url));
+                const QSize size = reader.size();
+                if (size.isValid()) reader.setScaledSize(size.scaled(longSide, longSide, Qt::KeepAspectRatio));
+                image = reader.read();
+            }
+            if (!image.isNull() && std::max(image.width(), image.height()) > longSide)
+                image = image.scaled(longSide, longSide, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            const QImage result = blurred(image, radius);
+            QMetaObject::invokeMethod(this, [this, key, generation, result]() {
+                finish(key, generation, result);
+            }, Qt::QueuedConnection);
+        });
+        return;
+    }
+
+    QQuickItem *item = entry->item;
+    if (!item || item->width() <= 0 || item->height() <= 0 || !item->window()) {
+        entry->busy = false;
+        return;
+    }
+    std::weak_ptr<Entry> weak = entry;
+    if (!item->window()->isVisible()) {
+        // 启动时窗口尚未显示，截取不会完成；等窗口显示后再来
+        entry->busy = false;
+        connect(item->window(), &QWindow::visibleChanged, this, [this, weak](bool visible) {
+            if (const EntryPtr locked = weak.lock(); locked && visible) invalidate(locked);
+        }, Qt::SingleShotConnection);
+        return;
+    }
+    // 截取本身在渲染线程上以目标尺寸绘制，得到的就是降采样后的图
+    const QSize size(std::max(1, qCeil(item->width() / entry->downsample)),
+                     std::max(1, qCeil(item->height() / entry->downsample)));
+    const QSharedPointer<QQuickItemGrabResult> grab = item->grabToImage(size);
+    if (!grab) {
+        entry->busy = false;
+        return;
+    }
+    connect(grab.data(), &QQuickItemGrabResult::ready, this, [this, weak, generation, grab]() {
+        const EntryPtr locked = weak.lock();
+        if (!locked || locked->generation != generation) return;
+        blurAsync(locked, grab->image());
+    }, Qt::SingleShotConnection);
+}
+
+void BlurCache::blurAsync(const EntryPtr &entry, const QImage &image)
+{
+    const QString key = entry->key;
+    const quint64 generation = entry->generation;
+    const int radius = entry->radius;
+    m_pool.start([this, key, generation, radius, image]() {
+        const QImage result = blurred(image, radius);
+        QMetaObject::invokeMethod(this, [this, key, generation, result]() {
+            finish(key, generation, result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void BlurCache::finish(const QString &key, quint64 generation, const QImage &image)
+{
+    const EntryPtr entry = m_entries.value(key);
+    if (!entry || entry->generation != generation) return;
+    entry->busy = false;
+    if (!image.isNull()) {
+        entry->image = image;
+        ++entry->revision;
+        emit updated(key);
+    }
+    if (entry->pending) start(entry);
+}
+
+void BlurCache::dropTexture(Entry &entry)
+{
+    QMutexLocker lock(&entry.textureMutex);
+    // 纹理属于渲染线程，交给它的事件循环删除
+    if (entry.texture) entry.texture->deleteLater();
+    entry.texture = nullptr;
+    entry.textureRevision = 0;
+}
+
+QSGTexture *BlurCache::texture(Entry &entry, QQuickWindow *window)
+{
+    QMutexLocker lock(&entry.textureMutex);
+    if (entry.image.isNull() || !window) return nullptr;
+    if (entry.texture && entry.textureRevision == entry.revision) return entry.texture;
+
+    QQuickWindow::CreateTextureOptions options;
+    if (entry.image.hasAlphaChannel()) options |= QQuickWindow::TextureHasAlphaChannel;
+    QSGTexture *texture = window->createTextureFromImage(entry.image, options);
+    if (!texture) return entry.texture;
+    // 共用旧纹理的卡片在同一次同步中都会换上新纹理，旧纹理延后到本帧之后删除
+    if (entry.texture) entry.texture->deleteLater();
+    entry.texture = texture;
+    entry.textureRevision = entry.revision;
+    return texture;
+}
+
+QImage BlurCache::blurred(const QImage &image, int radius)
+{
+    QImage out = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (out.isNull() || radius <= 0) return out;
+
+    const int width = out.width();
+    const int height = out.height();
+    // 预乘格式下各通道可以独立平均，不会在透明边缘产生暗边
+    quint32 *pixels = reinterpret_cast<quint32 *>(out.bits());
+    std::vector<quint32> buffer(size_t(width) * size_t(height));
+    int radii[3];
+    boxRadii(radius / 2.0, radii);
+    for (int r : radii) {
+        if (r <= 0) continue;
+        for (int y = 0; y < height; ++y)
+            boxLine(pixels + size_t(y) * width, buffer.data() + size_t(y) * width, width, 1, r);
+        for (int x = 0; x < width; ++x)
+            boxLine(buffer.data() + x, pixels + x, height, width, r);
+    }
+    return out;
+}
+
+// ---------------- BlurBackdrop ----------------
+
+BlurBackdrop::BlurBackdrop(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    connect(&BlurCache::instance(), &BlurCache::updated, this, &BlurBackdrop::onCacheUpdated);
+}
+
+BlurBackdrop::~BlurBackdrop()
+{
+    unsubscribe();
+}
+
+void BlurBackdrop::setSource(QQuickItem *source)
+{
+    if (m_source == source) return;
+    disconnect(m_sourceDestroyed);
+    m_source = source;
+    if (source) {
+        m_sourceDestroyed = connect(source, &QObject::destroyed, this, [this]() {
+            m_source = nullptr;
+            resubscribe();
+            emit sourceChanged();
+        });
+    }
+    emit sourceChanged();
+    resubscribe();
+}
+
+void BlurBackdrop::setImageSource(const QString &source)
+{
+    if (m_imageSource == source) return;
+    m_imageSource = source;
+    emit imageSourceChanged();
+    resubscribe();
+}
+
+void BlurBackdrop::setRadius(qreal radius)
+{
+    radius = std::max<qreal>(0, radius);
+    if (qFuzzyCompare(m_radius, radius)) return;
+    m_radius = radius;
+    emit radiusChanged();
+    resubscribe();
+}
+
+void BlurBackdrop::setDownsample(int downsample)
+{
+    downsample = qBound(1, downsample, 16);
+    if (m_downsample == downsample) return;
+    m_downsample = downsample;
+    emit downsampleChanged();
+    resubscribe();
+}
+
+void BlurBackdrop::setCornerRadius(qreal radius)
+{
+    if (qFuzzyCompare(m_cornerRadius, radius)) return;
+    m_cornerRadius = radius;
+    emit cornerRadiusChanged();
+    update();
+}
+
+void BlurBackdrop::setLive(bool live)
+{
+    if (m_live == live) return;
+    m_live = live;
+    if (m_entry) BlurCache::instance().setLive(m_entry, live, m_interval);
+    emit liveChanged();
+}
+
+void BlurBackdrop::setInterval(int interval)
+{
+    if (m_interval == interval) return;
+    m_interval = interval;
+    if (m_entry && m_live) {
+        BlurCache::instance().setLive(m_entry, false, m_interval);
+        BlurCache::instance().setLive(m_entry, true, m_interval);
+    }
+    emit intervalChanged();
+}
+
+void BlurBackdrop::invalidate()
+{
+    BlurCache::instance().invalidate(m_entry);
+}
+
+void BlurBackdrop::unsubscribe()
+{
+    disconnect(m_frameConnection);
+    if (!m_entry) return;
+    BlurCache &cache = BlurCache::instance();
+    if (m_live) cache.setLive(m_entry, false, m_interval);
+    cache.release(m_entry);
+    m_entry.reset();
+}
+
+void BlurBackdrop::resubscribe()
+{
+    const bool wasReady = isReady();
+    unsubscribe();
+
+    BlurCache &cache = BlurCache::instance();
+    QQuickWindow *win = window();
+    if (win && m_source) {
+        m_entry = cache.acquireItem(m_source, win, qRound(m_radius / m_downsample), m_downsample);
+        // 本项、源或它们的任一祖先移动/缩放都会改变取样区域：每帧只比较一次映射结果，不变则不重绘
+        m_frameConnection = connect(win, &QQuickWindow::afterAnimating, this, &BlurBackdrop::onAfterAnimating);
+    } else if (win && !m_imageSource.isEmpty() && width() > 0 && height() > 0) {
+        m_imageLongSide = imageLongSide();
+        const qreal scale = m_imageLongSide / std::max(width(), height());
+        m_entry = cache.acquireImage(m_imageSource, win, qRound(m_radius * scale), m_imageLongSide);
+    }
+    if (m_entry && m_live) cache.setLive(m_entry, true, m_interval);
+    m_lastSourceRect = QRectF();
+
+    // 换成另一份已就绪的结果（如切换到已缓存的封面）同样视为一次就绪变化
+    if (wasReady || isReady()) emit readyChanged();
+    update();
+}
+
+int BlurBackdrop::imageLongSide() const
+{
+    const int side = qCeil(std::max(width(), height()) / m_downsample);
+    return std::max(1, (side + kLongSideStep - 1) / kLongSideStep) * kLongSideStep;
+}
+
+QRectF BlurBackdrop::sourceRect() const
+{
+    if (m_source) {
+        if (m_source->width() <= 0 || m_source->height() <= 0) return QRectF();
+        const QRectF mapped = m_source->mapRectFromItem(this, QRectF(0, 0, width(), height()));
+        return QRectF(mapped.x() / m_source->width(), mapped.y() / m_source->height(),
+                      mapped.width() / m_source->width(), mapped.height() / m_source->height());
+    }
+    // 图片源：居中裁剪到本项的宽高比（等同 PreserveAspectCrop）
+    if (!m_entry || m_entry->image.isNull() || width() <= 0 || height() <= 0) return QRectF(0, 0, 1, 1);
+    const qreal itemAspect = width() / height();
+    const qreal imageAspect = qreal(m_entry->image.width()) / m_entry->image.height();
+    if (imageAspect > itemAspect) {
+        const qreal w = itemAspect / imageAspect;
+        return QRectF((1 - w) / 2, 0, w, 1);
+    }
+    const qreal h = imageAspect / itemAspect;
+    return QRectF(0, (1 - h) / 2, 1, h);
+}
+
+void BlurBackdrop::onCacheUpdated(const QString &key)
+{
+    if (!m_entry || m_entry->key != key) return;
+    if (m_entry->revision == 1) emit readyChanged();
+    update();
+}
+
+void BlurBackdrop::onAfterAnimating()
+{
+    if (!m_source || !isVisible()) return;
+    const QRectF rect = sourceRect();
+    if (rect == m_lastSourceRect) return;
+    m_lastSourceRect = rect;
+    update();
+}
+
+void BlurBackdrop::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() == oldGeometry.size()) return;
+    // 图片源按自身尺寸选择解码档位，跨档时才换用另一份缓存
+    if (!m_source && !m_imageSource.isEmpty() && (!m_entry || imageLongSide() != m_imageLongSide)) {
+        resubscribe();
+        return;
+    }
+    update();
+}
+
+void BlurBackdrop::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    QQuickItem::itemChange(change, value);
+    if (change == ItemSceneChange) {
+        resubscribe();
+    } else if (change == ItemVisibleHasChanged && value.boolValue) {
+        // 隐藏期间共享纹理可能已被其它卡片换新，重新显示时刷新引用
+        update();
+    }
+}
+
+QSGNode *BlurBackdrop::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    QSGTexture *texture = (m_entry && width() > 0 && height() > 0) ? BlurCache::texture(*m_entry, window()) : nullptr;
+    const QRectF texRect = sourceRect();
+    if (!texture || texRect.isEmpty()) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        auto *material = new QSGTextureMaterial;
+        material->setFiltering(QSGTexture::Linear);
+        material->setHorizontalWrapMode(QSGTexture::ClampToEdge);
+        material->setVerticalWrapMode(QSGTexture::ClampToEdge);
+        node->setMaterial(material);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+    auto *material = static_cast<QSGTextureMaterial *>(node->material());
+    if (material->texture() != texture) {
+        material->setTexture(texture);
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+
+    // 圆角矩形按行展开为三角形带：上下两段圆弧各取若干行，每行左右各一个顶点
+    const qreal w = width();
+    const qreal h = height();
+    const qreal r = std::clamp<qreal>(m_cornerRadius, 0, std::min(w, h) / 2);
+    const int segments = r > 0 ? qBound(2, qCeil(r / 2), kMaxCornerSegments) : 0;
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate((segments + 1) * 4);
+    QSGGeometry::TexturedPoint2D *v = geometry->vertexDataAsTexturedPoint2D();
+    int n = 0;
+    auto row = [&](qreal y, qreal inset) {
+        const qreal ty = texRect.y() + y / h * texRect.height();
+        v[n++].set(float(inset), float(y), float(texRect.x() + inset / w * texRect.width()), float(ty));
+        v[n++].set(float(w - inset), float(y), float(texRect.x() + (w - inset) / w * texRect.width()), float(ty));
+    };
+    for (int i = 0; i <= segments; ++i) {
+        const qreal phi = segments ? M_PI_2 * (1.0 - qreal(i) / segments) : 0.0;
+        row(r - r * std::sin(phi), r - r * std::cos(phi));
+    }
+    for (int i = 0; i <= segments; ++i) {
+        const qreal phi = segments ? M_PI_2 * qreal(i) / segments : 0.0;
+        row(h - r + r * std::sin(phi), r - r * std::cos(phi));
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
@@ -0,0 +1,167 @@
+// core/blurbackdrop.h
+#ifndef CORE_BLURBACKDROP_H
+#define CORE_BLURBACKDROP_H
+
+// 毛玻璃背景：源（QML 项或图片地址）先降采样，再在工作线程上做一次三遍盒式模糊（近似高斯）
+// 结果按“源 + 窗口 + 模糊参数”缓存，多张卡片共用同一份模糊图和同一张纹理，各自只换算纹理坐标
+// 源不变时每帧只有一次纹理采样；源内容/尺寸变化、手动 invalidate 或 live 定时触发时才重新模糊
+#include <QQuickItem>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QPointer>
+#include <QString>
+#include <QThreadPool>
+
+#include <memory>
+
+class QQuickWindow;
+class QSGTexture;
+class QTimer;
+
+class BlurCache : public QObject
+{
+    Q_OBJECT
+public:
+    struct Entry
+    {
+        QString key;
+        QPointer<QQuickItem> item;      // 项源：整体截取后降采样
+        QString url;                    // 图片源：直接按长边解码
+        QPointer<QQuickWindow> window;
+        int radius = 0;                 // 降采样图上的模糊半径（像素）
+        int downsample = 1;
+        int longSide = 0;
+        QImage image;                   // 模糊结果，预乘 ARGB32
+        quint64 revision = 0;           // 每次得到新的模糊结果递增
+        quint64 generation = 0;         // 丢弃过期的截取/模糊结果
+        int users = 0;
+        int liveUsers = 0;
+        bool busy = false;
+        bool pending = false;           // 处理期间又被标记失效，完成后再来一次
+        QTimer *liveTimer = nullptr;
+        QList<QMetaObject::Connection> connections;
+
+        // 纹理只在渲染线程创建和销毁；同步阶段与 GUI 线程释放之间用锁保护
+        QMutex textureMutex;
+        QSGTexture *texture = nullptr;
+        quint64 textureRevision = 0;
+    };
+    using EntryPtr = std::shared_ptr<Entry>;
+
+    static BlurCache &instance();
+    ~BlurCache() override;
+
+    // 同一键只处理一次；返回的条目在 release 之前一直有效
+    EntryPtr acquireItem(QQuickItem *item, QQuickWindow *window, int radius, int downsample);
+    EntryPtr acquireImage(const QString &url, QQuickWindow *window, int radius, int longSide);
+    void release(const EntryPtr &entry);
+    // 任一使用者打开 live 时按最短间隔定时重新截取
+    void setLive(const EntryPtr &entry, bool live, int interval);
+    void invalidate(const EntryPtr &entry);
+
+    // 只能在同步阶段（updatePaintNode）调用：模糊结果更新后才重建纹理
+    static QSGTexture *texture(Entry &entry, QQuickWindow *window);
+    // 纯计算，可在任意线程调用
+    static QImage blurred(const QImage &image, int radius);
+
+signals:
+    void updated(const QString &key);
+
+private slots:
+    void onItemChanged();
+
+private:
+    explicit BlurCache(QObject *parent = nullptr);
+    EntryPtr acquire(const QString &key, QQuickWindow *window);
+    void start(const EntryPtr &entry);
+    void blurAsync(const EntryPtr &entry, const QImage &image);
+    void finish(const QString &key, quint64 generation, const QImage &image);
+    void dropTexture(Entry &entry);
+
+    QThreadPool m_pool;
+    QHash<QString, EntryPtr> m_entries;     // 仅 GUI 线程访问
+};
+
+class BlurBackdrop : public QQuickItem
+{
+    Q_OBJECT
+    // 被模糊的 QML 项（通常是窗口背景），本项显示自身覆盖区域的模糊内容；优先于 imageSource
+    Q_PROPERTY(QQuickItem *source READ source WRITE setSource NOTIFY sourceChanged)
+    // 图片地址（file: / qrc: / image://cover），按 PreserveAspectCrop 铺满本项
+    Q_PROPERTY(QString imageSource READ imageSource WRITE setImageSource NOTIFY imageSourceChanged)
+    // 模糊半径，单位为源坐标像素
+    Q_PROPERTY(qreal radius READ radius WRITE setRadius NOTIFY radiusChanged)
+    // 在 1/downsample 尺寸的图上模糊，放大显示时由线性插值补足平滑
+    Q_PROPERTY(int downsample READ downsample WRITE setDownsample NOTIFY downsampleChanged)
+    Q_PROPERTY(qreal cornerRadius READ cornerRadius WRITE setCornerRadius NOTIFY cornerRadiusChanged)
+    // 源内容持续变化时打开，按 interval（毫秒）定时重新截取
+    Q_PROPERTY(bool live READ isLive WRITE setLive NOTIFY liveChanged)
+    Q_PROPERTY(int interval READ interval WRITE setInterval NOTIFY intervalChanged)
+    Q_PROPERTY(bool ready READ isReady NOTIFY readyChanged)
+
+public:
+    explicit BlurBackdrop(QQuickItem *parent = nullptr);
+    ~BlurBackdrop() override;
+
+    QQuickItem *source() const { return m_source; }
+    void setSource(QQuickItem *source);
+    QString imageSource() const { return m_imageSource; }
+    void setImageSource(const QString &source);
+    qreal radius() const { return m_radius; }
+    void setRadius(qreal radius);
+    int downsample() const { return m_downsample; }
+    void setDownsample(int downsample);
+    qreal cornerRadius() const { return m_cornerRadius; }
+    void setCornerRadius(qreal radius);
+    bool isLive() const { return m_live; }
+    void setLive(bool live);
+    int interval() const { return m_interval; }
+    void setInterval(int interval);
+    bool isReady() const { return m_entry && m_entry->revision > 0; }
+
+    // 源内容变化但没有可观察的信号时，由 QML 手动触发重新模糊
+    Q_INVOKABLE void invalidate();
+
+signals:
+    void sourceChanged();
+    void imageSourceChanged();
+    void radiusChanged();
+    void downsampleChanged();
+    void cornerRadiusChanged();
+    void liveChanged();
+    void intervalChanged();
+    void readyChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private slots:
+    void onCacheUpdated(const QString &key);
+    void onAfterAnimating();
+
+private:
+    void resubscribe();
+    void unsubscribe();
+    int imageLongSide() const;
+    QRectF sourceRect() const;
+
+    QPointer<QQuickItem> m_source;
+    QString m_imageSource;
+    qreal m_radius = 32;
+    int m_downsample = 4;
+    qreal m_cornerRadius = 0;
+    bool m_live = false;
+    int m_interval = 200;
+
+    BlurCache::EntryPtr m_entry;
+    QMetaObject::Connection m_sourceDestroyed;
+    QMetaObject::Connection m_frameConnection;
+    QRectF m_lastSourceRect;                // 上一帧本项在源中的区域，变化时才重绘
+    int m_imageLongSide = 0;
+};
+
+#endif // CORE_BLURBACKDROP_H
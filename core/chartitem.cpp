@@ -0,0 +1,891 @@
+// 实现文件：ChartItem —— 紧凑数据 + 降采样 + 单节点三角化绘制
+#include "core/chartitem.h"
+
+#include "core/chartseries.h"
+
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+using Vertex = QSGGeometry::ColoredPoint2D;
+
+const double kPi = 3.14159265358979323846;
+
+// 顶点颜色材质要求预乘 alpha
+struct Rgba
+{
+    uchar r = 0, g = 0, b = 0, a = 0;
+};
+
+Rgba premultiply(const QColor &c, qreal opacity = 1.0)
+{
+    const qreal a = std::clamp(c.alphaF() * opacity, 0.0, 1.0);
+    return Rgba { uchar(qRound(c.red() * a)), uchar(qRound(c.green() * a)), uchar(qRound(c.blue() * a)), uchar(qRound(a * 255)) };
+}
+
+QPointF unit(const QPointF &v)
+{
+    const qreal len = std::hypot(v.x(), v.y());
+    return len < 1e-6 ? QPointF() : v / len;
+}
+
+QColor toColor(const QVariant &value)
+{
+    QColor c = value.value<QColor>();
+    if (!c.isValid()) c = QColor::fromString(value.toString());
+    return c;
+}
+
+// 三角形列表，所有图元按绘制顺序追加，最终一次上传
+struct Mesh
+{
+    std::vector<Vertex> vertices;
+    std::vector<quint32> indices;
+
+    quint32 add(const QPointF &p, Rgba c)
+    {
+        Vertex v;
+        v.set(float(p.x()), float(p.y()), c.r, c.g, c.b, c.a);
+        vertices.push_back(v);
+        return quint32(vertices.size() - 1);
+    }
+    void tri(quint32 a, quint32 b, quint32 c) { indices.insert(indices.end(), { a, b, c }); }
+    void quad(quint32 a, quint32 b, quint32 c, quint32 d)
+    {
+        tri(a, b, c);
+        tri(a, c, d);
+    }
+
+    void rect(const QRectF &r, Rgba c)
+    {
+        if (r.width() <= 0 || r.height() <= 0) return;
+        quad(add(r.topLeft(), c), add(r.topRight(), c), add(r.bottomRight(), c), add(r.bottomLeft(), c));
+    }
+
+    // 抗锯齿折线：每个顶点沿角平分线外扩，内外各一圈 0.5px 透明羽化
+    void polyline(const std::vector<QPointF> &pts, qreal width, Rgba c)
+    {
+        const size_t n = pts.size();
+        if (n < 2) return;
+        const qreal inner = std::max(0.0, width / 2 - 0.5);
+        const qreal outer = width / 2 + 0.5;
+        const Rgba clear;
+        const quint32 base = quint32(vertices.size());
+        for (size_t i = 0; i < n; ++i) {
+            const QPointF d0 = i > 0 ? unit(pts[i] - pts[i - 1]) : QPointF();
+            const QPointF d1 = i + 1 < n ? unit(pts[i + 1] - pts[i]) : QPointF();
+            QPointF t = unit(d0 + d1);
+            if (t.isNull()) t = d1.isNull() ? d0 : d1;
+            QPointF normal(-t.y(), t.x());
+            const QPointF seg = i > 0 ? d0 : d1;
+            const qreal dot = normal.x() * -seg.y() + normal.y() * seg.x();
+            normal *= dot > 0.5 ? 1.0 / dot : 2.0;     // 斜接长度上限 2 倍
+            add(pts[i] + normal * outer, clear);
+            add(pts[i] + normal * inner, c);
+            add(pts[i] - normal * inner, c);
+            add(pts[i] - normal * outer, clear);
+        }
+        for (quint32 i = 0; i + 1 < n; ++i) {
+            const quint32 a = base + i * 4;
+            const quint32 b = a + 4;
+            for (quint32 k = 0; k < 3; ++k) quad(a + k, b + k, b + k + 1, a + k + 1);
+        }
+    }
+
+    // 扇形/环形（r0 > 0 为环形），外缘带 0.5px 羽化
+    void sector(const QPointF &center, qreal r0, qreal r1, qreal a0, qreal a1, Rgba c)
+    {
+        if (r1 <= 0 || a1 <= a0) return;
+        const int segments = std::max(2, int(std::ceil((a1 - a0) * r1 / 3.0)));
+        const Rgba clear;
+        const quint32 hub = r0 > 0 ? 0 : add(center, c);
+        quint32 prevIn = 0, prevOut = 0, prevEdge = 0;
+        for (int s = 0; s <= segments; ++s) {
+            const qreal a = a0 + (a1 - a0) * s / segments;
+            const QPointF dir(std::cos(a), std::sin(a));
+            const quint32 in = r0 > 0 ? add(center + dir * r0, c) : hub;
+            const quint32 out = add(center + dir * std::max(r0, r1 - 0.5), c);
+            const quint32 edge = add(center + dir * (r1 + 0.5), clear);
+            if (s > 0) {
+                if (r0 > 0) quad(prevIn, prevOut, out, in);
+                else tri(hub, prevOut, out);
+                quad(prevOut, prevEdge, edge, out);
+            }
+            prevIn = in;
+            prevOut = out;
+            prevEdge = edge;
+        }
+    }
+
+    void disc(const QPointF &center, qreal radius, Rgba c) { sector(center, 0, radius, 0, 2 * kPi, c); }
+
+    // 曲线与基线之间的填充带
+    void area(const std::vector<QPointF> &pts, qreal baseY, Rgba c)
+    {
+        if (pts.size() < 2) return;
+        const quint32 base = quint32(vertices.size());
+        for (const QPointF &p : pts) {
+            add(p, c);
+            add(QPointF(p.x(), baseY), c);
+        }
+        for (quint32 i = 0; i + 1 < pts.size(); ++i) {
+            const quint32 a = base + i * 2;
+            quad(a, a + 2, a + 3, a + 1);
+        }
+    }
+};
+
+// 三角形 (a, p, avg) 面积的两倍，LTTB 据此在桶内选点
+double triangleArea(const QPointF &a, double px, double py, const QPointF &avg)
+{
+    return std::abs((a.x() - avg.x()) * (py - a.y()) - (a.x() - px) * (avg.y() - a.y()));
+}
+
+// Catmull-Rom 转三次贝塞尔后按像素长度细分
+std::vector<QPointF> smoothPath(const std::vector<QPointF> &p)
+{
+    const size_t n = p.size();
+    if (n < 3) return p;
+    std::vector<QPointF> out;
+    out.reserve(n * 4);
+    out.push_back(p[0]);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        const QPointF &p0 = p[i > 0 ? i - 1 : 0];
+        const QPointF &p1 = p[i];
+        const QPointF &p2 = p[i + 1];
+        const QPointF &p3 = p[std::min(i + 2, n - 1)];
+        const QPointF c1 = p1 + (p2 - p0) / 6.0;
+        const QPointF c2 = p2 - (p3 - p1) / 6.0;
+        const int steps = std::clamp(int(std::hypot(p2.x() - p1.x(), p2.y() - p1.y()) / 4.0), 1, 16);
+        for (int s = 1; s <= steps; ++s) {
+            const qreal t = qreal(s) / steps;
+            const qreal u = 1 - t;
+            out.push_back(p1 * (u * u * u) + c1 * (3 * u * u * t) + c2 * (3 * u * t * t) + p2 * (t * t * t));
+        }
+    }
+    return out;
+}
+
+std::vector<QPointF> stepPath(const std::vector<QPointF> &p)
+{
+    std::vector<QPointF> out;
+    if (p.empty()) return out;
+    out.reserve(p.size() * 2);
+    out.push_back(p[0]);
+    for (size_t j = 1; j < p.size(); ++j) {
+        out.emplace_back(p[j].x(), p[j - 1].y());
+        out.push_back(p[j]);
+    }
+    return out;
+}
+
+} // namespace
+
+void ChartItem::Samples::clear()
+{
+    m_data.clear();
+    m_first = 0;
+    m_dropped = 0;
+}
+
+float *ChartItem::Samples::grow(size_t count)
+{
+    m_data.resize(m_data.size() + count);
+    return m_data.data() + m_data.size() - count;
+}
+
+void ChartItem::Samples::dropFront(size_t count)
+{
+    count = std::min(count, size());
+    m_first += count;
+    m_dropped += count;
+    if (m_first * 2 > m_data.size()) {
+        m_data.erase(m_data.begin(), m_data.begin() + std::ptrdiff_t(m_first));
+        m_first = 0;
+    }
+}
+
+ChartItem::ChartItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void ChartItem::setType(ChartType type)
+{
+    if (m_type == type) return;
+    m_type = type;
+    emit typeChanged();
+    if (!m_sources.isEmpty()) syncSources();    // 饼图总和只在需要时统计
+    else invalidateData();
+}
+
+void ChartItem::setSeries(const QVariantList &series)
+{
+    m_seriesVariant = series;
+    if (!m_sources.isEmpty()) {
+        emit seriesChanged();
+        return;
+    }
+    m_series.clear();
+    m_series.reserve(size_t(series.size()));
+    m_maxValue = 0.0f;
+    m_totalValue = 0.0;
+    // 一次性转换为紧凑数组，之后绘制与命中测试不再访问 QVariant
+    for (const QVariant &entry : series) {
+        const QVariantMap map = entry.toMap();
+        Series s;
+        s.name = map.value("name").toString();
+        s.color = toColor(map.value("color"));
+        const QVariantList data = map.value("data").toList();
+        s.values.reserve(size_t(data.size()));
+        for (const QVariant &point : data) {
+            const QVariantMap item = point.toMap();
+            const float v = item.isEmpty() ? point.toFloat() : item.value("value").toFloat();
+            s.values.push_back(v);
+            m_maxValue = std::max(m_maxValue, v);
+            if (m_series.empty()) m_totalValue += v;
+            // 逐项颜色只在数据里给出时保存（饼图），大数据量的面积/柱状图不付出这部分开销
+            if (item.contains(QStringLiteral("color"))) {
+                s.colors.resize(s.values.size() - 1);
+                s.colors.push_back(toColor(item.value("color")));
+            }
+        }
+        m_series.push_back(std::move(s));
+    }
+    emit seriesChanged();
+    invalidateData();
+}
+
+void ChartItem::setSources(const QList<ChartSeries *> &sources)
+{
+    if (m_sources == sources) return;
+    for (ChartSeries *source : std::as_const(m_sources)) {
+        if (source) disconnect(source, nullptr, this, nullptr);
+    }
+    m_sources = sources;
+    m_sources.removeAll(nullptr);
+    m_series.clear();
+    for (ChartSeries *source : std::as_const(m_sources)) {
+        // changed 已按帧合并，这里每帧最多同步一次
+        connect(source, &ChartSeries::changed, this, &ChartItem::syncSources);
+        connect(source, &ChartSeries::colorChanged, this, &ChartItem::syncSources);
+        connect(source, &ChartSeries::nameChanged, this, &ChartItem::syncSources);
+        connect(source, &QObject::destroyed, this, [this, source]() {
+            m_sources.removeAll(source);
+            m_series.clear();
+            emit sourcesChanged();
+            // 最后一个数据源销毁后回到 series 属性提供的静态数据
+            if (m_sources.isEmpty()) setSeries(m_seriesVariant);
+            else syncSources();
+        });
+    }
+    emit sourcesChanged();
+    if (m_sources.isEmpty()) setSeries(m_seriesVariant);
+    else syncSources();
+}
+
+void ChartItem::syncSources()
+{
+    if (m_sources.isEmpty()) return;
+    m_series.resize(size_t(m_sources.size()));
+    m_maxValue = 0.0f;
+    m_totalValue = 0.0;
+    for (qsizetype i = 0; i < m_sources.size(); ++i) {
+        const ChartSeries *source = m_sources.at(i);
+        Series &s = m_series[size_t(i)];
+        s.name = source->name();
+        s.color = source->color();
+        s.colors.clear();
+        // 只复制上次同步后新写入的点，被环形缓冲覆盖的旧点从头部淘汰；极值直接取增量维护的结果
+        const int count = source->count();
+        const size_t fresh = size_t(std::min<quint64>(source->sequence() - s.sequence, quint64(count)));
+        const size_t keep = size_t(count) - fresh;
+        if (keep > s.values.size() || source->sequence() < s.sequence) {
+            s.values.clear();
+            s.xs.clear();
+            s.decimation = Decimation();
+            source->copyPoints(0, count, s.values.grow(size_t(count)), s.xs.grow(size_t(count)));
+        } else {
+            s.values.dropFront(s.values.size() - keep);
+            s.xs.dropFront(s.xs.size() - keep);
+            source->copyPoints(int(keep), int(fresh), s.values.grow(fresh), s.xs.grow(fresh));
+        }
+        s.sequence = source->sequence();
+        m_maxValue = std::max(m_maxValue, float(source->maxValue()));
+        if (i == 0 && m_type == Pie) {
+            for (float v : s.values) m_totalValue += v;
+        }
+    }
+    invalidateData();
+}
+
+void ChartItem::appendValue(int series, qreal value)
+{
+    const float v = float(value);
+    appendValues(series, &v, 1);
+}
+
+void ChartItem::appendValues(int series, const float *values, qsizetype count)
+{
+    // 绑定了 ChartSeries 时数据由数据源提供
+    if (series < 0 || count <= 0 || !m_sources.isEmpty()) return;
+    if (size_t(series) >= m_series.size()) m_series.resize(size_t(series) + 1);
+    m_series[size_t(series)].values.append(values, size_t(count));
+    for (qsizetype i = 0; i < count; ++i) {
+        m_maxValue = std::max(m_maxValue, values[i]);
+        if (series == 0) m_totalValue += values[i];
+    }
+    invalidateData();
+}
+
+void ChartItem::setLineStyle(LineStyle style)
+{
+    if (m_lineStyle == style) return;
+    m_lineStyle = style;
+    emit styleChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setHoveredSeries(int series)
+{
+    if (m_hoveredSeries == series) return;
+    m_hoveredSeries = series;
+    emit hoverChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setHoveredIndex(int index)
+{
+    if (m_hoveredIndex == index) return;
+    m_hoveredIndex = index;
+    emit hoverChanged();
+    invalidateMesh();
+}
+
+qreal ChartItem::maxValue() const
+{
+    if (m_maxValue > 0) return m_maxValue;
+    return m_type == Bar ? 100.0 : 1.0;     // 避免除以 0
+}
+
+qreal ChartItem::totalValue() const
+{
+    return m_totalValue > 0 ? m_totalValue : 1.0;
+}
+
+void ChartItem::setVerticalPadding(qreal padding)
+{
+    if (m_verticalPadding == padding) return;
+    m_verticalPadding = padding;
+    emit styleChanged();
+    invalidateData();
+}
+
+void ChartItem::setLineWidth(qreal width)
+{
+    if (m_lineWidth == width) return;
+    m_lineWidth = width;
+    emit styleChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setFillOpacity(qreal opacity)
+{
+    if (m_fillOpacity == opacity) return;
+    m_fillOpacity = opacity;
+    emit styleChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setBarSpacing(qreal spacing)
+{
+    if (m_barSpacing == spacing) return;
+    m_barSpacing = spacing;
+    emit styleChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setGroupSpacing(qreal spacing)
+{
+    if (m_groupSpacing == spacing) return;
+    m_groupSpacing = spacing;
+    emit styleChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setGridColor(const QColor &color)
+{
+    if (m_gridColor == color) return;
+    m_gridColor = color;
+    emit styleChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setGridLines(int lines)
+{
+    if (m_gridLines == lines) return;
+    m_gridLines = lines;
+    emit styleChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setInnerRadius(qreal radius)
+{
+    if (m_innerRadius == radius) return;
+    m_innerRadius = radius;
+    emit styleChanged();
+    emit slicesChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setOuterMargin(qreal margin)
+{
+    if (m_outerMargin == margin) return;
+    m_outerMargin = margin;
+    emit styleChanged();
+    emit slicesChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setSeparatorColor(const QColor &color)
+{
+    if (m_separatorColor == color) return;
+    m_separatorColor = color;
+    emit styleChanged();
+    invalidateMesh();
+}
+
+void ChartItem::setSliceOffset(int index, qreal offset)
+{
+    if (index < 0) return;
+    if (size_t(index) >= m_sliceOffsets.size()) m_sliceOffsets.resize(size_t(index) + 1, 0.0f);
+    if (qFuzzyCompare(m_sliceOffsets[size_t(index)] + 1.0f, float(offset) + 1.0f)) return;
+    m_sliceOffsets[size_t(index)] = float(offset);
+    emit slicesChanged();
+    invalidateMesh();
+}
+
+void ChartItem::invalidateData()
+{
+    m_cacheDirty = true;
+    rebuildSliceAngles();
+    emit dataChanged();
+    if (m_type == Pie) emit slicesChanged();
+    invalidateMesh();
+}
+
+void ChartItem::invalidateMesh()
+{
+    m_meshDirty = true;
+    update();
+}
+
+void ChartItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        m_cacheDirty = true;
+        if (m_type == Pie) emit slicesChanged();
+        invalidateMesh();
+    }
+}
+
+ChartItem::Layout ChartItem::layout() const
+{
+    Layout l;
+    l.maxValue = maxValue();
+    l.count = pointCount();
+    // x 方向以第一个系列的首尾 x 为范围，与原 Canvas 绘制一致
+    if (l.count > 0) {
+        const Series &first = m_series.front();
+        l.minX = first.xAt(0);
+        l.maxX = first.xAt(size_t(l.count) - 1);
+    }
+    if (m_type == Area) {
+        l.top = m_verticalPadding;
+        l.bottom = height() - m_verticalPadding;
+    } else {
+        l.top = 0;
+        l.bottom = height();
+    }
+    return l;
+}
+
+qreal ChartItem::xForValue(qreal x, const Layout &l) const
+{
+    // 首尾点各留半个间隔；x 取下标时每个数据点居中于等宽区间
+    const qreal step = width() / std::max(1, l.count);
+    if (l.maxX <= l.minX) return step / 2;
+    return step / 2 + (x - l.minX) / (l.maxX - l.minX) * (width() - step);
+}
+
+qreal ChartItem::yForValue(qreal value, const Layout &l) const
+{
+    return l.bottom - (value / l.maxValue) * (l.bottom - l.top);
+}
+
+void ChartItem::updateScreenCache() const
+{
+    if (!m_cacheDirty) return;
+    m_cacheDirty = false;
+    if (m_type != Area) return;
+
+    const Layout l = layout();
+    const size_t threshold = size_t(std::max(3.0, std::ceil(width())));
+    for (const Series &s : m_series) {
+        s.screen.clear();
+        const size_t n = s.values.size();
+        if (n == 0) continue;
+        // 选点在数据坐标中增量维护，这里只做 O(像素宽度) 的屏幕变换
+        updateDecimation(s, threshold);
+        const Decimation &d = s.decimation;
+        const auto point = [&](size_t i) { return QPointF(xForValue(s.xAt(i), l), yForValue(s.values[i], l)); };
+        if (d.buckets.empty()) {
+            s.screen.reserve(n);
+            for (size_t i = 0; i < n; ++i) s.screen.push_back(point(i));
+            continue;
+        }
+        const quint64 first = s.values.offset();
+        s.screen.reserve(d.buckets.size() + 2);
+        s.screen.push_back(point(0));
+        for (const Bucket &b : d.buckets) {
+            if (b.pick > first && b.pick + 1 < first + n) s.screen.push_back(point(size_t(b.pick - first)));
+        }
+        s.screen.push_back(point(n - 1));
+    }
+}
+
+void ChartItem::updateDecimation(const Series &s, size_t threshold) const
+{
+    // Largest-Triangle-Three-Buckets：首尾点固定，每个桶保留与前一选点、后一桶均值构成最大三角形的点
+    // 桶按 x 的固定宽度对齐，数据滑动时已有桶不变，只重算被淘汰截断的头部桶与新数据落入的尾部桶
+    Decimation &d = s.decimation;
+    const size_t n = s.values.size();
+    // 超过像素宽度的点对显示无贡献，降到每像素约一个点
+    if (n <= threshold * 2) {
+        d = Decimation();
+        return;
+    }
+    const quint64 first = s.values.offset();
+    const quint64 last = first + n;
+    const auto x = [&](quint64 k) { return s.xAt(size_t(k - first)); };
+    const auto y = [&](quint64 k) { return qreal(s.values[size_t(k - first)]); };
+
+    // 桶宽偏离目标两倍以上（数据增长、宽度变化）或数据被重置时整体重建
+    const double span = x(last - 1) - x(first);
+    const double desired = span > 0 ? span / double(threshold - 2) : 1.0;
+    if (d.threshold != threshold || d.buckets.empty() || desired > d.width * 2 || desired < d.width / 2
+        || d.processed > last) {
+        d = Decimation();
+        d.width = desired;
+        d.threshold = threshold;
+        d.processed = first;
+    }
+
+    // 头部：丢弃已淘汰的桶，被截断的桶重新求和
+    bool frontDirty = false;
+    while (!d.buckets.empty() && d.buckets.front().end <= first) {
+        d.buckets.pop_front();
+        frontDirty = true;
+    }
+    if (!d.buckets.empty() && d.buckets.front().begin < first) {
+        Bucket &b = d.buckets.front();
+        b.begin = first;
+        b.sumX = b.sumY = 0;
+        for (quint64 k = b.begin; k < b.end; ++k) {
+            b.sumX += x(k);
+            b.sumY += y(k);
+        }
+        frontDirty = true;
+    }
+    d.processed = std::max(d.processed, first);
+
+    // 尾部：新点按 x 落入最后一个桶或开新桶（x 回退时并入最后一个桶）
+    const size_t oldSize = d.buckets.size();
+    const bool appended = d.processed < last;
+    for (quint64 k = d.processed; k < last; ++k) {
+        const double px = x(k);
+        const double py = y(k);
+        const qint64 key = qint64(std::floor(px / d.width));
+        if (!d.buckets.empty() && key <= d.buckets.back().key) {
+            Bucket &b = d.buckets.back();
+            b.end = k + 1;
+            b.sumX += px;
+            b.sumY += py;
+        } else {
+            d.buckets.push_back(Bucket { key, k, k + 1, px, py, k });
+        }
+    }
+    d.processed = last;
+
+    const auto pick = [&](size_t i) {
+        Bucket &b = d.buckets[i];
+        const QPointF a = i > 0 ? QPointF(x(d.buckets[i - 1].pick), y(d.buckets[i - 1].pick)) : QPointF(x(first), y(first));
+        QPointF avg(x(last - 1), y(last - 1));
+        if (i + 1 < d.buckets.size()) {
+            const Bucket &next = d.buckets[i + 1];
+            avg = QPointF(next.sumX, next.sumY) / double(next.end - next.begin);
+        }
+        double best = -1;
+        for (quint64 k = b.begin; k < b.end; ++k) {
+            const double area = triangleArea(a, x(k), y(k), avg);
+            if (area > best) {
+                best = area;
+                b.pick = k;
+            }
+        }
+    };
+    // 选点依赖前一桶的选点与后一桶的均值：头部重算前两个桶，尾部从原倒数第二个桶起重算
+    // 中间桶不随之级联更新，偏差只出现在重算边界的一个点上，视觉上不可见
+    const size_t tailFrom = appended ? (oldSize > 1 ? oldSize - 2 : 0) : d.buckets.size();
+    if (frontDirty) {
+        for (size_t i = 0; i < std::min<size_t>(2, tailFrom); ++i) pick(i);
+    }
+    for (size_t i = tailFrom; i < d.buckets.size(); ++i) pick(i);
+}
+
+void ChartItem::rebuildSliceAngles()
+{
+    m_sliceEnds.clear();
+    if (m_type != Pie || m_series.empty()) return;
+    const double total = totalValue();
+    double angle = 0;
+    for (float v : m_series.front().values) {
+        angle += double(v) / total * 2 * kPi;
+        m_sliceEnds.push_back(angle);
+    }
+}
+
+int ChartItem::indexAt(qreal x) const
+{
+    if (m_type != Area || m_series.empty() || m_series.front().values.empty()) return -1;
+    const Series &s = m_series.front();
+    const Layout l = layout();
+    const qreal step = width() / l.count;
+    if (l.maxX <= l.minX || width() <= step) return 0;
+    // 屏幕 x 反算为数据 x，再在第一个系列中二分查找最近的点
+    const qreal target = l.minX + (x - step / 2) / (width() - step) * (l.maxX - l.minX);
+    const int last = l.count - 1;
+    if (s.xs.empty()) return int(std::clamp<qreal>(std::round(target), 0, last));
+    const auto it = std::lower_bound(s.xs.begin(), s.xs.end(), float(target));
+    if (it == s.xs.begin()) return 0;
+    if (it == s.xs.end()) return last;
+    const int right = int(it - s.xs.begin());
+    return (target - *(it - 1)) <= (*it - target) ? right - 1 : right;
+}
+
+QVariantMap ChartItem::barAt(qreal x, qreal y) const
+{
+    QVariantMap hit { { "series", -1 }, { "index", -1 } };
+    const int count = pointCount();
+    const int seriesCount = int(m_series.size());
+    if (m_type != Bar || count == 0 || x < 0 || x >= width()) return hit;
+    const qreal groupTotal = width() / count;
+    const int index = std::min(count - 1, int(x / groupTotal));
+    const qreal groupWidth = groupTotal * (1 - m_groupSpacing);
+    const qreal barStep = groupWidth / seriesCount;
+    const qreal offset = x - index * groupTotal - (groupTotal - groupWidth) / 2;
+    if (offset < 0 || offset >= groupWidth) return hit;
+    const int series = std::min(seriesCount - 1, int(offset / barStep));
+    const Samples &values = m_series[size_t(series)].values;
+    if (size_t(index) >= values.size()) return hit;
+    const Layout l = layout();
+    // 过细的柱子按整列判定，只要求落在柱高范围内
+    const qreal top = yForValue(values[size_t(index)], l);
+    if (y < std::min(top, l.bottom - 4) || y > l.bottom) return hit;
+    hit.insert("series", series);
+    hit.insert("index", index);
+    return hit;
+}
+
+int ChartItem::sliceAt(qreal x, qreal y) const
+{
+    if (m_type != Pie || m_sliceEnds.empty()) return -1;
+    const QPointF center(width() / 2, height() / 2);
+    const qreal dx = x - center.x();
+    const qreal dy = y - center.y();
+    const qreal dist = std::hypot(dx, dy);
+    // 从 12 点方向顺时针的角度
+    qreal angle = std::atan2(dy, dx) + kPi / 2;
+    if (angle < 0) angle += 2 * kPi;
+    const auto it = std::upper_bound(m_sliceEnds.cbegin(), m_sliceEnds.cend(), angle);
+    if (it == m_sliceEnds.cend()) return -1;
+    const int index = int(it - m_sliceEnds.cbegin());
+    const qreal offset = size_t(index) < m_sliceOffsets.size() ? m_sliceOffsets[size_t(index)] : 0.0;
+    const qreal outer = std::min(width(), height()) / 2 - m_outerMargin + offset;
+    if (dist < m_innerRadius || dist > outer) return -1;
+    return index;
+}
+
+QPointF ChartItem::pointPosition(int series, int index) const
+{
+    if (series < 0 || size_t(series) >= m_series.size()) return QPointF();
+    const Series &s = m_series[size_t(series)];
+    const Samples &values = s.values;
+    if (index < 0 || size_t(index) >= values.size()) return QPointF();
+    const Layout l = layout();
+    if (m_type == Bar) {
+        const qreal groupTotal = width() / std::max(1, l.count);
+        const qreal groupWidth = groupTotal * (1 - m_groupSpacing);
+        const qreal barStep = groupWidth / int(m_series.size());
+        const qreal x = index * groupTotal + (groupTotal - groupWidth) / 2 + series * barStep + barStep / 2;
+        return QPointF(x, yForValue(values[size_t(index)], l));
+    }
+    return QPointF(xForValue(s.xAt(size_t(index)), l), yForValue(values[size_t(index)], l));
+}
+
+QPointF ChartItem::sliceLabelPosition(int index) const
+{
+    if (index < 0 || size_t(index) >= m_sliceEnds.size()) return QPointF();
+    const double start = index > 0 ? m_sliceEnds[size_t(index) - 1] : 0.0;
+    const double mid = (start + m_sliceEnds[size_t(index)]) / 2 - kPi / 2;
+    const qreal offset = size_t(index) < m_sliceOffsets.size() ? m_sliceOffsets[size_t(index)] : 0.0;
+    const qreal r = std::min(width(), height()) / 2 - m_outerMargin + offset;
+    const qreal labelRadius = m_innerRadius > 0 ? (r + m_innerRadius) / 2 : r * 0.7;
+    return QPointF(width() / 2 + std::cos(mid) * labelRadius, height() / 2 + std::sin(mid) * labelRadius);
+}
+
+QVariantList ChartItem::sliceLabelPositions() const
+{
+    QVariantList positions;
+    positions.reserve(qsizetype(m_sliceEnds.size()));
+    for (int i = 0; i < int(m_sliceEnds.size()); ++i) positions.append(sliceLabelPosition(i));
+    return positions;
+}
+
+qreal ChartItem::sliceFraction(int index) const
+{
+    if (m_series.empty() || index < 0 || size_t(index) >= m_series.front().values.size()) return 0.0;
+    return m_series.front().values[size_t(index)] / totalValue();
+}
+
+QSGNode *ChartItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (m_series.empty() || width() <= 0 || height() <= 0) {
+        delete node;
+        return nullptr;
+    }
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0, 0, QSGGeometry::UnsignedIntType);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGVertexColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+        m_meshDirty = true;
+    }
+    if (!m_meshDirty) return node;
+    m_meshDirty = false;
+
+    Mesh mesh;
+    const Layout l = layout();
+
+    if (m_type == Area) {
+        updateScreenCache();
+        for (const Series &s : m_series) {
+            if (s.screen.empty()) continue;
+            // 稠密（已降采样）时逐像素一个点，样条细分没有意义
+            const bool dense = s.screen.size() * 2 > size_t(width());
+            std::vector<QPointF> path = m_lineStyle == Step ? stepPath(s.screen)
+                                      : (m_lineStyle == Smooth && !dense) ? smoothPath(s.screen)
+                                      : s.screen;
+            mesh.area(path, l.bottom, premultiply(s.color, m_fillOpacity));
+            mesh.polyline(path, m_lineWidth, premultiply(s.color));
+        }
+        // 悬停点：外圈系列色，内圈白色
+        if (m_hoveredIndex >= 0) {
+            for (int si = 0; si < int(m_series.size()); ++si) {
+                if (m_hoveredSeries >= 0 && si != m_hoveredSeries) continue;
+                if (size_t(m_hoveredIndex) >= m_series[size_t(si)].values.size()) continue;
+                const QPointF p = pointPosition(si, m_hoveredIndex);
+                mesh.disc(p, 5, premultiply(m_series[size_t(si)].color));
+                mesh.disc(p, 3, premultiply(Qt::white));
+            }
+        }
+    } else if (m_type == Bar) {
+        const Rgba grid = premultiply(m_gridColor);
+        for (int j = 0; j <= m_gridLines && m_gridLines > 0; ++j) {
+            const qreal y = std::clamp(height() * j / m_gridLines, 0.5, height() - 0.5);
+            mesh.rect(QRectF(0, y - 0.5, width(), 1), grid);
+        }
+        const int count = l.count;
+        const int seriesCount = int(m_series.size());
+        if (count > 0) {
+            // 柱子窄于 2px 时按像素列合并，每列取区间最大值
+            const int columns = std::min(count, std::max(1, int(width() / 2)));
+            const qreal groupTotal = width() / columns;
+            const qreal groupWidth = groupTotal * (1 - m_groupSpacing);
+            const qreal barStep = groupWidth / seriesCount;
+            const qreal barWidth = barStep * (1 - (seriesCount > 1 ? m_barSpacing : 0));
+            const int hoveredColumn = m_hoveredIndex >= 0 ? int(qint64(m_hoveredIndex) * columns / count) : -1;
+            for (int c = 0; c < columns; ++c) {
+                const size_t first = size_t(qint64(c) * count / columns);
+                const size_t last = std::max(first + 1, size_t(qint64(c + 1) * count / columns));
+                const qreal groupX = c * groupTotal + (groupTotal - groupWidth) / 2;
+                for (int si = 0; si < seriesCount; ++si) {
+                    const Samples &values = m_series[size_t(si)].values;
+                    if (first >= values.size()) continue;
+                    float v = values[first];
+                    for (size_t k = first + 1; k < last && k < values.size(); ++k) v = std::max(v, values[k]);
+                    const qreal top = yForValue(v, l);
+                    const qreal h = l.bottom - top;
+                    if (h <= 0) continue;
+                    const qreal x = groupX + si * barStep + (barStep - barWidth) / 2;
+                    const bool hovered = c == hoveredColumn && si == m_hoveredSeries;
+                    const Rgba color = premultiply(m_series[size_t(si)].color, hovered ? 0.8 : 1.0);
+                    // 顶部圆角：两个四分之一圆 + 中间矩形
+                    const qreal r = std::min({ barWidth / 2, 5.0, h });
+                    if (r >= 1) {
+                        mesh.rect(QRectF(x, top + r, barWidth, h - r), color);
+                        mesh.rect(QRectF(x + r, top, barWidth - 2 * r, r), color);
+                        mesh.sector(QPointF(x + r, top + r), 0, r, kPi, 1.5 * kPi, color);
+                        mesh.sector(QPointF(x + barWidth - r, top + r), 0, r, 1.5 * kPi, 2 * kPi, color);
+                    } else {
+                        mesh.rect(QRectF(x, top, barWidth, h), color);
+                    }
+                }
+            }
+        }
+    } else {
+        const Samples &values = m_series.front().values;
+        const std::vector<QColor> &colors = m_series.front().colors;
+        const QPointF center(width() / 2, height() / 2);
+        const qreal maxRadius = std::min(width(), height()) / 2 - m_outerMargin;
+        const Rgba separator = premultiply(m_separatorColor);
+        double start = 0;
+        for (size_t i = 0; i < m_sliceEnds.size(); ++i) {
+            const double end = m_sliceEnds[i];
+            const qreal r = maxRadius + (i < m_sliceOffsets.size() ? m_sliceOffsets[i] : 0.0f);
+            const QColor color = i < colors.size() && colors[i].isValid() ? colors[i] : QColor(Qt::gray);
+            if (values[i] > 0) mesh.sector(center, m_innerRadius, r, start - kPi / 2, end - kPi / 2, premultiply(color));
+            start = end;
+        }
+        // 扇区间隔线
+        if (separator.a > 0 && m_sliceEnds.size() > 1) {
+            start = 0;
+            for (size_t i = 0; i < m_sliceEnds.size(); ++i) {
+                const qreal r = maxRadius + (i < m_sliceOffsets.size() ? m_sliceOffsets[i] : 0.0f);
+                const QPointF dir(std::cos(start - kPi / 2), std::sin(start - kPi / 2));
+                mesh.polyline({ center + dir * m_innerRadius, center + dir * (r + 1) }, 2.0, separator);
+                start = m_sliceEnds[i];
+            }
+        }
+    }
+
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(int(mesh.vertices.size()), int(mesh.indices.size()));
+    if (!mesh.vertices.empty()) {
+        std::memcpy(geometry->vertexDataAsColoredPoint2D(), mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+        std::memcpy(geometry->indexDataAsUInt(), mesh.indices.data(), mesh.indices.size() * sizeof(quint32));
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
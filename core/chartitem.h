@@ -0,0 +1,239 @@
+// core/chartitem.h
+#ifndef CORE_CHARTITEM_H
+#define CORE_CHARTITEM_H
+
+// 图表绘制后端：EAreaChart / EBarChart / EPieChart 共用，替代 Canvas + JS onPaint
+// 数据以紧凑 float 数组保存；面积图超过像素宽度时做 LTTB 降采样，柱状图按像素列取最值合并
+// LTTB 在数据坐标中按固定 x 宽度分桶，追加/淘汰只重算首尾几个桶；纵向缩放不影响选点，只重做屏幕变换
+// 降采样后的屏幕坐标按系列缓存，悬停/配色变化只重新三角化缓存点，整张图为一个顶点着色几何节点
+// 实时数据可绑定 ChartSeries（sources），每帧只读取新追加的点；面积图按其 x 值定位，柱状图/饼图按下标
+#include <QQuickItem>
+#include <QColor>
+#include <QList>
+#include <QPointF>
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <deque>
+#include <vector>
+
+class ChartSeries;
+
+class ChartItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(ChartType type READ type WRITE setType NOTIFY typeChanged)
+    // [{ name, color, data: [{ value, color? , ... }] }]，与各图表组件的 dataSeries 格式一致
+    Q_PROPERTY(QVariantList series READ series WRITE setSeries NOTIFY seriesChanged)
+    // 非空时取代 series：直接读取 ChartSeries 的环形缓冲与增量极值
+    Q_PROPERTY(QList<ChartSeries *> sources READ sources WRITE setSources NOTIFY sourcesChanged)
+    Q_PROPERTY(LineStyle lineStyle READ lineStyle WRITE setLineStyle NOTIFY styleChanged)
+    Q_PROPERTY(int hoveredSeries READ hoveredSeries WRITE setHoveredSeries NOTIFY hoverChanged)
+    Q_PROPERTY(int hoveredIndex READ hoveredIndex WRITE setHoveredIndex NOTIFY hoverChanged)
+    Q_PROPERTY(qreal maxValue READ maxValue NOTIFY dataChanged)
+    Q_PROPERTY(qreal totalValue READ totalValue NOTIFY dataChanged)
+    Q_PROPERTY(int pointCount READ pointCount NOTIFY dataChanged)
+    Q_PROPERTY(int seriesCount READ seriesCount NOTIFY dataChanged)
+    // 面积图
+    Q_PROPERTY(qreal verticalPadding READ verticalPadding WRITE setVerticalPadding NOTIFY styleChanged)
+    Q_PROPERTY(qreal lineWidth READ lineWidth WRITE setLineWidth NOTIFY styleChanged)
+    Q_PROPERTY(qreal fillOpacity READ fillOpacity WRITE setFillOpacity NOTIFY styleChanged)
+    // 柱状图
+    Q_PROPERTY(qreal barSpacing READ barSpacing WRITE setBarSpacing NOTIFY styleChanged)
+    Q_PROPERTY(qreal groupSpacing READ groupSpacing WRITE setGroupSpacing NOTIFY styleChanged)
+    Q_PROPERTY(QColor gridColor READ gridColor WRITE setGridColor NOTIFY styleChanged)
+    Q_PROPERTY(int gridLines READ gridLines WRITE setGridLines NOTIFY styleChanged)
+    // 饼图
+    Q_PROPERTY(qreal innerRadius READ innerRadius WRITE setInnerRadius NOTIFY styleChanged)
+    Q_PROPERTY(qreal outerMargin READ outerMargin WRITE setOuterMargin NOTIFY styleChanged)
+    Q_PROPERTY(QColor separatorColor READ separatorColor WRITE setSeparatorColor NOTIFY styleChanged)
+    // 各扇区标签位置，随数据、尺寸与悬停外扩动画更新
+    Q_PROPERTY(QVariantList sliceLabelPositions READ sliceLabelPositions NOTIFY slicesChanged)
+
+public:
+    enum ChartType { Area, Bar, Pie };
+    Q_ENUM(ChartType)
+    // 与 EAreaChart.LineStyle 取值一致
+    enum LineStyle { Smooth, Linear, Step };
+    Q_ENUM(LineStyle)
+
+    explicit ChartItem(QQuickItem *parent = nullptr);
+
+    ChartType type() const { return m_type; }
+    void setType(ChartType type);
+    QVariantList series() const { return m_seriesVariant; }
+    void setSeries(const QVariantList &series);
+    QList<ChartSeries *> sources() const { return m_sources; }
+    void setSources(const QList<ChartSeries *> &sources);
+    LineStyle lineStyle() const { return m_lineStyle; }
+    void setLineStyle(LineStyle style);
+    int hoveredSeries() const { return m_hoveredSeries; }
+    void setHoveredSeries(int series);
+    int hoveredIndex() const { return m_hoveredIndex; }
+    void setHoveredIndex(int index);
+
+    qreal maxValue() const;
+    qreal totalValue() const;
+    int pointCount() const { return m_series.empty() ? 0 : int(m_series.front().values.size()); }
+    int seriesCount() const { return int(m_series.size()); }
+
+    qreal verticalPadding() const { return m_verticalPadding; }
+    void setVerticalPadding(qreal padding);
+    qreal lineWidth() const { return m_lineWidth; }
+    void setLineWidth(qreal width);
+    qreal fillOpacity() const { return m_fillOpacity; }
+    void setFillOpacity(qreal opacity);
+    qreal barSpacing() const { return m_barSpacing; }
+    void setBarSpacing(qreal spacing);
+    qreal groupSpacing() const { return m_groupSpacing; }
+    void setGroupSpacing(qreal spacing);
+    QColor gridColor() const { return m_gridColor; }
+    void setGridColor(const QColor &color);
+    int gridLines() const { return m_gridLines; }
+    void setGridLines(int lines);
+    qreal innerRadius() const { return m_innerRadius; }
+    void setInnerRadius(qreal radius);
+    qreal outerMargin() const { return m_outerMargin; }
+    void setOuterMargin(qreal margin);
+    QColor separatorColor() const { return m_separatorColor; }
+    void setSeparatorColor(const QColor &color);
+    QVariantList sliceLabelPositions() const;
+
+    // 命中测试：面积图按第一个系列的 x 二分查找最近的数据点，饼图按累计角度二分查找扇区
+    Q_INVOKABLE int indexAt(qreal x) const;
+    // 柱状图：返回 { series, index }，未命中时均为 -1
+    Q_INVOKABLE QVariantMap barAt(qreal x, qreal y) const;
+    Q_INVOKABLE int sliceAt(qreal x, qreal y) const;
+    // 数据点（面积图）或柱顶中点（柱状图）在本项坐标系中的位置
+    Q_INVOKABLE QPointF pointPosition(int series, int index) const;
+    // 扇区中线上的标签位置：饼图取 0.7 倍半径，环形图取内外半径中点
+    Q_INVOKABLE QPointF sliceLabelPosition(int index) const;
+    Q_INVOKABLE qreal sliceFraction(int index) const;
+    // 悬停扇区外扩量由 QML 动画驱动
+    Q_INVOKABLE void setSliceOffset(int index, qreal offset);
+
+    // 追加数据：只扩展紧凑数组并增量维护最大值/总和，不重新解析 series
+    Q_INVOKABLE void appendValue(int series, qreal value);
+    void appendValues(int series, const float *values, qsizetype count);
+
+signals:
+    void typeChanged();
+    void seriesChanged();
+    void sourcesChanged();
+    void styleChanged();
+    void hoverChanged();
+    void dataChanged();
+    void slicesChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    // 只在尾部追加、头部淘汰的紧凑数组：淘汰只移动起点，空洞超过一半时才整体搬移，均摊 O(1)
+    class Samples
+    {
+    public:
+        size_t size() const { return m_data.size() - m_first; }
+        bool empty() const { return size() == 0; }
+        float operator[](size_t i) const { return m_data[m_first + i]; }
+        const float *begin() const { return m_data.data() + m_first; }
+        const float *end() const { return m_data.data() + m_data.size(); }
+        // 已淘汰的总点数：offset() + i 为第 i 个点的绝对序号
+        quint64 offset() const { return m_dropped; }
+
+        void clear();
+        void reserve(size_t n) { m_data.reserve(n); }
+        void push_back(float v) { m_data.push_back(v); }
+        void append(const float *values, size_t count) { m_data.insert(m_data.end(), values, values + count); }
+        float *grow(size_t count);
+        void dropFront(size_t count);
+
+    private:
+        std::vector<float> m_data;
+        size_t m_first = 0;
+        quint64 m_dropped = 0;
+    };
+
+    // 数据坐标中的一个 LTTB 桶：[begin, end) 为绝对序号，pick 为桶内选中的点
+    struct Bucket
+    {
+        qint64 key;
+        quint64 begin;
+        quint64 end;
+        double sumX;
+        double sumY;
+        quint64 pick;
+    };
+
+    struct Decimation
+    {
+        std::deque<Bucket> buckets;
+        double width = 0;           // 桶的 x 宽度
+        size_t threshold = 0;
+        quint64 processed = 0;      // 已分桶的点（绝对序号上界）
+    };
+
+    struct Series
+    {
+        QString name;
+        QColor color;
+        Samples values;
+        Samples xs;                         // 为空时 x 取下标（静态 series）
+        std::vector<QColor> colors;         // 饼图逐项颜色
+        quint64 sequence = 0;               // 已同步到的 ChartSeries::sequence()
+        mutable Decimation decimation;      // 面积图降采样状态
+        mutable std::vector<QPointF> screen; // 降采样后的屏幕坐标缓存（面积图）
+
+        qreal xAt(size_t i) const { return xs.empty() ? qreal(i) : qreal(xs[i]); }
+    };
+
+    struct Layout
+    {
+        qreal top = 0;
+        qreal bottom = 0;
+        qreal maxValue = 1;
+        qreal minX = 0;
+        qreal maxX = 0;
+        int count = 0;
+    };
+
+    Layout layout() const;
+    qreal xForValue(qreal x, const Layout &l) const;
+    qreal yForValue(qreal value, const Layout &l) const;
+    void invalidateData();
+    void invalidateMesh();
+    void updateScreenCache() const;
+    void updateDecimation(const Series &s, size_t threshold) const;
+    void rebuildSliceAngles();
+    void syncSources();
+
+    ChartType m_type = Area;
+    QVariantList m_seriesVariant;
+    QList<ChartSeries *> m_sources;
+    std::vector<Series> m_series;
+    float m_maxValue = 0.0f;
+    double m_totalValue = 0.0;
+    LineStyle m_lineStyle = Smooth;
+    int m_hoveredSeries = -1;
+    int m_hoveredIndex = -1;
+
+    qreal m_verticalPadding = 8.0;
+    qreal m_lineWidth = 2.0;
+    qreal m_fillOpacity = 0.3;
+    qreal m_barSpacing = 0.2;
+    qreal m_groupSpacing = 0.3;
+    QColor m_gridColor = QColor(255, 255, 255, 25);
+    int m_gridLines = 5;
+    qreal m_innerRadius = 0.0;
+    qreal m_outerMargin = 20.0;
+    QColor m_separatorColor = QColor(Qt::transparent);
+
+    std::vector<double> m_sliceEnds;        // 饼图累计角度（弧度，从 12 点顺时针）
+    std::vector<float> m_sliceOffsets;
+    mutable bool m_cacheDirty = true;
+    bool m_meshDirty = true;
+};
+
+#endif // CORE_CHARTITEM_H
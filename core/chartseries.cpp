@@ -0,0 +1,184 @@
+// 实现文件：ChartSeries —— 环形缓冲 + 单调队列极值 + 按帧合并通知
+#include "core/chartseries.h"
+
+#include <QTimer>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const int kFrameIntervalMs = 16;
+
+} // namespace
+
+ChartSeries::ChartSeries(QObject *parent)
+    : QObject(parent)
+    , m_notifyTimer(new QTimer(this))
+{
+    m_x.resize(size_t(m_capacity));
+    m_y.resize(size_t(m_capacity));
+    // 高频推送（20–60 Hz 甚至更高）时，同一帧内的追加只通知一次
+    m_notifyTimer->setSingleShot(true);
+    m_notifyTimer->setTimerType(Qt::PreciseTimer);
+    m_notifyTimer->setInterval(kFrameIntervalMs);
+    connect(m_notifyTimer, &QTimer::timeout, this, &ChartSeries::changed);
+}
+
+void ChartSeries::setName(const QString &name)
+{
+    if (m_name == name) return;
+    m_name = name;
+    emit nameChanged();
+}
+
+void ChartSeries::setColor(const QColor &color)
+{
+    if (m_color == color) return;
+    m_color = color;
+    emit colorChanged();
+}
+
+void ChartSeries::setCapacity(int capacity)
+{
+    capacity = std::max(1, capacity);
+    if (m_capacity == capacity) return;
+
+    // 按时间顺序取出最新的点后重新写入，极值队列随之重建
+    std::vector<float> xs(size_t(m_count));
+    std::vector<float> ys(size_t(m_count));
+    copyPoints(0, m_count, ys.data(), xs.data());
+    const size_t keep = std::min(size_t(m_count), size_t(capacity));
+    const size_t skip = size_t(m_count) - keep;
+    const float nextX = m_nextX;
+
+    m_capacity = capacity;
+    m_x.assign(size_t(capacity), 0.0f);
+    m_y.assign(size_t(capacity), 0.0f);
+    m_head = 0;
+    m_count = 0;
+    m_minQueue.clear();
+    m_maxQueue.clear();
+    for (size_t i = skip; i < xs.size(); ++i) push(xs[i], ys[i]);
+    m_nextX = nextX;
+
+    emit capacityChanged();
+    scheduleChanged();
+}
+
+qreal ChartSeries::xAt(int index) const
+{
+    if (index < 0 || index >= m_count) return 0.0;
+    return m_x[size_t((m_head - m_count + index + m_capacity) % m_capacity)];
+}
+
+qreal ChartSeries::yAt(int index) const
+{
+    if (index < 0 || index >= m_count) return 0.0;
+    return m_y[size_t((m_head - m_count + index + m_capacity) % m_capacity)];
+}
+
+void ChartSeries::push(float x, float y)
+{
+    // 覆盖最旧点前先把它移出极值队列
+    if (m_count == m_capacity) {
+        const quint64 oldest = m_seq - quint64(m_count);
+        if (!m_minQueue.empty() && m_minQueue.front().seq == oldest) m_minQueue.pop_front();
+        if (!m_maxQueue.empty() && m_maxQueue.front().seq == oldest) m_maxQueue.pop_front();
+    } else {
+        ++m_count;
+    }
+    m_x[size_t(m_head)] = x;
+    m_y[size_t(m_head)] = y;
+    m_head = (m_head + 1) % m_capacity;
+
+    // 单调队列：新点会淘汰所有不可能再成为极值的旧点
+    while (!m_minQueue.empty() && m_minQueue.back().value >= y) m_minQueue.pop_back();
+    m_minQueue.push_back(Extremum { m_seq, y });
+    while (!m_maxQueue.empty() && m_maxQueue.back().value <= y) m_maxQueue.pop_back();
+    m_maxQueue.push_back(Extremum { m_seq, y });
+
+    ++m_seq;
+    m_nextX = x + 1.0f;
+}
+
+void ChartSeries::append(qreal x, qreal y)
+{
+    push(float(x), float(y));
+    scheduleChanged();
+}
+
+void ChartSeries::appendBatch(const float *ys, qsizetype count, const float *xs)
+{
+    if (!ys || count <= 0) return;
+    // 只有最后 capacity 个点会留下，前面的直接跳过
+    const qsizetype skip = std::max<qsizetype>(0, count - m_capacity);
+    if (skip > 0 && !xs) m_nextX += float(skip);
+    for (qsizetype i = skip; i < count; ++i) push(xs ? xs[i] : m_nextX, ys[i]);
+    scheduleChanged();
+}
+
+void ChartSeries::appendBatch(const QJSValue &values, bool interleaved)
+{
+    std::vector<float> data;
+    // Float32Array：直接读取底层 ArrayBuffer，避免逐元素经过 JS 值转换
+    const QVariant buffer = values.property(QStringLiteral("buffer")).toVariant();
+    if (buffer.typeId() == QMetaType::QByteArray
+        && values.property(QStringLiteral("BYTES_PER_ELEMENT")).toInt() == int(sizeof(float))
+        && values.property(QStringLiteral("constructor")).property(QStringLiteral("name")).toString() == QLatin1String("Float32Array")) {
+        const QByteArray bytes = buffer.toByteArray();
+        const qsizetype offset = values.property(QStringLiteral("byteOffset")).toInt();
+        const qsizetype length = values.property(QStringLiteral("length")).toInt();
+        if (offset < 0 || length < 0 || offset + length * qsizetype(sizeof(float)) > bytes.size()) return;
+        data.resize(size_t(length));
+        if (length > 0) std::memcpy(data.data(), bytes.constData() + offset, size_t(length) * sizeof(float));
+    } else if (values.isArray()) {
+        const int length = values.property(QStringLiteral("length")).toInt();
+        data.reserve(size_t(std::max(0, length)));
+        for (int i = 0; i < length; ++i) data.push_back(float(values.property(quint32(i)).toNumber()));
+    } else {
+        return;
+    }
+
+    if (!interleaved) {
+        appendBatch(data.data(), qsizetype(data.size()));
+        return;
+    }
+    const size_t pairs = data.size() / 2;
+    std::vector<float> xs(pairs), ys(pairs);
+    for (size_t i = 0; i < pairs; ++i) {
+        xs[i] = data[i * 2];
+        ys[i] = data[i * 2 + 1];
+    }
+    appendBatch(ys.data(), qsizetype(pairs), xs.data());
+}
+
+void ChartSeries::clear()
+{
+    if (m_count == 0) return;
+    m_head = 0;
+    m_count = 0;
+    m_minQueue.clear();
+    m_maxQueue.clear();
+    scheduleChanged();
+}
+
+void ChartSeries::copyPoints(int from, int count, float *ys, float *xs) const
+{
+    from = std::clamp(from, 0, m_count);
+    count = std::clamp(count, 0, m_count - from);
+    if (count == 0) return;
+    const int start = (m_head - m_count + from + m_capacity) % m_capacity;
+    const int first = std::min(count, m_capacity - start);
+    std::memcpy(ys, m_y.data() + start, size_t(first) * sizeof(float));
+    if (first < count) std::memcpy(ys + first, m_y.data(), size_t(count - first) * sizeof(float));
+    if (!xs) return;
+    std::memcpy(xs, m_x.data() + start, size_t(first) * sizeof(float));
+    if (first < count) std::memcpy(xs + first, m_x.data(), size_t(count - first) * sizeof(float));
+}
+
+void ChartSeries::scheduleChanged()
+{
+    ++m_revision;
+    if (!m_notifyTimer->isActive()) m_notifyTimer->start();
+}
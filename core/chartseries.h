@@ -0,0 +1,93 @@
+// core/chartseries.h
+#ifndef CORE_CHARTSERIES_H
+#define CORE_CHARTSERIES_H
+
+// 实时图表数据源：固定容量环形缓冲保存 (x, y)，写满后覆盖最旧的点
+// 最小/最大值用单调队列增量维护（含被覆盖点的淘汰），追加为均摊 O(1)
+// 同一帧内的多次追加合并为一次 changed 通知，ChartItem 据此每帧最多同步一次
+#include <QObject>
+#include <QColor>
+#include <QJSValue>
+#include <QString>
+
+#include <deque>
+#include <vector>
+
+class QTimer;
+
+class ChartSeries : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    // 修改容量会保留最新的 min(count, capacity) 个点
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(int count READ count NOTIFY changed)
+    Q_PROPERTY(qreal minValue READ minValue NOTIFY changed)
+    Q_PROPERTY(qreal maxValue READ maxValue NOTIFY changed)
+    // 每次追加/清空递增，供绑定判断数据是否变化
+    Q_PROPERTY(quint64 revision READ revision NOTIFY changed)
+
+public:
+    explicit ChartSeries(QObject *parent = nullptr);
+
+    QString name() const { return m_name; }
+    void setName(const QString &name);
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color);
+    int capacity() const { return m_capacity; }
+    void setCapacity(int capacity);
+    int count() const { return m_count; }
+    qreal minValue() const { return m_count ? m_minQueue.front().value : 0.0; }
+    qreal maxValue() const { return m_count ? m_maxQueue.front().value : 0.0; }
+    quint64 revision() const { return m_revision; }
+    // 已写入的总点数（含已被覆盖的点），ChartItem 据此只读取新追加的部分
+    quint64 sequence() const { return m_seq; }
+
+    // 按从旧到新的逻辑下标访问
+    Q_INVOKABLE qreal xAt(int index) const;
+    Q_INVOKABLE qreal yAt(int index) const;
+
+    // x 应单调不减（如时间戳），面积图按 x 定位各点
+    Q_INVOKABLE void append(qreal x, qreal y);
+    // 接受 Float32Array / 数组：只含 y 时 x 依次递增；interleaved 为真时按 x0,y0,x1,y1… 解析
+    Q_INVOKABLE void appendBatch(const QJSValue &values, bool interleaved = false);
+    Q_INVOKABLE void clear();
+
+    // C++ 端批量追加；xs 为空时 x 依次递增
+    void appendBatch(const float *ys, qsizetype count, const float *xs = nullptr);
+    // 从逻辑下标 from 起按从旧到新的顺序复制 count 个点（每个数组最多两段 memcpy），xs 可为空
+    void copyPoints(int from, int count, float *ys, float *xs = nullptr) const;
+
+signals:
+    void nameChanged();
+    void colorChanged();
+    void capacityChanged();
+    void changed();
+
+private:
+    struct Extremum
+    {
+        quint64 seq;
+        float value;
+    };
+
+    void push(float x, float y);
+    void scheduleChanged();
+
+    QString m_name;
+    QColor m_color;
+    int m_capacity = 1024;
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    int m_head = 0;             // 下一个写入位置
+    int m_count = 0;
+    quint64 m_seq = 0;          // 已写入的总点数，m_seq - m_count 为最旧点的序号
+    float m_nextX = 0.0f;
+    std::deque<Extremum> m_minQueue;
+    std::deque<Extremum> m_maxQueue;
+    quint64 m_revision = 0;
+    QTimer *m_notifyTimer;
+};
+
+#endif // CORE_CHARTSERIES_H
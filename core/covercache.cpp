@@ -0,0 +1,136 @@
+// 实现文件：CoverCache —— 内容哈希落盘 + 分档缩略图 + 内存 LRU
+#include "core/covercache.h"
+#include "core/trace.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <iterator>
+
+namespace {
+
+const int kBuckets[] = { 64, 128, 256, 512, 1024 };
+
+QString sha1Hex(const QByteArray &data)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+}
+
+bool writeAtomically(const QString &path, const QByteArray &data)
+{
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly)) return false;
+    out.write(data);
+    return out.commit();
+}
+
+} // namespace
+
+CoverCache &CoverCache::instance()
+{
+    static CoverCache cache;
+    return cache;
+}
+
+CoverCache::CoverCache()
+    : m_dir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/covers")
+{
+    QDir().mkpath(m_dir);
+    m_memory.setMaxCost(MEMORY_BUDGET_KB);
+}
+
+QString CoverCache::store(const QByteArray &encoded)
+{
+    if (encoded.isEmpty()) return QString();
+    TRACE_SCOPE("cover.store");
+    const QString hash = sha1Hex(encoded);
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_stored.contains(hash)) return hash;
+    }
+    const QString path = originalPath(hash);
+    if (!QFile::exists(path) && !writeAtomically(path, encoded)) return QString();
+    QMutexLocker lock(&m_mutex);
+    m_stored.insert(hash);
+    return hash;
+}
+
+bool CoverCache::contains(const QString &hash)
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_stored.contains(hash)) return true;
+    }
+    return QFile::exists(originalPath(hash));
+}
+
+QImage CoverCache::image(const QString &hash, int size)
+{
+    if (hash.isEmpty()) return QImage();
+    const int bucket = bucketFor(size);
+    const QString key = hash + QLatin1Char('/') + QString::number(bucket);
+    {
+        QMutexLocker lock(&m_mutex);
+        if (const QImage *cached = m_memory.object(key)) return *cached;
+    }
+
+    QImage img;
+    const QString thumbPath = thumbnailPath(hash, bucket);
+    if (QFile::exists(thumbPath)) img.load(thumbPath);
+
+    if (img.isNull()) {
+        QImageReader reader(originalPath(hash));
+        reader.setAutoTransform(true);
+        const QSize original = reader.size();
+        const bool downscale = original.isValid() && (original.width() > bucket || original.height() > bucket);
+        // JPEG 等格式可在解码阶段直接缩小，避免先解出整幅大图
+        if (downscale) reader.setScaledSize(original.scaled(bucket, bucket, Qt::KeepAspectRatio));
+        img = reader.read();
+        if (img.isNull()) return QImage();
+        if (img.width() > bucket || img.height() > bucket) {
+            img = img.scaled(bucket, bucket, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+        // 只有比原图小的档位才值得落盘
+        if (downscale) {
+            QSaveFile out(thumbPath);
+            const char *format = img.hasAlphaChannel() ? "PNG" : "JPG";
+            if (out.open(QIODevice::WriteOnly) && img.save(&out, format, 90)) out.commit();
+        }
+    }
+
+    QMutexLocker lock(&m_mutex);
+    m_memory.insert(key, new QImage(img), qMax<qsizetype>(1, img.sizeInBytes() / 1024));
+    return img;
+}
+
+int CoverCache::bucketFor(int size)
+{
+    if (size <= 0) return 512;
+    for (int bucket : kBuckets) {
+        if (size <= bucket) return bucket;
+    }
+    return kBuckets[std::size(kBuckets) - 1];
+}
+
+QString CoverCache::urlFor(const QString &hash, int size)
+{
+    if (hash.isEmpty()) return QString();
+    QString url = QStringLiteral("image://cover/") + hash;
+    if (size > 0) url += QLatin1Char('/') + QString::number(size);
+    return url;
+}
+
+QString CoverCache::originalPath(const QString &hash) const
+{
+    return m_dir + QLatin1Char('/') + hash;
+}
+
+QString CoverCache::thumbnailPath(const QString &hash, int bucket) const
+{
+    return m_dir + QLatin1Char('/') + hash + QLatin1Char('_') + QString::number(bucket);
+}
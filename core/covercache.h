@@ -0,0 +1,42 @@
+// core/covercache.h
+#ifndef CORE_COVERCACHE_H
+#define CORE_COVERCACHE_H
+
+// 封面缓存：按内容哈希去重（同专辑多首曲目只存一份），原图字节原样落盘不重新编码
+// 缩略图按固定档位生成并落盘，解码结果放入按字节计费的内存 LRU；可在任意线程调用
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QCache>
+#include <QMutex>
+#include <QSet>
+
+class CoverCache
+{
+public:
+    static CoverCache &instance();
+
+    // 保存标签内嵌的原始封面字节，返回内容哈希；已存在时不再写盘
+    QString store(const QByteArray &encoded);
+    bool contains(const QString &hash);
+
+    // 不大于 size 档位的缩略图：内存 LRU -> 磁盘缩略图 -> 原图缩放解码并落盘
+    QImage image(const QString &hash, int size);
+
+    static int bucketFor(int size);
+    // QML 使用的地址：image://cover/<hash>[/<size>]
+    static QString urlFor(const QString &hash, int size = 0);
+
+private:
+    CoverCache();
+    QString originalPath(const QString &hash) const;
+    QString thumbnailPath(const QString &hash, int bucket) const;
+
+    QString m_dir;
+    QMutex m_mutex;                     // 保护以下字段
+    QCache<QString, QImage> m_memory;   // 代价单位为 KB
+    QSet<QString> m_stored;
+    static const int MEMORY_BUDGET_KB = 48 * 1024;
+};
+
+#endif // CORE_COVERCACHE_H
@@ -0,0 +1,64 @@
+// 实现文件：CoverImageProvider —— 线程池中解码封面缩略图
+#include "core/coverimageprovider.h"
+#include "core/covercache.h"
+
+#include <QImage>
+#include <QRunnable>
+
+namespace {
+
+class CoverImageResponse : public QQuickImageResponse, public QRunnable
+{
+public:
+    CoverImageResponse(const QString &id, const QSize &requestedSize)
+        : m_id(id)
+        , m_requestedSize(requestedSize)
+    {
+        // 由引擎在 finished 之后负责释放
+        setAutoDelete(false);
+    }
+
+    QQuickTextureFactory *textureFactory() const override
+    {
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+    QString errorString() const override
+    {
+        return m_image.isNull() ? QStringLiteral("cover not found: ") + m_id : QString();
+    }
+
+    void run() override
+    {
+        const QString hash = m_id.section(QLatin1Char('/'), 0, 0);
+        int size = m_id.section(QLatin1Char('/'), 1, 1).toInt();
+        if (size <= 0) size = qMax(m_requestedSize.width(), m_requestedSize.height());
+        m_image = CoverCache::instance().image(hash, size);
+        emit finished();
+    }
+
+private:
+    QString m_id;
+    QSize m_requestedSize;
+    QImage m_image;
+};
+
+} // namespace
+
+CoverImageProvider::CoverImageProvider()
+{
+    // 磁盘读取 + 解码，少量线程即可
+    m_pool.setMaxThreadCount(2);
+}
+
+CoverImageProvider::~CoverImageProvider()
+{
+    m_pool.waitForDone();
+}
+
+QQuickImageResponse *CoverImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    auto *response = new CoverImageResponse(id, requestedSize);
+    m_pool.start(response);
+    return response;
+}
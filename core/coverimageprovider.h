@@ -0,0 +1,22 @@
+// core/coverimageprovider.h
+#ifndef CORE_COVERIMAGEPROVIDER_H
+#define CORE_COVERIMAGEPROVIDER_H
+
+// image://cover/<hash>[/<size>] 异步图像提供器：在独立线程池中从 CoverCache 取图
+// 未指定 size 时按 Image.sourceSize 选择缩略图档位
+#include <QQuickAsyncImageProvider>
+#include <QThreadPool>
+
+class CoverImageProvider : public QQuickAsyncImageProvider
+{
+public:
+    CoverImageProvider();
+    ~CoverImageProvider() override;
+
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+
+private:
+    QThreadPool m_pool;
+};
+
+#endif // CORE_COVERIMAGEPROVIDER_H
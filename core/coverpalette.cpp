@@ -0,0 +1,355 @@
+// 实现文件：CoverPalette —— 15 位直方图 + 中位切分调色板
+#include "core/coverpalette.h"
+#include "core/covercache.h"
+#include "core/metadataindex.h"
+
+#include <QHash>
+#include <QImageReader>
+#include <QUrl>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const int kSide = 32;                   // 每通道 5 位
+const int kMaxBoxes = 12;
+
+inline int cellIndex(int r, int g, int b)
+{
+    return (r << 10) | (g << 5) | b;
+}
+
+struct Box
+{
+    int lo[3] = { 0, 0, 0 };
+    int hi[3] = { kSide - 1, kSide - 1, kSide - 1 };
+    quint32 count = 0;
+
+    int volume() const { return (hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1); }
+};
+
+template <typename Fn>
+void forEachCell(const Box &box, Fn fn)
+{
+    for (int r = box.lo[0]; r <= box.hi[0]; ++r) {
+        for (int g = box.lo[1]; g <= box.hi[1]; ++g) {
+            for (int b = box.lo[2]; b <= box.hi[2]; ++b) fn(r, g, b);
+        }
+    }
+}
+
+// 收缩到实际有像素的范围并统计像素数
+void shrink(Box &box, const std::vector<quint32> &hist)
+{
+    int lo[3] = { kSide, kSide, kSide };
+    int hi[3] = { -1, -1, -1 };
+    quint32 count = 0;
+    forEachCell(box, [&](int r, int g, int b) {
+        const quint32 n = hist[cellIndex(r, g, b)];
+        if (!n) return;
+        const int c[3] = { r, g, b };
+        for (int i = 0; i < 3; ++i) {
+            lo[i] = std::min(lo[i], c[i]);
+            hi[i] = std::max(hi[i], c[i]);
+        }
+        count += n;
+    });
+    box.count = count;
+    if (!count) return;
+    std::copy(lo, lo + 3, box.lo);
+    std::copy(hi, hi + 3, box.hi);
+}
+
+// 沿最长轴在像素数中位处切开
+bool split(const Box &box, const std::vector<quint32> &hist, Box *first, Box *second)
+{
+    int axis = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (box.hi[i] - box.lo[i] > box.hi[axis] - box.lo[axis]) axis = i;
+    }
+    if (box.hi[axis] == box.lo[axis]) return false;
+
+    std::array<quint32, kSide> planes {};
+    forEachCell(box, [&](int r, int g, int b) {
+        const int c[3] = { r, g, b };
+        planes[c[axis]] += hist[cellIndex(r, g, b)];
+    });
+    quint32 sum = 0;
+    int cut = box.lo[axis];
+    for (; cut < box.hi[axis] - 1; ++cut) {
+        sum += planes[cut];
+        if (sum * 2 >= box.count) break;
+    }
+
+    *first = box;
+    *second = box;
+    first->hi[axis] = cut;
+    second->lo[axis] = cut + 1;
+    shrink(*first, hist);
+    shrink(*second, hist);
+    return first->count && second->count;
+}
+
+QColor average(const Box &box, const std::vector<quint32> &hist)
+{
+    quint64 sum[3] = { 0, 0, 0 };
+    forEachCell(box, [&](int r, int g, int b) {
+        const quint64 n = hist[cellIndex(r, g, b)];
+        // 取格子中心值
+        sum[0] += n * quint64((r << 3) | 4);
+        sum[1] += n * quint64((g << 3) | 4);
+        sum[2] += n * quint64((b << 3) | 4);
+    });
+    return QColor(int(sum[0] / box.count), int(sum[1] / box.count), int(sum[2] / box.count));
+}
+
+// 与原 Canvas 取色一致：亮度限定在 0.35~0.75，有色彩倾向时饱和度至少 0.3
+QColor toAccent(const QColor &color)
+{
+    float h, s, l;
+    color.getHslF(&h, &s, &l);
+    if (s > 0.1f) s = std::max(s, 0.3f);
+    l = std::clamp(l, 0.35f, 0.75f);
+    return QColor::fromHslF(std::max(h, 0.0f), s, l);
+}
+
+QString localPath(const QString &source)
+{
+    if (source.startsWith(QLatin1String("file:"))) return QUrl(source).toLocalFile();
+    if (source.startsWith(QLatin1String("qrc:"))) return source.mid(3);
+    return source;
+}
+
+// 调色板只在 GUI 线程读写
+QHash<QString, CoverPalette::Swatches> &memoryCache()
+{
+    static QHash<QString, CoverPalette::Swatches> cache;
+    return cache;
+}
+
+QString indexKey(const QString &hash)
+{
+    return QStringLiteral("palette:") + hash;
+}
+
+} // namespace
+
+CoverPalette::CoverPalette(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+CoverPalette::~CoverPalette()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void CoverPalette::setSource(const QString &source)
+{
+    if (m_source == source) return;
+    m_source = source;
+    emit sourceChanged();
+
+    const quint64 generation = ++m_generation;
+    if (source.isEmpty()) {
+        apply(Swatches());
+        return;
+    }
+    const QString hash = coverHash(source);
+    Swatches cached;
+    if (!hash.isEmpty() && lookupCached(hash, &cached)) {
+        apply(cached);
+        return;
+    }
+
+    // 计算期间保留上一张封面的颜色，避免主题先闪回默认色
+    m_pool.clear();
+    m_pool.start([this, generation, hash, source]() {
+        QImage image;
+        if (!hash.isEmpty()) {
+            image = CoverCache::instance().image(hash, SAMPLE_SIZE);
+        } else {
+            QImageReader reader(localPath(source));
+            const QSize size = reader.size();
+            if (size.isValid()) reader.setScaledSize(size.scaled(SAMPLE_SIZE, SAMPLE_SIZE, Qt::KeepAspectRatio));
+            image = reader.read();
+        }
+        const Swatches swatches = extract(image);
+        QMetaObject::invokeMethod(this, [this, generation, hash, swatches]() {
+            if (generation != m_generation) return;
+            if (!hash.isEmpty() && swatches.isValid()) storeCached(hash, swatches);
+            apply(swatches);
+        }, Qt::QueuedConnection);
+    });
+}
+
+CoverPalette::Swatches CoverPalette::extract(const QImage &source)
+{
+    Swatches out;
+    if (source.isNull()) return out;
+    QImage image = source;
+    if (image.width() > SAMPLE_SIZE || image.height() > SAMPLE_SIZE) {
+        image = image.scaled(SAMPLE_SIZE, SAMPLE_SIZE, Qt::KeepAspectRatio, Qt::FastTransformation);
+    }
+    image = image.convertToFormat(QImage::Format_ARGB32);
+
+    // 直方图：无分支的位运算取 5 位 RGB，alpha 最高位作为权重跳过透明像素
+    std::vector<quint32> hist(kSide * kSide * kSide, 0);
+    for (int y = 0; y < image.height(); ++y) {
+        const quint32 *line = reinterpret_cast<const quint32 *>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const quint32 p = line[x];
+            hist[((p >> 9) & 0x7C00) | ((p >> 6) & 0x03E0) | ((p >> 3) & 0x001F)] += p >> 31;
+        }
+    }
+
+    Box root;
+    shrink(root, hist);
+    if (!root.count) return out;
+
+    // 前 3/4 按像素数切分，其余按像素数 × 体积切分，避免大片单色占满所有名额
+    std::vector<Box> boxes { root };
+    while (int(boxes.size()) < kMaxBoxes) {
+        const bool byVolume = int(boxes.size()) >= kMaxBoxes * 3 / 4;
+        int pick = -1;
+        quint64 best = 0;
+        for (int i = 0; i < int(boxes.size()); ++i) {
+            const Box &box = boxes[i];
+            if (box.volume() <= 1) continue;
+            const quint64 key = byVolume ? quint64(box.count) * quint64(box.volume()) : box.count;
+            if (key > best) {
+                best = key;
+                pick = i;
+            }
+        }
+        if (pick < 0) break;
+        Box first, second;
+        if (!split(boxes[pick], hist, &first, &second)) {
+            // 无法再分：标记为单格，下一轮跳过
+            boxes[pick].hi[0] = boxes[pick].lo[0];
+            boxes[pick].hi[1] = boxes[pick].lo[1];
+            boxes[pick].hi[2] = boxes[pick].lo[2];
+            continue;
+        }
+        boxes[pick] = first;
+        boxes.push_back(second);
+    }
+
+    struct Candidate
+    {
+        QColor color;
+        float population;
+        float hslS, hslL, hsvS, hsvV;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(boxes.size());
+    quint32 maxCount = 0;
+    for (const Box &box : boxes) maxCount = std::max(maxCount, box.count);
+    for (const Box &box : boxes) {
+        Candidate c;
+        c.color = average(box, hist);
+        c.population = float(box.count) / float(maxCount);
+        float h, v;
+        c.color.getHslF(&h, &c.hslS, &c.hslL);
+        c.color.getHsvF(&h, &c.hsvS, &v);
+        c.hsvV = v;
+        candidates.push_back(c);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate &a, const Candidate &b) { return a.population > b.population; });
+
+    out.dominant = candidates.front().color;
+
+    // 强调色沿用原取色的筛选条件：有一定饱和度、不过暗不过亮的最大色块
+    QColor accentBase = out.dominant;
+    for (const Candidate &c : candidates) {
+        if (c.hsvS > 0.15f && c.hsvV > 0.15f && c.hsvV < 0.95f) {
+            accentBase = c.color;
+            break;
+        }
+    }
+    out.accent = toAccent(accentBase);
+
+    float vibrantScore = -1.0f;
+    float mutedScore = -1.0f;
+    for (const Candidate &c : candidates) {
+        const float lightness = 1.0f - std::abs(c.hslL - 0.5f) * 2.0f;
+        if (c.hslS >= 0.35f && c.hslL >= 0.3f && c.hslL <= 0.75f) {
+            const float score = c.hslS * 3.0f + lightness * 2.0f + c.population;
+            if (score > vibrantScore) {
+                vibrantScore = score;
+                out.vibrant = c.color;
+            }
+        }
+        if (c.hslS <= 0.4f && c.hslL >= 0.3f && c.hslL <= 0.7f) {
+            const float score = (1.0f - std::abs(c.hslS - 0.25f)) * 3.0f + lightness * 2.0f + c.population;
+            if (score > mutedScore) {
+                mutedScore = score;
+                out.muted = c.color;
+            }
+        }
+    }
+    if (!out.vibrant.isValid()) out.vibrant = out.accent;
+    if (!out.muted.isValid()) {
+        float h, s, l;
+        out.dominant.getHslF(&h, &s, &l);
+        out.muted = QColor::fromHslF(std::max(h, 0.0f), s * 0.5f, std::clamp(l, 0.3f, 0.7f));
+    }
+    return out;
+}
+
+QString CoverPalette::coverHash(const QString &source)
+{
+    static const QLatin1String prefix("image://cover/");
+    if (!source.startsWith(prefix)) return QString();
+    const QString rest = source.mid(prefix.size());
+    const qsizetype slash = rest.indexOf(QLatin1Char('/'));
+    return slash < 0 ? rest : rest.left(slash);
+}
+
+void CoverPalette::apply(const Swatches &swatches)
+{
+    if (m_swatches.dominant == swatches.dominant && m_swatches.vibrant == swatches.vibrant
+        && m_swatches.muted == swatches.muted && m_swatches.accent == swatches.accent) {
+        return;
+    }
+    m_swatches = swatches;
+    emit paletteChanged();
+}
+
+bool CoverPalette::lookupCached(const QString &hash, Swatches *swatches)
+{
+    QHash<QString, Swatches> &cache = memoryCache();
+    auto it = cache.constFind(hash);
+    if (it != cache.cend()) {
+        *swatches = it.value();
+        return true;
+    }
+    QVariantMap meta;
+    if (!MetadataIndex::instance().lookup(indexKey(hash), FileStamp::content(), &meta)) return false;
+    Swatches stored;
+    stored.dominant = QColor::fromString(meta.value("dominant").toString());
+    stored.vibrant = QColor::fromString(meta.value("vibrant").toString());
+    stored.muted = QColor::fromString(meta.value("muted").toString());
+    stored.accent = QColor::fromString(meta.value("accent").toString());
+    if (!stored.isValid()) return false;
+    cache.insert(hash, stored);
+    *swatches = stored;
+    return true;
+}
+
+void CoverPalette::storeCached(const QString &hash, const Swatches &swatches)
+{
+    memoryCache().insert(hash, swatches);
+    QVariantMap meta;
+    meta.insert("dominant", swatches.dominant.name());
+    meta.insert("vibrant", swatches.vibrant.name());
+    meta.insert("muted", swatches.muted.name());
+    meta.insert("accent", swatches.accent.name());
+    MetadataIndex::instance().insert(indexKey(hash), FileStamp::content(), meta);
+}
@@ -0,0 +1,69 @@
+// core/coverpalette.h
+#ifndef CORE_COVERPALETTE_H
+#define CORE_COVERPALETTE_H
+
+// 封面取色：在工作线程对 64px 缩略图做 15 位 RGB 直方图 + 中位切分，得到主色/鲜艳色/柔和色
+// 结果按封面内容哈希缓存于进程内并写入元数据索引，同一封面再次出现时 GUI 线程只做一次查表
+#include <QObject>
+#include <QString>
+#include <QColor>
+#include <QImage>
+#include <QThreadPool>
+
+class CoverPalette : public QObject
+{
+    Q_OBJECT
+    // image://cover/<hash>[/<size>] 或本地图片路径
+    Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(QColor dominant READ dominant NOTIFY paletteChanged)
+    Q_PROPERTY(QColor vibrant READ vibrant NOTIFY paletteChanged)
+    Q_PROPERTY(QColor muted READ muted NOTIFY paletteChanged)
+    // 主题强调色：高饱和主色按 HSL 限定亮度 0.35~0.75
+    Q_PROPERTY(QColor accent READ accent NOTIFY paletteChanged)
+    Q_PROPERTY(bool ready READ isReady NOTIFY paletteChanged)
+
+public:
+    struct Swatches
+    {
+        QColor dominant;
+        QColor vibrant;
+        QColor muted;
+        QColor accent;
+
+        bool isValid() const { return dominant.isValid(); }
+    };
+
+    explicit CoverPalette(QObject *parent = nullptr);
+    ~CoverPalette() override;
+
+    QString source() const { return m_source; }
+    void setSource(const QString &source);
+
+    QColor dominant() const { return m_swatches.dominant; }
+    QColor vibrant() const { return m_swatches.vibrant; }
+    QColor muted() const { return m_swatches.muted; }
+    QColor accent() const { return m_swatches.accent; }
+    bool isReady() const { return m_swatches.isValid(); }
+
+    // 纯计算，可在任意线程调用
+    static Swatches extract(const QImage &image);
+    // 从 image://cover 地址取出内容哈希，其他地址返回空
+    static QString coverHash(const QString &source);
+
+signals:
+    void sourceChanged();
+    void paletteChanged();
+
+private:
+    void apply(const Swatches &swatches);
+    static bool lookupCached(const QString &hash, Swatches *swatches);
+    static void storeCached(const QString &hash, const Swatches &swatches);
+
+    QString m_source;
+    Swatches m_swatches;
+    quint64 m_generation = 0;       // 丢弃过期的工作线程结果
+    QThreadPool m_pool;
+    static const int SAMPLE_SIZE = 64;
+};
+
+#endif // CORE_COVERPALETTE_H
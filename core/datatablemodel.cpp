@@ -0,0 +1,1026 @@
+// 实现文件：DataTableModel —— 列式存储、后台排序筛选与勾选位图
+#include "core/datatablemodel.h"
+
+#include <QCollator>
+#include <QFontMetricsF>
+#include <QTimer>
+#include <QtAlgorithms>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const int kCancelCheckInterval = 4096;  // 工作线程每处理这么多行检查一次是否已过期
+
+// 整列（忽略缺失值）都能解析为数值时启用数值比较
+void finishColumn(DataTableModel::Column &column)
+{
+    const size_t n = column.text.size();
+    column.number.clear();
+    column.numeric = false;
+    for (size_t i = 0; i < n; ++i) {
+        const QString &text = column.text[i];
+        if (text.isNull()) continue;
+        bool ok = false;
+        const double value = text.toDouble(&ok);
+        if (!ok) {
+            column.number.clear();
+            return;
+        }
+        // 遇到第一个数值才分配：文本列通常在首个非空值处就退出，增量更新时重新判定代价很小
+        if (column.number.empty()) column.number.assign(n, std::numeric_limits<double>::quiet_NaN());
+        column.number[i] = value;
+    }
+    column.numeric = !column.number.empty();
+}
+
+// [first, first + count) 的文本已更新后同步数值；数值列只解析这些行，出现非数值时整列降级为文本
+void updateNumbers(DataTableModel::Column &column, int first, int count)
+{
+    if (!column.numeric) {
+        // 文本列只有新值全为数值时才可能变成数值列，其余情况无需整列重新判定
+        bool anyNumber = false;
+        for (int i = first; i < first + count; ++i) {
+            const QString &text = column.text[size_t(i)];
+            if (text.isNull()) continue;
+            bool ok = false;
+            text.toDouble(&ok);
+            if (!ok) return;
+            anyNumber = true;
+        }
+        if (anyNumber) finishColumn(column);
+        return;
+    }
+    for (int i = first; i < first + count; ++i) {
+        const QString &text = column.text[size_t(i)];
+        if (text.isNull()) {
+            column.number[size_t(i)] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+        bool ok = false;
+        const double value = text.toDouble(&ok);
+        if (!ok) {
+            column.number.clear();
+            column.numeric = false;
+            return;
+        }
+        column.number[size_t(i)] = value;
+    }
+}
+
+QString cellText(const QVariant &value)
+{
+    // 缺失值保留为 null，显示为 "-"，排序时排在最后
+    if (!value.isValid() || value.isNull()) return QString();
+    QString text = value.toString();
+    if (text.isNull()) text = QStringLiteral("");
+    return text;
+}
+
+std::vector<quint64> packBits(const std::vector<bool> &bits, int rows, int &count)
+{
+    std::vector<quint64> words(size_t((rows + 63) / 64), 0);
+    count = 0;
+    for (int i = 0; i < rows && size_t(i) < bits.size(); ++i) {
+        if (!bits[size_t(i)]) continue;
+        words[size_t(i) >> 6] |= quint64(1) << (i & 63);
+        ++count;
+    }
+    return words;
+}
+
+bool bitAt(const std::vector<quint64> &words, int i)
+{
+    return (words[size_t(i) >> 6] >> (i & 63)) & 1u;
+}
+
+void assignBit(std::vector<quint64> &words, int i, bool on)
+{
+    const quint64 mask = quint64(1) << (i & 63);
+    if (on) words[size_t(i) >> 6] |= mask;
+    else words[size_t(i) >> 6] &= ~mask;
+}
+
+// 从任意位置起取 64 位，越界部分为 0
+quint64 wordAt(const std::vector<quint64> &words, qint64 pos)
+{
+    const size_t i = size_t(pos >> 6);
+    const int shift = int(pos & 63);
+    const quint64 low = i < words.size() ? words[i] >> shift : 0;
+    const quint64 high = (shift && i + 1 < words.size()) ? words[i + 1] << (64 - shift) : 0;
+    return low | high;
+}
+
+// 把位图从 from 起的位整体移到 to 起（按字处理），from 之前的位保持不变；rows 为移动前的位数
+std::vector<quint64> shiftBits(const std::vector<quint64> &src, int rows, int from, int to)
+{
+    const qint64 total = qint64(rows) + (to - from);
+    std::vector<quint64> words(size_t((total + 63) / 64), 0);
+    const int keep = std::min(from, to);
+    const size_t head = size_t(keep) >> 6;
+    std::copy(src.begin(), src.begin() + qsizetype(std::min(head, src.size())), words.begin());
+    if ((keep & 63) && head < src.size()) words[head] = src[head] & ((quint64(1) << (keep & 63)) - 1);
+    for (size_t w = size_t(to) >> 6; w < words.size(); ++w) {
+        const qint64 start = std::max<qint64>(qint64(w) * 64, to);
+        const qint64 stop = std::min<qint64>(qint64(w) * 64 + 64, total);
+        if (start >= stop) break;
+        quint64 bits = wordAt(src, start - to + from);
+        if (stop - start < 64) bits &= (quint64(1) << (stop - start)) - 1;
+        words[w] |= bits << (start & 63);
+    }
+    return words;
+}
+
+// 在 first 处插入 count 个 0 位；末尾追加时只需扩容
+void insertBits(std::vector<quint64> &words, int rows, int first, int count)
+{
+    if (first == rows) words.resize(size_t((rows + count + 63) / 64), 0);
+    else words = shiftBits(words, rows, first, first + count);
+}
+
+// 删除 [first, first + count)，末字中超出行数的位清零（整字填充与计数依赖这一点）
+void removeBits(std::vector<quint64> &words, int rows, int first, int count)
+{
+    words = shiftBits(words, rows, first + count, first);
+}
+
+// 置位 [first, first + count)
+void fillBits(std::vector<quint64> &words, int first, int count)
+{
+    for (int i = first; i < first + count;) {
+        const int shift = i & 63;
+        const int n = std::min(64 - shift, first + count - i);
+        const quint64 mask = (n == 64 ? ~quint64(0) : (quint64(1) << n) - 1) << shift;
+        words[size_t(i) >> 6] |= mask;
+        i += n;
+    }
+}
+
+bool isRowNumberColumn(const DataTableModel::Column &column, int role)
+{
+    return role < 0 && column.key == QLatin1String("index");
+}
+
+} // namespace
+
+DataTableModel::DataTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_importTimer(new QTimer(this))
+    , m_viewTimer(new QTimer(this))
+    , m_notifyTimer(new QTimer(this))
+{
+    // 排序/筛选串行执行，新请求使旧结果作废
+    m_pool.setMaxThreadCount(1);
+    // 源模型的连续重置/移动合并为一次整表导入；排序/筛选参数的连续修改合并为一次计算
+    m_importTimer->setSingleShot(true);
+    m_importTimer->setInterval(0);
+    connect(m_importTimer, &QTimer::timeout, this, &DataTableModel::importSourceModel);
+    m_viewTimer->setSingleShot(true);
+    m_viewTimer->setInterval(0);
+    connect(m_viewTimer, &QTimer::timeout, this, &DataTableModel::startView);
+    // 源模型逐行增删时计数与勾选状态的通知合并为一次
+    m_notifyTimer->setSingleShot(true);
+    m_notifyTimer->setInterval(0);
+    connect(m_notifyTimer, &QTimer::timeout, this, &DataTableModel::notify);
+}
+
+DataTableModel::~DataTableModel()
+{
+    ++m_generation;
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+int DataTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_rows.size());
+}
+
+int DataTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_keys.size());
+}
+
+QVariant DataTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || size_t(index.row()) >= m_rows.size()) return QVariant();
+    if (index.column() < 0 || index.column() >= m_keys.size()) return QVariant();
+    const int source = m_rows[size_t(index.row())];
+    switch (role) {
+    case Qt::DisplayRole: {
+        const int column = m_columnMap[size_t(index.column())];
+        if (column < 0) return QStringLiteral("-");
+        const QString &text = m_table->columns[size_t(column)].text[size_t(source)];
+        return text.isNull() ? QStringLiteral("-") : text;
+    }
+    case KeyRole: return m_keys.at(index.column());
+    case CheckedRole: return testBit(source);
+    case SourceRowRole: return source;
+    default: return QVariant();
+    }
+}
+
+QVariant DataTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    if (section < 0 || section >= m_headers.size()) return QVariant();
+    return m_headers.at(section).toMap().value(QStringLiteral("label"));
+}
+
+QHash<int, QByteArray> DataTableModel::roleNames() const
+{
+    return {
+        { Qt::DisplayRole, "display" },
+        { KeyRole, "key" },
+        { CheckedRole, "checked" },
+        { SourceRowRole, "sourceRow" }
+    };
+}
+
+void DataTableModel::setHeaders(const QVariantList &headers)
+{
+    if (m_headers == headers) return;
+    beginResetModel();
+    m_headers = headers;
+    m_keys.clear();
+    for (const QVariant &header : headers) m_keys.append(header.toMap().value(QStringLiteral("key")).toString());
+    rebuildColumnMap();
+    endResetModel();
+    emit headersChanged();
+    // 导入时只保留表头中的列，列集合变化后需要重新导入
+    reimport();
+}
+
+void DataTableModel::setSourceModel(QAbstractItemModel *model)
+{
+    if (m_sourceModel == model) return;
+    if (m_sourceModel) disconnect(m_sourceModel, nullptr, this, nullptr);
+    m_sourceModel = model;
+    m_rowData.clear();
+    if (m_sourceModel) {
+        auto schedule = [this]() { m_importTimer->start(); };
+        connect(m_sourceModel, &QAbstractItemModel::modelReset, this, schedule);
+        connect(m_sourceModel, &QAbstractItemModel::rowsMoved, this, schedule);
+        connect(m_sourceModel, &QAbstractItemModel::layoutChanged, this, schedule);
+        connect(m_sourceModel, &QAbstractItemModel::rowsInserted, this, &DataTableModel::onSourceRowsInserted);
+        connect(m_sourceModel, &QAbstractItemModel::rowsRemoved, this, &DataTableModel::onSourceRowsRemoved);
+        connect(m_sourceModel, &QAbstractItemModel::dataChanged, this, &DataTableModel::onSourceDataChanged);
+    }
+    emit sourceModelChanged();
+    importSourceModel();
+}
+
+void DataTableModel::setRows(const QVariantList &rows)
+{
+    if (m_sourceModel) {
+        disconnect(m_sourceModel, nullptr, this, nullptr);
+        m_sourceModel = nullptr;
+        emit sourceModelChanged();
+    }
+    m_rowData = rows;
+    importRows();
+}
+
+void DataTableModel::setTable(std::vector<Column> columns, std::vector<bool> checked)
+{
+    auto table = std::make_shared<Table>();
+    table->rows = columns.empty() ? 0 : int(columns.front().text.size());
+    for (Column &column : columns) {
+        column.text.resize(size_t(table->rows));
+        if (column.number.size() != column.text.size()) finishColumn(column);
+    }
+    table->columns = std::move(columns);
+    m_rowData.clear();
+    replaceTable(std::move(table), std::move(checked));
+}
+
+void DataTableModel::reimport()
+{
+    if (m_sourceModel) importSourceModel();
+    else if (!m_rowData.isEmpty()) importRows();
+    else {
+        beginResetModel();
+        rebuildColumnMap();
+        endResetModel();
+    }
+}
+
+void DataTableModel::importSourceModel()
+{
+    m_importTimer->stop();
+    auto table = std::make_shared<Table>();
+    std::vector<bool> checked;
+    m_sourceRoles.clear();
+    m_sourceCheckedRole = -1;
+    QAbstractItemModel *model = m_sourceModel;
+    if (model) {
+        const int rows = model->rowCount();
+        const QHash<int, QByteArray> roles = model->roleNames();
+        QHash<QString, int> roleOf;
+        for (auto it = roles.cbegin(); it != roles.cend(); ++it) roleOf.insert(QString::fromUtf8(it.value()), it.key());
+
+        table->rows = rows;
+        table->columns.reserve(size_t(m_keys.size()));
+        for (const QString &key : std::as_const(m_keys)) {
+            Column column;
+            column.key = key;
+            column.text.resize(size_t(rows));
+            table->columns.push_back(std::move(column));
+            m_sourceRoles.push_back(roleOf.value(key, -1));
+        }
+        readSourceRows(*table, 0, rows);
+        for (Column &column : table->columns) finishColumn(column);
+        m_sourceCheckedRole = roleOf.value(QStringLiteral("checked"), -1);
+        if (m_sourceCheckedRole >= 0) {
+            checked.resize(size_t(rows));
+            for (int r = 0; r < rows; ++r) checked[size_t(r)] = model->data(model->index(r, 0), m_sourceCheckedRole).toBool();
+        }
+    }
+    replaceTable(std::move(table), std::move(checked));
+}
+
+void DataTableModel::readSourceRows(Table &table, int first, int count) const
+{
+    QAbstractItemModel *model = m_sourceModel;
+    for (size_t c = 0; c < table.columns.size(); ++c) {
+        Column &column = table.columns[c];
+        const int role = m_sourceRoles[c];
+        if (role >= 0) {
+            for (int r = first; r < first + count; ++r) column.text[size_t(r)] = cellText(model->data(model->index(r, 0), role));
+        } else if (isRowNumberColumn(column, role)) {
+            // 与旧的 ListView 委托一致：没有 index 字段时显示行号
+            for (int r = first; r < first + count; ++r) column.text[size_t(r)] = QString::number(r);
+        }
+    }
+}
+
+bool DataTableModel::canUpdateInPlace() const
+{
+    // 整表导入尚未完成（排队中或在等新视图）时，后续变更并入那次导入
+    return m_table && !m_pendingTable && !m_importTimer->isActive()
+        && m_sourceRoles.size() == m_table->columns.size();
+}
+
+DataTableModel::Table &DataTableModel::detachTable()
+{
+    // 后台排序/筛选可能仍在读取当前表
+    if (m_table.use_count() > 1) m_table = std::make_shared<Table>(*m_table);
+    return *m_table;
+}
+
+void DataTableModel::onSourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+    if (!canUpdateInPlace() || first < 0 || first > m_table->rows || last < first) {
+        m_importTimer->start();
+        return;
+    }
+    const int inserted = last - first + 1;
+    const int oldRows = m_table->rows;
+    ++m_generation;     // 进行中的排序/筛选基于旧行号
+
+    Table &table = detachTable();
+    for (Column &column : table.columns) {
+        column.text.insert(column.text.begin() + first, size_t(inserted), QString());
+        if (column.numeric) column.number.insert(column.number.begin() + first, size_t(inserted), std::numeric_limits<double>::quiet_NaN());
+    }
+    table.rows += inserted;
+    // 行号列从插入点起整体后移
+    for (size_t c = 0; c < table.columns.size(); ++c) {
+        Column &column = table.columns[c];
+        if (!isRowNumberColumn(column, m_sourceRoles[c])) continue;
+        for (int r = first; r < table.rows; ++r) column.text[size_t(r)] = QString::number(r);
+    }
+    readSourceRows(table, first, inserted);
+    for (size_t c = 0; c < table.columns.size(); ++c) {
+        const bool renumbered = isRowNumberColumn(table.columns[c], m_sourceRoles[c]);
+        updateNumbers(table.columns[c], first, renumbered ? table.rows - first : inserted);
+    }
+
+    insertBits(m_checked, oldRows, first, inserted);
+    int added = 0;
+    if (m_sourceCheckedRole >= 0) {
+        for (int r = first; r <= last; ++r) {
+            if (!m_sourceModel->data(m_sourceModel->index(r, 0), m_sourceCheckedRole).toBool()) continue;
+            assignBit(m_checked, r, true);
+            ++added;
+        }
+    }
+    // 新行先显示出来，重新筛选的结果到达后再决定去留；两个勾选计数同步增加
+    m_checkedCount += added;
+    m_visibleChecked += added;
+    if (!m_visible.empty()) {
+        insertBits(m_visible, oldRows, first, inserted);
+        fillBits(m_visible, first, inserted);
+    }
+    // 末尾追加（逐行 append 的常见情形）不影响已有行号
+    if (first < oldRows) {
+        for (int &row : m_rows) {
+            if (row >= first) row += inserted;
+        }
+    }
+
+    // 源顺序下插在对应位置；排序/筛选生效时先追加到末尾，等新视图重排
+    const bool sorted = hasView();
+    const int at = sorted ? int(m_rows.size()) : first;
+    beginInsertRows(QModelIndex(), at, at + inserted - 1);
+    m_rows.insert(m_rows.begin() + at, size_t(inserted), 0);
+    for (int i = 0; i < inserted; ++i) m_rows[size_t(at + i)] = first + i;
+    endInsertRows();
+
+    // 连续插入合并为一次重新排序/筛选与一次计数通知
+    scheduleNotify();
+    if (sorted || m_busy) scheduleView();
+}
+
+void DataTableModel::onSourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+    if (!canUpdateInPlace() || first < 0 || last >= m_table->rows || last < first) {
+        m_importTimer->start();
+        return;
+    }
+    const int removed = last - first + 1;
+    const int oldRows = m_table->rows;
+    ++m_generation;
+
+    // 勾选计数按被删行增量扣减
+    for (int r = first; r <= last; ++r) {
+        if (!bitAt(m_checked, r)) continue;
+        --m_checkedCount;
+        if (m_visible.empty() || bitAt(m_visible, r)) --m_visibleChecked;
+    }
+
+    // 先从视图中移除，此时表格尚未改动，剩余行照常取数
+    if (!hasView() && int(m_rows.size()) == oldRows) {
+        // 源顺序：视图行即源行，一段删除
+        beginRemoveRows(QModelIndex(), first, last);
+        m_rows.erase(m_rows.begin() + first, m_rows.begin() + last + 1);
+        for (size_t i = size_t(first); i < m_rows.size(); ++i) m_rows[i] -= removed;
+        endRemoveRows();
+    } else {
+        // 排序/筛选后被删行散落各处：按连续段倒序移除
+        auto gone = [first, last](int source) { return source >= first && source <= last; };
+        for (int end = int(m_rows.size()) - 1; end >= 0; --end) {
+            if (!gone(m_rows[size_t(end)])) continue;
+            int begin = end;
+            while (begin > 0 && gone(m_rows[size_t(begin - 1)])) --begin;
+            beginRemoveRows(QModelIndex(), begin, end);
+            m_rows.erase(m_rows.begin() + begin, m_rows.begin() + end + 1);
+            endRemoveRows();
+            end = begin;
+        }
+        for (int &row : m_rows) {
+            if (row > last) row -= removed;
+        }
+    }
+
+    Table &table = detachTable();
+    for (size_t c = 0; c < table.columns.size(); ++c) {
+        Column &column = table.columns[c];
+        column.text.erase(column.text.begin() + first, column.text.begin() + last + 1);
+        if (column.numeric) column.number.erase(column.number.begin() + first, column.number.begin() + last + 1);
+    }
+    table.rows -= removed;
+    for (size_t c = 0; c < table.columns.size(); ++c) {
+        Column &column = table.columns[c];
+        if (isRowNumberColumn(column, m_sourceRoles[c])) {
+            for (int r = first; r < table.rows; ++r) column.text[size_t(r)] = QString::number(r);
+            updateNumbers(column, first, table.rows - first);
+        } else if (!column.numeric) {
+            // 删掉的可能正是唯一的非数值单元
+            finishColumn(column);
+        }
+    }
+
+    removeBits(m_checked, oldRows, first, removed);
+    if (!m_visible.empty()) removeBits(m_visible, oldRows, first, removed);
+
+    scheduleNotify();
+    // 删除不改变剩余行的相对顺序；只需重启被作废的计算
+    if (m_busy) scheduleView();
+}
+
+void DataTableModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles)
+{
+    if (!topLeft.isValid() || topLeft.parent().isValid()) return;
+    const int first = topLeft.row();
+    const int last = bottomRight.row();
+    if (!canUpdateInPlace() || first < 0 || last >= m_table->rows || last < first) {
+        m_importTimer->start();
+        return;
+    }
+    const int changed = last - first + 1;
+    bool cells = false;
+    for (size_t c = 0; c < m_sourceRoles.size(); ++c) {
+        const int role = m_sourceRoles[c];
+        if (role < 0 || (!roles.isEmpty() && !roles.contains(role))) continue;
+        Column &column = detachTable().columns[c];
+        for (int r = first; r <= last; ++r) column.text[size_t(r)] = cellText(m_sourceModel->data(m_sourceModel->index(r, 0), role));
+        updateNumbers(column, first, changed);
+        cells = true;
+    }
+    bool checks = false;
+    if (m_sourceCheckedRole >= 0 && (roles.isEmpty() || roles.contains(m_sourceCheckedRole))) {
+        for (int r = first; r <= last; ++r) {
+            const bool on = m_sourceModel->data(m_sourceModel->index(r, 0), m_sourceCheckedRole).toBool();
+            if (bitAt(m_checked, r) == on) continue;
+            assignBit(m_checked, r, on);
+            m_checkedCount += on ? 1 : -1;
+            if (m_visible.empty() || bitAt(m_visible, r)) m_visibleChecked += on ? 1 : -1;
+            checks = true;
+        }
+    }
+    if (!cells && !checks) return;
+
+    // 受影响的视图行：源顺序下即同一区间，否则扫描代理索引
+    int low = first, high = last;
+    if (hasView()) {
+        low = int(m_rows.size());
+        high = -1;
+        for (size_t i = 0; i < m_rows.size(); ++i) {
+            if (m_rows[i] < first || m_rows[i] > last) continue;
+            low = std::min(low, int(i));
+            high = std::max(high, int(i));
+        }
+    }
+    if (low <= high) emit dataChanged(index(low, 0), index(high, columnCount() - 1));
+    if (checks) scheduleNotify();
+    // 单元格变化可能影响排序位置与筛选结果
+    if (cells && hasView()) scheduleView();
+}
+
+void DataTableModel::importRows()
+{
+    auto table = std::make_shared<Table>();
+    const int rows = int(m_rowData.size());
+    table->rows = rows;
+    table->columns.resize(size_t(m_keys.size()));
+    for (qsizetype c = 0; c < m_keys.size(); ++c) {
+        table->columns[size_t(c)].key = m_keys.at(c);
+        table->columns[size_t(c)].text.resize(size_t(rows));
+    }
+    std::vector<bool> checked(size_t(rows), false);
+    // 按行读取一次 QVariantMap，分发到各列
+    for (int r = 0; r < rows; ++r) {
+        const QVariantMap row = m_rowData.at(r).toMap();
+        for (qsizetype c = 0; c < m_keys.size(); ++c) {
+            const auto it = row.constFind(m_keys.at(c));
+            if (it != row.cend()) table->columns[size_t(c)].text[size_t(r)] = cellText(it.value());
+            else if (m_keys.at(c) == QLatin1String("index")) table->columns[size_t(c)].text[size_t(r)] = QString::number(r);
+        }
+        checked[size_t(r)] = row.value(QStringLiteral("checked")).toBool();
+    }
+    for (Column &column : table->columns) finishColumn(column);
+    replaceTable(std::move(table), std::move(checked));
+}
+
+void DataTableModel::replaceTable(std::shared_ptr<Table> table, std::vector<bool> checked)
+{
+    if (hasView()) {
+        // 排序/筛选生效时保留当前视图，新表的代理索引算好后与新表一起替换，不先闪回源顺序
+        m_pendingTable = std::move(table);
+        m_pendingChecked = std::move(checked);
+        startView();
+        return;
+    }
+    ++m_generation;     // 作废正在进行的排序/筛选
+    m_pendingTable.reset();
+    m_pendingChecked.clear();
+    const int oldCount = count();
+    beginResetModel();
+    m_table = std::move(table);
+    rebuildColumnMap();
+    m_rows.resize(size_t(m_table->rows));
+    for (int i = 0; i < m_table->rows; ++i) m_rows[size_t(i)] = i;
+    m_visible.clear();
+    m_checked = packBits(checked, m_table->rows, m_checkedCount);
+    m_visibleChecked = m_checkedCount;
+    endResetModel();
+    setBusy(false);
+    if (oldCount != count()) emit countChanged();
+    emit checkStateChanged();
+    emit viewChanged();
+}
+
+void DataTableModel::rebuildColumnMap()
+{
+    m_columnMap.assign(size_t(m_keys.size()), -1);
+    if (!m_table) return;
+    for (qsizetype c = 0; c < m_keys.size(); ++c) m_columnMap[size_t(c)] = columnOf(m_table.get(), m_keys.at(c));
+}
+
+int DataTableModel::columnOf(const Table *table, const QString &key)
+{
+    if (!table) return -1;
+    for (size_t i = 0; i < table->columns.size(); ++i) {
+        if (table->columns[i].key == key) return int(i);
+    }
+    return -1;
+}
+
+QString DataTableModel::checkState() const
+{
+    if (m_rows.empty() || m_visibleChecked == 0) return QStringLiteral("none");
+    return m_visibleChecked == count() ? QStringLiteral("all") : QStringLiteral("partial");
+}
+
+void DataTableModel::setSortKeys(const QVariantList &keys)
+{
+    if (m_sortKeys == keys) return;
+    m_sortKeys = keys;
+    emit sortKeysChanged();
+    scheduleView();
+}
+
+void DataTableModel::setFilterText(const QString &text)
+{
+    if (m_filterText == text) return;
+    m_filterText = text;
+    emit filterChanged();
+    scheduleView();
+}
+
+void DataTableModel::setFilters(const QVariantList &filters)
+{
+    if (m_filters == filters) return;
+    m_filters = filters;
+    emit filterChanged();
+    scheduleView();
+}
+
+void DataTableModel::sortBy(const QString &key)
+{
+    QVariantList keys = m_sortKeys;
+    bool ascending = true;
+    if (!keys.isEmpty() && keys.first().toMap().value(QStringLiteral("key")).toString() == key) {
+        ascending = !keys.first().toMap().value(QStringLiteral("ascending"), true).toBool();
+    }
+    keys.removeIf([&key](const QVariant &entry) { return entry.toMap().value(QStringLiteral("key")).toString() == key; });
+    keys.prepend(QVariantMap { { QStringLiteral("key"), key }, { QStringLiteral("ascending"), ascending } });
+    setSortKeys(keys);
+}
+
+std::vector<DataTableModel::SortKey> DataTableModel::resolveSortKeys() const
+{
+    std::vector<SortKey> keys;
+    for (const QVariant &entry : m_sortKeys) {
+        const QVariantMap map = entry.toMap();
+        const int column = columnOf(viewTable(), map.value(QStringLiteral("key")).toString());
+        if (column >= 0) keys.push_back(SortKey { column, map.value(QStringLiteral("ascending"), true).toBool() });
+    }
+    return keys;
+}
+
+std::vector<DataTableModel::Predicate> DataTableModel::resolvePredicates() const
+{
+    std::vector<Predicate> predicates;
+    if (!m_filterText.isEmpty()) {
+        predicates.push_back(Predicate { -1, Predicate::Contains, m_filterText, 0.0, false });
+    }
+    static const QHash<QString, Predicate::Op> ops = {
+        { QStringLiteral("contains"), Predicate::Contains },
+        { QStringLiteral("=="), Predicate::Equal },
+        { QStringLiteral("!="), Predicate::NotEqual },
+        { QStringLiteral("<"), Predicate::Less },
+        { QStringLiteral("<="), Predicate::LessEqual },
+        { QStringLiteral(">"), Predicate::Greater },
+        { QStringLiteral(">="), Predicate::GreaterEqual }
+    };
+    for (const QVariant &entry : m_filters) {
+        const QVariantMap map = entry.toMap();
+        const QString key = map.value(QStringLiteral("key")).toString();
+        const int column = key.isEmpty() ? -1 : columnOf(viewTable(), key);
+        if (!key.isEmpty() && column < 0) continue;
+        Predicate predicate;
+        predicate.column = column;
+        predicate.op = ops.value(map.value(QStringLiteral("op"), QStringLiteral("contains")).toString(), Predicate::Contains);
+        predicate.text = map.value(QStringLiteral("value")).toString();
+        predicate.number = predicate.text.toDouble(&predicate.numeric);
+        // 任一列匹配只支持包含
+        if (column < 0) predicate.op = Predicate::Contains;
+        predicates.push_back(predicate);
+    }
+    return predicates;
+}
+
+void DataTableModel::scheduleView()
+{
+    if (!m_viewTimer->isActive()) m_viewTimer->start();
+}
+
+void DataTableModel::scheduleNotify()
+{
+    if (!m_notifyTimer->isActive()) m_notifyTimer->start();
+}
+
+void DataTableModel::notify()
+{
+    m_notifyTimer->stop();
+    emit countChanged();
+    emit checkStateChanged();
+}
+
+void DataTableModel::startView()
+{
+    m_viewTimer->stop();
+    const quint64 generation = ++m_generation;
+    TablePtr table = m_pendingTable ? m_pendingTable : m_table;
+    if (!table) return;
+    std::vector<Predicate> predicates = resolvePredicates();
+    std::vector<SortKey> sortKeys = resolveSortKeys();
+    if (predicates.empty() && sortKeys.empty()) {
+        // 恢复源顺序无需后台计算
+        std::vector<int> rows(size_t(table->rows));
+        for (int i = 0; i < table->rows; ++i) rows[size_t(i)] = i;
+        applyView(generation, std::move(rows));
+        return;
+    }
+    setBusy(true);
+    m_pool.start([this, table, predicates = std::move(predicates), sortKeys = std::move(sortKeys), generation]() {
+        std::vector<int> rows = buildView(*table, predicates, sortKeys, m_generation, generation);
+        if (m_generation.load() != generation) return;
+        QMetaObject::invokeMethod(this, [this, generation, rows = std::move(rows)]() mutable {
+            applyView(generation, std::move(rows));
+        }, Qt::QueuedConnection);
+    });
+}
+
+std::vector<int> DataTableModel::buildView(const Table &table, const std::vector<Predicate> &predicates,
+                                           const std::vector<SortKey> &sortKeys, const std::atomic<quint64> &generation,
+                                           quint64 expected)
+{
+    std::vector<int> rows;
+    rows.reserve(size_t(table.rows));
+
+    auto matches = [&table](const Predicate &p, int row) {
+        if (p.column < 0) {
+            for (const Column &column : table.columns) {
+                if (column.text[size_t(row)].contains(p.text, Qt::CaseInsensitive)) return true;
+            }
+            return false;
+        }
+        const Column &column = table.columns[size_t(p.column)];
+        const QString &text = column.text[size_t(row)];
+        if (p.op == Predicate::Contains) return text.contains(p.text, Qt::CaseInsensitive);
+        int cmp = 0;
+        if (column.numeric && p.numeric) {
+            const double value = column.number[size_t(row)];
+            if (std::isnan(value)) return p.op == Predicate::NotEqual;
+            cmp = value < p.number ? -1 : (value > p.number ? 1 : 0);
+        } else {
+            if (text.isNull()) return p.op == Predicate::NotEqual;
+            cmp = QString::compare(text, p.text, Qt::CaseInsensitive);
+        }
+        switch (p.op) {
+        case Predicate::Equal: return cmp == 0;
+        case Predicate::NotEqual: return cmp != 0;
+        case Predicate::Less: return cmp < 0;
+        case Predicate::LessEqual: return cmp <= 0;
+        case Predicate::Greater: return cmp > 0;
+        case Predicate::GreaterEqual: return cmp >= 0;
+        default: return true;
+        }
+    };
+
+    for (int r = 0; r < table.rows; ++r) {
+        if ((r % kCancelCheckInterval) == 0 && generation.load() != expected) return {};
+        bool keep = true;
+        for (const Predicate &p : predicates) {
+            if (!matches(p, r)) {
+                keep = false;
+                break;
+            }
+        }
+        if (keep) rows.push_back(r);
+    }
+    if (sortKeys.empty()) return rows;
+
+    // 文本列预先生成排序键，比较时不再做区域化分析
+    QCollator collator;
+    collator.setNumericMode(true);
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    std::vector<std::vector<QCollatorSortKey>> collationKeys(sortKeys.size());
+    for (size_t k = 0; k < sortKeys.size(); ++k) {
+        const Column &column = table.columns[size_t(sortKeys[k].column)];
+        if (column.numeric) continue;
+        std::vector<QCollatorSortKey> &keys = collationKeys[k];
+        keys.reserve(size_t(table.rows));
+        for (int r = 0; r < table.rows; ++r) {
+            if ((r % kCancelCheckInterval) == 0 && generation.load() != expected) return {};
+            keys.push_back(collator.sortKey(column.text[size_t(r)]));
+        }
+    }
+
+    std::stable_sort(rows.begin(), rows.end(), [&](int a, int b) {
+        for (size_t k = 0; k < sortKeys.size(); ++k) {
+            const Column &column = table.columns[size_t(sortKeys[k].column)];
+            int cmp = 0;
+            // 缺失值无论升降序都排在最后
+            if (column.numeric) {
+                const double va = column.number[size_t(a)];
+                const double vb = column.number[size_t(b)];
+                const bool na = std::isnan(va), nb = std::isnan(vb);
+                if (na || nb) {
+                    if (na != nb) return nb;
+                    continue;
+                }
+                cmp = va < vb ? -1 : (va > vb ? 1 : 0);
+            } else {
+                const bool na = column.text[size_t(a)].isNull(), nb = column.text[size_t(b)].isNull();
+                if (na || nb) {
+                    if (na != nb) return nb;
+                    continue;
+                }
+                cmp = collationKeys[k][size_t(a)].compare(collationKeys[k][size_t(b)]);
+            }
+            if (cmp != 0) return sortKeys[k].ascending ? cmp < 0 : cmp > 0;
+        }
+        return false;
+    });
+    return rows;
+}
+
+void DataTableModel::applyView(quint64 generation, std::vector<int> rows)
+{
+    if (generation != m_generation.load()) return;
+    const Table *table = viewTable();
+    if (!table) return;
+    const bool replacing = bool(m_pendingTable);
+    const int oldCount = count();
+    const bool filtered = !m_filters.isEmpty() || !m_filterText.isEmpty();
+    std::vector<quint64> visible;
+    if (filtered) {
+        visible.assign(size_t((table->rows + 63) / 64), 0);
+        for (int row : rows) visible[size_t(row) >> 6] |= quint64(1) << (row & 63);
+    }
+    if (replacing || int(rows.size()) != oldCount) {
+        beginResetModel();
+        if (replacing) {
+            m_table = std::move(m_pendingTable);
+            m_pendingTable.reset();
+            rebuildColumnMap();
+            m_checked = packBits(m_pendingChecked, m_table->rows, m_checkedCount);
+            m_pendingChecked.clear();
+        }
+        m_rows = std::move(rows);
+        m_visible = std::move(visible);
+        endResetModel();
+    } else {
+        // 行数不变（重新排序、数据变化后重排）：以布局变化替换，视图保留滚动位置，持久索引跟随源行
+        emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+        std::vector<int> position(size_t(table->rows), -1);
+        for (size_t i = 0; i < rows.size(); ++i) position[size_t(rows[i])] = int(i);
+        const QModelIndexList before = persistentIndexList();
+        QModelIndexList after;
+        after.reserve(before.size());
+        for (const QModelIndex &old : before) {
+            const int row = position[size_t(m_rows[size_t(old.row())])];
+            after.append(row < 0 ? QModelIndex() : createIndex(row, old.column()));
+        }
+        changePersistentIndexList(before, after);
+        m_rows = std::move(rows);
+        m_visible = std::move(visible);
+        emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+    }
+    recountVisibleChecked();
+    setBusy(false);
+    if (oldCount != count()) emit countChanged();
+    emit checkStateChanged();
+    emit viewChanged();
+}
+
+void DataTableModel::recountVisibleChecked()
+{
+    if (m_visible.empty()) {
+        m_visibleChecked = m_checkedCount;
+        return;
+    }
+    int total = 0;
+    for (size_t i = 0; i < m_checked.size(); ++i) total += int(qPopulationCount(m_checked[i] & m_visible[i]));
+    m_visibleChecked = total;
+}
+
+QVariantMap DataTableModel::get(int row) const
+{
+    QVariantMap item;
+    if (row < 0 || size_t(row) >= m_rows.size()) return item;
+    const int source = m_rows[size_t(row)];
+    for (const Column &column : m_table->columns) {
+        const QString &text = column.text[size_t(source)];
+        if (text.isNull()) continue;
+        item.insert(column.key, column.numeric ? QVariant(column.number[size_t(source)]) : QVariant(text));
+    }
+    item.insert(QStringLiteral("checked"), testBit(source));
+    return item;
+}
+
+int DataTableModel::sourceRow(int row) const
+{
+    return (row >= 0 && size_t(row) < m_rows.size()) ? m_rows[size_t(row)] : -1;
+}
+
+bool DataTableModel::isChecked(int row) const
+{
+    return row >= 0 && size_t(row) < m_rows.size() && testBit(m_rows[size_t(row)]);
+}
+
+void DataTableModel::setChecked(int row, bool checked)
+{
+    if (row < 0 || size_t(row) >= m_rows.size() || isChecked(row) == checked) return;
+    const int source = m_rows[size_t(row)];
+    m_checked[size_t(source) >> 6] ^= quint64(1) << (source & 63);
+    // 视图中的行必然可见，两个计数同步增减
+    const int delta = checked ? 1 : -1;
+    m_checkedCount += delta;
+    m_visibleChecked += delta;
+    emit dataChanged(index(row, 0), index(row, columnCount() - 1), { CheckedRole });
+    emit checkStateChanged();
+}
+
+void DataTableModel::toggleChecked(int row)
+{
+    setChecked(row, !isChecked(row));
+}
+
+void DataTableModel::setAllChecked(bool checked)
+{
+    if (m_rows.empty()) return;
+    if (m_visible.empty()) {
+        // 无筛选：整字填充，O(行数 / 64)
+        const int rows = m_table->rows;
+        std::fill(m_checked.begin(), m_checked.end(), checked ? ~quint64(0) : quint64(0));
+        if (checked && (rows & 63)) m_checked.back() = (quint64(1) << (rows & 63)) - 1;
+        m_checkedCount = checked ? rows : 0;
+    } else {
+        for (size_t i = 0; i < m_checked.size(); ++i) {
+            const quint64 before = m_checked[i];
+            m_checked[i] = checked ? (before | m_visible[i]) : (before & ~m_visible[i]);
+            m_checkedCount += int(qPopulationCount(m_checked[i])) - int(qPopulationCount(before));
+        }
+    }
+    m_visibleChecked = checked ? count() : 0;
+    emit dataChanged(index(0, 0), index(count() - 1, columnCount() - 1), { CheckedRole });
+    emit checkStateChanged();
+}
+
+QList<int> DataTableModel::checkedRows() const
+{
+    QList<int> rows;
+    rows.reserve(m_checkedCount);
+    for (size_t w = 0; w < m_checked.size(); ++w) {
+        quint64 bits = m_checked[w];
+        while (bits) {
+            rows.append(int(w * 64) + int(qCountTrailingZeroBits(bits)));
+            bits &= bits - 1;
+        }
+    }
+    return rows;
+}
+
+QList<qreal> DataTableModel::estimateColumnWidths(const QFont &font, qreal padding, qreal minimum, int sampleSize) const
+{
+    const QFontMetricsF metrics(font);
+    QList<qreal> widths;
+    widths.reserve(m_keys.size());
+    const int rows = m_table ? m_table->rows : 0;
+
+    // 抽样行：少量数据全量测量，否则取首尾各 1/4，其余等距抽取
+    std::vector<int> samples;
+    if (rows <= sampleSize) {
+        samples.resize(size_t(rows));
+        for (int i = 0; i < rows; ++i) samples[size_t(i)] = i;
+    } else {
+        const int edge = sampleSize / 4;
+        for (int i = 0; i < edge; ++i) {
+            samples.push_back(i);
+            samples.push_back(rows - 1 - i);
+        }
+        const int middle = sampleSize - edge * 2;
+        const double stride = double(rows - edge * 2) / std::max(1, middle);
+        for (int i = 0; i < middle; ++i) samples.push_back(edge + int(i * stride));
+    }
+
+    for (qsizetype c = 0; c < m_keys.size(); ++c) {
+        qreal width = std::max(minimum, metrics.horizontalAdvance(m_headers.at(c).toMap().value(QStringLiteral("label")).toString()) + padding * 2);
+        const int column = m_columnMap[size_t(c)];
+        if (column >= 0) {
+            const Column &data = m_table->columns[size_t(column)];
+            for (int row : samples) {
+                const QString &text = data.text[size_t(row)];
+                width = std::max(width, metrics.horizontalAdvance(text.isNull() ? QStringLiteral("-") : text) + padding * 2);
+            }
+        }
+        widths.append(std::ceil(width));
+    }
+    return widths;
+}
+
+void DataTableModel::setBusy(bool busy)
+{
+    if (m_busy == busy) return;
+    m_busy = busy;
+    emit busyChanged();
+}
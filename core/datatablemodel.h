@@ -0,0 +1,194 @@
+// core/datatablemodel.h
+#ifndef CORE_DATATABLEMODEL_H
+#define CORE_DATATABLEMODEL_H
+
+// EDataTable 的数据源：按列存储（每列一段 QString 数组，全数值列另存 double），
+// 排序/筛选在工作线程上生成“视图行 -> 源行”的代理索引，完成后一次性替换
+// 勾选状态为源行位图，已勾选数随单行切换增量维护，全选/部分/未选判断为 O(1)
+// 源模型的插入/删除/数据变化只更新受影响的行；重置或移动才整表重新导入，新视图算好前保留旧视图
+#include <QAbstractTableModel>
+#include <QFont>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+class DataTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+    // [{ key, label }]，列顺序即表格列顺序
+    Q_PROPERTY(QVariantList headers READ headers WRITE setHeaders NOTIFY headersChanged)
+    // 兼容旧接口：ListModel 或任意 QAbstractItemModel，按角色名取列，变更后增量同步
+    Q_PROPERTY(QAbstractItemModel *sourceModel READ sourceModel WRITE setSourceModel NOTIFY sourceModelChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int totalCount READ totalCount NOTIFY countChanged)
+    Q_PROPERTY(int checkedCount READ checkedCount NOTIFY checkStateChanged)
+    // "none" / "partial" / "all"，针对当前可见（筛选后）的行
+    Q_PROPERTY(QString checkState READ checkState NOTIFY checkStateChanged)
+    // [{ key, ascending }]，靠前的键优先；稳定排序
+    Q_PROPERTY(QVariantList sortKeys READ sortKeys WRITE setSortKeys NOTIFY sortKeysChanged)
+    // 任一列包含该文本（不区分大小写）
+    Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterChanged)
+    // [{ key, op, value }]，op 取 contains / == / != / < / <= / > / >=，各条件为“与”
+    Q_PROPERTY(QVariantList filters READ filters WRITE setFilters NOTIFY filterChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+
+public:
+    enum Roles {
+        KeyRole = Qt::UserRole + 1,
+        CheckedRole,
+        SourceRowRole
+    };
+    Q_ENUM(Roles)
+
+    // 单列数据：文本始终保存；整列可解析为数值时另存一份 double 供数值比较
+    struct Column
+    {
+        QString key;
+        std::vector<QString> text;
+        std::vector<double> number;
+        bool numeric = false;
+    };
+    struct Table
+    {
+        std::vector<Column> columns;
+        int rows = 0;
+    };
+    using TablePtr = std::shared_ptr<const Table>;
+
+    explicit DataTableModel(QObject *parent = nullptr);
+    ~DataTableModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QVariantList headers() const { return m_headers; }
+    void setHeaders(const QVariantList &headers);
+    QAbstractItemModel *sourceModel() const { return m_sourceModel; }
+    void setSourceModel(QAbstractItemModel *model);
+    int count() const { return int(m_rows.size()); }
+    int totalCount() const { return m_table ? m_table->rows : 0; }
+    int checkedCount() const { return m_checkedCount; }
+    QString checkState() const;
+    QVariantList sortKeys() const { return m_sortKeys; }
+    void setSortKeys(const QVariantList &keys);
+    QString filterText() const { return m_filterText; }
+    void setFilterText(const QString &text);
+    QVariantList filters() const { return m_filters; }
+    void setFilters(const QVariantList &filters);
+    bool isBusy() const { return m_busy; }
+
+    // 以 JS 对象数组整体替换数据；checked 字段作为初始勾选状态
+    Q_INVOKABLE void setRows(const QVariantList &rows);
+    // C++ 端直接提交列数据（各列长度须一致），不经过 QVariant
+    void setTable(std::vector<Column> columns, std::vector<bool> checked = {});
+
+    // 视图行 -> { key: value, ..., checked }，与 ListModel.get 兼容
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE int sourceRow(int row) const;
+    Q_INVOKABLE bool isChecked(int row) const;
+    Q_INVOKABLE void setChecked(int row, bool checked);
+    Q_INVOKABLE void toggleChecked(int row);
+    // 作用于当前可见的行
+    Q_INVOKABLE void setAllChecked(bool checked);
+    // 源行号列表，按源顺序
+    Q_INVOKABLE QList<int> checkedRows() const;
+    // 点击表头：同一列在升序/降序间切换，换列时该列成为首要排序键
+    Q_INVOKABLE void sortBy(const QString &key);
+    // 抽样估算列宽：表头 + 首尾与等距抽取的 sampleSize 行，宽度取最大值并加上两侧 padding
+    Q_INVOKABLE QList<qreal> estimateColumnWidths(const QFont &font, qreal padding, qreal minimum = 80, int sampleSize = 512) const;
+
+signals:
+    void headersChanged();
+    void sourceModelChanged();
+    void countChanged();
+    void checkStateChanged();
+    void sortKeysChanged();
+    void filterChanged();
+    void busyChanged();
+    // 代理索引替换完成（排序/筛选结果已生效）
+    void viewChanged();
+
+private:
+    struct SortKey
+    {
+        int column;
+        bool ascending;
+    };
+    struct Predicate
+    {
+        int column;         // -1 表示任一列
+        enum Op { Contains, Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual } op;
+        QString text;
+        double number;
+        bool numeric;
+    };
+
+    void reimport();
+    void importSourceModel();
+    void readSourceRows(Table &table, int first, int count) const;
+    void onSourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void onSourceRowsRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles);
+    bool canUpdateInPlace() const;
+    Table &detachTable();
+    void importRows();
+    void replaceTable(std::shared_ptr<Table> table, std::vector<bool> checked);
+    void rebuildColumnMap();
+    void scheduleView();
+    void scheduleNotify();
+    void notify();
+    void startView();
+    void applyView(quint64 generation, std::vector<int> rows);
+    bool hasView() const { return !m_sortKeys.isEmpty() || !m_filters.isEmpty() || !m_filterText.isEmpty(); }
+    // 排序/筛选所针对的表：有待替换的新表时为新表
+    const Table *viewTable() const { return m_pendingTable ? m_pendingTable.get() : m_table.get(); }
+    static int columnOf(const Table *table, const QString &key);
+    std::vector<SortKey> resolveSortKeys() const;
+    std::vector<Predicate> resolvePredicates() const;
+    static std::vector<int> buildView(const Table &table, const std::vector<Predicate> &predicates,
+                                      const std::vector<SortKey> &sortKeys, const std::atomic<quint64> &generation,
+                                      quint64 expected);
+    bool testBit(int sourceRow) const { return (m_checked[size_t(sourceRow) >> 6] >> (sourceRow & 63)) & 1u; }
+    void recountVisibleChecked();
+    void setBusy(bool busy);
+
+    QVariantList m_headers;
+    QStringList m_keys;
+    QPointer<QAbstractItemModel> m_sourceModel;
+    std::shared_ptr<Table> m_table;         // 后台任务持有只读副本，原地修改前写时复制
+    std::shared_ptr<Table> m_pendingTable;  // 整表重新导入后等待排序/筛选结果的新表
+    std::vector<bool> m_pendingChecked;
+    std::vector<int> m_sourceRoles;         // Table 列 -> 源模型角色，缺失为 -1
+    int m_sourceCheckedRole = -1;
+    QVariantList m_rowData;                 // setRows 的原始数据，表头变化时据此重新导入
+    std::vector<int> m_columnMap;           // 表格列 -> Table 列，缺失为 -1
+    std::vector<int> m_rows;                // 视图行 -> 源行
+    std::vector<quint64> m_checked;         // 源行勾选位图
+    int m_checkedCount = 0;                 // 全部源行中的勾选数
+    int m_visibleChecked = 0;               // 当前可见行中的勾选数
+    std::vector<quint64> m_visible;         // 源行可见位图；为空表示没有筛选
+
+    QVariantList m_sortKeys;
+    QString m_filterText;
+    QVariantList m_filters;
+    bool m_busy = false;
+    std::atomic<quint64> m_generation { 0 };
+    QThreadPool m_pool;
+    QTimer *m_importTimer;
+    QTimer *m_viewTimer;
+    QTimer *m_notifyTimer;
+};
+
+#endif // CORE_DATATABLEMODEL_H
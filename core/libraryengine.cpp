@@ -0,0 +1,568 @@
+// 实现文件：LibraryEngine —— 共享扫描、按根目录引用计数的增量监控、元数据预取与歌词查找
+#include "core/libraryengine.h"
+#include "core/metadataindex.h"
+#include "core/metadataservice.h"
+#include "core/lyricsdocument.h"
+#include "core/trace.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QPointer>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUrl>
+
+#include <algorithm>
+
+LibraryEngine &LibraryEngine::instance()
+{
+    static QPointer<LibraryEngine> engine;
+    if (!engine) engine = new LibraryEngine(QCoreApplication::instance());
+    return *engine;
+}
+
+LibraryEngine::LibraryEngine(QObject *parent)
+    : QObject(parent)
+    , m_scanner(new LibraryScanner(this))
+    , m_watcher(new QFileSystemWatcher(this))
+    , m_scanTimer(new QTimer(this))
+{
+    // 配置扫描定时器
+    m_scanTimer->setSingleShot(true);
+    m_scanTimer->setInterval(SCAN_DELAY_MS);
+
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &LibraryEngine::onDirectoryChanged);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged,
+            this, &LibraryEngine::onFileChanged);
+    connect(m_scanTimer, &QTimer::timeout,
+            this, &LibraryEngine::performDelayedScan);
+    connect(m_scanner, &LibraryScanner::batchReady,
+            this, &LibraryEngine::onScanBatch);
+    connect(m_scanner, &LibraryScanner::finished,
+            this, &LibraryEngine::onScanFinished);
+    connect(&MetadataService::instance(), &MetadataService::ready,
+            this, &LibraryEngine::onMetadataRead);
+}
+
+QString LibraryEngine::normalizePath(const QString &path)
+{
+    QString local = path;
+    if (path.startsWith("file:")) {
+        QUrl u(path);
+        if (u.isValid()) local = u.toLocalFile();
+    }
+    return QDir::cleanPath(QDir::fromNativeSeparators(local));
+}
+
+bool LibraryEngine::isUnder(const QString &path, const QString &root)
+{
+    if (!path.startsWith(root)) return false;
+    return path.size() == root.size() || path.at(root.size()) == QLatin1Char('/') || root.endsWith(QLatin1Char('/'));
+}
+
+QString LibraryEngine::defaultProjectRoot() const
+{
+    QString appDir = QCoreApplication::applicationDirPath();
+    QDir dir(appDir);
+
+    // 向上查找最多6级目录
+    for (int i = 0; i < 6; ++i) {
+        if (dir.exists("src.qrc") || dir.exists("components")) {
+            return dir.absolutePath();
+        }
+        if (!dir.cdUp()) break;
+    }
+
+    return appDir; // 默认返回应用程序目录
+}
+
+QString LibraryEngine::musicFolder() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::MusicLocation);
+}
+
+QStringList LibraryEngine::defaultRoots() const
+{
+    QStringList roots { defaultProjectRoot() };
+    const QString music = musicFolder();
+    if (!music.isEmpty()) roots.append(QDir::cleanPath(music));
+    return roots;
+}
+
+QStringList LibraryEngine::scanMusicFiles(const QString &rootPath, bool recursive)
+{
+    TRACE_SCOPE("library.scanMusicFiles");
+    QStringList musicFiles;
+    if (rootPath.isEmpty()) return musicFiles;
+
+    const QString normalized = normalizePath(rootPath);
+    QDir dir(normalized);
+    if (!dir.exists()) return musicFiles;
+
+    // 逐目录遍历，同时记下目录快照供文件监控做增量对比
+    QHash<QString, DirectorySnapshot> snapshots;
+    musicFiles = LibraryScanner::walkTree(normalized, recursive, &snapshots);
+    m_snapshots.insert(snapshots);
+
+    return musicFiles;
+}
+
+void LibraryEngine::addFiles(const QStringList &files)
+{
+    for (const QString &file : files) m_cachedFiles.insert(file);
+}
+
+void LibraryEngine::clearCache()
+{
+    m_cachedFiles.clear();
+    m_scanFiles.clear();
+    m_scanKey.clear();
+    m_scanComplete = false;
+}
+
+// ---------------------- 异步扫描 ----------------------
+QString LibraryEngine::scanKey(const QStringList &roots, bool recursive)
+{
+    return roots.join(QLatin1Char('\n')) + (recursive ? QStringLiteral("\n+r") : QStringLiteral("\n-r"));
+}
+
+void LibraryEngine::startScan(const QStringList &roots, bool recursive)
+{
+    // 新的一组根目录：顶替未完成的上一次扫描，并为其参与者补发结束信号，使其照常进入监控
+    // 文件集合保留，其他视图仍在使用
+    if (m_scanner->isRunning()) {
+        m_scanner->cancel();
+        TRACE_ASYNC_END("library.scan", qHash(m_scanKey));
+        emit scanFinished(m_scanKey, int(m_scanFiles.size()), m_scanClock.elapsed());
+    }
+    m_scanKey = scanKey(roots, recursive);
+    m_scanRoots = roots;
+    m_scanFiles.clear();
+    m_scanComplete = false;
+    m_scanUsers = 1;
+    m_scanClock.start();
+    TRACE_ASYNC_BEGIN("library.scan", qHash(m_scanKey));
+    m_scanner->start(roots, recursive);
+}
+
+void LibraryEngine::retainScan(const QString &key)
+{
+    if (key.isEmpty() || key != m_scanKey || !m_scanner->isRunning()) return;
+    ++m_scanUsers;
+}
+
+void LibraryEngine::releaseScan(const QString &key)
+{
+    if (key.isEmpty() || key != m_scanKey || !m_scanner->isRunning()) return;
+    if (--m_scanUsers > 0) return;
+    m_scanner->cancel();
+    TRACE_ASYNC_END("library.scan", qHash(m_scanKey));
+}
+
+bool LibraryEngine::isScanning() const
+{
+    return m_scanner->isRunning();
+}
+
+bool LibraryEngine::scanReusable(const QString &key) const
+{
+    if (key.isEmpty() || key != m_scanKey) return false;
+    if (m_scanner->isRunning()) return true;
+    if (!m_scanComplete) return false;
+    // 已完成的结果只有在监控覆盖其全部根目录时才保持最新
+    for (const QString &root : m_scanRoots) {
+        bool covered = false;
+        for (auto it = m_rootRefs.cbegin(); it != m_rootRefs.cend() && !covered; ++it) covered = isUnder(root, it.key());
+        if (!covered) return false;
+    }
+    return true;
+}
+
+QStringList LibraryEngine::scannedFiles() const
+{
+    // 监控期间已删除的文件不再交出
+    QStringList files;
+    files.reserve(m_scanFiles.size());
+    for (const QString &file : m_scanFiles) {
+        if (m_cachedFiles.contains(file)) files.append(file);
+    }
+    return files;
+}
+
+void LibraryEngine::onScanBatch(const QStringList &files)
+{
+    for (const QString &file : files) m_cachedFiles.insert(file);
+    m_scanFiles.append(files);
+    TRACE_COUNTER("library.scannedFiles", m_scanFiles.size());
+    emit scanBatch(files);
+}
+
+void LibraryEngine::onScanFinished(int count, qint64 elapsedMs)
+{
+    m_scanComplete = true;
+    TRACE_ASYNC_END("library.scan", qHash(m_scanKey));
+    // 扫描期间已列举的目录直接作为监控基线，无需再遍历一遍
+    m_snapshots.insert(m_scanner->takeSnapshots());
+    for (auto it = m_rootRefs.cbegin(); it != m_rootRefs.cend(); ++it) watchTree(it.key());
+    m_scanUsers = 0;
+    emit scanFinished(m_scanKey, count, elapsedMs);
+}
+
+// 查找与音源同名同目录的 LRC，或项目根目录回退
+QString LibraryEngine::findLyricsFileForSource(const QString &source)
+{
+    TRACE_SCOPE("lyrics.findFile");
+    if (source.isEmpty()) return QString();
+
+    // 优先：同名同目录
+    auto trySameDir = [&](const QString &localPath) -> QString {
+        QFileInfo fi(localPath);
+        if (!fi.exists()) return QString();
+        // 索引中记录过的歌词路径：仍存在则直接使用，省去目录列举
+        MetadataIndex &index = MetadataIndex::instance();
+        const QString cached = index.value(localPath).value("lyricsPath").toString();
+        if (!cached.isEmpty() && QFile::exists(cached)) {
+            return QUrl::fromLocalFile(cached).toString();
+        }
+        QString candidate = fi.dir().absoluteFilePath(fi.completeBaseName() + ".lrc");
+        if (QFile::exists(candidate)) {
+            index.merge(localPath, QVariantMap{{"lyricsPath", candidate}});
+            return QUrl::fromLocalFile(candidate).toString();
+        }
+        // 兼容：若同名未命中且目录内只有一个 .lrc，则使用该文件
+        QStringList lrcs = fi.dir().entryList(QStringList() << "*.lrc", QDir::Files, QDir::Name);
+        if (lrcs.size() == 1) {
+            QString onlyLrc = fi.dir().absoluteFilePath(lrcs.first());
+            if (QFile::exists(onlyLrc)) {
+                index.merge(localPath, QVariantMap{{"lyricsPath", onlyLrc}});
+                return QUrl::fromLocalFile(onlyLrc).toString();
+            }
+        }
+        return QString();
+    };
+
+    if (source.startsWith("file:///")) {
+        QUrl u(source);
+        QString localPath = u.toLocalFile();
+        QString hit = trySameDir(localPath);
+        if (!hit.isEmpty()) return hit;
+    } else if (source.startsWith("qrc:/")) {
+        // qrc: 路径下尝试根据文件名在项目根目录匹配
+        QUrl u(source);
+        QFileInfo fi(u.path());
+        QString baseName = fi.completeBaseName();
+        const QString root = defaultProjectRoot();
+        QString candidate = QDir(root).absoluteFilePath(baseName + ".lrc");
+        if (QFile::exists(candidate)) {
+            return QUrl::fromLocalFile(candidate).toString();
+        }
+    } else {
+        // 普通本地路径
+        QString hit = trySameDir(source);
+        if (!hit.isEmpty()) return hit;
+    }
+
+    // 回退：项目根目录第一个 .lrc 文件（避免完全无歌词）
+    const QString root = defaultProjectRoot();
+    QDirIterator it(root, QStringList() << "*.lrc", QDir::Files, QDirIterator::NoIteratorFlags);
+    if (it.hasNext()) {
+        QString p = it.next();
+        return QUrl::fromLocalFile(p).toString();
+    }
+    return QString();
+}
+
+// 读取歌词文本（按 BOM / UTF-8 / UTF-16 / GB18030 识别编码）
+QString LibraryEngine::loadLyricsText(const QString &source)
+{
+    TRACE_SCOPE("lyrics.loadText");
+    QString lrcUrl = findLyricsFileForSource(source);
+    if (lrcUrl.isEmpty()) return QString();
+    QUrl u(lrcUrl);
+    QString lrcPath = u.toLocalFile();
+    if (lrcPath.isEmpty()) {
+        // 兜底：如果传入的就是本地路径
+        lrcPath = lrcUrl;
+    }
+    QFile f(lrcPath);
+    if (!f.exists()) return QString();
+    if (f.open(QIODevice::ReadOnly)) {
+        return LyricsDocument::decode(f.readAll());
+    }
+    return QString();
+}
+
+QVariantMap LibraryEngine::getMetadata(const QString &source)
+{
+    // 内存缓存未命中时直接由持久化索引应答（时间戳校验在预取阶段完成）
+    auto it = m_metaCache.constFind(source);
+    if (it != m_metaCache.constEnd()) return it.value();
+    return MetadataIndex::instance().value(source);
+}
+
+bool LibraryEngine::needsRead(const QString &source, QString *local)
+{
+    *local = normalizePath(source);
+    if (local->isEmpty()) return false;
+    if (m_prefetchPending.contains(*local) || m_metaCache.contains(*local)) return false;
+    if (!LibraryScanner::hasMusicSuffix(*local)) return false;
+    const FileStamp stamp = FileStamp::of(*local);
+    if (!stamp.isFile) return false;
+    // 索引命中且 mtime/size/inode 未变：getMetadata 已能同步取得，无需重新解析
+    QVariantMap indexed;
+    if (MetadataIndex::instance().lookup(*local, stamp, &indexed)) {
+        m_metaCache.insert(*local, indexed);
+        return false;
+    }
+    return true;
+}
+
+void LibraryEngine::prefetchMetadata(const QStringList &files)
+{
+    QStringList pending;
+    QString local;
+    for (const QString &f : files) {
+        if (!needsRead(f, &local)) continue;
+        m_prefetchPending.insert(local);
+        pending.append(local);
+    }
+    if (!pending.isEmpty()) MetadataService::instance().prefetch(pending);
+}
+
+void LibraryEngine::prefetchViewport(QObject *view, const QStringList &visible, const QStringList &nearby)
+{
+    // 已交给服务的路径仍需随视口重新分级，只跳过已有元数据的
+    auto filter = [this](const QStringList &sources) {
+        QStringList result;
+        QString local;
+        for (const QString &source : sources) {
+            if (needsRead(source, &local)) {
+                m_prefetchPending.insert(local);
+                result.append(local);
+            } else if (m_prefetchPending.contains(local)) {
+                result.append(local);
+            }
+        }
+        return result;
+    };
+    MetadataService::instance().setViewport(view, filter(visible), filter(nearby));
+}
+
+void LibraryEngine::onMetadataRead(const QString &path, const TrackMetadata &meta)
+{
+    // 服务的每次读取（预取或播放器请求）都回填存储并通知各视图
+    const QVariantMap map = meta.toVariantMap();
+    m_prefetchPending.remove(path);
+    m_metaCache.insert(path, map);
+    emit metadataReady(path, map);
+}
+
+// ---------------------- 文件监控 ----------------------
+void LibraryEngine::retainRoot(const QString &root)
+{
+    if (root.isEmpty() || !QFileInfo(root).isDir()) return;
+    if (m_rootRefs[root]++ > 0) return;
+    // 扫描进行中：等扫描结束后直接用其目录快照注册，避免重复遍历
+    if (m_scanner->isRunning()) return;
+    // 递归监控全部子目录；事件只触发对应目录的增量重扫
+    watchTree(root);
+}
+
+void LibraryEngine::releaseRoot(const QString &root)
+{
+    auto it = m_rootRefs.find(root);
+    if (it == m_rootRefs.end()) return;
+    if (--it.value() > 0) return;
+    m_rootRefs.erase(it);
+    unwatchTree(root);
+    if (m_rootRefs.isEmpty()) {
+        m_dirtyDirs.clear();
+        m_scanTimer->stop();
+    }
+}
+
+// 新增：文件监控槽函数
+void LibraryEngine::onDirectoryChanged(const QString &path)
+{
+    // 只记录发生变化的目录；目录被删除时由父目录的重扫负责移除
+    m_dirtyDirs.insert(path);
+    TRACE_COUNTER("library.pendingRescans", m_dirtyDirs.size());
+
+    // 不重启定时器：持续的事件风暴下也能在固定延迟内得到处理
+    if (!m_scanTimer->isActive()) m_scanTimer->start();
+}
+
+void LibraryEngine::onFileChanged(const QString &path)
+{
+    // 文件本身不单独监控，归并为所在目录的变化
+    onDirectoryChanged(QFileInfo(path).absolutePath());
+}
+
+void LibraryEngine::performDelayedScan()
+{
+    if (m_rootRefs.isEmpty()) return;
+    TRACE_SCOPE("library.rescan");
+
+    // 父目录先于子目录处理，子目录的变化可被父目录的结果覆盖
+    QStringList dirs = m_dirtyDirs.values();
+    m_dirtyDirs.clear();
+    TRACE_COUNTER("library.pendingRescans", 0);
+    std::sort(dirs.begin(), dirs.end());
+
+    QStringList addedFiles;
+    QStringList removedFiles;
+    for (const QString &dir : std::as_const(dirs)) {
+        rescanDirectory(dir, addedFiles, removedFiles);
+    }
+
+    // 新增文件并入最近一次扫描的结果，后加入的视图取到的列表保持最新
+    for (const QString &file : std::as_const(addedFiles)) {
+        for (const QString &root : std::as_const(m_scanRoots)) {
+            if (!isUnder(file, root)) continue;
+            m_scanFiles.append(file);
+            break;
+        }
+    }
+
+    // 只发送增量信号，代价与变化量成正比
+    for (const QString &file : std::as_const(removedFiles)) {
+        emit fileRemoved(file);
+    }
+    for (const QString &file : std::as_const(addedFiles)) {
+        emit fileAdded(file);
+    }
+}
+
+
+void LibraryEngine::rescanDirectory(const QString &dir, QStringList &added, QStringList &removed)
+{
+    if (!QFileInfo(dir).isDir()) {
+        forgetDirectory(dir, removed);
+        return;
+    }
+    auto it = m_snapshots.find(dir);
+    if (it == m_snapshots.end()) return; // 已被父目录的处理移除
+
+    const DirectorySnapshot fresh = LibraryScanner::snapshotDirectory(dir);
+    const DirectorySnapshot old = it.value();
+    it.value() = fresh;
+
+    QStringList modified;
+    for (auto f = fresh.files.cbegin(); f != fresh.files.cend(); ++f) {
+        const QString path = dir + QLatin1Char('/') + f.key();
+        auto o = old.files.constFind(f.key());
+        if (o == old.files.cend()) {
+            m_cachedFiles.insert(path);
+            added.append(path);
+        } else if (o.value() != f.value() && m_metaCache.contains(path)) {
+            // 内容被改写：丢弃旧元数据并重新读取
+            m_metaCache.remove(path);
+            MetadataService::instance().invalidate(path);
+            modified.append(path);
+        }
+    }
+    for (auto o = old.files.cbegin(); o != old.files.cend(); ++o) {
+        if (fresh.files.contains(o.key())) continue;
+        const QString path = dir + QLatin1Char('/') + o.key();
+        m_cachedFiles.remove(path);
+        m_metaCache.remove(path);
+        removed.append(path);
+    }
+    if (!modified.isEmpty()) prefetchMetadata(modified);
+
+    // 子目录增删：新目录整棵纳入监控，消失的目录整棵移除
+    const QSet<QString> oldSubdirs(old.subdirs.cbegin(), old.subdirs.cend());
+    const QSet<QString> freshSubdirs(fresh.subdirs.cbegin(), fresh.subdirs.cend());
+    for (const QString &sub : old.subdirs) {
+        if (!freshSubdirs.contains(sub)) forgetDirectory(sub, removed);
+    }
+    for (const QString &sub : fresh.subdirs) {
+        if (oldSubdirs.contains(sub)) continue;
+        QHash<QString, DirectorySnapshot> snapshots;
+        const QStringList files = LibraryScanner::walkTree(sub, true, &snapshots);
+        m_snapshots.insert(snapshots);
+        for (const QString &file : files) {
+            if (m_cachedFiles.contains(file)) continue;
+            m_cachedFiles.insert(file);
+            added.append(file);
+        }
+        watchTree(sub);
+    }
+}
+
+void LibraryEngine::forgetDirectory(const QString &dir, QStringList &removed)
+{
+    auto it = m_snapshots.find(dir);
+    if (it != m_snapshots.end()) {
+        const DirectorySnapshot snapshot = it.value();
+        m_snapshots.erase(it);
+        for (auto f = snapshot.files.cbegin(); f != snapshot.files.cend(); ++f) {
+            const QString path = dir + QLatin1Char('/') + f.key();
+            if (!m_cachedFiles.remove(path)) continue;
+            m_metaCache.remove(path);
+            removed.append(path);
+        }
+        for (const QString &sub : snapshot.subdirs) forgetDirectory(sub, removed);
+    }
+    if (m_watchedDirs.remove(dir)) m_watcher->removePath(dir);
+}
+
+void LibraryEngine::watchTree(const QString &root)
+{
+    // 基于快照展开整棵目录树；缺少快照时同步补齐
+    TRACE_SCOPE("library.watchTree");
+    if (!m_snapshots.contains(root)) {
+        QHash<QString, DirectorySnapshot> snapshots;
+        LibraryScanner::walkTree(root, true, &snapshots);
+        m_snapshots.insert(snapshots);
+    }
+    QStringList toWatch;
+    QStringList stack { root };
+    while (!stack.isEmpty()) {
+        const QString dir = stack.takeLast();
+        auto it = m_snapshots.constFind(dir);
+        if (it == m_snapshots.cend()) continue;
+        if (!m_watchedDirs.contains(dir)) {
+            m_watchedDirs.insert(dir);
+            toWatch.append(dir);
+        }
+        stack.append(it->subdirs);
+    }
+    if (!toWatch.isEmpty()) m_watcher->addPaths(toWatch);
+}
+
+void LibraryEngine::unwatchTree(const QString &root)
+{
+    // 只注销不再被任何其他根目录覆盖的目录（根目录可能相互嵌套）
+    QStringList toRemove;
+    for (auto it = m_watchedDirs.begin(); it != m_watchedDirs.end();) {
+        bool keep = !isUnder(*it, root);
+        for (auto r = m_rootRefs.cbegin(); r != m_rootRefs.cend() && !keep; ++r) keep = isUnder(*it, r.key());
+        if (keep) {
+            ++it;
+        } else {
+            toRemove.append(*it);
+            it = m_watchedDirs.erase(it);
+        }
+    }
+    if (!toRemove.isEmpty()) m_watcher->removePaths(toRemove);
+}
+
+bool LibraryEngine::isValidMusicFile(const QString &filePath)
+{
+    QString local = filePath;
+    if (filePath.startsWith("file:")) {
+        QUrl u(filePath);
+        if (u.isValid()) local = u.toLocalFile();
+    }
+    // 先做廉价的扩展名判断，再 stat（isFile 已隐含 exists）
+    if (!LibraryScanner::hasMusicSuffix(local)) {
+        return false;
+    }
+    return QFileInfo(local).isFile();
+}
@@ -0,0 +1,119 @@
+// core/libraryengine.h
+#ifndef CORE_LIBRARYENGINE_H
+#define CORE_LIBRARYENGINE_H
+
+// 进程内共享的音乐库引擎：一次扫描、一套目录监控（按根目录引用计数）、一份元数据存储
+// QML 中的每个 MusicLibrary 只是轻量外观，转发调用并按各自的扫描与监控范围转发信号
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+#include "core/libraryscanner.h"
+#include "core/metadataservice.h"
+
+class QFileSystemWatcher;
+class QTimer;
+
+class LibraryEngine : public QObject
+{
+    Q_OBJECT
+public:
+    static LibraryEngine &instance();
+
+    // 本地路径或 file: URL -> 清理后的本地路径
+    static QString normalizePath(const QString &path);
+    // path 是否为 root 本身或位于其下
+    static bool isUnder(const QString &path, const QString &root);
+    static bool isValidMusicFile(const QString &filePath);
+
+    QString defaultProjectRoot() const;
+    QString musicFolder() const;
+    // 项目目录在前，与 scanAllAvailableMusic 的合并顺序一致
+    QStringList defaultRoots() const;
+
+    // 同步遍历；目录快照同时作为监控基线
+    QStringList scanMusicFiles(const QString &rootPath, bool recursive = true);
+    void addFiles(const QStringList &files);
+
+    // 异步扫描：同一组根目录同时只扫描一次；后加入者先取 scannedFiles()，再接收后续批次
+    // 进行中的扫描按参与的视图引用计数：最后一个参与者退出才真正取消；
+    // 被另一组根目录的扫描顶替时，以已到达的文件数为所有参与者补发 scanFinished
+    static QString scanKey(const QStringList &roots, bool recursive);
+    void startScan(const QStringList &roots, bool recursive);
+    // 加入进行中的同一扫描；已完成或 key 不符时什么也不做
+    void retainScan(const QString &key);
+    void releaseScan(const QString &key);
+    bool isScanning() const;
+    QString currentScanKey() const { return m_scanKey; }
+    // 该扫描正在进行，或已完成且仍有目录监控保持其结果为最新
+    bool scanReusable(const QString &key) const;
+    QStringList scannedFiles() const;
+
+    // 目录监控按根目录引用计数：首个使用者注册整棵目录树，最后一个释放时注销
+    void retainRoot(const QString &root);
+    void releaseRoot(const QString &root);
+
+    void clearCache();
+    int cachedFileCount() const { return int(m_cachedFiles.size()); }
+    QStringList cachedFiles() const { return m_cachedFiles.values(); }
+
+    QString findLyricsFileForSource(const QString &source);
+    QString loadLyricsText(const QString &source);
+    QVariantMap getMetadata(const QString &source);
+    // 后台预取，排在任何视口请求之后
+    void prefetchMetadata(const QStringList &files);
+    // view 的可见行与附近行：交给 MetadataService 按优先级调度，离开视口的请求被取消
+    void prefetchViewport(QObject *view, const QStringList &visible, const QStringList &nearby);
+
+signals:
+    void fileAdded(const QString &filePath);
+    void fileRemoved(const QString &filePath);
+    void metadataReady(const QString &source, const QVariantMap &meta);
+    void scanBatch(const QStringList &files);
+    void scanFinished(const QString &key, int count, qint64 elapsedMs);
+
+private slots:
+    void onDirectoryChanged(const QString &path);
+    void onFileChanged(const QString &path);
+    void performDelayedScan();
+    void onScanBatch(const QStringList &files);
+    void onScanFinished(int count, qint64 elapsedMs);
+    void onMetadataRead(const QString &path, const TrackMetadata &meta);
+
+private:
+    explicit LibraryEngine(QObject *parent = nullptr);
+    // 增量监控：按目录快照对比，只处理发生变化的目录
+    void watchTree(const QString &root);
+    void unwatchTree(const QString &root);
+    void rescanDirectory(const QString &dir, QStringList &added, QStringList &removed);
+    void forgetDirectory(const QString &dir, QStringList &removed);
+    // 尚无元数据且需要读取文件：已在索引中的顺便装入内存存储
+    bool needsRead(const QString &source, QString *local);
+
+    // 元数据预取：读取由 MetadataService 在线程池中完成，此处只记录已交出的路径
+    QSet<QString> m_prefetchPending;
+    QHash<QString, QVariantMap> m_metaCache;
+
+    LibraryScanner *m_scanner;
+    QString m_scanKey;                                  // 最近一次异步扫描
+    QStringList m_scanRoots;
+    QStringList m_scanFiles;                            // 其已发出的文件，按到达顺序
+    bool m_scanComplete = false;
+    int m_scanUsers = 0;                                // 进行中扫描的参与视图数
+    QElapsedTimer m_scanClock;
+
+    QFileSystemWatcher *m_watcher;
+    QTimer *m_scanTimer;
+    QSet<QString> m_cachedFiles;
+    QHash<QString, int> m_rootRefs;                     // 监控根目录 -> 引用数
+    QSet<QString> m_watchedDirs;                        // 实际注册到 watcher 的全部目录
+    QHash<QString, DirectorySnapshot> m_snapshots;      // 目录 -> 上次列举结果
+    QSet<QString> m_dirtyDirs;                          // 等待增量重扫的目录
+    static const int SCAN_DELAY_MS = 300; // 合并短时间内的事件风暴；单次只重扫变化的目录
+};
+
+#endif // CORE_LIBRARYENGINE_H
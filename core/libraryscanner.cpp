@@ -0,0 +1,214 @@
+// 实现文件：LibraryScanner —— 线程池并行目录遍历 + 分批回送
+#include "core/libraryscanner.h"
+#include "core/trace.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QThread>
+
+#include <atomic>
+#include <utility>
+
+struct LibraryScanner::Job
+{
+    std::atomic_bool cancelled { false };
+    std::atomic_int outstanding { 0 };   // 尚未完成的目录任务数
+    bool recursive = true;
+    QElapsedTimer timer;
+
+    QMutex mutex;                        // 保护以下字段
+    QStringList pending;
+    QSet<QString> seen;                  // 多个根目录重叠时去重
+    QHash<QString, DirectorySnapshot> snapshots;
+    bool deliveryQueued = false;
+    int total = 0;
+};
+
+LibraryScanner::LibraryScanner(QObject *parent)
+    : QObject(parent)
+{
+    // 目录遍历以 IO 为主，线程数略高于核心数以覆盖网络盘延迟
+    m_pool.setMaxThreadCount(qBound(2, QThread::idealThreadCount() * 2, 16));
+}
+
+LibraryScanner::~LibraryScanner()
+{
+    cancel();
+    m_pool.waitForDone();
+}
+
+const QStringList &LibraryScanner::musicExtensions()
+{
+    static const QStringList extensions = { "mp3", "m4a", "flac", "wav", "ogg", "aac", "wma" };
+    return extensions;
+}
+
+bool LibraryScanner::hasMusicSuffix(const QString &fileName)
+{
+    static const QSet<QString> suffixes(musicExtensions().cbegin(), musicExtensions().cend());
+    const qsizetype dot = fileName.lastIndexOf(QLatin1Char('.'));
+    if (dot < 0) return false;
+    return suffixes.contains(fileName.mid(dot + 1).toLower());
+}
+
+DirectorySnapshot LibraryScanner::snapshotDirectory(const QString &path, QStringList *files)
+{
+    DirectorySnapshot snapshot;
+    QDirIterator it(path, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo info = it.fileInfo();
+        if (info.isDir()) {
+            if (!info.isSymLink()) snapshot.subdirs.append(info.filePath());
+        } else if (hasMusicSuffix(info.fileName())) {
+            snapshot.files.insert(info.fileName(), info.lastModified().toMSecsSinceEpoch());
+            if (files) files->append(info.filePath());
+        }
+    }
+    return snapshot;
+}
+
+QStringList LibraryScanner::walkTree(const QString &root, bool recursive, QHash<QString, DirectorySnapshot> *snapshots)
+{
+    QStringList files;
+    QStringList stack { root };
+    while (!stack.isEmpty()) {
+        const QString dir = stack.takeLast();
+        const DirectorySnapshot snapshot = snapshotDirectory(dir, &files);
+        if (recursive) {
+            // 逆序入栈，保持子目录按列举顺序出栈
+            for (qsizetype i = snapshot.subdirs.size() - 1; i >= 0; --i) stack.append(snapshot.subdirs.at(i));
+        }
+        if (snapshots) snapshots->insert(dir, snapshot);
+    }
+    return files;
+}
+
+QHash<QString, DirectorySnapshot> LibraryScanner::takeSnapshots()
+{
+    return std::exchange(m_snapshots, {});
+}
+
+void LibraryScanner::start(const QStringList &roots, bool recursive)
+{
+    cancel();
+    auto job = std::make_shared<Job>();
+    job->recursive = recursive;
+    job->timer.start();
+    m_job = job;
+
+    QStringList dirs;
+    for (const QString &root : roots) {
+        if (root.isEmpty() || dirs.contains(root) || !QFileInfo(root).isDir()) continue;
+        dirs.append(root);
+    }
+    if (dirs.isEmpty()) {
+        QMetaObject::invokeMethod(this, [this, job]() { finish(job); }, Qt::QueuedConnection);
+        return;
+    }
+    job->outstanding = int(dirs.size());
+    for (const QString &dir : dirs) {
+        m_pool.start([this, job, dir]() { scanDirectory(job, dir); });
+    }
+}
+
+void LibraryScanner::cancel()
+{
+    if (!m_job) return;
+    m_job->cancelled = true;
+    m_job.reset();
+}
+
+void LibraryScanner::scanDirectory(const std::shared_ptr<Job> &job, const QString &path)
+{
+    TRACE_SCOPE("scanner.directory");
+    QStringList local;
+    DirectorySnapshot snapshot;
+    if (!job->cancelled) {
+        QDirIterator it(path, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+        while (it.hasNext() && !job->cancelled) {
+            it.next();
+            const QFileInfo info = it.fileInfo();
+            if (info.isDir()) {
+                // 不跟随符号链接目录，避免环路；子目录交给线程池，由空闲线程领取
+                if (info.isSymLink()) continue;
+                const QString sub = info.filePath();
+                snapshot.subdirs.append(sub);
+                if (!job->recursive) continue;
+                ++job->outstanding;
+                m_pool.start([this, job, sub]() { scanDirectory(job, sub); });
+            } else if (hasMusicSuffix(info.fileName())) {
+                // 同时记录 mtime，供文件监控做增量对比
+                snapshot.files.insert(info.fileName(), info.lastModified().toMSecsSinceEpoch());
+                local.append(info.filePath());
+                if (local.size() >= BATCH_SIZE) flush(job, local);
+            }
+        }
+    }
+    flush(job, local);
+    if (!job->cancelled) {
+        QMutexLocker lock(&job->mutex);
+        job->snapshots.insert(path, snapshot);
+    }
+    if (--job->outstanding == 0) {
+        QMetaObject::invokeMethod(this, [this, job]() { finish(job); }, Qt::QueuedConnection);
+    }
+}
+
+void LibraryScanner::flush(const std::shared_ptr<Job> &job, QStringList &local)
+{
+    if (local.isEmpty() || job->cancelled) {
+        local.clear();
+        return;
+    }
+    bool post = false;
+    {
+        QMutexLocker lock(&job->mutex);
+        for (const QString &file : std::as_const(local)) {
+            if (job->seen.contains(file)) continue;
+            job->seen.insert(file);
+            job->pending.append(file);
+        }
+        // 同一时刻最多一个待处理的投递事件，其余结果合并进同一批
+        if (!job->deliveryQueued && !job->pending.isEmpty()) {
+            job->deliveryQueued = true;
+            post = true;
+        }
+    }
+    local.clear();
+    if (post) {
+        QMetaObject::invokeMethod(this, [this, job]() { deliver(job); }, Qt::QueuedConnection);
+    }
+}
+
+void LibraryScanner::deliver(const std::shared_ptr<Job> &job)
+{
+    QStringList batch;
+    {
+        QMutexLocker lock(&job->mutex);
+        batch.swap(job->pending);
+        job->deliveryQueued = false;
+        job->total += int(batch.size());
+    }
+    if (job != m_job || batch.isEmpty()) return;
+    emit batchReady(batch);
+}
+
+void LibraryScanner::finish(const std::shared_ptr<Job> &job)
+{
+    if (job != m_job) return;
+    deliver(job);
+    int total = 0;
+    {
+        QMutexLocker lock(&job->mutex);
+        total = job->total;
+        m_snapshots = std::move(job->snapshots);
+    }
+    m_job.reset();
+    emit finished(total, job->timer.elapsed());
+}
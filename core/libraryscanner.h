@@ -0,0 +1,60 @@
+// core/libraryscanner.h
+#ifndef CORE_LIBRARYSCANNER_H
+#define CORE_LIBRARYSCANNER_H
+
+// 并行音乐库扫描：每个子目录作为独立任务投递到线程池，空闲线程自动接手剩余目录
+// 结果分批回送到 GUI 线程，首批数据在首个目录列出后即可渲染
+#include <QObject>
+#include <QStringList>
+#include <QHash>
+#include <QThreadPool>
+
+#include <memory>
+
+// 单个目录的快照：直接包含的音乐文件（文件名 -> mtime 毫秒）与子目录
+struct DirectorySnapshot
+{
+    QHash<QString, qint64> files;
+    QStringList subdirs;
+};
+
+class LibraryScanner : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LibraryScanner(QObject *parent = nullptr);
+    ~LibraryScanner() override;
+
+    // 开始扫描（会取消尚未完成的上一次扫描）
+    void start(const QStringList &roots, bool recursive = true);
+    void cancel();
+    bool isRunning() const { return m_job != nullptr; }
+
+    // 最近一次完成的扫描所得目录快照（取走后清空）
+    QHash<QString, DirectorySnapshot> takeSnapshots();
+
+    static bool hasMusicSuffix(const QString &fileName);
+    static const QStringList &musicExtensions();
+    // 同步列举单个目录（不递归）；files 非空时按列举顺序追加音乐文件完整路径
+    static DirectorySnapshot snapshotDirectory(const QString &path, QStringList *files = nullptr);
+    // 同步遍历目录树：按目录遍历顺序返回音乐文件，并写入每个目录的快照
+    static QStringList walkTree(const QString &root, bool recursive, QHash<QString, DirectorySnapshot> *snapshots);
+
+signals:
+    void batchReady(const QStringList &files);
+    void finished(int count, qint64 elapsedMs);
+
+private:
+    struct Job;
+    void scanDirectory(const std::shared_ptr<Job> &job, const QString &path);
+    void flush(const std::shared_ptr<Job> &job, QStringList &local);
+    void deliver(const std::shared_ptr<Job> &job);
+    void finish(const std::shared_ptr<Job> &job);
+
+    QThreadPool m_pool;
+    std::shared_ptr<Job> m_job;
+    QHash<QString, DirectorySnapshot> m_snapshots;
+    static const int BATCH_SIZE = 128; // 单个目录内累计多少条后提前回送
+};
+
+#endif // CORE_LIBRARYSCANNER_H
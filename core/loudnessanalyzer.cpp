@@ -0,0 +1,586 @@
+// 实现文件：LoudnessAnalyzer —— K 加权与双门限积分响度、真峰值插值、ReplayGain 标签回退与调度
+#include "core/loudnessanalyzer.h"
+#include "core/libraryengine.h"
+#include "core/libraryscanner.h"
+#include "core/metadataindex.h"
+#include "core/metadataservice.h"
+#include "core/tagreader.h"
+#include "core/trace.h"
+
+#include <QAudioBuffer>
+#include <QAudioDecoder>
+#include <QAudioFormat>
+#include <QCoreApplication>
+#include <QDir>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QPointer>
+#include <QThread>
+#include <QUrl>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const int kAnalysisRate = 48000;       // BS.1770 的滤波器系数与真峰值插值器均以 48kHz 给出
+const int kChannels = 2;               // 与播放输出一致：单声道按双声道、多声道取前两路
+const int kSubBlocksPerBlock = 4;      // 400ms 门限块 = 4 个 100ms 子块，相邻块重叠 75%
+const double kAbsoluteGate = -70.0;    // LUFS
+const double kRelativeGate = -10.0;    // LU
+const int kMaxAlbumFiles = 64;         // 目录中音乐文件超过此数时不视为一张专辑
+const int kLanes = 8;
+const int kPhases = 4;
+const int kTaps = 12;
+
+// BS.1770-4 附录 2：4 倍过采样的 48 阶插值滤波器，按相位拆分
+const float kTruePeakFilter[kPhases][kTaps] = {
+    { 0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f, -0.0594482421875f, 0.1373291015625f,
+      0.9721679687500f, -0.1022949218750f, 0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f },
+    { -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f, -0.1665039062500f, 0.4650878906250f,
+      0.7797851562500f, -0.2003173828125f, 0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f },
+    { -0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f, -0.2003173828125f, 0.7797851562500f,
+      0.4650878906250f, -0.1665039062500f, 0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f },
+    { -0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f, -0.1022949218750f, 0.9721679687500f,
+      0.1373291015625f, -0.0594482421875f, 0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f },
+};
+
+struct Biquad
+{
+    double b0, b1, b2, a1, a2;
+};
+
+// 由双线性变换按实际采样率求 K 加权的两级滤波器（高搁架 + RLB 高通），48kHz 时即标准给出的系数
+void kWeighting(double rate, Biquad *shelf, Biquad *highPass)
+{
+    const double pi = 3.14159265358979323846;
+    const double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+    const double vb = std::pow(vh, 0.4996667741545416);
+    double q = 0.7071752369554196;
+    double k = std::tan(pi * 1681.974450955533 / rate);
+    double a0 = 1.0 + k / q + k * k;
+    *shelf = { (vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0,
+               2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0 };
+    q = 0.5003270373238773;
+    k = std::tan(pi * 38.13547087602444 / rate);
+    a0 = 1.0 + k / q + k * k;
+    *highPass = { 1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0 };
+}
+
+// 解码端若未按请求格式输出，在此统一为交错立体声浮点
+void toStereo(const QAudioBuffer &buffer, std::vector<float> &out)
+{
+    const QAudioFormat format = buffer.format();
+    const int srcChannels = std::max(1, format.channelCount());
+    const qsizetype frames = buffer.frameCount();
+    out.resize(size_t(frames) * kChannels);
+
+    auto convert = [&](auto sampleAt) {
+        float *dst = out.data();
+        for (qsizetype f = 0; f < frames; ++f, dst += kChannels) {
+            const qsizetype base = f * srcChannels;
+            for (int c = 0; c < kChannels; ++c) dst[c] = sampleAt(base + std::min(c, srcChannels - 1));
+        }
+    };
+    switch (format.sampleFormat()) {
+    case QAudioFormat::Float: {
+        const float *data = buffer.constData<float>();
+        if (srcChannels == kChannels) {
+            std::memcpy(out.data(), data, out.size() * sizeof(float));
+        } else {
+            convert([data](qsizetype i) { return data[i]; });
+        }
+        break;
+    }
+    case QAudioFormat::Int16: {
+        const qint16 *data = buffer.constData<qint16>();
+        convert([data](qsizetype i) { return data[i] / 32768.0f; });
+        break;
+    }
+    case QAudioFormat::Int32: {
+        const qint32 *data = buffer.constData<qint32>();
+        convert([data](qsizetype i) { return float(data[i] / 2147483648.0); });
+        break;
+    }
+    case QAudioFormat::UInt8: {
+        const quint8 *data = buffer.constData<quint8>();
+        convert([data](qsizetype i) { return (int(data[i]) - 128) / 128.0f; });
+        break;
+    }
+    default:
+        out.clear();
+        break;
+    }
+}
+
+// 交错立体声的测量器：K 加权后累加 100ms 子块的均方，同时跟踪真峰值
+class Meter
+{
+public:
+    void start(int rate)
+    {
+        m_rate = rate;
+        kWeighting(rate, &m_shelf, &m_highPass);
+        m_subBlockFrames = std::max(1, rate / 10);
+        // 采样率已达 96kHz 及以上时样本峰值与真峰值相差无几，不再插值
+        m_oversample = rate < 96000;
+        m_history.assign(size_t(kTaps - 1) * kChannels, 0.0f);
+    }
+    bool started() const { return m_rate > 0; }
+
+    void process(const float *samples, qsizetype frames)
+    {
+        measurePeak(samples, frames);
+        qsizetype done = 0;
+        while (done < frames) {
+            const qsizetype n = std::min<qsizetype>(frames - done, m_subBlockFrames - m_subBlockFill);
+            filter(samples + done * kChannels, n);
+            done += n;
+            m_subBlockFill += int(n);
+            if (m_subBlockFill == m_subBlockFrames) {
+                // 各声道权重均为 1（立体声无环绕声道）
+                m_subBlocks.push_back(m_sum / double(m_subBlockFrames));
+                m_sum = 0.0;
+                m_subBlockFill = 0;
+            }
+        }
+    }
+
+    float peak() const { return m_peak; }
+
+    // 积分响度：绝对门限筛一遍，以剩余块的平均响度 -10 LU 作相对门限再筛一遍；门限换算到能量域比较
+    bool integrate(double *lufs, qint64 *blocks) const
+    {
+        auto energyOf = [](double loudness) { return std::pow(10.0, (loudness + 0.691) / 10.0); };
+        std::vector<double> energies;
+        for (size_t j = kSubBlocksPerBlock - 1; j < m_subBlocks.size(); ++j) {
+            double sum = 0.0;
+            for (int k = 0; k < kSubBlocksPerBlock; ++k) sum += m_subBlocks[j - size_t(k)];
+            energies.push_back(sum / kSubBlocksPerBlock);
+        }
+        auto gatedMean = [&energies](double threshold, qint64 *count) {
+            double sum = 0.0;
+            qint64 n = 0;
+            for (double e : energies) {
+                if (e <= threshold) continue;
+                sum += e;
+                ++n;
+            }
+            *count = n;
+            return n > 0 ? sum / double(n) : 0.0;
+        };
+        const double absolute = energyOf(kAbsoluteGate);
+        qint64 n = 0;
+        const double ungated = gatedMean(absolute, &n);
+        if (n == 0) return false;
+        const double relative = ungated * std::pow(10.0, kRelativeGate / 10.0);
+        const double mean = gatedMean(std::max(absolute, relative), &n);
+        if (n == 0) return false;
+        *lufs = -0.691 + 10.0 * std::log10(mean);
+        *blocks = n;
+        return true;
+    }
+
+private:
+    // 两级双二阶（转置直接 II 型）；两个声道的递推互不依赖，按帧交错处理，编译器可将两路打包为一条 SIMD 运算
+    void filter(const float *x, qsizetype frames)
+    {
+        const Biquad s = m_shelf;
+        const Biquad h = m_highPass;
+        double s1[kChannels], s2[kChannels], h1[kChannels], h2[kChannels], sum[kChannels];
+        for (int c = 0; c < kChannels; ++c) {
+            s1[c] = m_state[c][0];
+            s2[c] = m_state[c][1];
+            h1[c] = m_state[c][2];
+            h2[c] = m_state[c][3];
+            sum[c] = 0.0;
+        }
+        for (qsizetype i = 0; i < frames; ++i) {
+            for (int c = 0; c < kChannels; ++c) {
+                const double in = x[i * kChannels + c];
+                const double y = s.b0 * in + s1[c];
+                s1[c] = s.b1 * in - s.a1 * y + s2[c];
+                s2[c] = s.b2 * in - s.a2 * y;
+                const double z = h.b0 * y + h1[c];
+                h1[c] = h.b1 * y - h.a1 * z + h2[c];
+                h2[c] = h.b2 * y - h.a2 * z;
+                sum[c] += z * z;
+            }
+        }
+        for (int c = 0; c < kChannels; ++c) {
+            // 静音段状态衰减到非规格化数会使递推变慢数十倍，直接归零
+            m_state[c][0] = std::fabs(s1[c]) < 1e-30 ? 0.0 : s1[c];
+            m_state[c][1] = std::fabs(s2[c]) < 1e-30 ? 0.0 : s2[c];
+            m_state[c][2] = std::fabs(h1[c]) < 1e-30 ? 0.0 : h1[c];
+            m_state[c][3] = std::fabs(h2[c]) < 1e-30 ? 0.0 : h2[c];
+            m_sum += sum[c];
+        }
+    }
+
+    // 交错布局下同一声道的前后样本相距 kChannels，插值对每个输出位置形式相同，沿样本方向 8 路并行
+    void measurePeak(const float *samples, qsizetype frames)
+    {
+        const qsizetype n = frames * kChannels;
+        float lanes[kLanes] = {};
+        if (!m_oversample) {
+            qsizetype i = 0;
+            for (; i + kLanes <= n; i += kLanes) {
+                for (int l = 0; l < kLanes; ++l) lanes[l] = std::max(lanes[l], std::fabs(samples[i + l]));
+            }
+            for (; i < n; ++i) lanes[0] = std::max(lanes[0], std::fabs(samples[i]));
+        } else {
+            // 前 kTaps-1 帧历史 + 本次样本，滤波器可直接向前取样
+            const size_t history = m_history.size();
+            m_input.resize(history + size_t(n));
+            std::memcpy(m_input.data(), m_history.data(), history * sizeof(float));
+            std::memcpy(m_input.data() + history, samples, size_t(n) * sizeof(float));
+            const float *x = m_input.data() + history;
+
+            auto interpolate = [x](qsizetype i, int p) {
+                float acc = 0.0f;
+                for (int k = 0; k < kTaps; ++k) acc += kTruePeakFilter[p][k] * x[i - k * kChannels];
+                return acc;
+            };
+            qsizetype i = 0;
+            for (; i + kLanes <= n; i += kLanes) {
+                for (int p = 0; p < kPhases; ++p) {
+                    float acc[kLanes] = {};
+                    for (int k = 0; k < kTaps; ++k) {
+                        const float tap = kTruePeakFilter[p][k];
+                        const float *src = x + i - k * kChannels;
+                        for (int l = 0; l < kLanes; ++l) acc[l] += tap * src[l];
+                    }
+                    for (int l = 0; l < kLanes; ++l) lanes[l] = std::max(lanes[l], std::fabs(acc[l]));
+                }
+            }
+            for (; i < n; ++i) {
+                for (int p = 0; p < kPhases; ++p) lanes[0] = std::max(lanes[0], std::fabs(interpolate(i, p)));
+            }
+            std::memcpy(m_history.data(), m_input.data() + n, history * sizeof(float));
+        }
+        for (int l = 0; l < kLanes; ++l) m_peak = std::max(m_peak, lanes[l]);
+    }
+
+    int m_rate = 0;
+    Biquad m_shelf {};
+    Biquad m_highPass {};
+    double m_state[kChannels][4] = {};
+    double m_sum = 0.0;
+    int m_subBlockFrames = 0;
+    int m_subBlockFill = 0;
+    std::vector<double> m_subBlocks;    // 每 100ms 的 K 加权均方（各声道之和）
+    bool m_oversample = true;
+    std::vector<float> m_history;
+    std::vector<float> m_input;
+    float m_peak = 0.0f;
+};
+
+QUrl sourceUrl(const QString &path)
+{
+    if (path.startsWith(QLatin1String("qrc:/"))) return QUrl(path);
+    if (path.startsWith(QLatin1String(":/"))) return QUrl(QStringLiteral("qrc") + path);
+    return QUrl::fromLocalFile(path);
+}
+
+} // namespace
+
+const double LoudnessAnalyzer::REFERENCE_LUFS = -18.0;
+const double LoudnessAnalyzer::PEAK_CEILING_DB = -1.0;
+
+double LoudnessInfo::trackGain() const
+{
+    // 无有效块（整首静音或过短）时不做调整
+    return valid && blocks > 0 ? LoudnessAnalyzer::REFERENCE_LUFS - lufs : 0.0;
+}
+
+QVariantMap LoudnessInfo::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert("lufs", lufs);
+    map.insert("peak", peak);
+    map.insert("blocks", blocks);
+    map.insert("album", album);
+    map.insert("source", fromTags ? QStringLiteral("replaygain") : QStringLiteral("r128"));
+    if (hasAlbumGain) {
+        map.insert("albumGain", albumGain);
+        map.insert("albumPeak", albumPeak);
+    }
+    return map;
+}
+
+LoudnessInfo LoudnessInfo::fromVariantMap(const QVariantMap &map)
+{
+    LoudnessInfo info;
+    info.valid = map.contains("lufs");
+    info.lufs = map.value("lufs").toDouble();
+    info.peak = map.value("peak", 1.0).toDouble();
+    info.blocks = map.value("blocks").toLongLong();
+    info.album = map.value("album").toString();
+    info.fromTags = map.value("source").toString() == QLatin1String("replaygain");
+    info.hasAlbumGain = map.contains("albumGain");
+    info.albumGain = map.value("albumGain").toDouble();
+    info.albumPeak = map.value("albumPeak", 1.0).toDouble();
+    return info;
+}
+
+LoudnessAnalyzer &LoudnessAnalyzer::instance()
+{
+    static QPointer<LoudnessAnalyzer> analyzer;
+    if (!analyzer) analyzer = new LoudnessAnalyzer(QCoreApplication::instance());
+    return *analyzer;
+}
+
+LoudnessAnalyzer::LoudnessAnalyzer(QObject *parent)
+    : QObject(parent)
+{
+    // 空闲优先级只使用播放与界面剩下的算力，因此默认可按核数并行
+    m_pool.setThreadPriority(QThread::IdlePriority);
+    setMaxThreads(QThread::idealThreadCount());
+    // 曲库扫描完成或出现新文件时补齐分析；由这里单向订阅，曲库代码本身不依赖多媒体模块
+    LibraryEngine &library = LibraryEngine::instance();
+    connect(&library, &LibraryEngine::scanFinished, this, [this]() {
+        prefetch(LibraryEngine::instance().scannedFiles());
+    });
+    connect(&library, &LibraryEngine::fileAdded, this, [this](const QString &file) { prefetch(QStringList { file }); });
+}
+
+LoudnessAnalyzer::~LoudnessAnalyzer()
+{
+    m_stopping = true;
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QString LoudnessAnalyzer::indexKey(const QString &path)
+{
+    return QStringLiteral("loudness:") + path;
+}
+
+void LoudnessAnalyzer::setMaxThreads(int count)
+{
+    m_maxThreads = std::max(1, count);
+    m_pool.setMaxThreadCount(m_maxThreads);
+    dispatch();
+}
+
+bool LoudnessAnalyzer::lookup(const QString &source, LoudnessInfo *out)
+{
+    const QString path = MetadataService::normalizePath(source);
+    auto it = m_results.constFind(path);
+    if (it != m_results.cend()) {
+        *out = it.value();
+        return true;
+    }
+    const FileStamp stamp = FileStamp::of(path);
+    QVariantMap map;
+    if (!stamp.isFile || !MetadataIndex::instance().lookup(indexKey(path), stamp, &map)) return false;
+    const LoudnessInfo info = LoudnessInfo::fromVariantMap(map);
+    if (!info.valid) return false;
+    m_results.insert(path, info);
+    *out = info;
+    return true;
+}
+
+bool LoudnessAnalyzer::albumGain(const QString &source, double *gainDb, double *peak)
+{
+    const QString path = MetadataService::normalizePath(source);
+    LoudnessInfo info;
+    if (!lookup(path, &info) || !info.valid) return false;
+    if (info.hasAlbumGain) {
+        *gainDb = info.albumGain;
+        *peak = info.albumPeak;
+        return true;
+    }
+    if (info.album.isEmpty()) return false;
+
+    // 按块数加权合并各曲通过门限的平均能量：相当于把全专辑的门限块放在一起求均值
+    // （相对门限仍按单曲计算，与整张专辑一次测量相差通常在 0.1 LU 以内）
+    const QStringList siblings = albumSiblings(path);
+    double energy = 0.0;
+    qint64 blocks = 0;
+    double albumPeak = 0.0;
+    bool complete = true;
+    for (const QString &sibling : siblings) {
+        LoudnessInfo other;
+        if (!lookup(sibling, &other)) {
+            request(sibling, Priority::Playback);
+            complete = false;
+            continue;
+        }
+        if (!other.valid || other.blocks == 0 || other.album != info.album) continue;
+        energy += double(other.blocks) * std::pow(10.0, other.lufs / 10.0);
+        blocks += other.blocks;
+        albumPeak = std::max(albumPeak, other.peak);
+    }
+    if (!complete || blocks == 0) return false;
+    *gainDb = REFERENCE_LUFS - 10.0 * std::log10(energy / double(blocks));
+    *peak = albumPeak;
+    return true;
+}
+
+QStringList LoudnessAnalyzer::albumSiblings(const QString &path)
+{
+    const QString dir = QFileInfo(path).absolutePath();
+    auto it = m_directories.find(dir);
+    if (it == m_directories.end()) {
+        QStringList files;
+        const QFileInfoList entries = QDir(dir).entryInfoList(QDir::Files, QDir::Name);
+        for (const QFileInfo &entry : entries) {
+            if (LibraryScanner::hasMusicSuffix(entry.fileName())) files.append(entry.absoluteFilePath());
+        }
+        // 混放大量曲目的目录（如整个音乐文件夹）不按专辑处理，避免为一首歌分析整个目录
+        if (files.size() > kMaxAlbumFiles) files.clear();
+        it = m_directories.insert(dir, files);
+    }
+    return it.value();
+}
+
+void LoudnessAnalyzer::request(const QString &source, Priority priority)
+{
+    const QString path = MetadataService::normalizePath(source);
+    if (path.isEmpty() || m_results.contains(path) || m_running.contains(path)) return;
+    auto it = m_queued.find(path);
+    if (it != m_queued.end()) {
+        if (priority == Priority::Playback && it.value() == Priority::Background) {
+            it.value() = Priority::Playback;
+            m_playbackQueue.push_back(path);
+            dispatch();
+        }
+        return;
+    }
+    m_queued.insert(path, priority);
+    if (priority == Priority::Playback) m_playbackQueue.push_back(path);
+    else m_backgroundQueue.push_back(path);
+    dispatch();
+}
+
+void LoudnessAnalyzer::prefetch(const QStringList &paths)
+{
+    MetadataIndex &index = MetadataIndex::instance();
+    for (const QString &source : paths) {
+        const QString path = MetadataService::normalizePath(source);
+        if (path.isEmpty() || m_results.contains(path) || m_running.contains(path) || m_queued.contains(path)) continue;
+        if (!index.value(indexKey(path)).isEmpty()) continue;
+        m_queued.insert(path, Priority::Background);
+        m_backgroundQueue.push_back(path);
+    }
+    dispatch();
+}
+
+void LoudnessAnalyzer::dispatch()
+{
+    // 只把并行上限内的任务交给线程池，其余留在队列中，后来的播放请求才能插到前面
+    while (m_running.size() < m_maxThreads) {
+        QString path;
+        while (path.isEmpty() && !m_playbackQueue.empty()) {
+            const QString candidate = m_playbackQueue.front();
+            m_playbackQueue.pop_front();
+            if (m_queued.contains(candidate)) path = candidate;
+        }
+        while (path.isEmpty() && !m_backgroundQueue.empty()) {
+            const QString candidate = m_backgroundQueue.front();
+            m_backgroundQueue.pop_front();
+            // 已提升为播放优先级的条目由播放队列处理
+            auto it = m_queued.constFind(candidate);
+            if (it != m_queued.cend() && it.value() == Priority::Background) path = candidate;
+        }
+        if (path.isEmpty()) break;
+        m_queued.remove(path);
+        m_running.insert(path);
+        TRACE_COUNTER("loudness.queued", m_queued.size());
+        m_pool.start([this, path]() {
+            const FileStamp stamp = FileStamp::of(path);
+            const LoudnessInfo info = analyze(path, &m_stopping);
+            if (m_stopping) return;
+            QMetaObject::invokeMethod(this, [this, path, info, stamp]() { finish(path, info, stamp); },
+                                      Qt::QueuedConnection);
+        });
+    }
+}
+
+void LoudnessAnalyzer::finish(const QString &path, const LoudnessInfo &info, const FileStamp &stamp)
+{
+    m_running.remove(path);
+    // 失败的结果也留在内存中，本次运行不再重试；只有成功的写入索引
+    m_results.insert(path, info);
+    if (info.valid && stamp.isFile) MetadataIndex::instance().insert(indexKey(path), stamp, info.toVariantMap());
+    emit ready(path);
+    dispatch();
+}
+
+LoudnessInfo LoudnessAnalyzer::analyze(const QString &path, const std::atomic_bool *cancelled)
+{
+    TRACE_SCOPE("loudness.analyze");
+    LoudnessInfo info;
+    const TagInfo tags = TagReader::read(path);
+    if (!tags.album.isEmpty()) {
+        info.album = (tags.albumArtist.isEmpty() ? tags.artist : tags.albumArtist) + QLatin1Char('\n') + tags.album;
+    }
+
+    // 标签已带 ReplayGain：按参考电平反推响度，块数按时长估计（每 100ms 一块）
+    if (tags.hasReplayGain()) {
+        info.fromTags = true;
+        info.lufs = REFERENCE_LUFS - tags.trackGain;
+        info.peak = tags.trackPeak > 0.0 ? tags.trackPeak : 1.0;
+        info.blocks = std::max<qint64>(1, tags.durationMs / 100);
+        if (!qIsNaN(tags.albumGain)) {
+            info.hasAlbumGain = true;
+            info.albumGain = tags.albumGain;
+            info.albumPeak = tags.albumPeak > 0.0 ? tags.albumPeak : 1.0;
+        }
+        info.valid = true;
+        return info;
+    }
+
+    TRACE_SCOPE("loudness.decode");
+    // QAudioDecoder 依赖事件循环回送数据，在工作线程内开一个局部事件循环
+    QAudioDecoder decoder;
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Float);
+    format.setChannelCount(kChannels);
+    format.setSampleRate(kAnalysisRate);
+    decoder.setAudioFormat(format);
+    decoder.setSource(sourceUrl(path));
+
+    Meter meter;
+    std::vector<float> samples;
+    bool failed = false;
+    QEventLoop loop;
+    QObject::connect(&decoder, &QAudioDecoder::bufferReady, &loop, [&]() {
+        while (decoder.bufferAvailable()) {
+            const QAudioBuffer buffer = decoder.read();
+            if (!buffer.isValid()) continue;
+            // 解码端可能忽略请求的采样率：滤波器系数按实际采样率计算
+            if (!meter.started()) {
+                if (buffer.format().sampleRate() <= 0) continue;
+                meter.start(buffer.format().sampleRate());
+            }
+            toStereo(buffer, samples);
+            meter.process(samples.data(), qsizetype(samples.size() / kChannels));
+        }
+        if (cancelled && cancelled->load()) {
+            decoder.stop();
+            failed = true;
+            loop.quit();
+        }
+    });
+    QObject::connect(&decoder, &QAudioDecoder::finished, &loop, &QEventLoop::quit);
+    QObject::connect(&decoder, qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), &loop, [&]() {
+        failed = true;
+        loop.quit();
+    });
+    decoder.start();
+    loop.exec();
+
+    if (failed || !meter.started()) return info;
+    info.peak = meter.peak();
+    if (!meter.integrate(&info.lufs, &info.blocks)) {
+        // 整首都在绝对门限以下：记为有效但不调整增益
+        info.lufs = kAbsoluteGate;
+        info.blocks = 0;
+    }
+    info.valid = true;
+    return info;
+}
@@ -0,0 +1,91 @@
+// core/loudnessanalyzer.h
+#ifndef CORE_LOUDNESSANALYZER_H
+#define CORE_LOUDNESSANALYZER_H
+
+// 响度分析（ITU-R BS.1770 / EBU R128）：工作线程解码为立体声浮点，K 加权后按 400ms 块（75% 重叠）
+// 经绝对门限 -70 LUFS 与相对门限 -10 LU 求积分响度，4 倍过采样求真峰值
+// 标签中已有 ReplayGain 时直接采用，不再解码；结果以 "loudness:<路径>" 写入 MetadataIndex
+// 分析线程为空闲优先级，并行数可配置；播放所需的曲目优先于后台分析，曲库扫描结果在后台补齐
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVariantMap>
+
+#include <atomic>
+#include <deque>
+
+struct FileStamp;
+
+struct LoudnessInfo
+{
+    double lufs = 0.0;          // 积分响度
+    double peak = 1.0;          // 线性真峰值（来自标签时为样本峰值，缺失按满幅计）
+    qint64 blocks = 0;          // 参与积分的门限块数，合并专辑响度时作为权重
+    QString album;              // 专辑艺术家 + 专辑名；与同目录曲目比对以确定专辑
+    double albumGain = 0.0;     // 仅来自标签，dB
+    double albumPeak = 1.0;
+    bool hasAlbumGain = false;
+    bool fromTags = false;
+    bool valid = false;
+
+    // 相对参考电平的增益（dB）
+    double trackGain() const;
+
+    QVariantMap toVariantMap() const;
+    static LoudnessInfo fromVariantMap(const QVariantMap &map);
+};
+
+class LoudnessAnalyzer : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Priority { Playback, Background };
+
+    static LoudnessAnalyzer &instance();
+    ~LoudnessAnalyzer() override;
+
+    // 内存 -> 持久化索引（校验时间戳）；没有结果时返回 false
+    bool lookup(const QString &path, LoudnessInfo *out);
+    // 专辑增益：标签中的专辑增益优先；否则合并同目录同专辑各曲的响度，尚未全部分析时返回 false
+    // 并把缺少的曲目按播放优先级排队
+    bool albumGain(const QString &path, double *gainDb, double *peak);
+    // 同一路径只分析一次；Playback 优先级会提升已在后台排队的路径
+    void request(const QString &path, Priority priority = Priority::Playback);
+    // 后台分析整个曲库：索引中已有记录的跳过（不 stat，文件变化时由播放前的 lookup 重新分析）
+    void prefetch(const QStringList &paths);
+    // 同时分析的曲目数上限（默认等于 CPU 核数；线程为空闲优先级，只占用空闲算力）
+    void setMaxThreads(int count);
+    int maxThreads() const { return m_maxThreads; }
+
+    // 纯计算，可在任意线程调用：先读标签，没有 ReplayGain 时解码测量
+    static LoudnessInfo analyze(const QString &path, const std::atomic_bool *cancelled = nullptr);
+    static QString indexKey(const QString &path);
+
+    static const double REFERENCE_LUFS;     // ReplayGain 2.0 参考电平
+    static const double PEAK_CEILING_DB;    // 增益后真峰值上限
+
+signals:
+    // 分析完成（失败时 info.valid 为假），只在 GUI 线程
+    void ready(const QString &path);
+
+private:
+    explicit LoudnessAnalyzer(QObject *parent = nullptr);
+    void dispatch();
+    void finish(const QString &path, const LoudnessInfo &info, const FileStamp &stamp);
+    QStringList albumSiblings(const QString &path);
+
+    QThreadPool m_pool;
+    int m_maxThreads = 1;
+    QHash<QString, LoudnessInfo> m_results;         // 仅 GUI 线程访问
+    QHash<QString, QStringList> m_directories;      // 目录 -> 其中的音乐文件，专辑合并用
+    QHash<QString, Priority> m_queued;              // 排队中的路径及其当前优先级
+    std::deque<QString> m_playbackQueue;            // 提升优先级后旧条目留在后台队列，出队时跳过
+    std::deque<QString> m_backgroundQueue;
+    QSet<QString> m_running;
+    std::atomic_bool m_stopping { false };
+};
+
+#endif // CORE_LOUDNESSANALYZER_H
@@ -0,0 +1,331 @@
+// 实现文件：LyricsDocument —— LRC 解析、编码识别与按时间二分定位
+#include "core/lyricsdocument.h"
+#include "core/metadataindex.h"
+#include "core/trace.h"
+
+#include <QCache>
+#include <QFile>
+#include <QStringDecoder>
+#include <QUrl>
+
+#include <algorithm>
+
+namespace {
+
+// mm:ss / mm:ss.x / mm:ss.xx / mm:ss.xxx（小数点也可写作冒号），格式不符返回 -1
+qint64 parseTime(QStringView tag)
+{
+    const qsizetype colon = tag.indexOf(QLatin1Char(':'));
+    if (colon <= 0) return -1;
+    bool ok = false;
+    const int minutes = tag.left(colon).toInt(&ok);
+    if (!ok || minutes < 0) return -1;
+    const QStringView rest = tag.mid(colon + 1);
+    qsizetype sep = rest.indexOf(QLatin1Char('.'));
+    if (sep < 0) sep = rest.indexOf(QLatin1Char(':'));
+    const int seconds = (sep < 0 ? rest : rest.left(sep)).toInt(&ok);
+    if (!ok || seconds < 0) return -1;
+    int ms = 0;
+    if (sep >= 0) {
+        const QStringView frac = rest.mid(sep + 1);
+        if (frac.isEmpty() || frac.size() > 3) return -1;
+        const int value = frac.toInt(&ok);
+        if (!ok || value < 0) return -1;
+        ms = frac.size() == 1 ? value * 100 : frac.size() == 2 ? value * 10 : value;
+    }
+    return qint64(minutes) * 60000 + qint64(seconds) * 1000 + ms;
+}
+
+// 无 BOM 的 UTF-16：LRC 以 ASCII 标签为主，高字节为 0 的比例很高
+bool looksLikeUtf16(const QByteArray &bytes, bool *littleEndian)
+{
+    const qsizetype n = std::min<qsizetype>(bytes.size() & ~qsizetype(1), 512);
+    if (n < 8) return false;
+    int evenZeros = 0, oddZeros = 0;
+    for (qsizetype i = 0; i < n; i += 2) {
+        if (bytes.at(i) == 0) ++evenZeros;
+        if (bytes.at(i + 1) == 0) ++oddZeros;
+    }
+    const int pairs = int(n / 2);
+    if (oddZeros * 5 > pairs * 2 && evenZeros * 10 < pairs) {
+        *littleEndian = true;
+        return true;
+    }
+    if (evenZeros * 5 > pairs * 2 && oddZeros * 10 < pairs) {
+        *littleEndian = false;
+        return true;
+    }
+    return false;
+}
+
+struct CacheEntry
+{
+    FileStamp stamp;
+    std::shared_ptr<const LyricsDocument::Data> data;
+};
+
+} // namespace
+
+LyricsDocument::LyricsDocument(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int LyricsDocument::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant LyricsDocument::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= count()) return QVariant();
+    const int row = index.row();
+    switch (role) {
+    case TimeRole: return timeAt(row);
+    case EndTimeRole: return endTimeAt(row);
+    case Qt::DisplayRole:
+    case TextRole: return textAt(row);
+    case HasWordsRole: return m_data->lines[row].wordCount > 0;
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> LyricsDocument::roleNames() const
+{
+    return {
+        { TimeRole, "time" },
+        { EndTimeRole, "endTime" },
+        { TextRole, "text" },
+        { HasWordsRole, "hasWords" }
+    };
+}
+
+void LyricsDocument::setSource(const QString &source)
+{
+    if (m_source == source) return;
+    m_source = source;
+    emit sourceChanged();
+    resolve();
+}
+
+void LyricsDocument::setLibrary(MusicLibrary *library)
+{
+    if (m_library == library) return;
+    m_library = library;
+    emit libraryChanged();
+    if (!m_source.isEmpty()) resolve();
+}
+
+void LyricsDocument::reload()
+{
+    resolve();
+}
+
+int LyricsDocument::indexForPosition(qint64 positionMs) const
+{
+    if (!m_data) return -1;
+    const std::vector<Line> &lines = m_data->lines;
+    auto it = std::upper_bound(lines.cbegin(), lines.cend(), positionMs,
+                               [](qint64 value, const Line &line) { return value < line.timeMs; });
+    return int(it - lines.cbegin()) - 1;
+}
+
+qint64 LyricsDocument::timeAt(int row) const
+{
+    return (row >= 0 && row < count()) ? m_data->lines[row].timeMs : -1;
+}
+
+qint64 LyricsDocument::endTimeAt(int row, qint64 fallbackMs) const
+{
+    if (row < 0 || row >= count()) return fallbackMs;
+    return row + 1 < count() ? m_data->lines[row + 1].timeMs : fallbackMs;
+}
+
+QString LyricsDocument::textAt(int row) const
+{
+    if (row < 0 || row >= count()) return QString();
+    const Line &line = m_data->lines[row];
+    return m_data->text.mid(line.textBegin, line.textLength);
+}
+
+qreal LyricsDocument::lineProgress(int row, qint64 positionMs, qint64 fallbackEndMs) const
+{
+    if (row < 0 || row >= count()) return 0.0;
+    const Line &line = m_data->lines[row];
+    qint64 end = endTimeAt(row, fallbackEndMs);
+    if (end <= line.timeMs) end = line.timeMs + 3000;
+    if (positionMs <= line.timeMs) return 0.0;
+    if (positionMs >= end) return 1.0;
+
+    if (line.wordCount == 0 || line.textLength == 0) {
+        return qreal(positionMs - line.timeMs) / qreal(end - line.timeMs);
+    }
+    const Word *first = m_data->words.data() + line.wordBegin;
+    const Word *last = first + line.wordCount;
+    const Word *next = std::upper_bound(first, last, positionMs,
+                                        [](qint64 value, const Word &word) { return value < word.timeMs; });
+    if (next == first) return qreal(first->charOffset) / line.textLength;
+    const Word &current = *(next - 1);
+    const qint64 t1 = next != last ? next->timeMs : end;
+    const qint32 c1 = next != last ? next->charOffset : line.textLength;
+    const qreal frac = t1 > current.timeMs ? qreal(positionMs - current.timeMs) / qreal(t1 - current.timeMs) : 1.0;
+    const qreal chars = current.charOffset + (c1 - current.charOffset) * std::clamp(frac, 0.0, 1.0);
+    return std::clamp(chars / line.textLength, 0.0, 1.0);
+}
+
+QString LyricsDocument::decode(const QByteArray &bytes)
+{
+    if (bytes.isEmpty()) return QString();
+
+    // BOM（UTF-8 / UTF-16 / UTF-32）优先，解码时去掉 BOM
+    if (const auto bom = QStringConverter::encodingForData(bytes)) {
+        QStringDecoder decoder(*bom);
+        return decoder(bytes);
+    }
+
+    QStringDecoder utf8(QStringConverter::Utf8, QStringConverter::Flag::Stateless);
+    const QString text = utf8(bytes);
+    if (!utf8.hasError()) return text;
+
+    bool littleEndian = true;
+    if (looksLikeUtf16(bytes, &littleEndian)) {
+        QStringDecoder utf16(littleEndian ? QStringConverter::Utf16LE : QStringConverter::Utf16BE);
+        return utf16(bytes);
+    }
+
+    // 中文歌词最常见的非 UTF-8 编码；无 ICU 支持时退回本地编码
+    QStringDecoder gb18030("GB18030", QStringConverter::Flag::Stateless);
+    if (gb18030.isValid()) {
+        const QString gbText = gb18030(bytes);
+        if (!gb18030.hasError()) return gbText;
+    }
+    return QString::fromLocal8Bit(bytes);
+}
+
+std::shared_ptr<const LyricsDocument::Data> LyricsDocument::parse(const QString &text)
+{
+    auto data = std::make_shared<Data>();
+    qint64 offsetMs = 0;
+    std::vector<qint64> stamps;
+    std::vector<Word> lineWords;
+    QString body;
+
+    qsizetype lineStart = 0;
+    while (lineStart <= text.size()) {
+        qsizetype lineEnd = text.indexOf(QLatin1Char('\n'), lineStart);
+        if (lineEnd < 0) lineEnd = text.size();
+        const QStringView line = QStringView(text).mid(lineStart, lineEnd - lineStart).trimmed();
+        lineStart = lineEnd + 1;
+        if (line.isEmpty()) continue;
+
+        // 行首连续的 [..] 标签：时间戳、offset 或元信息（ti/ar/al 等，忽略）
+        stamps.clear();
+        qsizetype pos = 0;
+        while (pos < line.size() && line.at(pos) == QLatin1Char('[')) {
+            const qsizetype close = line.indexOf(QLatin1Char(']'), pos);
+            if (close < 0) break;
+            const QStringView tag = line.mid(pos + 1, close - pos - 1);
+            const qint64 t = parseTime(tag);
+            if (t >= 0) {
+                stamps.push_back(t);
+            } else if (tag.startsWith(QLatin1String("offset:"), Qt::CaseInsensitive)) {
+                offsetMs = tag.mid(7).trimmed().toInt();
+            }
+            pos = close + 1;
+        }
+        if (stamps.empty()) continue;
+
+        // 正文：剥离 <mm:ss.xx> 逐字标签，记录每个字段在纯文本中的起点
+        body.clear();
+        lineWords.clear();
+        const QStringView rest = line.mid(pos);
+        for (qsizetype i = 0; i < rest.size(); ++i) {
+            if (rest.at(i) == QLatin1Char('<')) {
+                const qsizetype close = rest.indexOf(QLatin1Char('>'), i);
+                const qint64 t = close > i ? parseTime(rest.mid(i + 1, close - i - 1)) : -1;
+                if (t >= 0) {
+                    lineWords.push_back(Word { qint32(t), qint32(body.size()) });
+                    i = close;
+                    continue;
+                }
+            }
+            body.append(rest.at(i));
+        }
+        qsizetype lead = 0;
+        while (lead < body.size() && body.at(lead).isSpace()) ++lead;
+        const QString lineText = body.trimmed();
+        if (lineText.isEmpty()) continue;
+        for (Word &word : lineWords) {
+            word.charOffset = qint32(std::clamp<qsizetype>(word.charOffset - lead, 0, lineText.size()));
+        }
+
+        const qint32 textBegin = qint32(data->text.size());
+        data->text.append(lineText);
+        // 一行多个时间戳共用同一段文本；逐字时间按与首个时间戳的差值平移
+        for (qint64 stamp : stamps) {
+            Line entry { qint32(stamp), textBegin, qint32(lineText.size()), qint32(data->words.size()), 0 };
+            for (const Word &word : lineWords) {
+                data->words.push_back(Word { qint32(word.timeMs + stamp - stamps.front()), word.charOffset });
+            }
+            entry.wordCount = qint32(lineWords.size());
+            data->lines.push_back(entry);
+        }
+    }
+
+    // offset 为正表示歌词整体提前
+    data->offsetMs = qint32(offsetMs);
+    if (offsetMs != 0) {
+        for (Line &line : data->lines) line.timeMs = qint32(std::max<qint64>(0, line.timeMs - offsetMs));
+        for (Word &word : data->words) word.timeMs = qint32(std::max<qint64>(0, word.timeMs - offsetMs));
+    }
+    std::stable_sort(data->lines.begin(), data->lines.end(),
+                     [](const Line &a, const Line &b) { return a.timeMs < b.timeMs; });
+    data->lines.shrink_to_fit();
+    data->words.shrink_to_fit();
+    data->text.squeeze();
+    return data;
+}
+
+std::shared_ptr<const LyricsDocument::Data> LyricsDocument::load(const QString &path)
+{
+    TRACE_SCOPE("lyrics.load");
+    // 只在 GUI 线程访问
+    static QCache<QString, CacheEntry> cache(CACHE_LIMIT);
+
+    const FileStamp stamp = FileStamp::of(path);
+    if (!stamp.isValid()) {
+        cache.remove(path);
+        return nullptr;
+    }
+    if (const CacheEntry *entry = cache.object(path); entry && entry->stamp == stamp) return entry->data;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return nullptr;
+    std::shared_ptr<const Data> data = parse(decode(file.readAll()));
+    cache.insert(path, new CacheEntry { stamp, data });
+    return data;
+}
+
+void LyricsDocument::resolve()
+{
+    QString url;
+    if (m_source.endsWith(QLatin1String(".lrc"), Qt::CaseInsensitive)) {
+        url = m_source;
+    } else if (!m_source.isEmpty() && m_library) {
+        url = m_library->findLyricsFileForSource(m_source);
+    }
+    const QString local = url.startsWith(QLatin1String("file:")) ? QUrl(url).toLocalFile() : url;
+    std::shared_ptr<const Data> data = local.isEmpty() ? nullptr : load(local);
+    if (data && data->lines.empty()) data.reset();
+    setData(url, std::move(data));
+}
+
+void LyricsDocument::setData(const QString &path, std::shared_ptr<const Data> data)
+{
+    if (m_path == path && m_data == data) return;
+    beginResetModel();
+    m_path = path;
+    m_data = std::move(data);
+    endResetModel();
+    emit loaded();
+}
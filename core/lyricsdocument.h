@@ -0,0 +1,106 @@
+// core/lyricsdocument.h
+#ifndef CORE_LYRICSDOCUMENT_H
+#define CORE_LYRICSDOCUMENT_H
+
+// LRC 歌词文档：解析为按时间排序的紧凑数组（行文本拼接在一段字符串中），支持
+// 一行多时间戳、[offset:] 与逐字 <mm:ss.xx> 标签；按时间定位行为二分查找
+// 解析结果按路径 + mtime/size 缓存，同一首歌重复打开窗口不再读盘解析
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QString>
+#include <QPointer>
+
+#include <memory>
+#include <vector>
+
+#include "core/music.h"
+
+class LyricsDocument : public QAbstractListModel
+{
+    Q_OBJECT
+    // 音频路径；歌词文件由 library 的 findLyricsFileForSource 解析，也可直接给出 .lrc 路径
+    Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(MusicLibrary *library READ library WRITE setLibrary NOTIFY libraryChanged)
+    Q_PROPERTY(QString path READ path NOTIFY loaded)
+    Q_PROPERTY(int count READ count NOTIFY loaded)
+    Q_PROPERTY(bool available READ isAvailable NOTIFY loaded)
+    Q_PROPERTY(int offset READ offset NOTIFY loaded)
+
+public:
+    enum Roles {
+        TimeRole = Qt::UserRole + 1,
+        EndTimeRole,
+        TextRole,
+        HasWordsRole
+    };
+    Q_ENUM(Roles)
+
+    struct Line
+    {
+        qint32 timeMs;
+        qint32 textBegin;       // 在 Data::text 中的起点
+        qint32 textLength;
+        qint32 wordBegin;       // 在 Data::words 中的起点
+        qint32 wordCount;
+    };
+    struct Word
+    {
+        qint32 timeMs;
+        qint32 charOffset;      // 相对本行文本的起点；末尾的空标签记为结束时刻
+    };
+    struct Data
+    {
+        std::vector<Line> lines;
+        std::vector<Word> words;
+        QString text;
+        qint32 offsetMs = 0;
+    };
+
+    explicit LyricsDocument(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QString source() const { return m_source; }
+    void setSource(const QString &source);
+    MusicLibrary *library() const { return m_library; }
+    void setLibrary(MusicLibrary *library);
+    QString path() const { return m_path; }
+    int count() const { return m_data ? int(m_data->lines.size()) : 0; }
+    bool isAvailable() const { return count() > 0; }
+    int offset() const { return m_data ? m_data->offsetMs : 0; }
+
+    // 最后一个开始时间不晚于 positionMs 的行；早于第一行时返回 -1
+    Q_INVOKABLE int indexForPosition(qint64 positionMs) const;
+    Q_INVOKABLE qint64 timeAt(int row) const;
+    // 下一行开始时间；最后一行返回 fallbackMs
+    Q_INVOKABLE qint64 endTimeAt(int row, qint64 fallbackMs = -1) const;
+    Q_INVOKABLE QString textAt(int row) const;
+    // 本行已唱过的文本比例 0~1：有逐字标签时按字插值，否则按行时长线性插值
+    Q_INVOKABLE qreal lineProgress(int row, qint64 positionMs, qint64 fallbackEndMs = -1) const;
+    Q_INVOKABLE void reload();
+
+    // BOM -> UTF-8 校验 -> 无 BOM 的 UTF-16 -> GB18030/本地编码
+    static QString decode(const QByteArray &bytes);
+    static std::shared_ptr<const Data> parse(const QString &text);
+    // 带缓存读取：路径与时间戳不变时直接复用上次解析结果
+    static std::shared_ptr<const Data> load(const QString &path);
+
+signals:
+    void sourceChanged();
+    void libraryChanged();
+    void loaded();
+
+private:
+    void resolve();
+    void setData(const QString &path, std::shared_ptr<const Data> data);
+
+    QString m_source;
+    QString m_path;
+    QPointer<MusicLibrary> m_library;
+    std::shared_ptr<const Data> m_data;
+    static const int CACHE_LIMIT = 32;
+};
+
+#endif // CORE_LYRICSDOCUMENT_H
@@ -0,0 +1,283 @@
+// 实现文件：MetadataIndex —— 追加式记录日志 + mmap 惰性解码
+#include "core/metadataindex.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QPointer>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QtEndian>
+
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+// 文件头：魔数 + 版本；每条记录：quint32(LE) 长度 + QDataStream(path, mtime, size, inode, meta)
+const char kMagic[4] = { 'E', 'V', 'M', 'I' };
+const quint32 kVersion = 2;    // 2：mtime 精确到毫秒（版本 1 为整秒）
+const qint64 kHeaderSize = 8;
+const int kCompactGarbage = 1024;   // 覆盖记录超过该数量且多于有效记录时压缩
+
+QByteArray fileHeader()
+{
+    QByteArray header(kMagic, 4);
+    char version[4];
+    qToLittleEndian(kVersion, version);
+    header.append(version, 4);
+    return header;
+}
+
+} // namespace
+
+FileStamp FileStamp::of(const QString &path)
+{
+    FileStamp stamp;
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) != 0) return stamp;
+#if defined(Q_OS_DARWIN)
+    stamp.mtimeMs = qint64(st.st_mtimespec.tv_sec) * 1000 + st.st_mtimespec.tv_nsec / 1000000;
+#else
+    stamp.mtimeMs = qint64(st.st_mtim.tv_sec) * 1000 + st.st_mtim.tv_nsec / 1000000;
+#endif
+    stamp.size = qint64(st.st_size);
+    stamp.inode = quint64(st.st_ino);
+    stamp.isFile = S_ISREG(st.st_mode);
+#else
+    const QFileInfo info(path);
+    if (!info.exists()) return stamp;
+    stamp.mtimeMs = info.lastModified().toMSecsSinceEpoch();
+    stamp.size = info.size();
+    stamp.isFile = info.isFile();
+#endif
+    return stamp;
+}
+
+MetadataIndex &MetadataIndex::instance()
+{
+    static QPointer<MetadataIndex> index;
+    if (!index) {
+        index = new MetadataIndex(defaultPath(), QCoreApplication::instance());
+        index->load();
+    }
+    return *index;
+}
+
+MetadataIndex::MetadataIndex(const QString &filePath, QObject *parent)
+    : QObject(parent)
+    , m_path(filePath)
+    , m_flushTimer(new QTimer(this))
+{
+    // 写入合并：连续更新在延迟后一次性追加
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(FLUSH_DELAY_MS);
+    connect(m_flushTimer, &QTimer::timeout, this, &MetadataIndex::flush);
+}
+
+MetadataIndex::~MetadataIndex()
+{
+    flush();
+    unmap();
+}
+
+QString MetadataIndex::defaultPath()
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return dir + "/metadata.idx";
+}
+
+bool MetadataIndex::load()
+{
+    unmap();
+    m_entries.clear();
+    m_garbage = 0;
+
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+    m_mapSize = m_file.size();
+    m_map = m_mapSize >= kHeaderSize ? m_file.map(0, m_mapSize) : nullptr;
+    const char *base = reinterpret_cast<const char *>(m_map);
+    if (!base || memcmp(base, kMagic, 4) != 0 || qFromLittleEndian<quint32>(base + 4) != kVersion) {
+        // 格式不符或旧版本：丢弃后重建
+        unmap();
+        QFile::remove(m_path);
+        return false;
+    }
+
+    // 仅解码路径与时间戳，元数据保留为映射区偏移
+    QBuffer buffer;
+    buffer.setData(QByteArray::fromRawData(base, m_mapSize));
+    buffer.open(QIODevice::ReadOnly);
+    QDataStream in(&buffer);
+    in.setVersion(QDataStream::Qt_6_5);
+
+    bool truncated = false;
+    qint64 pos = kHeaderSize;
+    while (pos + 4 <= m_mapSize) {
+        const qint64 length = qFromLittleEndian<quint32>(base + pos);
+        const qint64 body = pos + 4;
+        if (length == 0 || body + length > m_mapSize) {
+            truncated = true; // 上次写入中断留下的残缺尾记录
+            break;
+        }
+        buffer.seek(body);
+        QString path;
+        Entry entry;
+        in >> path >> entry.stamp.mtimeMs >> entry.stamp.size >> entry.stamp.inode;
+        if (in.status() != QDataStream::Ok) {
+            truncated = true;
+            break;
+        }
+        entry.stamp.isFile = true;
+        entry.metaOffset = buffer.pos();
+        auto it = m_entries.find(path);
+        if (it != m_entries.end()) {
+            ++m_garbage;
+            *it = entry;
+        } else {
+            m_entries.insert(path, entry);
+        }
+        pos = body + length;
+    }
+
+    if (truncated || (m_garbage > kCompactGarbage && m_garbage > m_entries.size())) {
+        compact();
+    }
+    return true;
+}
+
+void MetadataIndex::flush()
+{
+    m_flushTimer->stop();
+    if (m_pending.isEmpty()) return;
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    // 独立句柄追加写入；映射区只覆盖加载时的长度，不受影响
+    QFile out(m_path);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Append)) return;
+    if (out.size() == 0) out.write(fileHeader());
+    out.write(m_pending);
+    m_pending.clear();
+}
+
+QVariantMap MetadataIndex::value(const QString &path) const
+{
+    auto it = m_entries.find(path);
+    if (it == m_entries.end()) return QVariantMap();
+    decode(it.value());
+    return it->meta;
+}
+
+bool MetadataIndex::lookup(const QString &path, const FileStamp &stamp, QVariantMap *meta) const
+{
+    auto it = m_entries.find(path);
+    if (it == m_entries.end() || it->stamp != stamp) return false;
+    decode(it.value());
+    if (meta) *meta = it->meta;
+    return true;
+}
+
+void MetadataIndex::insert(const QString &path, const FileStamp &stamp, const QVariantMap &meta)
+{
+    if (!stamp.isValid()) return;
+    auto it = m_entries.find(path);
+    Entry entry;
+    entry.stamp = stamp;
+    entry.meta = meta;
+    if (it != m_entries.end()) {
+        decode(it.value());
+        if (it->stamp == stamp) {
+            // 文件未变：保留 coverHash/lyricsPath 等后续合并进来的字段
+            for (auto f = it->meta.cbegin(); f != it->meta.cend(); ++f) {
+                if (!entry.meta.contains(f.key())) entry.meta.insert(f.key(), f.value());
+            }
+            if (entry.meta == it->meta) return;
+        }
+        ++m_garbage;
+        *it = entry;
+    } else {
+        m_entries.insert(path, entry);
+    }
+    append(path, entry);
+}
+
+void MetadataIndex::merge(const QString &path, const QVariantMap &fields)
+{
+    auto it = m_entries.find(path);
+    if (it == m_entries.end()) return;
+    decode(it.value());
+    bool changed = false;
+    for (auto f = fields.cbegin(); f != fields.cend(); ++f) {
+        if (it->meta.value(f.key()) == f.value()) continue;
+        it->meta.insert(f.key(), f.value());
+        changed = true;
+    }
+    if (!changed) return;
+    ++m_garbage;
+    append(path, it.value());
+}
+
+void MetadataIndex::decode(Entry &entry) const
+{
+    if (entry.metaOffset < 0) return;
+    const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(m_map) + entry.metaOffset,
+                                                   m_mapSize - entry.metaOffset);
+    QDataStream in(raw);
+    in.setVersion(QDataStream::Qt_6_5);
+    in >> entry.meta;
+    entry.metaOffset = -1;
+}
+
+void MetadataIndex::append(const QString &path, const Entry &entry)
+{
+    QByteArray record;
+    QDataStream out(&record, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << path << entry.stamp.mtimeMs << entry.stamp.size << entry.stamp.inode << entry.meta;
+    char length[4];
+    qToLittleEndian(quint32(record.size()), length);
+    m_pending.append(length, 4);
+    m_pending.append(record);
+    m_flushTimer->start();
+}
+
+void MetadataIndex::unmap()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_mapSize = 0;
+    if (m_file.isOpen()) m_file.close();
+}
+
+bool MetadataIndex::compact()
+{
+    // 先把所有记录解码出映射区，再解除映射后整体重写（Windows 下映射中的文件无法替换）
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) decode(it.value());
+    unmap();
+
+    m_pending.clear();
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) append(it.key(), it.value());
+    m_flushTimer->stop();
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    QSaveFile out(m_path);
+    if (!out.open(QIODevice::WriteOnly)) return false;
+    out.write(fileHeader());
+    out.write(m_pending);
+    if (!out.commit()) {
+        m_flushTimer->start();
+        return false;
+    }
+    m_pending.clear();
+    m_garbage = 0;
+    return true;
+}
@@ -0,0 +1,84 @@
+// core/metadataindex.h
+#ifndef CORE_METADATAINDEX_H
+#define CORE_METADATAINDEX_H
+
+// 持久化元数据索引：位于 CacheLocation，按路径 + mtime/size/inode 判定是否失效
+// 文件为追加式记录日志，启动时 mmap 映射，只解码路径与时间戳，元数据按需惰性解码
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QVariantMap>
+#include <QFile>
+
+class QTimer;
+
+struct FileStamp
+{
+    qint64 mtimeMs = 0;
+    qint64 size = -1;
+    quint64 inode = 0;      // Windows 下恒为 0
+    bool isFile = false;
+
+    bool isValid() const { return size >= 0; }
+    bool operator==(const FileStamp &o) const
+    {
+        return mtimeMs == o.mtimeMs && size == o.size && inode == o.inode;
+    }
+    bool operator!=(const FileStamp &o) const { return !(*this == o); }
+
+    // 单次 stat 取得 mtime/size/inode
+    static FileStamp of(const QString &path);
+    // 按内容寻址的键（如 "palette:<coverHash>"）内容不会变化，使用恒定时间戳
+    static FileStamp content() { FileStamp stamp; stamp.size = 0; return stamp; }
+};
+
+class MetadataIndex : public QObject
+{
+    Q_OBJECT
+public:
+    // 进程内共享实例，首次调用时加载
+    static MetadataIndex &instance();
+
+    explicit MetadataIndex(const QString &filePath, QObject *parent = nullptr);
+    ~MetadataIndex() override;
+
+    static QString defaultPath();
+
+    bool load();
+    void flush();
+    int count() const { return int(m_entries.size()); }
+
+    // 不校验时间戳，直接返回已索引的元数据（供 getMetadata 快速应答）
+    QVariantMap value(const QString &path) const;
+    // 时间戳一致才命中
+    bool lookup(const QString &path, const FileStamp &stamp, QVariantMap *meta) const;
+    // 整条写入（title/artist/album/duration 等）
+    void insert(const QString &path, const FileStamp &stamp, const QVariantMap &meta);
+    // 在已有记录上合并字段（coverHash、lyricsPath 等），记录不存在或已失效时忽略
+    void merge(const QString &path, const QVariantMap &fields);
+
+private:
+    struct Entry
+    {
+        FileStamp stamp;
+        qint64 metaOffset = -1;     // 映射区内元数据偏移；-1 表示已解码
+        QVariantMap meta;
+    };
+
+    void decode(Entry &entry) const;
+    void append(const QString &path, const Entry &entry);
+    void unmap();
+    bool compact();
+
+    QString m_path;
+    QFile m_file;
+    uchar *m_map = nullptr;
+    qint64 m_mapSize = 0;
+    mutable QHash<QString, Entry> m_entries;
+    QByteArray m_pending;           // 待追加写入的记录
+    int m_garbage = 0;              // 被后续记录覆盖的旧记录数
+    QTimer *m_flushTimer;
+    static const int FLUSH_DELAY_MS = 2000;
+};
+
+#endif // CORE_METADATAINDEX_H
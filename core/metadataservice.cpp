@@ -0,0 +1,340 @@
+// 实现文件：MetadataService —— 请求合并、按优先级调度的线程池读取、内存与持久化缓存
+#include "core/metadataservice.h"
+#include "core/covercache.h"
+#include "core/metadataindex.h"
+#include "core/tagreader.h"
+#include "core/trace.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QUrl>
+
+#include <algorithm>
+
+namespace {
+
+bool isResource(const QString &path)
+{
+    return path.startsWith(QLatin1String("qrc:/")) || path.startsWith(QLatin1Char(':'));
+}
+
+} // namespace
+
+const int MetadataService::CACHE_ENTRIES;
+
+QVariantMap TrackMetadata::toVariantMap() const
+{
+    QVariantMap meta;
+    meta.insert(QStringLiteral("title"), title);
+    meta.insert(QStringLiteral("artist"), artist);
+    meta.insert(QStringLiteral("album"), album);
+    meta.insert(QStringLiteral("duration"), durationMs);
+    meta.insert(QStringLiteral("coverHash"), coverHash);
+    return meta;
+}
+
+MetadataService &MetadataService::instance()
+{
+    static QPointer<MetadataService> service;
+    if (!service) service = new MetadataService(QCoreApplication::instance());
+    return *service;
+}
+
+MetadataService::MetadataService(QObject *parent)
+    : QObject(parent)
+    , m_cache(CACHE_ENTRIES)
+    , m_maxReads(std::clamp(QThread::idealThreadCount() / 2, 2, 4))
+{
+    // 读取以磁盘 IO 为主，少量线程即可；过多反而让机械盘来回寻道
+    // 线程池只承载已出队的读取，排队与优先级由本类维护
+    m_pool.setMaxThreadCount(m_maxReads);
+}
+
+MetadataService::~MetadataService()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QString MetadataService::normalizePath(const QString &source)
+{
+    if (source.startsWith(QLatin1String("file:"))) {
+        const QUrl url(source);
+        if (url.isValid()) return url.toLocalFile();
+    }
+    return source;
+}
+
+bool MetadataService::cached(const QString &source, TrackMetadata *out) const
+{
+    const TrackMetadata *meta = m_cache.object(normalizePath(source));
+    if (!meta) return false;
+    if (out) *out = *meta;
+    return true;
+}
+
+void MetadataService::request(const QString &source, QObject *context, Callback callback)
+{
+    const QString path = normalizePath(source);
+    if (path.isEmpty()) return;
+
+    TrackMetadata meta;
+    if (cached(path, &meta)) {
+        callback(meta);
+        return;
+    }
+    // 持久化索引里已有完整记录（含封面哈希）且文件未变：无需再读文件
+    if (fromIndex(path, &meta)) {
+        m_cache.insert(path, new TrackMetadata(meta));
+        callback(meta);
+        return;
+    }
+
+    // 有人等待回调的路径按可见优先级排队；已在读取中的只追加等待者
+    m_pending[path].push_back(Waiter{context, context, std::move(callback)});
+    if (context) {
+        ContextRequests &requests = m_contexts[context];
+        if (!requests.destroyed) {
+            requests.destroyed = connect(context, &QObject::destroyed, this, [this, context]() { cancel(context); });
+        }
+        requests.paths.insert(path);
+    }
+    TRACE_COUNTER("metadata.pending", m_pending.size());
+    reschedule(path);
+    dispatch();
+}
+
+void MetadataService::cancel(QObject *context)
+{
+    auto it = m_contexts.find(context);
+    if (it == m_contexts.end()) return;
+    const ContextRequests requests = std::move(it.value());
+    m_contexts.erase(it);
+    disconnect(requests.destroyed);
+
+    for (const QString &path : requests.paths) {
+        auto pending = m_pending.find(path);
+        if (pending == m_pending.end()) continue;
+        std::vector<Waiter> &waiters = pending.value();
+        waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                                     [context](const Waiter &w) { return w.owner == context; }),
+                      waiters.end());
+        if (waiters.empty()) m_pending.erase(pending);
+        // 没有其他等待者时按视口/后台重新定级，都不需要则出队；已在读取中的照常完成并写入缓存
+        reschedule(path);
+    }
+    TRACE_COUNTER("metadata.pending", m_pending.size());
+    dispatch();
+}
+
+void MetadataService::forgetWaiter(QObject *owner, const QString &path)
+{
+    auto it = m_contexts.find(owner);
+    if (it == m_contexts.end()) return;
+    it->paths.remove(path);
+    if (!it->paths.isEmpty()) return;
+    disconnect(it->destroyed);
+    m_contexts.erase(it);
+}
+
+void MetadataService::prefetch(const QStringList &sources)
+{
+    for (const QString &source : sources) {
+        const QString path = normalizePath(source);
+        if (path.isEmpty() || m_cache.contains(path)) continue;
+        m_background.insert(path);
+        reschedule(path);
+    }
+    dispatch();
+}
+
+void MetadataService::setViewport(QObject *view, const QStringList &visible, const QStringList &nearby)
+{
+    if (!view) return;
+    auto it = m_viewports.find(view);
+    if (it == m_viewports.end()) {
+        connect(view, &QObject::destroyed, this, [this, view]() { removeViewport(view); });
+        it = m_viewports.insert(view, Viewport());
+    }
+
+    Viewport next;
+    for (const QString &source : visible) {
+        const QString path = normalizePath(source);
+        if (!path.isEmpty() && !m_cache.contains(path)) next.visible.insert(path);
+    }
+    for (const QString &source : nearby) {
+        const QString path = normalizePath(source);
+        if (!path.isEmpty() && !m_cache.contains(path) && !next.visible.contains(path)) next.nearby.insert(path);
+    }
+    const Viewport previous = std::exchange(it.value(), next);
+
+    // 只有新旧两个集合中的路径可能改变排队状态，代价与视口大小成正比
+    for (const QString &path : previous.visible) reschedule(path);
+    for (const QString &path : previous.nearby) reschedule(path);
+    for (const QString &path : std::as_const(next.visible)) reschedule(path);
+    for (const QString &path : std::as_const(next.nearby)) reschedule(path);
+    dispatch();
+}
+
+void MetadataService::removeViewport(QObject *view)
+{
+    const Viewport previous = m_viewports.take(view);
+    for (const QString &path : previous.visible) reschedule(path);
+    for (const QString &path : previous.nearby) reschedule(path);
+    dispatch();
+}
+
+void MetadataService::setMaxConcurrentReads(int count)
+{
+    m_maxReads = std::max(1, count);
+    m_pool.setMaxThreadCount(m_maxReads);
+    dispatch();
+}
+
+void MetadataService::invalidate(const QString &source)
+{
+    m_cache.remove(normalizePath(source));
+}
+
+TrackMetadata MetadataService::read(const QString &path)
+{
+    // 一次读取同时取得文本标签与封面原始字节；封面按内容哈希落盘，不解码不重新编码
+    TRACE_SCOPE("metadata.read");
+    const TagInfo info = TagReader::read(path, true);
+    TrackMetadata meta;
+    meta.title = info.title;
+    meta.artist = info.albumArtist.isEmpty() ? info.artist : info.albumArtist;
+    meta.album = info.album;
+    meta.durationMs = info.durationMs;
+    if (!info.coverData.isEmpty()) meta.coverHash = CoverCache::instance().store(info.coverData);
+    return meta;
+}
+
+bool MetadataService::wanted(const QString &path, Priority *priority) const
+{
+    // 等待回调者与可见行同级；多个视图取最高的一级
+    if (m_pending.contains(path)) {
+        *priority = Priority::Visible;
+        return true;
+    }
+    bool nearby = false;
+    for (const Viewport &viewport : m_viewports) {
+        if (viewport.visible.contains(path)) {
+            *priority = Priority::Visible;
+            return true;
+        }
+        nearby = nearby || viewport.nearby.contains(path);
+    }
+    if (nearby) {
+        *priority = Priority::Nearby;
+        return true;
+    }
+    if (m_background.contains(path)) {
+        *priority = Priority::Background;
+        return true;
+    }
+    return false;
+}
+
+void MetadataService::reschedule(const QString &path)
+{
+    // 读取一旦开始便不中止；已缓存的无需排队
+    if (m_reading.contains(path)) return;
+    Priority priority;
+    if (m_cache.contains(path) || !wanted(path, &priority)) {
+        // 取消：队列里的旧条目留待出队时跳过
+        m_queued.remove(path);
+        return;
+    }
+    auto it = m_queued.constFind(path);
+    if (it != m_queued.cend() && it->first == priority) return;
+
+    const quint64 ticket = ++m_nextTicket;
+    m_queued.insert(path, { priority, ticket });
+    std::deque<std::pair<QString, quint64>> &queue = m_queues[int(priority)];
+    queue.emplace_back(path, ticket);
+    // 视口来回移动会留下大量过期条目，超过有效条目一定倍数时压实
+    if (queue.size() > 2 * size_t(m_queued.size()) + 1024) {
+        std::deque<std::pair<QString, quint64>> live;
+        for (auto &entry : queue) {
+            auto q = m_queued.constFind(entry.first);
+            if (q != m_queued.cend() && q->second == entry.second) live.push_back(std::move(entry));
+        }
+        queue.swap(live);
+    }
+}
+
+void MetadataService::dispatch()
+{
+    while (m_reading.size() < m_maxReads) {
+        QString path;
+        for (auto &queue : m_queues) {
+            while (!queue.empty() && path.isEmpty()) {
+                const std::pair<QString, quint64> entry = std::move(queue.front());
+                queue.pop_front();
+                auto it = m_queued.constFind(entry.first);
+                if (it == m_queued.cend() || it->second != entry.second) continue;
+                m_queued.erase(it);
+                path = entry.first;
+            }
+            if (!path.isEmpty()) break;
+        }
+        if (path.isEmpty()) break;
+
+        m_reading.insert(path);
+        QPointer<MetadataService> guard(this);
+        m_pool.start([this, guard, path]() {
+            const TrackMetadata meta = read(path);
+            if (!guard) return;
+            QMetaObject::invokeMethod(this, [this, path, meta]() { finish(path, meta); }, Qt::QueuedConnection);
+        });
+    }
+    TRACE_COUNTER("metadata.queued", m_queued.size());
+}
+
+bool MetadataService::fromIndex(const QString &path, TrackMetadata *out)
+{
+    if (isResource(path)) return false;
+    QVariantMap indexed;
+    if (!MetadataIndex::instance().lookup(path, FileStamp::of(path), &indexed)) return false;
+    // 仅由预取写入的记录没有 coverHash 键：封面尚未读过，仍需读取文件
+    if (!indexed.contains(QStringLiteral("coverHash"))) return false;
+    out->title = indexed.value(QStringLiteral("title")).toString();
+    out->artist = indexed.value(QStringLiteral("artist")).toString();
+    out->album = indexed.value(QStringLiteral("album")).toString();
+    out->durationMs = indexed.value(QStringLiteral("duration")).toLongLong();
+    out->coverHash = indexed.value(QStringLiteral("coverHash")).toString();
+    return true;
+}
+
+void MetadataService::finish(const QString &path, const TrackMetadata &meta)
+{
+    m_reading.remove(path);
+    m_background.remove(path);
+    m_cache.insert(path, new TrackMetadata(meta));
+    if (!isResource(path)) {
+        // 在仍有效的已有记录（可能带 lyricsPath 等字段）上整条写回；无封面时也记录空哈希，下次不必再读
+        const FileStamp stamp = FileStamp::of(path);
+        if (stamp.isFile) {
+            QVariantMap record;
+            MetadataIndex::instance().lookup(path, stamp, &record);
+            record.insert(QStringLiteral("title"), meta.title);
+            record.insert(QStringLiteral("artist"), meta.artist);
+            record.insert(QStringLiteral("album"), meta.album);
+            record.insert(QStringLiteral("duration"), meta.durationMs);
+            record.insert(QStringLiteral("coverHash"), meta.coverHash);
+            MetadataIndex::instance().insert(path, stamp, record);
+        }
+    }
+
+    const std::vector<Waiter> waiters = m_pending.take(path);
+    TRACE_COUNTER("metadata.pending", m_pending.size());
+    for (const Waiter &waiter : waiters) {
+        if (waiter.owner) forgetWaiter(waiter.owner, path);
+    }
+    for (const Waiter &waiter : waiters) {
+        if (waiter.context) waiter.callback(meta);
+    }
+    emit ready(path, meta);
+    dispatch();
+}
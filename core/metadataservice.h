@@ -0,0 +1,119 @@
+// core/metadataservice.h
+#ifndef CORE_METADATASERVICE_H
+#define CORE_METADATASERVICE_H
+
+// 共享元数据服务：在线程池中由 TagReader 直接解析标签，封面原始字节存入 CoverCache
+// 同一路径的并发请求只读取一次；结果按路径缓存（内存 LRU + 持久化 MetadataIndex）
+// 读取按优先级调度（可见 > 视口附近 > 后台），排队中的请求可随视口移动提升、降级或取消
+// 不创建任何播放器或音频输出，无声卡的机器上同样可用
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVariantMap>
+
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+struct TrackMetadata
+{
+    QString title;          // 标签缺失时为空，由调用方决定回退显示
+    QString artist;         // 专辑艺术家优先，与 TagInfo::toVariantMap 一致
+    QString album;
+    qint64 durationMs = 0;
+    QString coverHash;      // CoverCache 内容哈希；无封面时为空
+
+    // 与 MetadataIndex 记录相同的键：title / artist / album / duration / coverHash
+    QVariantMap toVariantMap() const;
+};
+
+class MetadataService : public QObject
+{
+    Q_OBJECT
+public:
+    using Callback = std::function<void(const TrackMetadata &)>;
+
+    enum class Priority { Visible, Nearby, Background };
+
+    static MetadataService &instance();
+    ~MetadataService() override;
+
+    // 本地路径、file: URL、qrc:/ 资源统一为缓存键
+    static QString normalizePath(const QString &source);
+
+    // 已缓存时写入 out 并返回 true
+    bool cached(const QString &source, TrackMetadata *out) const;
+    // 回调在 GUI 线程执行：命中缓存时同步回调，否则读取完成后回调；context 销毁后不再回调
+    void request(const QString &source, QObject *context, Callback callback);
+    // 撤销 context 尚未完成的全部请求：没有其他请求方的路径退回视口/后台优先级或直接出队
+    // context 销毁时自动调用
+    void cancel(QObject *context);
+    // 后台预取：不回调，读取完成后发出 ready；已排队的路径不会被降级
+    void prefetch(const QStringList &sources);
+    // 视图当前的可见行与附近行（整体替换上一次的集合）：新进入的提升优先级，
+    // 离开视口且没有其他请求方的直接取消；view 销毁时自动撤销
+    void setViewport(QObject *view, const QStringList &visible, const QStringList &nearby);
+    // 同时进行的读取数上限（默认随 CPU 核数，2~4）
+    void setMaxConcurrentReads(int count);
+    int maxConcurrentReads() const { return m_maxReads; }
+    // 文件内容变化或被删除时丢弃缓存
+    void invalidate(const QString &source);
+
+signals:
+    // 每次读取完成（无论由谁发起）都发出，只在 GUI 线程
+    void ready(const QString &path, const TrackMetadata &meta);
+
+private:
+    struct Waiter
+    {
+        QObject *owner;                 // 仅用于撤销时比对，不解引用
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    struct ContextRequests
+    {
+        QSet<QString> paths;
+        QMetaObject::Connection destroyed;
+    };
+
+    struct Viewport
+    {
+        QSet<QString> visible;
+        QSet<QString> nearby;
+    };
+
+    explicit MetadataService(QObject *parent = nullptr);
+    static TrackMetadata read(const QString &path);
+    static bool fromIndex(const QString &path, TrackMetadata *out);
+    // 按当前全部请求方（等待者、视口、后台预取）重新决定路径的排队状态，均摊 O(1)
+    void reschedule(const QString &path);
+    bool wanted(const QString &path, Priority *priority) const;
+    void dispatch();
+    void removeViewport(QObject *view);
+    void forgetWaiter(QObject *owner, const QString &path);
+    void finish(const QString &path, const TrackMetadata &meta);
+
+    QThreadPool m_pool;
+    QCache<QString, TrackMetadata> m_cache;
+    // 以下仅 GUI 线程访问
+    QHash<QString, std::vector<Waiter>> m_pending;    // 路径 -> 等待回调者
+    QHash<QObject *, ContextRequests> m_contexts;     // 请求方 -> 其等待中的路径
+    QSet<QString> m_background;                       // 后台预取请求的路径
+    QHash<QObject *, Viewport> m_viewports;
+    // 排队中的路径 -> (优先级, 票号)；队列中票号不符的条目已被改期或取消，出队时跳过
+    QHash<QString, std::pair<Priority, quint64>> m_queued;
+    std::deque<std::pair<QString, quint64>> m_queues[3];
+    QSet<QString> m_reading;
+    quint64 m_nextTicket = 0;
+    int m_maxReads;
+    static const int CACHE_ENTRIES = 4096;
+};
+
+#endif // CORE_METADATASERVICE_H
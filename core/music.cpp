@@ -1,38 +1,23 @@
-// 实现文件：AudioMetadata 与 MusicLibrary 的实现
+// 实现文件：AudioMetadata 与 MusicLibrary（LibraryEngine 外观）的实现
 #include "core/music.h"
+#include "core/libraryengine.h"
+#include "core/covercache.h"
 
-#include <QMediaPlayer>
-#include <QAudioOutput>
-#include <QCoreApplication>
-#include <QFile>
 #include <QFileInfo>
-#include <QDir>
-#include <QDirIterator>
-#include <QStandardPaths>
-#include <QImage>
-#include <QPixmap>
-#include <QFileSystemWatcher>
+#include <QSet>
 #include <QTimer>
 
 // ---------------------- AudioMetadata ----------------------
 AudioMetadata::AudioMetadata(QObject *parent)
     : QObject(parent)
-    , m_mediaPlayer(new QMediaPlayer(this))
-    , m_audioOutput(new QAudioOutput(this))
     , m_duration(0)
 {
-    m_mediaPlayer->setAudioOutput(m_audioOutput);
-    connect(m_mediaPlayer, &QMediaPlayer::metaDataChanged,
-            this, &AudioMetadata::onMetaDataChanged);
-    connect(m_mediaPlayer, &QMediaPlayer::durationChanged,
-            this, &AudioMetadata::onDurationChanged);
 }
 
 AudioMetadata::~AudioMetadata()
 {
-    if (!m_tempCoverPath.isEmpty()) {
-        QFile::remove(m_tempCoverPath);
-    }
+    // 从未发起过请求的句柄无需撤销，也避免在退出阶段重新创建服务
+    if (m_generation > 0) MetadataService::instance().cancel(this);
 }
 
 void AudioMetadata::setSource(const QString &source)
@@ -40,6 +25,8 @@ void AudioMetadata::setSource(const QString &source)
     if (m_source != source) {
         m_source = source;
         emit sourceChanged();
+        // 旧来源的读取不再需要：撤销后不会再以可见优先级插到屏幕上的行前面
+        MetadataService::instance().cancel(this);
 
         m_title.clear();
         m_artist.clear();
@@ -47,11 +34,6 @@ void AudioMetadata::setSource(const QString &source)
         m_coverImageUrl.clear();
         m_duration = 0;
 
-        if (!m_tempCoverPath.isEmpty()) {
-            QFile::remove(m_tempCoverPath);
-            m_tempCoverPath.clear();
-        }
-
         loadMetadata();
     }
 }
@@ -60,89 +42,35 @@ void AudioMetadata::loadMetadata()
 {
     if (m_source.isEmpty()) return;
 
-    // 设置媒体源
-    if (m_source.startsWith("qrc:/")) {
-        m_mediaPlayer->setSource(QUrl(m_source));
-    } else {
-        m_mediaPlayer->setSource(QUrl::fromLocalFile(m_source));
-    }
+    // 同一来源的多个句柄共享一次读取与一条缓存；已缓存时同步应用
+    const quint64 generation = ++m_generation;
+    MetadataService::instance().request(m_source, this, [this, generation](const TrackMetadata &meta) {
+        if (generation == m_generation) applyMetadata(meta);
+    });
 }
 
-void AudioMetadata::onMetaDataChanged()
+void AudioMetadata::applyMetadata(const TrackMetadata &meta)
 {
-    const QMediaMetaData metaData = m_mediaPlayer->metaData();
-
     // 标题
-    if (metaData.value(QMediaMetaData::Title).isValid()) {
-        m_title = metaData.value(QMediaMetaData::Title).toString();
-    } else {
-        m_title = extractFileNameTitle(m_source);
-    }
+    m_title = meta.title.isEmpty() ? extractFileNameTitle(m_source) : meta.title;
     emit titleChanged();
 
     // 艺术家
-    if (metaData.value(QMediaMetaData::AlbumArtist).isValid()) {
-        m_artist = metaData.value(QMediaMetaData::AlbumArtist).toString();
-    } else if (metaData.value(QMediaMetaData::ContributingArtist).isValid()) {
-        m_artist = metaData.value(QMediaMetaData::ContributingArtist).toString();
-    } else {
-        m_artist = QStringLiteral("未知艺术家");
-    }
+    m_artist = meta.artist.isEmpty() ? QStringLiteral("未知艺术家") : meta.artist;
     emit artistChanged();
 
     // 专辑
-    if (metaData.value(QMediaMetaData::AlbumTitle).isValid()) {
-        m_album = metaData.value(QMediaMetaData::AlbumTitle).toString();
-    } else {
-        m_album = QStringLiteral("未知专辑");
-    }
+    m_album = meta.album.isEmpty() ? QStringLiteral("未知专辑") : meta.album;
     emit albumChanged();
 
-    // 封面
-    extractCoverArt();
-    emit metadataLoaded();
-}
-
-void AudioMetadata::onDurationChanged(qint64 duration)
-{
-    m_duration = static_cast<int>(duration / 1000);
+    // 时长（标签或帧头估算；播放中的精确时长由 PlaybackEngine 提供）
+    m_duration = static_cast<int>(meta.durationMs / 1000);
     emit durationChanged();
-}
-
-void AudioMetadata::extractCoverArt()
-{
-    const QMediaMetaData metaData = m_mediaPlayer->metaData();
-    QVariant coverData;
-
-    if (metaData.value(QMediaMetaData::CoverArtImage).isValid()) {
-        coverData = metaData.value(QMediaMetaData::CoverArtImage);
-    } else if (metaData.value(QMediaMetaData::ThumbnailImage).isValid()) {
-        coverData = metaData.value(QMediaMetaData::ThumbnailImage);
-    }
-
-    if (coverData.isValid()) {
-        QImage coverImage;
-        if (coverData.canConvert<QImage>()) {
-            coverImage = coverData.value<QImage>();
-        } else if (coverData.canConvert<QPixmap>()) {
-            coverImage = coverData.value<QPixmap>().toImage();
-        } else if (coverData.canConvert<QByteArray>()) {
-            QByteArray imageData = coverData.toByteArray();
-            coverImage.loadFromData(imageData);
-        }
 
-        if (!coverImage.isNull()) {
-            QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-            m_tempCoverPath = tempDir + "/music_cover_" + QString::number(QCoreApplication::applicationPid()) + ".png";
-            if (coverImage.save(m_tempCoverPath, "PNG")) {
-                m_coverImageUrl = QUrl::fromLocalFile(m_tempCoverPath);
-                emit coverImageUrlChanged();
-            }
-        }
-    } else {
-        m_coverImageUrl = QUrl();
-        emit coverImageUrlChanged();
-    }
+    // 封面
+    m_coverImageUrl = meta.coverHash.isEmpty() ? QUrl() : QUrl(CoverCache::urlFor(meta.coverHash));
+    emit coverImageUrlChanged();
+    emit metadataLoaded();
 }
 
 QString AudioMetadata::extractFileNameTitle(const QString &filePath)
@@ -159,70 +87,30 @@ QString AudioMetadata::extractFileNameTitle(const QString &filePath)
 // ---------------------- MusicLibrary ----------------------
 MusicLibrary::MusicLibrary(QObject *parent)
     : QObject(parent)
-    , m_watcher(new QFileSystemWatcher(this))
-    , m_scanTimer(new QTimer(this))
-    , m_isWatching(false)
-    , m_prefetchPlayer(new QMediaPlayer(this))
-    , m_prefetchOutput(new QAudioOutput(this))
-    , m_prefetchActive(false)
-{
-    // 配置扫描定时器
-    m_scanTimer->setSingleShot(true);
-    m_scanTimer->setInterval(SCAN_DELAY_MS);
-    m_lastScanMs = 0;
-    
-    // 连接信号
-    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
-            this, &MusicLibrary::onDirectoryChanged);
-    connect(m_watcher, &QFileSystemWatcher::fileChanged,
-            this, &MusicLibrary::onFileChanged);
-    connect(m_scanTimer, &QTimer::timeout,
-            this, &MusicLibrary::performDelayedScan);
+{
+    LibraryEngine &engine = LibraryEngine::instance();
+    connect(&engine, &LibraryEngine::fileAdded, this, &MusicLibrary::onEngineFileAdded);
+    connect(&engine, &LibraryEngine::fileRemoved, this, &MusicLibrary::onEngineFileRemoved);
+    connect(&engine, &LibraryEngine::scanBatch, this, &MusicLibrary::onEngineScanBatch);
+    connect(&engine, &LibraryEngine::scanFinished, this, &MusicLibrary::onEngineScanFinished);
+    // 元数据存储全局唯一：任一视图触发的预取结果所有视图都能看到
+    connect(&engine, &LibraryEngine::metadataReady, this, &MusicLibrary::metadataReady);
+}
 
-    m_prefetchPlayer->setAudioOutput(m_prefetchOutput);
-    connect(m_prefetchPlayer, &QMediaPlayer::metaDataChanged,
-            this, &MusicLibrary::onPrefetchMetaDataChanged);
-    connect(m_prefetchPlayer, &QMediaPlayer::durationChanged,
-            this, &MusicLibrary::onPrefetchDurationChanged);
+MusicLibrary::~MusicLibrary()
+{
+    LibraryEngine::instance().releaseScan(m_scanKey);
+    stopWatching();
 }
 
 QStringList MusicLibrary::scanMusicFiles(const QString &rootPath, bool recursive)
 {
-    QStringList musicFiles;
-    if (rootPath.isEmpty()) return musicFiles;
-
-    QString normalized = rootPath;
-    if (rootPath.startsWith("file:")) {
-        QUrl u(rootPath);
-        if (u.isValid()) normalized = u.toLocalFile();
-    }
-    normalized = QDir::fromNativeSeparators(normalized);
-
-    QDir dir(normalized);
-    if (!dir.exists()) return musicFiles;
-
-    QStringList extensions = getValidMusicExtensions();
-    QStringList nameFilters;
-    for (const QString &ext : extensions) {
-        nameFilters << QString("*.%1").arg(ext);
-    }
-
-    QDirIterator::IteratorFlag flag = recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags;
-    QDirIterator it(normalized, nameFilters, QDir::Files, flag);
-
-    while (it.hasNext()) {
-        QString filePath = it.next();
-        if (isValidMusicFile(filePath)) {
-            musicFiles.append(filePath);
-        }
-    }
-
-    return musicFiles;
+    return LibraryEngine::instance().scanMusicFiles(rootPath, recursive);
 }
 
 QString MusicLibrary::defaultProjectRoot()
 {
-    return findProjectRootFromAppDir();
+    return LibraryEngine::instance().defaultProjectRoot();
 }
 
 QStringList MusicLibrary::scanDefaultProjectMusic(bool recursive)
@@ -230,26 +118,10 @@ QStringList MusicLibrary::scanDefaultProjectMusic(bool recursive)
     return scanMusicFiles(defaultProjectRoot(), recursive);
 }
 
-QString MusicLibrary::findProjectRootFromAppDir() const
-{
-    QString appDir = QCoreApplication::applicationDirPath();
-    QDir dir(appDir);
-
-    // 向上查找最多6级目录
-    for (int i = 0; i < 6; ++i) {
-        if (dir.exists("src.qrc") || dir.exists("components")) {
-            return dir.absolutePath();
-        }
-        if (!dir.cdUp()) break;
-    }
-
-    return appDir; // 默认返回应用程序目录
-}
-
 // 新增：获取Windows音乐文件夹路径
 QString MusicLibrary::getWindowsMusicFolder()
 {
-    return QStandardPaths::writableLocation(QStandardPaths::MusicLocation);
+    return LibraryEngine::instance().musicFolder();
 }
 
 // 新增：扫描Windows音乐文件夹
@@ -270,164 +142,104 @@ QStringList MusicLibrary::scanAllAvailableMusic(bool recursive)
     // 首先扫描项目音乐
     QStringList projectMusic = scanDefaultProjectMusic(recursive);
     allMusic.append(projectMusic);
+    QSet<QString> seen(projectMusic.cbegin(), projectMusic.cend());
     
     // 始终合并Windows音乐文件夹，避免项目有少量文件时遗漏用户库
     QStringList windowsMusic = scanWindowsMusic(recursive);
     for (const QString &p : windowsMusic) {
-        if (!allMusic.contains(p)) allMusic.append(p);
+        if (!seen.contains(p)) {
+            seen.insert(p);
+            allMusic.append(p);
+        }
     }
     
-    // 更新缓存
-    m_cachedFiles = allMusic;
+    // 更新共享文件集合
+    LibraryEngine::instance().addFiles(allMusic);
+    m_singleRoot.clear();
     
     return allMusic;
 }
 
-// 查找与音源同名同目录的 LRC，或项目根目录回退
-QString MusicLibrary::findLyricsFileForSource(const QString &source)
+void MusicLibrary::scanMusicFilesAsync(const QString &rootPath, bool recursive)
 {
-    if (source.isEmpty()) return QString();
+    joinScan(QStringList() << LibraryEngine::normalizePath(rootPath), recursive);
+}
 
-    // 优先：同名同目录
-    auto trySameDir = [&](const QString &localPath) -> QString {
-        QFileInfo fi(localPath);
-        if (!fi.exists()) return QString();
-        QString candidate = fi.dir().absoluteFilePath(fi.completeBaseName() + ".lrc");
-        if (QFile::exists(candidate)) {
-            return QUrl::fromLocalFile(candidate).toString();
-        }
-        // 兼容：若同名未命中且目录内只有一个 .lrc，则使用该文件
-        QStringList lrcs = fi.dir().entryList(QStringList() << "*.lrc", QDir::Files, QDir::Name);
-        if (lrcs.size() == 1) {
-            QString onlyLrc = fi.dir().absoluteFilePath(lrcs.first());
-            if (QFile::exists(onlyLrc)) {
-                return QUrl::fromLocalFile(onlyLrc).toString();
-            }
-        }
-        return QString();
-    };
-
-    if (source.startsWith("file:///")) {
-        QUrl u(source);
-        QString localPath = u.toLocalFile();
-        QString hit = trySameDir(localPath);
-        if (!hit.isEmpty()) return hit;
-    } else if (source.startsWith("qrc:/")) {
-        // qrc: 路径下尝试根据文件名在项目根目录匹配
-        QUrl u(source);
-        QFileInfo fi(u.path());
-        QString baseName = fi.completeBaseName();
-        QString root = defaultProjectRoot();
-        QString candidate = QDir(root).absoluteFilePath(baseName + ".lrc");
-        if (QFile::exists(candidate)) {
-            return QUrl::fromLocalFile(candidate).toString();
-        }
-    } else {
-        // 普通本地路径
-        QString hit = trySameDir(source);
-        if (!hit.isEmpty()) return hit;
-    }
+void MusicLibrary::scanAllAvailableMusicAsync(bool recursive)
+{
+    // 项目目录在前，与 scanAllAvailableMusic 的合并顺序一致；重叠部分由扫描器去重
+    joinScan(LibraryEngine::instance().defaultRoots(), recursive);
+}
 
-    // 回退：项目根目录第一个 .lrc 文件（避免完全无歌词）
-    QString root = defaultProjectRoot();
-    QDirIterator it(root, QStringList() << "*.lrc", QDir::Files, QDirIterator::NoIteratorFlags);
-    if (it.hasNext()) {
-        QString p = it.next();
-        return QUrl::fromLocalFile(p).toString();
+void MusicLibrary::joinScan(const QStringList &roots, bool recursive)
+{
+    LibraryEngine &engine = LibraryEngine::instance();
+    const QString key = LibraryEngine::scanKey(roots, recursive);
+    // 再次加入自己正在参与的扫描只补发结果；换了根目录则先退出原来的扫描
+    const bool joined = key == m_scanKey && engine.isScanning() && engine.currentScanKey() == key;
+    if (!joined) engine.releaseScan(m_scanKey);
+    m_scanKey = key;
+    m_singleRoot.clear();
+    if (!engine.scanReusable(key)) {
+        engine.startScan(roots, recursive);
+        return;
     }
-    return QString();
+    if (!joined) engine.retainScan(key);
+    // 其他视图已发起同一扫描：先补发已到达的文件，之后的批次经引擎信号转发
+    const QStringList files = engine.scannedFiles();
+    const bool finished = !engine.isScanning();
+    QTimer::singleShot(0, this, [this, key, files, finished]() {
+        if (m_scanKey != key) return;
+        if (!files.isEmpty()) emit scanBatch(files);
+        if (finished) emit scanFinished(int(files.size()), 0);
+    });
 }
 
-// 读取歌词文本（UTF-8优先，回退本地编码）
-QString MusicLibrary::loadLyricsText(const QString &source)
+void MusicLibrary::cancelScan()
 {
-    QString lrcUrl = findLyricsFileForSource(source);
-    if (lrcUrl.isEmpty()) return QString();
-    QUrl u(lrcUrl);
-    QString lrcPath = u.toLocalFile();
-    if (lrcPath.isEmpty()) {
-        // 兜底：如果传入的就是本地路径
-        lrcPath = lrcUrl;
-    }
-    QFile f(lrcPath);
-    if (!f.exists()) return QString();
-    if (f.open(QIODevice::ReadOnly)) {
-        QByteArray bytes = f.readAll();
-        f.close();
-        // 尝试UTF-8
-        QString text = QString::fromUtf8(bytes);
-        // 若解码后基本为空，则回退本地编码
-        if (text.trimmed().isEmpty() && !bytes.isEmpty()) {
-            text = QString::fromLocal8Bit(bytes);
-        }
-        return text;
-    }
-    return QString();
+    // 只退出本视图的参与；其他视图仍在等待同一扫描时继续进行
+    LibraryEngine::instance().releaseScan(m_scanKey);
+    m_scanKey.clear();
 }
 
-QVariantMap MusicLibrary::getMetadata(const QString &source)
+bool MusicLibrary::isScanning() const
 {
-    return m_metaCache.value(source);
+    return LibraryEngine::instance().isScanning();
 }
 
-void MusicLibrary::prefetchMetadata(const QStringList &files)
+void MusicLibrary::onEngineScanBatch(const QStringList &files)
 {
-    for (const QString &f : files) {
-        if (f.isEmpty()) continue;
-        QString local = f;
-        if (f.startsWith("file:")) {
-            QUrl u(f);
-            if (u.isValid()) local = u.toLocalFile();
-        }
-        if (!isValidMusicFile(local)) continue;
-        if (!m_prefetchQueue.contains(local) && !m_metaCache.contains(local)) m_prefetchQueue.append(local);
-    }
-    if (!m_prefetchActive) {
-        m_prefetchActive = true;
-        QTimer::singleShot(0, this, &MusicLibrary::processNextPrefetch);
-    }
+    if (!m_scanKey.isEmpty() && m_scanKey == LibraryEngine::instance().currentScanKey()) emit scanBatch(files);
 }
 
-void MusicLibrary::processNextPrefetch()
+void MusicLibrary::onEngineScanFinished(const QString &key, int count, qint64 elapsedMs)
 {
-    if (m_prefetchQueue.isEmpty()) {
-        m_prefetchActive = false;
-        m_currentPrefetchSource.clear();
-        return;
-    }
-    m_currentPrefetchSource = m_prefetchQueue.takeFirst();
-    if (m_currentPrefetchSource.startsWith("qrc:/")) {
-        m_prefetchPlayer->setSource(QUrl(m_currentPrefetchSource));
-    } else {
-        m_prefetchPlayer->setSource(QUrl::fromLocalFile(m_currentPrefetchSource));
-    }
-    if (m_prefetchOutput) m_prefetchOutput->setVolume(0.0);
-    m_prefetchPlayer->play();
+    if (!m_scanKey.isEmpty() && m_scanKey == key) emit scanFinished(count, elapsedMs);
 }
 
-void MusicLibrary::onPrefetchMetaDataChanged()
+QString MusicLibrary::findLyricsFileForSource(const QString &source)
 {
-    if (m_currentPrefetchSource.isEmpty()) return;
-    const QMediaMetaData md = m_prefetchPlayer->metaData();
-    QVariantMap meta;
-    QString title = md.value(QMediaMetaData::Title).toString();
-    QString artist;
-    if (md.value(QMediaMetaData::AlbumArtist).isValid()) artist = md.value(QMediaMetaData::AlbumArtist).toString();
-    else if (md.value(QMediaMetaData::ContributingArtist).isValid()) artist = md.value(QMediaMetaData::ContributingArtist).toString();
-    meta.insert("title", title);
-    meta.insert("artist", artist);
-    meta.insert("duration", m_prefetchPlayer->duration());
-    m_metaCache.insert(m_currentPrefetchSource, meta);
-    emit metadataReady(m_currentPrefetchSource, meta);
-    QTimer::singleShot(1, this, &MusicLibrary::processNextPrefetch);
+    return LibraryEngine::instance().findLyricsFileForSource(source);
 }
 
-void MusicLibrary::onPrefetchDurationChanged(qint64 duration)
+QString MusicLibrary::loadLyricsText(const QString &source)
 {
-    if (m_currentPrefetchSource.isEmpty()) return;
-    auto meta = m_metaCache.value(m_currentPrefetchSource);
-    meta.insert("duration", static_cast<int>(duration));
-    m_metaCache.insert(m_currentPrefetchSource, meta);
+    return LibraryEngine::instance().loadLyricsText(source);
+}
+
+QVariantMap MusicLibrary::getMetadata(const QString &source)
+{
+    return LibraryEngine::instance().getMetadata(source);
+}
+
+void MusicLibrary::prefetchMetadata(const QStringList &files)
+{
+    LibraryEngine::instance().prefetchMetadata(files);
+}
+
+void MusicLibrary::prefetchViewport(const QStringList &visible, const QStringList &nearby)
+{
+    LibraryEngine::instance().prefetchViewport(this, visible, nearby);
 }
 
 // 新增：文件监控功能
@@ -436,20 +248,10 @@ void MusicLibrary::startWatching()
     if (m_isWatching) return;
     
     m_isWatching = true;
-    m_watchedPaths.clear();
-    
-    // 添加项目根目录到监控
-    QString projectRoot = defaultProjectRoot();
-    if (!projectRoot.isEmpty()) {
-        addWatchPath(projectRoot);
+    // 项目根目录与Windows音乐文件夹；同一目录被多个视图监控时只注册一次
+    for (const QString &root : LibraryEngine::instance().defaultRoots()) {
+        addWatchPath(root);
     }
-    
-    // 添加Windows音乐文件夹到监控
-    QString windowsMusic = getWindowsMusicFolder();
-    if (!windowsMusic.isEmpty()) {
-        addWatchPath(windowsMusic);
-    }
-    
 }
 
 void MusicLibrary::stopWatching()
@@ -457,9 +259,9 @@ void MusicLibrary::stopWatching()
     if (!m_isWatching) return;
     
     m_isWatching = false;
-    m_watcher->removePaths(m_watchedPaths);
+    LibraryEngine &engine = LibraryEngine::instance();
+    for (const QString &root : std::as_const(m_watchedPaths)) engine.releaseRoot(root);
     m_watchedPaths.clear();
-    m_scanTimer->stop();
 }
 
 bool MusicLibrary::isWatching() const
@@ -469,167 +271,75 @@ bool MusicLibrary::isWatching() const
 
 void MusicLibrary::addWatchDirectory(const QString &path)
 {
-    QString local = path;
-    if (path.startsWith("file:")) {
-        QUrl u(path);
-        if (u.isValid()) local = u.toLocalFile();
-    }
-    addWatchPath(local);
-}
-
-// 新增：缓存管理
-void MusicLibrary::clearCache()
-{
-    m_cachedFiles.clear();
+    addWatchPath(LibraryEngine::normalizePath(path));
 }
 
-int MusicLibrary::getCachedFileCount() const
+void MusicLibrary::addWatchPath(const QString &path)
 {
-    return m_cachedFiles.size();
+    if (path.isEmpty() || m_watchedPaths.contains(path) || !QFileInfo(path).isDir()) return;
+    m_watchedPaths.append(path);
+    LibraryEngine::instance().retainRoot(path);
 }
 
-// 新增：文件监控槽函数
-void MusicLibrary::onDirectoryChanged(const QString &path)
+bool MusicLibrary::isWatchedPath(const QString &path) const
 {
-    // 检查路径是否仍然存在
-    QDir dir(path);
-    if (!dir.exists()) {
-        // 重新添加父目录到监控（如果存在）
-        QDir parentDir = dir;
-        if (parentDir.cdUp() && parentDir.exists()) {
-            m_watcher->addPath(parentDir.absolutePath());
-        }
+    if (!m_isWatching) return false;
+    for (const QString &root : m_watchedPaths) {
+        if (LibraryEngine::isUnder(path, root)) return true;
     }
-    
-    // 延迟扫描以避免频繁更新
-    m_scanTimer->start();
+    return false;
 }
 
-void MusicLibrary::onFileChanged(const QString &path)
+void MusicLibrary::onEngineFileAdded(const QString &filePath)
 {
-    // 检查文件是否仍然存在
-    QFileInfo fileInfo(path);
-    if (!fileInfo.exists()) {
-        // 从监控中移除
-        m_watcher->removePath(path);
-    }
-    
-    // 延迟扫描以避免频繁更新
-    m_scanTimer->start();
+    if (isWatchedPath(filePath)) emit fileAdded(filePath);
 }
 
-void MusicLibrary::performDelayedScan()
+void MusicLibrary::onEngineFileRemoved(const QString &filePath)
 {
-    if (!m_isWatching) return;
-    const qint64 now = QDateTime::currentMSecsSinceEpoch();
-    if (m_lastScanMs > 0 && (now - m_lastScanMs) < 7000) {
-        // 退抖：7s 内不重复全量扫描
-        m_scanTimer->start();
-        return;
-    }
-    m_lastScanMs = now;
-    
-    // 重新扫描当前监控路径
-    QStringList newFiles;
-    if (!m_watchedPaths.isEmpty()) {
-        for (const QString &p : m_watchedPaths) {
-            newFiles += scanMusicFiles(p, true);
-        }
-    } else {
-        newFiles = scanAllAvailableMusic(true);
-    }
-    
-    // 检查是否有变化
-    if (newFiles != m_cachedFiles) {
-        // 找出新增和删除的文件
-        QStringList addedFiles;
-        QStringList removedFiles;
-        
-        for (const QString &file : newFiles) {
-            if (!m_cachedFiles.contains(file)) {
-                addedFiles.append(file);
-            }
-        }
-        
-        for (const QString &file : m_cachedFiles) {
-            if (!newFiles.contains(file)) {
-                removedFiles.append(file);
-            }
-        }
-        
-        // 更新缓存
-        m_cachedFiles = newFiles;
-        
-        // 发送信号
-        emit musicFilesChanged(newFiles);
-        
-        for (const QString &file : addedFiles) {
-            emit fileAdded(file);
-        }
-        
-        for (const QString &file : removedFiles) {
-            emit fileRemoved(file);
-        }
-    }
+    if (isWatchedPath(filePath)) emit fileRemoved(filePath);
 }
 
-// 新增：辅助方法
-QStringList MusicLibrary::getValidMusicExtensions() const
+// 新增：缓存管理（文件集合为所有视图共享）
+void MusicLibrary::clearCache()
 {
-    return QStringList() << "mp3" << "m4a" << "flac" << "wav" << "ogg" << "aac" << "wma";
+    m_singleRoot.clear();
+    LibraryEngine::instance().clearCache();
 }
 
-bool MusicLibrary::isValidMusicFile(const QString &filePath) const
+int MusicLibrary::getCachedFileCount() const
 {
-    QString local = filePath;
-    if (filePath.startsWith("file:")) {
-        QUrl u(filePath);
-        if (u.isValid()) local = u.toLocalFile();
-    }
-    QFileInfo fileInfo(local);
-    if (!fileInfo.exists() || !fileInfo.isFile()) {
-        return false;
-    }
-    
-    QString extension = fileInfo.suffix().toLower();
-    return getValidMusicExtensions().contains(extension);
+    if (m_singleRoot.isEmpty()) return LibraryEngine::instance().cachedFileCount();
+    return int(cachedFiles().size());
 }
 
-void MusicLibrary::addWatchPath(const QString &path)
+QStringList MusicLibrary::cachedFiles() const
 {
-    if (path.isEmpty() || m_watchedPaths.contains(path)) {
-        return;
-    }
-    
-    QDir dir(path);
-    if (!dir.exists()) {
-        return;
+    const QStringList all = LibraryEngine::instance().cachedFiles();
+    if (m_singleRoot.isEmpty()) return all;
+    QStringList files;
+    for (const QString &file : all) {
+        if (LibraryEngine::isUnder(file, m_singleRoot)) files.append(file);
     }
-    
-    m_watchedPaths.append(path);
-    m_watcher->addPath(path);
-    // 取消递归子目录监控，避免大量事件导致频繁全量扫描
+    return files;
 }
 
-void MusicLibrary::updateFileCache()
+bool MusicLibrary::isValidMusicFile(const QString &filePath) const
 {
-    m_cachedFiles = scanAllAvailableMusic(true);
+    return LibraryEngine::isValidMusicFile(filePath);
 }
 
 QStringList MusicLibrary::scanOnlyDirectory(const QString &path)
 {
-    QString local = path;
-    if (path.startsWith("file:")) {
-        QUrl u(path);
-        if (u.isValid()) local = u.toLocalFile();
-    }
-    local = QDir::fromNativeSeparators(local);
+    const QString local = LibraryEngine::normalizePath(path);
     stopWatching();
-    m_watchedPaths.clear();
+    m_scanKey.clear();
+    QStringList files = scanMusicFiles(local, true);
+    LibraryEngine::instance().addFiles(files);
+    m_singleRoot = local;
+    // 扫描得到的快照即监控基线
     m_isWatching = true;
     addWatchPath(local);
-    QStringList files = scanMusicFiles(local, true);
-    m_cachedFiles = files;
     emit musicFilesChanged(files);
     return files;
 }
@@ -638,11 +348,5 @@ void MusicLibrary::startWatchingSingle(const QString &path)
 {
     stopWatching();
     m_isWatching = true;
-    m_watchedPaths.clear();
-    QString local = path;
-    if (path.startsWith("file:")) {
-        QUrl u(path);
-        if (u.isValid()) local = u.toLocalFile();
-    }
-    addWatchPath(local);
+    addWatchPath(LibraryEngine::normalizePath(path));
 }
@@ -7,17 +7,11 @@
 #include <QString>
 #include <QStringList>
 #include <QUrl>
-#include <QMediaMetaData>
-#include <QTimer>
-#include <QFileSystemWatcher>
-#include <QHash>
 #include <QVariantMap>
 
-class QMediaPlayer;
-class QAudioOutput;
-class QFileInfo;
+#include "core/metadataservice.h"
 
-// 合并：音频元数据读取
+// 合并：音频元数据读取（轻量句柄：读取与缓存由共享的 MetadataService 完成）
 class AudioMetadata : public QObject
 {
     Q_OBJECT
@@ -51,31 +45,27 @@ signals:
     void durationChanged();
     void metadataLoaded();
 
-private slots:
-    void onMetaDataChanged();
-    void onDurationChanged(qint64 duration);
-
 private:
-    void extractCoverArt();
+    void applyMetadata(const TrackMetadata &meta);
     QString extractFileNameTitle(const QString &filePath);
 
-    QMediaPlayer *m_mediaPlayer;
-    QAudioOutput *m_audioOutput;
     QString m_title;
     QString m_artist;
     QString m_album;
     QUrl m_coverImageUrl;
     QString m_source;
     int m_duration;
-    QString m_tempCoverPath;
+    quint64 m_generation = 0;       // 切换来源后丢弃旧请求的回调
 };
 
-// 合并：音乐库扫描
+// 合并：音乐库扫描（轻量外观：扫描、监控与元数据由进程内共享的 LibraryEngine 完成）
+// 多个实例共用一次扫描与一套监控；各实例只接收自己发起的扫描批次与自己监控范围内的增删
 class MusicLibrary : public QObject
 {
     Q_OBJECT
 public:
     explicit MusicLibrary(QObject *parent = nullptr);
+    ~MusicLibrary() override;
 
     Q_INVOKABLE QStringList scanMusicFiles(const QString &rootPath, bool recursive = true);
     Q_INVOKABLE QString defaultProjectRoot();
@@ -86,11 +76,20 @@ public:
     Q_INVOKABLE QStringList scanWindowsMusic(bool recursive = true);
     Q_INVOKABLE QStringList scanAllAvailableMusic(bool recursive = true);
 
+    // 新增：异步并行扫描，结果经 scanBatch 分批回送，结束时发出 scanFinished
+    // 相同根目录的扫描已在进行或结果仍被监控保持最新时不再重复遍历，先补发已有结果
+    Q_INVOKABLE void scanMusicFilesAsync(const QString &rootPath, bool recursive = true);
+    Q_INVOKABLE void scanAllAvailableMusicAsync(bool recursive = true);
+    Q_INVOKABLE void cancelScan();
+    Q_INVOKABLE bool isScanning() const;
+
     // 新增：歌词支持（返回文本或文件URL）
     Q_INVOKABLE QString loadLyricsText(const QString &source);
     Q_INVOKABLE QString findLyricsFileForSource(const QString &source);
     Q_INVOKABLE QVariantMap getMetadata(const QString &source);
     Q_INVOKABLE void prefetchMetadata(const QStringList &files);
+    // 视图当前可见与附近的条目，优先于后台预取；每次调用替换上一次的集合
+    Q_INVOKABLE void prefetchViewport(const QStringList &visible, const QStringList &nearby);
     Q_INVOKABLE QStringList scanOnlyDirectory(const QString &path);
     
     // 新增：文件监控功能
@@ -103,6 +102,7 @@ public:
     // 新增：缓存和性能优化
     Q_INVOKABLE void clearCache();
     Q_INVOKABLE int getCachedFileCount() const;
+    Q_INVOKABLE QStringList cachedFiles() const;
     Q_INVOKABLE bool isValidMusicFile(const QString &filePath) const;
 
 signals:
@@ -110,35 +110,24 @@ signals:
     void fileAdded(const QString &filePath);
     void fileRemoved(const QString &filePath);
     void metadataReady(const QString &source, const QVariantMap &meta);
+    void scanBatch(const QStringList &files);
+    void scanFinished(int count, qint64 elapsedMs);
 
 private slots:
-    void onDirectoryChanged(const QString &path);
-    void onFileChanged(const QString &path);
-    void performDelayedScan();
-    void processNextPrefetch();
-    void onPrefetchMetaDataChanged();
-    void onPrefetchDurationChanged(qint64 duration);
+    void onEngineFileAdded(const QString &filePath);
+    void onEngineFileRemoved(const QString &filePath);
+    void onEngineScanBatch(const QStringList &files);
+    void onEngineScanFinished(const QString &key, int count, qint64 elapsedMs);
 
 private:
-    QString findProjectRootFromAppDir() const;
-    QStringList getValidMusicExtensions() const;
+    void joinScan(const QStringList &roots, bool recursive);
     void addWatchPath(const QString &path);
-    void updateFileCache();
-    QMediaPlayer *m_prefetchPlayer;
-    QAudioOutput *m_prefetchOutput;
-    QStringList m_prefetchQueue;
-    bool m_prefetchActive;
-    QString m_currentPrefetchSource;
-    QHash<QString, QVariantMap> m_metaCache;
-    bool m_singleMode = false;
-    
-    QFileSystemWatcher *m_watcher;
-    QTimer *m_scanTimer;
-    QStringList m_cachedFiles;
-    QStringList m_watchedPaths;
-    bool m_isWatching;
-    static const int SCAN_DELAY_MS = 4000; // 延迟扫描避免频繁更新（加大退抖间隔）
-    qint64 m_lastScanMs = 0; // 上次扫描时间戳
+    bool isWatchedPath(const QString &path) const;
+
+    QString m_scanKey;              // 已加入的异步扫描；为空时不转发扫描批次
+    QStringList m_watchedPaths;     // 本实例持有引用的监控根目录
+    QString m_singleRoot;           // scanOnlyDirectory 限定的目录：文件列表只取其下的文件
+    bool m_isWatching = false;
 };
 
 #endif // CORE_MUSIC_H
@@ -0,0 +1,308 @@
+// 实现文件：MusicSearch —— 倒排索引 + 有序词典前缀匹配
+#include "core/musicsearch.h"
+#include "core/pinyin.h"
+
+#include <QFileInfo>
+#include <QTimer>
+
+#include <algorithm>
+
+namespace {
+
+// 汉字逐字成词，其余字母数字按连续片段成词，统一做大小写折叠
+void tokenize(const QString &text, QStringList &out)
+{
+    QString word;
+    auto flushWord = [&]() {
+        if (word.isEmpty()) return;
+        out.append(word.toCaseFolded());
+        word.clear();
+    };
+    const QList<uint> ucs4 = text.toUcs4();
+    for (uint cp : ucs4) {
+        const char32_t c = cp;
+        if (QChar::script(c) == QChar::Script_Han) {
+            flushWord();
+            out.append(QString::fromUcs4(&c, 1));
+        } else if (QChar::isLetterOrNumber(c)) {
+            word.append(QString::fromUcs4(&c, 1));
+        } else {
+            flushWord();
+        }
+    }
+    flushWord();
+}
+
+// 拼音首字母词：整段一份，另外每段连续汉字各一份（“Jay 周杰伦” -> jayzjl、zjl）
+void pinyinTerms(const QString &text, QStringList &out)
+{
+    if (!Pinyin::containsHan(text)) return;
+    const QString whole = Pinyin::initials(text);
+    if (whole.size() >= 2) out.append(whole);
+    QString run;
+    const QList<uint> ucs4 = text.toUcs4();
+    for (int i = 0; i <= ucs4.size(); ++i) {
+        const char c = i < ucs4.size() ? Pinyin::initial(ucs4.at(i)) : 0;
+        if (c) {
+            run.append(QLatin1Char(c));
+            continue;
+        }
+        if (run.size() >= 2 && run != whole) out.append(run);
+        run.clear();
+    }
+}
+
+float fieldWeight(quint8 fields)
+{
+    if (fields & 1) return 4.0f;    // 标题
+    if (fields & 2) return 3.0f;    // 艺术家
+    if (fields & 4) return 2.0f;    // 专辑
+    return 1.0f;                    // 文件名
+}
+
+} // namespace
+
+MusicSearch::MusicSearch(QObject *parent)
+    : QObject(parent)
+    , m_changeTimer(new QTimer(this))
+{
+    m_changeTimer->setSingleShot(true);
+    m_changeTimer->setInterval(50);
+    connect(m_changeTimer, &QTimer::timeout, this, &MusicSearch::indexChanged);
+}
+
+void MusicSearch::setLibrary(MusicLibrary *library)
+{
+    if (m_library == library) return;
+    if (m_library) disconnect(m_library, nullptr, this, nullptr);
+    m_library = library;
+    if (m_library) {
+        connect(m_library, &MusicLibrary::scanBatch, this, &MusicSearch::addFiles);
+        connect(m_library, &MusicLibrary::fileAdded, this, [this](const QString &path) { addFile(path); });
+        connect(m_library, &MusicLibrary::fileRemoved, this, &MusicSearch::removeFile);
+        connect(m_library, &MusicLibrary::musicFilesChanged, this, &MusicSearch::reset);
+        connect(m_library, &MusicLibrary::metadataReady, this, &MusicSearch::onMetadataReady);
+        reset(m_library->cachedFiles());
+    } else {
+        clear();
+    }
+    emit libraryChanged();
+}
+
+QStringList MusicSearch::search(const QString &query, int limit) const
+{
+    std::vector<Match> matches = match(query);
+    const size_t n = limit > 0 ? std::min(matches.size(), size_t(limit)) : matches.size();
+    // 只对前 limit 条排序；同分时标题较短者更贴近查询
+    std::partial_sort(matches.begin(), matches.begin() + n, matches.end(), [this](const Match &a, const Match &b) {
+        if (a.score != b.score) return a.score > b.score;
+        return m_docs[a.doc].title.size() < m_docs[b.doc].title.size();
+    });
+    QStringList paths;
+    paths.reserve(qsizetype(n));
+    for (size_t i = 0; i < n; ++i) paths.append(m_docs[matches[i].doc].path);
+    return paths;
+}
+
+QVariantList MusicSearch::facets(const QString &field, const QString &query, int limit) const
+{
+    const bool byArtist = field == QLatin1String("artist");
+    QHash<QString, int> counts;
+    if (query.trimmed().isEmpty()) {
+        counts = byArtist ? m_artistCounts : m_albumCounts;
+    } else {
+        for (const Match &m : match(query)) {
+            const Doc &doc = m_docs[m.doc];
+            const QString &name = byArtist ? doc.artist : doc.album;
+            if (!name.isEmpty()) ++counts[name];
+        }
+    }
+
+    std::vector<std::pair<QString, int>> sorted(counts.cbegin(), counts.cend());
+    std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+        if (a.second != b.second) return a.second > b.second;
+        return a.first < b.first;
+    });
+    QVariantList out;
+    for (const auto &entry : sorted) {
+        if (limit > 0 && out.size() >= limit) break;
+        QVariantMap item;
+        item.insert("name", entry.first);
+        item.insert("count", entry.second);
+        out.append(item);
+    }
+    return out;
+}
+
+void MusicSearch::addFiles(const QStringList &files)
+{
+    for (const QString &path : files) {
+        if (path.isEmpty() || m_ids.contains(path)) continue;
+        index(path, m_library ? m_library->getMetadata(path) : QVariantMap());
+    }
+    scheduleChanged();
+}
+
+void MusicSearch::addFile(const QString &path, const QVariantMap &meta)
+{
+    if (path.isEmpty() || m_ids.contains(path)) return;
+    index(path, (meta.isEmpty() && m_library) ? m_library->getMetadata(path) : meta);
+    scheduleChanged();
+}
+
+void MusicSearch::removeFile(const QString &path)
+{
+    auto it = m_ids.constFind(path);
+    if (it == m_ids.cend()) return;
+    unindex(it.value());
+    scheduleChanged();
+}
+
+void MusicSearch::reset(const QStringList &files)
+{
+    clear();
+    addFiles(files);
+}
+
+void MusicSearch::clear()
+{
+    m_docs.clear();
+    m_ids.clear();
+    m_terms.clear();
+    m_artistCounts.clear();
+    m_albumCounts.clear();
+    m_deadDocs = 0;
+    scheduleChanged();
+}
+
+void MusicSearch::onMetadataReady(const QString &source, const QVariantMap &meta)
+{
+    auto it = m_ids.constFind(source);
+    if (it == m_ids.cend()) return;
+    const Doc &doc = m_docs[it.value()];
+    if (doc.title == meta.value("title").toString() && doc.artist == meta.value("artist").toString()
+        && doc.album == meta.value("album").toString()) {
+        return;
+    }
+    // 以新 id 重新入索引，保持倒排表按 id 递增
+    unindex(it.value());
+    index(source, meta);
+    scheduleChanged();
+}
+
+void MusicSearch::index(const QString &path, const QVariantMap &meta)
+{
+    const quint32 id = quint32(m_docs.size());
+    Doc doc;
+    doc.path = path;
+    doc.title = meta.value("title").toString();
+    doc.artist = meta.value("artist").toString();
+    doc.album = meta.value("album").toString();
+    doc.alive = true;
+
+    QHash<QString, quint8> terms;
+    auto addText = [&terms](const QString &text, quint8 field) {
+        if (text.isEmpty()) return;
+        QStringList tokens;
+        tokenize(text, tokens);
+        pinyinTerms(text, tokens);
+        for (const QString &token : std::as_const(tokens)) terms[token] |= field;
+    };
+    addText(doc.title, TitleField);
+    addText(doc.artist, ArtistField);
+    addText(doc.album, AlbumField);
+    addText(QFileInfo(path).completeBaseName(), FileNameField);
+
+    doc.terms.reserve(terms.size());
+    for (auto t = terms.cbegin(); t != terms.cend(); ++t) {
+        m_terms[t.key()].push_back(Posting { id, t.value() });
+        doc.terms.append(t.key());
+    }
+    if (!doc.artist.isEmpty()) ++m_artistCounts[doc.artist];
+    if (!doc.album.isEmpty()) ++m_albumCounts[doc.album];
+    m_ids.insert(path, id);
+    m_docs.push_back(std::move(doc));
+}
+
+void MusicSearch::unindex(quint32 id)
+{
+    Doc &doc = m_docs[id];
+    for (const QString &term : std::as_const(doc.terms)) {
+        auto it = m_terms.find(term);
+        if (it == m_terms.end()) continue;
+        std::vector<Posting> &postings = it->second;
+        auto p = std::lower_bound(postings.begin(), postings.end(), id,
+                                  [](const Posting &posting, quint32 value) { return posting.doc < value; });
+        if (p != postings.end() && p->doc == id) postings.erase(p);
+        if (postings.empty()) m_terms.erase(it);
+    }
+    auto decrement = [](QHash<QString, int> &counts, const QString &key) {
+        auto it = counts.find(key);
+        if (it != counts.end() && --it.value() <= 0) counts.erase(it);
+    };
+    if (!doc.artist.isEmpty()) decrement(m_artistCounts, doc.artist);
+    if (!doc.album.isEmpty()) decrement(m_albumCounts, doc.album);
+    m_ids.remove(doc.path);
+    doc = Doc();
+    if (++m_deadDocs > 1024 && m_deadDocs > count()) compact();
+}
+
+void MusicSearch::compact()
+{
+    // 删除过多时重建，回收空洞 id
+    std::vector<Doc> docs;
+    docs.swap(m_docs);
+    m_ids.clear();
+    m_terms.clear();
+    m_artistCounts.clear();
+    m_albumCounts.clear();
+    m_deadDocs = 0;
+    for (const Doc &doc : docs) {
+        if (!doc.alive) continue;
+        QVariantMap meta;
+        meta.insert("title", doc.title);
+        meta.insert("artist", doc.artist);
+        meta.insert("album", doc.album);
+        index(doc.path, meta);
+    }
+}
+
+void MusicSearch::scheduleChanged()
+{
+    if (!m_changeTimer->isActive()) m_changeTimer->start();
+}
+
+std::vector<MusicSearch::Match> MusicSearch::match(const QString &query) const
+{
+    std::vector<Match> out;
+    QStringList tokens;
+    tokenize(query, tokens);
+    tokens.removeDuplicates();
+    if (tokens.isEmpty() || tokens.size() > 0xFFFF) return out;
+
+    // hits[doc] 记录该文档已连续命中的查询词数，只有命中全部前序词的文档才继续累计
+    const size_t n = m_docs.size();
+    std::vector<quint16> hits(n, 0);
+    std::vector<float> scores(n, 0.0f);
+    for (qsizetype i = 0; i < tokens.size(); ++i) {
+        const QString &token = tokens.at(i);
+        bool any = false;
+        // 词典有序：lower_bound 起为精确词，其后为同前缀词
+        for (auto it = m_terms.lower_bound(token); it != m_terms.end() && it->first.startsWith(token); ++it) {
+            const float boost = it->first.size() == token.size() ? 2.0f : 1.0f;
+            for (const Posting &p : it->second) {
+                if (hits[p.doc] != i) continue;
+                hits[p.doc] = quint16(i + 1);
+                scores[p.doc] += fieldWeight(p.fields) * boost;
+                any = true;
+            }
+        }
+        if (!any) return out;
+    }
+
+    const quint16 need = quint16(tokens.size());
+    for (quint32 d = 0; d < quint32(n); ++d) {
+        if (hits[d] == need) out.push_back(Match { d, scores[d] });
+    }
+    return out;
+}
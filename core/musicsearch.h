@@ -0,0 +1,100 @@
+// core/musicsearch.h
+#ifndef CORE_MUSICSEARCH_H
+#define CORE_MUSICSEARCH_H
+
+// 音乐库搜索：标题/艺术家/专辑/文件名的倒排索引，支持前缀匹配与拼音首字母
+// 绑定 MusicLibrary 后随扫描批次、文件增删、元数据到达增量更新
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QPointer>
+
+#include <map>
+#include <vector>
+
+#include "core/music.h"
+
+class QTimer;
+
+class MusicSearch : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(MusicLibrary *library READ library WRITE setLibrary NOTIFY libraryChanged)
+    Q_PROPERTY(int count READ count NOTIFY indexChanged)
+
+public:
+    explicit MusicSearch(QObject *parent = nullptr);
+
+    MusicLibrary *library() const { return m_library; }
+    void setLibrary(MusicLibrary *library);
+    int count() const { return int(m_ids.size()); }
+
+    // 多个词之间为“与”关系；返回按相关度排序的路径
+    Q_INVOKABLE QStringList search(const QString &query, int limit = 50) const;
+    // 分面统计：field 为 "artist" 或 "album"；query 非空时只统计命中结果
+    Q_INVOKABLE QVariantList facets(const QString &field, const QString &query = QString(), int limit = 20) const;
+
+    Q_INVOKABLE void addFiles(const QStringList &files);
+    Q_INVOKABLE void addFile(const QString &path, const QVariantMap &meta = QVariantMap());
+    Q_INVOKABLE void removeFile(const QString &path);
+    Q_INVOKABLE void reset(const QStringList &files);
+    Q_INVOKABLE void clear();
+
+signals:
+    void libraryChanged();
+    // 合并通知：索引内容变化后延迟发出一次，便于 QML 刷新当前结果
+    void indexChanged();
+
+private slots:
+    void onMetadataReady(const QString &source, const QVariantMap &meta);
+
+private:
+    enum Field : quint8 {
+        TitleField = 1,
+        ArtistField = 2,
+        AlbumField = 4,
+        FileNameField = 8
+    };
+
+    struct Posting
+    {
+        quint32 doc;
+        quint8 fields;
+    };
+
+    struct Doc
+    {
+        QString path;
+        QString title;
+        QString artist;
+        QString album;
+        QStringList terms;
+        bool alive = false;
+    };
+
+    struct Match
+    {
+        quint32 doc;
+        float score;
+    };
+
+    void index(const QString &path, const QVariantMap &meta);
+    void unindex(quint32 id);
+    void compact();
+    void scheduleChanged();
+    std::vector<Match> match(const QString &query) const;
+
+    QPointer<MusicLibrary> m_library;
+    std::vector<Doc> m_docs;                            // 文档 id 单调递增，倒排表天然有序
+    QHash<QString, quint32> m_ids;                      // 路径 -> 文档 id
+    std::map<QString, std::vector<Posting>> m_terms;    // 有序词典，前缀查询走 lower_bound
+    QHash<QString, int> m_artistCounts;
+    QHash<QString, int> m_albumCounts;
+    int m_deadDocs = 0;
+    QTimer *m_changeTimer;
+};
+
+#endif // CORE_MUSICSEARCH_H
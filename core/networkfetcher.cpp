@@ -0,0 +1,272 @@
+// 实现文件：NetworkFetcher —— 请求合并、ttl 与条件重新验证、工作线程解析、离线回退
+#include "core/networkfetcher.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QLocale>
+#include <QNetworkAccessManager>
+#include <QNetworkCacheMetaData>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QStandardPaths>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace {
+
+const int kTimeoutMs = 15000;
+const qint64 kCacheBytes = 32 * 1024 * 1024;
+const qint64 kQmlCacheBytes = 128 * 1024 * 1024;
+
+// 响应头 Date（RFC 7231 IMF-fixdate）；重新验证得到 304 时 QNAM 会用新的响应头更新缓存记录
+QDateTime responseDate(const QNetworkCacheMetaData &meta)
+{
+    for (const QNetworkCacheMetaData::RawHeader &header : meta.rawHeaders()) {
+        if (header.first.compare("date", Qt::CaseInsensitive) != 0) continue;
+        const QDateTime parsed = QLocale::c().toDateTime(QString::fromLatin1(header.second).trimmed(),
+                                                         QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'"));
+        if (parsed.isValid()) return QDateTime(parsed.date(), parsed.time(), QTimeZone::UTC);
+    }
+    return QDateTime();
+}
+
+// 响应头 Cache-Control 的 max-age（毫秒）；no-cache / no-store 或没有 max-age 时为 0
+qint64 serverMaxAgeMs(const QNetworkCacheMetaData &meta)
+{
+    for (const QNetworkCacheMetaData::RawHeader &header : meta.rawHeaders()) {
+        if (header.first.compare("cache-control", Qt::CaseInsensitive) != 0) continue;
+        qint64 maxAge = 0;
+        for (const QByteArray &directive : header.second.split(',')) {
+            const QByteArray d = directive.trimmed().toLower();
+            if (d == "no-cache" || d == "no-store") return 0;
+            if (d.startsWith("max-age=")) maxAge = std::max<qint64>(0, d.mid(8).toLongLong()) * 1000;
+        }
+        return maxAge;
+    }
+    return 0;
+}
+
+// 缓存记录的年龄：以响应头 Date 为起点；没有缓存时为 -1
+qint64 cacheAgeMs(const QNetworkCacheMetaData &meta)
+{
+    if (!meta.isValid()) return -1;
+    const QDateTime date = responseDate(meta);
+    // 没有 Date 头时无法判断新旧，视为已过期，但仍可作为旧内容先行显示
+    if (!date.isValid()) return std::numeric_limits<qint64>::max();
+    return std::max<qint64>(0, date.msecsTo(QDateTime::currentDateTimeUtc()));
+}
+
+} // namespace
+
+NetworkFetcher &NetworkFetcher::instance()
+{
+    static QPointer<NetworkFetcher> fetcher;
+    if (!fetcher) fetcher = new NetworkFetcher(QCoreApplication::instance());
+    return *fetcher;
+}
+
+NetworkFetcher::NetworkFetcher(QObject *parent)
+    : QObject(parent)
+    , m_manager(new QNetworkAccessManager(this))
+    , m_cache(new QNetworkDiskCache(this))
+{
+    m_cache->setMaximumCacheSize(kCacheBytes);
+    setCacheDirectory(defaultCacheDirectory() + QStringLiteral("/data"));
+    m_manager->setCache(m_cache);
+    // 解析很快，单线程即可，也保证同一请求的“旧内容”先于新结果交付
+    m_pool.setMaxThreadCount(1);
+}
+
+NetworkFetcher::~NetworkFetcher()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QString NetworkFetcher::defaultCacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/http");
+}
+
+void NetworkFetcher::setCacheDirectory(const QString &dir)
+{
+    m_cacheDir = dir;
+    m_cache->setCacheDirectory(dir);
+}
+
+QString NetworkFetcher::keyFor(const Request &request)
+{
+    return QString::number(int(request.kind)) + QLatin1Char('|') + request.url.toString(QUrl::FullyEncoded);
+}
+
+void NetworkFetcher::fetch(const Request &request, QObject *context, Callback callback)
+{
+    if (!request.url.isValid() || request.url.isEmpty()) {
+        Result result;
+        result.error = QStringLiteral("invalid url");
+        QPointer<QObject> guard(context);
+        QMetaObject::invokeMethod(this, [guard, callback, result]() {
+            if (guard) callback(result);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    const QString key = keyFor(request);
+    auto it = m_pending.find(key);
+    if (it != m_pending.end()) {
+        // 相同请求在途：只登记回调，结果到达时一并交付
+        it->waiters.push_back(Waiter { context, std::move(callback) });
+        return;
+    }
+    Pending pending;
+    pending.request = request;
+    pending.waiters.push_back(Waiter { context, std::move(callback) });
+    m_pending.insert(key, std::move(pending));
+
+    if (request.kind != Location && !request.force) {
+        // 新鲜期取端点 ttl 与服务端 max-age 中较大者（max-age 内 QNAM 本来也直接读缓存）
+        const QNetworkCacheMetaData meta = m_cache->metaData(request.url);
+        const qint64 age = cacheAgeMs(meta);
+        const qint64 ttl = std::max(request.ttlMs, serverMaxAgeMs(meta));
+        if (age >= 0 && age < ttl && deliverCached(key, false, true)) return;
+        // 已过期：先交出旧内容，界面不必空等网络
+        if (age >= 0) deliverCached(key, true, false);
+    }
+    startNetwork(key);
+}
+
+void NetworkFetcher::startNetwork(const QString &key)
+{
+    const Request request = m_pending.value(key).request;
+    QNetworkRequest networkRequest(request.url);
+    networkRequest.setTransferTimeout(kTimeoutMs);
+    if (request.kind == Location) {
+        networkRequest.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::ManualRedirectPolicy);
+        networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+        networkRequest.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+    } else {
+        // PreferNetwork：有缓存记录时 QNAM 自动附带 If-None-Match / If-Modified-Since，304 时沿用缓存正文
+        networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute,
+                                    request.force ? QNetworkRequest::AlwaysNetwork : QNetworkRequest::PreferNetwork);
+    }
+    QNetworkReply *reply = m_manager->get(networkRequest);
+    connect(reply, &QNetworkReply::finished, this, [this, key, reply]() { onReplyFinished(key, reply); });
+}
+
+void NetworkFetcher::onReplyFinished(const QString &key, QNetworkReply *reply)
+{
+    reply->deleteLater();
+    if (!m_pending.contains(key)) return;
+    const Request request = m_pending.value(key).request;
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    if (request.kind == Location) {
+        Result result;
+        result.status = status;
+        const QUrl target = reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
+        if (target.isValid()) {
+            result.ok = true;
+            result.data = request.url.resolved(target).toString();
+        } else if (reply->error() == QNetworkReply::NoError) {
+            result.ok = true;
+            result.data = reply->url().toString();
+        } else {
+            result.error = reply->errorString();
+        }
+        deliver(key, result, true);
+        return;
+    }
+
+    if (reply->error() == QNetworkReply::NoError) {
+        Result result;
+        result.ok = true;
+        result.status = status;
+        result.fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+        parseAndDeliver(key, request.kind, reply->readAll(), result, true);
+        return;
+    }
+
+    // 离线或服务端出错：退回缓存中的旧内容
+    const QString error = reply->errorString();
+    if (deliverCached(key, true, true, error)) return;
+    Result result;
+    result.status = status;
+    result.error = error;
+    deliver(key, result, true);
+}
+
+bool NetworkFetcher::deliverCached(const QString &key, bool stale, bool final, const QString &error)
+{
+    const auto it = m_pending.constFind(key);
+    if (it == m_pending.constEnd()) return false;
+    const Request request = it->request;
+    QIODevice *device = m_cache->data(request.url);
+    if (!device) return false;
+    const QByteArray body = device->readAll();
+    delete device;
+
+    const QNetworkCacheMetaData meta = m_cache->metaData(request.url);
+    Result result;
+    result.ok = true;
+    result.status = meta.attributes().value(QNetworkRequest::HttpStatusCodeAttribute, 200).toInt();
+    result.fromCache = true;
+    result.stale = stale;
+    result.error = error;
+    parseAndDeliver(key, request.kind, body, result, final);
+    return true;
+}
+
+void NetworkFetcher::parseAndDeliver(const QString &key, Kind kind, const QByteArray &body, Result result, bool final)
+{
+    m_pool.start([this, key, kind, body, result, final]() mutable {
+        if (kind == Json) {
+            QJsonParseError error;
+            const QJsonDocument document = QJsonDocument::fromJson(body, &error);
+            if (error.error != QJsonParseError::NoError) {
+                result.ok = false;
+                result.error = error.errorString();
+            } else {
+                result.data = document.toVariant();
+            }
+        } else {
+            result.data = QString::fromUtf8(body);
+        }
+        QMetaObject::invokeMethod(this, [this, key, result, final]() {
+            deliver(key, result, final);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void NetworkFetcher::deliver(const QString &key, const Result &result, bool final)
+{
+    auto it = m_pending.find(key);
+    if (it == m_pending.end()) return;
+    std::vector<Waiter> waiters;
+    if (final) {
+        waiters = std::move(it->waiters);
+        m_pending.erase(it);
+    } else {
+        waiters = it->waiters;
+    }
+    for (const Waiter &waiter : waiters) {
+        if (waiter.context) waiter.callback(result);
+    }
+}
+
+QNetworkAccessManager *CachedNetworkAccessManagerFactory::create(QObject *parent)
+{
+    // 引擎可能在多个线程各创建一个实例；各用独立目录，避免两个缓存对象同时整理同一目录
+    static std::atomic_int counter { 0 };
+    auto *manager = new QNetworkAccessManager(parent);
+    auto *cache = new QNetworkDiskCache(manager);
+    cache->setCacheDirectory(NetworkFetcher::defaultCacheDirectory() + QStringLiteral("/qml-%1").arg(counter++));
+    cache->setMaximumCacheSize(kQmlCacheBytes);
+    manager->setCache(cache);
+    return manager;
+}
@@ -0,0 +1,101 @@
+// core/networkfetcher.h
+#ifndef CORE_NETWORKFETCHER_H
+#define CORE_NETWORKFETCHER_H
+
+// 共享 HTTP 获取服务：单个 QNetworkAccessManager + 磁盘缓存（CacheLocation/http）
+// 缓存未超过端点 ttl（或服务端 Cache-Control max-age）时直接读缓存，年龄按响应头 Date 计算；超过后先交出旧内容（stale），再带 ETag/Last-Modified 条件请求重新验证
+// 相同请求在途时只发一次；JSON 在工作线程解析；网络失败时退回缓存内容，离线也有内容可显示
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QQmlNetworkAccessManagerFactory>
+#include <QString>
+#include <QThreadPool>
+#include <QUrl>
+#include <QVariant>
+
+#include <functional>
+#include <vector>
+
+class QNetworkAccessManager;
+class QNetworkDiskCache;
+class QNetworkReply;
+
+class NetworkFetcher : public QObject
+{
+    Q_OBJECT
+public:
+    enum Kind {
+        Json,
+        Text,
+        Location        // 只取重定向目标地址，不下载正文（随机图片接口）
+    };
+
+    struct Request
+    {
+        QUrl url;
+        Kind kind = Json;
+        qint64 ttlMs = 0;       // 0：按服务端 max-age，没有时每次都重新验证
+        bool force = false;     // 跳过缓存直接请求（手动刷新）
+    };
+
+    struct Result
+    {
+        bool ok = false;
+        int status = 0;         // HTTP 状态码；读缓存时为缓存记录的状态码
+        QVariant data;          // Json：解析后的 QVariantMap/List；Text：QString；Location：目标地址
+        bool fromCache = false;
+        bool stale = false;     // 过期或离线时给出的旧内容
+        QString error;
+    };
+    using Callback = std::function<void(const Result &)>;
+
+    static NetworkFetcher &instance();
+    ~NetworkFetcher() override;
+
+    // 回调在 GUI 线程执行，context 销毁后不再回调
+    // 缓存过期时先回调一次旧内容（stale 为真），重新验证完成后再回调一次
+    void fetch(const Request &request, QObject *context, Callback callback);
+
+    QString cacheDirectory() const { return m_cacheDir; }
+    // 测试时可指向临时目录，配合本地 HTTP 服务验证缓存与重新验证行为
+    void setCacheDirectory(const QString &dir);
+
+    static QString defaultCacheDirectory();
+
+private:
+    struct Waiter
+    {
+        QPointer<QObject> context;
+        Callback callback;
+    };
+    struct Pending
+    {
+        Request request;
+        std::vector<Waiter> waiters;
+    };
+
+    explicit NetworkFetcher(QObject *parent = nullptr);
+    static QString keyFor(const Request &request);
+    void startNetwork(const QString &key);
+    void onReplyFinished(const QString &key, QNetworkReply *reply);
+    // 缓存中的正文按请求类型解析后交付；final 为假时请求保持在途（旧内容先行）；没有缓存时返回 false
+    bool deliverCached(const QString &key, bool stale, bool final, const QString &error = QString());
+    void parseAndDeliver(const QString &key, Kind kind, const QByteArray &body, Result result, bool final);
+    void deliver(const QString &key, const Result &result, bool final);
+
+    QNetworkAccessManager *m_manager;
+    QNetworkDiskCache *m_cache;
+    QString m_cacheDir;
+    QThreadPool m_pool;
+    QHash<QString, Pending> m_pending;       // 仅 GUI 线程访问
+};
+
+// QML 引擎（Image 等）使用的网络访问也带上磁盘缓存，远程图片不必每次启动重新下载
+class CachedNetworkAccessManagerFactory : public QQmlNetworkAccessManagerFactory
+{
+public:
+    QNetworkAccessManager *create(QObject *parent) override;
+};
+
+#endif // CORE_NETWORKFETCHER_H
@@ -0,0 +1,107 @@
+// 实现文件：NetworkResource —— 属性变化合并为一次请求，结果按代次过滤后写回
+#include "core/networkresource.h"
+#include "core/networkfetcher.h"
+
+#include <QTimer>
+#include <QUrl>
+
+#include <algorithm>
+
+NetworkResource::NetworkResource(QObject *parent)
+    : QObject(parent)
+    , m_loadTimer(new QTimer(this))
+{
+    // 声明时依次设置 url/kind/ttl，只在全部就绪后请求一次
+    m_loadTimer->setSingleShot(true);
+    m_loadTimer->setInterval(0);
+    connect(m_loadTimer, &QTimer::timeout, this, [this]() { load(false); });
+}
+
+void NetworkResource::setUrl(const QString &url)
+{
+    if (m_url == url) return;
+    m_url = url;
+    emit urlChanged();
+    scheduleLoad();
+}
+
+void NetworkResource::setKind(Kind kind)
+{
+    if (m_kind == kind) return;
+    m_kind = kind;
+    emit kindChanged();
+    scheduleLoad();
+}
+
+void NetworkResource::setTtl(int ttl)
+{
+    if (m_ttl == ttl) return;
+    m_ttl = ttl;
+    emit ttlChanged();
+}
+
+void NetworkResource::setAutoLoad(bool autoLoad)
+{
+    if (m_autoLoad == autoLoad) return;
+    m_autoLoad = autoLoad;
+    emit autoLoadChanged();
+    scheduleLoad();
+}
+
+void NetworkResource::reload()
+{
+    m_loadTimer->stop();
+    load(false);
+}
+
+void NetworkResource::refresh()
+{
+    m_loadTimer->stop();
+    load(true);
+}
+
+void NetworkResource::scheduleLoad()
+{
+    if (m_autoLoad && !m_url.isEmpty()) m_loadTimer->start();
+}
+
+void NetworkResource::load(bool force)
+{
+    const quint64 generation = ++m_generation;
+    if (m_url.isEmpty()) {
+        setStatus(Null);
+        return;
+    }
+
+    NetworkFetcher::Request request;
+    request.url = QUrl(m_url);
+    request.kind = NetworkFetcher::Kind(m_kind);
+    request.ttlMs = std::max(0, m_ttl);
+    request.force = force;
+    // 已有内容时保持 Ready，避免刷新期间界面闪回加载态
+    if (m_status != Ready) setStatus(Loading);
+
+    NetworkFetcher::instance().fetch(request, this, [this, generation](const NetworkFetcher::Result &result) {
+        if (generation != m_generation) return;
+        if (!result.ok) {
+            setStatus(m_value.isValid() ? Ready : Error, result.error);
+            emit failed();
+            return;
+        }
+        m_value = result.data;
+        m_stale = result.stale;
+        m_fromCache = result.fromCache;
+        m_httpStatus = result.status;
+        emit valueChanged();
+        setStatus(Ready, result.error);
+        emit loaded();
+    });
+}
+
+void NetworkResource::setStatus(Status status, const QString &error)
+{
+    if (m_status == status && m_errorString == error) return;
+    m_status = status;
+    m_errorString = error;
+    emit statusChanged();
+}
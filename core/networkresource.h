@@ -0,0 +1,88 @@
+// core/networkresource.h
+#ifndef CORE_NETWORKRESOURCE_H
+#define CORE_NETWORKRESOURCE_H
+
+// QML 端的网络资源：声明 url/kind/ttl，由 NetworkFetcher 获取并缓存
+// 地址或参数变化后在下一轮事件循环合并为一次请求；过期缓存先以 stale 状态显示，重新验证后再更新
+#include <QObject>
+#include <QString>
+#include <QVariant>
+
+class QTimer;
+
+class NetworkResource : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString url READ url WRITE setUrl NOTIFY urlChanged)
+    Q_PROPERTY(Kind kind READ kind WRITE setKind NOTIFY kindChanged)
+    // 缓存新鲜期（毫秒），期内不访问网络；0 表示每次都重新验证
+    Q_PROPERTY(int ttl READ ttl WRITE setTtl NOTIFY ttlChanged)
+    // 为假时只在调用 reload()/refresh() 时获取
+    Q_PROPERTY(bool autoLoad READ autoLoad WRITE setAutoLoad NOTIFY autoLoadChanged)
+    Q_PROPERTY(Status status READ status NOTIFY statusChanged)
+    // Json：对象/数组；Text：字符串；Location：重定向目标地址
+    Q_PROPERTY(QVariant value READ value NOTIFY valueChanged)
+    Q_PROPERTY(bool stale READ isStale NOTIFY valueChanged)
+    Q_PROPERTY(bool fromCache READ isFromCache NOTIFY valueChanged)
+    Q_PROPERTY(int httpStatus READ httpStatus NOTIFY valueChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY statusChanged)
+
+public:
+    enum Kind { Json, Text, Location };
+    Q_ENUM(Kind)
+    enum Status { Null, Loading, Ready, Error };
+    Q_ENUM(Status)
+
+    explicit NetworkResource(QObject *parent = nullptr);
+
+    QString url() const { return m_url; }
+    void setUrl(const QString &url);
+    Kind kind() const { return m_kind; }
+    void setKind(Kind kind);
+    int ttl() const { return m_ttl; }
+    void setTtl(int ttl);
+    bool autoLoad() const { return m_autoLoad; }
+    void setAutoLoad(bool autoLoad);
+    Status status() const { return m_status; }
+    QVariant value() const { return m_value; }
+    bool isStale() const { return m_stale; }
+    bool isFromCache() const { return m_fromCache; }
+    int httpStatus() const { return m_httpStatus; }
+    QString errorString() const { return m_errorString; }
+
+    // 遵循 ttl：新鲜缓存直接使用
+    Q_INVOKABLE void reload();
+    // 忽略缓存直接请求（手动刷新）
+    Q_INVOKABLE void refresh();
+
+signals:
+    void urlChanged();
+    void kindChanged();
+    void ttlChanged();
+    void autoLoadChanged();
+    void statusChanged();
+    void valueChanged();
+    // 每次得到内容（包括先行显示的旧内容）时发出
+    void loaded();
+    void failed();
+
+private:
+    void scheduleLoad();
+    void load(bool force);
+    void setStatus(Status status, const QString &error = QString());
+
+    QString m_url;
+    Kind m_kind = Json;
+    int m_ttl = 0;
+    bool m_autoLoad = true;
+    Status m_status = Null;
+    QVariant m_value;
+    bool m_stale = false;
+    bool m_fromCache = false;
+    int m_httpStatus = 0;
+    QString m_errorString;
+    quint64 m_generation = 0;
+    QTimer *m_loadTimer;
+};
+
+#endif // CORE_NETWORKRESOURCE_H
@@ -0,0 +1,263 @@
+// 实现文件：Pinyin —— 静态首字母表查询
+#include "core/pinyin.h"
+
+namespace {
+
+const char32_t kFirst = 0x4E00;
+const char32_t kLast = 0x9FA5;
+
+// U+4E00..U+9FA5 每个码位一个字符：首字母，'.' 表示非 GB2312 一级汉字
+// 由 GB2312 一级汉字区间（B0A1 'a' … D4D1 'z'，止于 D7F9）离线生成
+const char kInitials[] =
+    "yd.q...wzssx.by..c.zq.s.qbycds....d.ly.s..gy.z..f.c.l...wdwz.lj....n.j..my.zwzhfl.ppq.g.cy...jqy"
+    "xx....s.........ml.r..........q.......l.yz.se.yk.yh.wj....yx.....wk.jhychm.xjtl...q.......r....y"
+    "sr...jpc..jj.rc..l.czstzfx.....q...dly....y.m...y.z...jj...r.f.f.q........y..wjffx.....zyhh...sw"
+    "c...s.l...w....bg...b.l.s.s.s......d..d......wdzzy.t.h...y.fz...n..y.....p..l..yb..j...........s"
+    "....z...c..l.s.........d...g.y..x..l.jzcqk....wh.....q.........b...ce.....j....ql......sf....by."
+    ".x.......l...jxf.j........a..................b....d.j...thy....j.c....j...n...............z.z.q."
+    ".......j.......p..........z.t........j................ot.......ck....f..l....b.................."
+    "...d....c...c.....a........s...................x..........l............s...........s.j.....p...."
+    "..................r..............l.............................e.y.yxcz.xg.k.m...d..t.....d.d..."
+    "..j..r..q..bgl..lg.gxbqjdz.yjs..j....n..gr..cz....m..m.r.x.jn...g...y.......d..fb.cj.kyl...d...."
+    "j...q.z..l.dl..j.c.........l.n..jf..f........p.kh..d..x.tacj.h.zdd.r..fq..k......xh....llzgc.c.."
+    "s...p...pl.b..g.d.....zsqsck.g...djt......x..q..gj..t.p..............b.j.sj....f..g............j"
+    "........p..................l.qbgjw.l....dznj.....ljl...........s...b...y.m.x......l.....k......m"
+    "....q.....................s...gwy....bc.x.............hb.c...z..jk.x......f..............pqy...n"
+    ".s.q...swhb...hx.bzz.dmn..b.b.b.zkl.l..w...w...myw.jql.jx......q..c.etl..l.yy........c..l.h....y"
+    "..x...x.cj.................q...x.sc.....ycjysf...f..s.qsbx.p....d..kgjl...zjzbdkt.sy..yhst..d..."
+    ".y.cg...hjd.tmhltx.x.l.m...j.ltyf.....fbdf.htksq.z..wc..xc.wh.w.y.....d.c.g.....n....o..y..qw..."
+    "..n.....z..........w.h..p..shm..j.....p....zh.jyf.z..gk..l..............z...y..k.z.k....x....y.."
+    "ap..h.dwhz...xa..y.....h.......y.....go.sln..kx...z.......b.h....y....sc.a......t..............."
+    "....h.......h.sw.c............t....kz.s...a......................f..psl...p...n.........x...t..."
+    "k.w.s..l.hh.............c...xh.........x...........z...p...y.........x.............s........s..."
+    ".w.s.........................s...........j....g.........x..m.....................zc.z.s....x...h"
+    "..............y.........................q.z.s.........g.......................ht................"
+    "...x...................r....j.............n...............qs..h.y.t.d........y..kc..w.....g..gt."
+    "...p..y.q......................t...s....z....g..d.........c...j.z......j..f..tkhzk.....k..jt.bwf"
+    "zp..k.t...p....p.......k..........cll......x......l........d......gy..k....d..k................."
+    "..ga.......m..c.....p..........yb........................pj.......t...d..........q...d.........."
+    ".b..d.....k.....y....d......................t....s..t...t.....s............t...................."
+    "...j.s............sm.....q....zx........md.......................b...................h.........."
+    "....r......sr.z.s..k..h..y..........c..b.....f.x.....xw...d.y..g.......d.ttf..yh.s..t..ykjd....."
+    "....y..qnf.f..kz.q..b.jt........d.s..a.............nn.n.jt...h....r.w.zfm.r.......dj..y..m......"
+    ".....t..f.....n..........m.q..........m....s....jg.xw.....y.j........l..y...j..............y...z"
+    ".w.wl..j................n...n..js....e...m.......y....q...............p..w................h....."
+    "..........l.........y.s........x..................m.......m........................x............"
+    ".js......j..x....................d.......n......................................................"
+    "................................................z...ky.zcs..zx.m...jg.x..hl.....s....f....r..n.."
+    ".n.t.z.ysa.sw..h.......zgzdwybs.cskxs.h...xg....z..hyxj..r...kbs..j.jymk....f...m.hy.........qmc"
+    ".g...l..z...............cdsxd..s.f..s.j..wz....x.s..e.j.c.s..c......y..y.........j......syc.njwn"
+    "jpc..j..qtjw..sp.x...z........s.tl...l.........t.s.......y.....y.sq.................c..g...d...."
+    ".........y...l.....y....a......k.........................z.......x....l.e.y..q..f..........j...."
+    ".......c......q.....c.y..................b...z..............................q..................."
+    "................................................................................................"
+    ".............w...............cz..xc..gzqjg.w..c..jysb..x......j..bsb.sf.s...x...z....pt.l.zbzd.."
+    "......dz.....xb.........c....m....m..f......h........m............c...............gpn.b.x..hyy.g"
+    "....z.qb..c....xl..kyd.d.mg.f.pf......dz.....t........sky................ll........k..l........."
+    "......................yt..j.....k.yqn.....b....s...g.y.fh..c...dz....mxh.......w.r.......dq....."
+    "..................gd.l.......y....x.t.y..cb.bp..zy.......y.cb...wz..jd..h.hl....x.t....dp......."
+    ".y........x...w........d.....h.....x.by.....jr.........zwm......z......y...k.....c...n.....x.h.f"
+    "hts...........z...n.zpb.....ls..d....j.xy.g....q...........z.......s.......l.h..k.h..s.........."
+    "..h.x...he.dtg.xq..k..e.....n..y....q....x...h......h..........wy..h..y.n...x..m..b.....j...d..."
+    ".....q....jw.....h...t......x..wh.....djcc.b.cdgd..x..h..rx......c......yy.....y..........y....g"
+    "....f..k.......................y........c...h.s..s...m............m....hk.......w......k........"
+    "...........b..z.........................h.....................h...d.....x.a.......l............."
+    "......n.................................g.w.xsrxcwj...h.z.q...............j...l....cd..h.......f"
+    "sb.....s...s.cz..pbdr...t..k.......k..qz.k.synbcr..b..f..p..e.zcj...c....jb......ysz.tdkz.fp...."
+    "klq.hb..p..pt....b...d...m..yc.m..f.zdcmnl..bpl.g.jtb.t.jz.zb..n..lj.ylnbz..ks.z.g.qs..k....pzsn"
+    ".cg....z.a....k..t....w...zl.wtxnd.zjh..a.nc...z..........t..w....w..tk..z..bhsnj....b........ls"
+    ".jhd...p......j.......cj...n....x.d....dsd..z..tq.p...y.j.......l.tc.j.ktyc........l...zd.c....."
+    ".........r...z.mt.c...y..........w.c.....kj..j......y........l..cgl..j.........bc..cs.......s.g."
+    "..........t.bd............x..c......s.byb.t.........s...z..............c.m..............mm......"
+    "..l..j.p.........cs..s........z.....c....l..qbc.z....n......h.....l..s.......cq...q...........s."
+    "......c.........................p.................z.....r..................j...z......s..g.g..fz"
+    ".....g..x...d..m.j....a..j.l.bc...gs..d.....j...s.q.z..f...............w...zb....b.....d.l..x..z"
+    ".w..jc.f.z...d.sx........f...s...p...l.....x...z.......q........w.j..rdjzz..xx...h....sk..w....."
+    "..a...k.....c.mh...yx..........xy....c.mz....z.s............z.x....h.......js.....sx.y....w....."
+    "....w.h.c.....pjx...q.j...z...l...z....x.........s....na......................m.....b..........."
+    ".........................s...p..................y.qyg....c..m.ztz.......yy.p.f......s..l...w.c.q"
+    "........m.wmbz.s.z..pd....j..x..s.zq..g..s....lxcc....z.....d..sgt...l..y....h.bj.............sb"
+    ".j..g....w......x....z.l..m.gz....sz......qf...k......jj............b..........bmgqrr.......g.z."
+    "n....c......j..k.z.lc..........s.....z.bz..d...l.s.s..ql.........x........z............yhg..gz.."
+    "..gt.wk.a...z...ts.hj..............d.q..jz............t..........l...mb................g........"
+    "..s...mwl....s.tx..s............j........m.q.g....b..z..j.p.....t.............s..l...k....g....."
+    ".....y.......zz...j..........................t..y............c.c....................x.....c...l."
+    ".......................k....l.....g...y.............l.......b...........z...........l..q........"
+    "................h..........j.................................c............f....................z"
+    ".m........h......y.....................q.................c.......x...............c.............."
+    "t...x.......................................m..................................................."
+    "................................................................qchx...o..........y.......q...k."
+    ".......x.q..g.....................zzcbwq..w..............d.sj......y..d..xsc..........z........."
+    "....................od.y.......d.h...y.....w.m.m..d.bbbp.b.m.....z.........h...t................"
+    "...............s.m.mq.n....f...f..q...hya.....dlq...s...y.......tzq....h.h......x....s.h...x.rgj"
+    "cw..t.....w.....t.j......x...qf..qyw....sc.....q.........s.p...g.m..ollc..hm..j....h....fy.zzgzy"
+    "....xq...qb.m........f.....f..n..pbq.n..z.l.....t..y.b.....xpz...j.........y......s....x...l..d."
+    ".....j....h......ez........hwqp..l...qjj..zc..j..h.n.....zj...........p..hl...f.....y..hj......."
+    "..t..n..xs..y.x......t.....t.l.l.w.hd.rjzsf....y..y..h..h.......d...z.x....lt....s....n.t......."
+    ".d..y......yc.h..s.c...h.y.t.........q....y..z..j...y..s.....y..qd.zb....w...w.g....k...y.m....."
+    "...p.........t........h.x..z..................................ws...k.j...g......y...........l..."
+    "..y.......x....s......r...n......c.....d...z.....h.zt.....g...z..m..lll.bt..........d..........."
+    "..p...q........l...ly...........m..........m.....s.z..........y..............w..........p...q.l."
+    "......l......tc.....................c...c.....p.............l....z.................a............"
+    "j.................b..............................................................p.............."
+    "............................................g..............................h.m.dh....lz.j...z.zc"
+    ".........lc...y...c.qk...z..................jtpj...b....zd..lc...slt....l...............hl.z...y"
+    "....k.fs.h.tjr.x.......w.p...f...........yh..........h...bf...........j.........y.....r........."
+    "............h.j...............s.....m..z......z..............s......x.....x....x....r....x.....s"
+    "............a......................r..........l......y...............z.........................."
+    "......b...................................z.p....a...jfybd...s.........pb...p............y.n...m"
+    ".ml....m.w........s..q...tx.....xl........d.................................q..f......z..y......"
+    "..k.d...b.......h......g.j....n.hj..........dxs.zy......l...l.................l.......c....mc..."
+    ".........xzm..x.....h.........hy.............................................t.................."
+    "....x..l.y.w..........j....m.............w.m...hx.l........b..............s..z..f..............."
+    "z............b.....................q.ll..l......s.................z................lqpp.....q..."
+    "..........................h...rs................g.....y............l............................"
+    "............................................................g.....pbr.w.......w.......pc........"
+    "....z...................g.s.t..s.....s..ys.f.b..tyjs.d.nd..h.........c......j..w....p....l..x..."
+    ".....lq...f.........c...j.............j........s.y.....l.gj....n.y..bj.....y..cf..p..c...z..tjj."
+    ".....b.zyjq.......y.zh..d..t..p...l.......h.....t...c....b.......c.............................w"
+    "....l.s..dbt........z...q...................a......................x....................g..d.bb."
+    "..z.d.jh...g.....a....w.......................p..z.............m..y..zp.y.y...azyjh.k.gdp..s...m"
+    "..............md..m.z...x...p.d..s.......m.k...................zm.......zx.....m......kj..t.y..."
+    "zz.........................j.....s.d..m....jc............d..........mc........x...m............."
+    ".....p.q.zd.s......t.......z...........................c...m......sy.z...j.j.da....s.........xfk"
+    ".ms.........qk....p.y.z...y............z........p...p..sz.....l.c....g............x..s.......x.."
+    "...........ly.q........j....p............d..las..b.....wd......d.......b........pj.tc.........n."
+    ".c...b....lc....p....k..................m..............l..h......j.............................."
+    "..........................s.l.s..q......q.............z......zss.....x..p....j.........dh......."
+    ".j..l..........f.........................................y.l.qh.xs.t..g..b.q.z...km.....m......z"
+    "....c.qy.z.....jc.......j..y.h..x..........c.ss........b..z.....c..................w.......djj.g"
+    "......m................s............................x.jq..k....c.t.qz........q...yz...jcj...cw.k"
+    ".....k.........................l...........l..........s..z....jjz..j.t.......j.d.........z.....g"
+    "......b....s.....x..b......d..........f.b...d.............j.l............d.j...fkzt.d.c....s...."
+    ".......................k.c....q.j............g......bj.s.........g.......l...j...x.............."
+    "......zp...........l.....g.......c............l..l.....p...............c........................"
+    ".......h.......................b.............j.....................................m.......l.z.."
+    ".........f........l..p.cz......s....yz....f...l..l.j.....c....j...........h..........gt..c..m..z"
+    "k..............n...........x..............w.....................s.s....j...z...l................"
+    "..............................................x................................................."
+    "................................................................................................"
+    ".................................................................f.............................."
+    "..................................z.............................j.h.x.yj..jrw..c.sgn.zlfzwf..n.x"
+    "...lzsxzz.b..syj.brj.r..hgx.ljjt..jx.stj.jx..x..c..swm.bc...zz.lz...jml..j....d....hdlb.y.f..f.."
+    "c.......ys....s.....j...g.q.....................gw...h.l..f.......b......zz...z...s............."
+    "..........y.q.m.....g.....l...x..x..q....................g...y...w...c......y.......x...q......d"
+    "c...............ha.........fy...yl.k.z......es..n....g.hyb................p........e..y.s..c.d.g"
+    "..n.......llz.......l...p.j...............c........................sy.sz.r.lj.........x.z.dg.g.."
+    "cgz.ff...jf...ak..y.......f...szzx.w..d.....b.t.......p...p.s.b..h.............ky..g..j.x.a..n.."
+    "..z...c..mj....zqn.n..b...j....................f.t......l.....p.......t...ly....ff..qw.........."
+    ".....x........s.y........fxn..ttb.........b....g........b..tmx..........p..........s............"
+    "t.by..y............................c......z..c.....zz......zj...y....jy.....ss....s.t.......s.wz"
+    "..........h.b...jc...dbx.c.............t................s......................lj.sy......y...a."
+    "..j........y.s....m.........wz.......jl.....fb.x.h.f.....q...y.........w.....c.s.y..t..m...k..bg"
+    ".....rk....s...b.y.......p.......zmfqm........j........................jc..mc........yc.rr......"
+    "......j..c......j.h.l.....j......d.rh..y...y...y.......h..............p..l....s................."
+    "...........m.....ll....h.y...m.........g..j.j..h............c...b........p.......lf............."
+    "....t.......mpw..............l......yy.xs....................l.........................z...g...."
+    ".p.d.......hz....c...k............d........j.............m..s.....................p.....z......."
+    "....x....r.......s....b......l.j............p....................................m.m...z..w....."
+    ".c.........ns..........q....ab...........jr.........................................y.........l."
+    "....b......................x..............x....s.........................j.....cm....o.........."
+    "....t....f.................z.....................m......................................z......."
+    "..............hlnl........x...y............c.....s.......h...sx.sym.......w.b........c......y..."
+    "....z...........................z.....qs..gd........h....w.z........g.........m.z........y....e."
+    "s.f...............y..t.wz...m....l.....................................y.c....x........h........"
+    "....................h.d......................r.................m..........................l....."
+    ".........................................................x...........................r.........."
+    "..c.............................x....x......xy......x..j.y.......h.y.b..b..sc...s......z........"
+    ".y..a......d.p....t...x.....w..............b.x...f...............cl..z..............yy...q......"
+    "....k..............sp...lg........g.............h.b..................r....t....................."
+    "....x..........................j...............................x.y....f........................."
+    ".................................jg.gms.lj........j................j..c........................."
+    "y..............................................................................................."
+    ".........................z...............yt........s............................................"
+    "................................................................................................"
+    "......................................................................j.....p..................."
+    ".................................jdfrj..tr.q.xyxj.jh..y.xel.sfsfjz..pzs.zsz.zc...y...s.s..cz.hd."
+    ".gxy.gxc...jwy.w.yh.ss.qz.nd.fk..s.d.lz.t.ym.dh.x..w...c..y.m.....xyb.q.jm..mt..lp..q..g........"
+    ".h....d.....w....................xh.......hy.............bc..............h..m..................."
+    "................................................................................................"
+    ".............................bzf.gczxbzhzftpbgzgej..tg.dmfh.z.jh.llzz.....sfd.ssc...p.l.z.zs..z."
+    "zsygc.s....h....z...fzgq.........c...c....yq...................t...q...............zp.........z."
+    "...y.......bd....p...........j.g........k.g....l...t.j....d...............y.c..t..............j."
+    "..t......cz.........................t...d..t..........................b.....dc....d............c"
+    ".z.....c...................................sg..q..d.......t....................................."
+    "................................................................................................"
+    "......................................czgx..z.lrh...z......q.z.j...j.fl.bhg.....fj.s.yxz.z.xg.cb"
+    "...l....bb.b....cr.......b...ld..qy.qx.gm.....y.yj..f...hz.jywlc..t.......dp.d..s......mbj...z.."
+    "tsst..n..xx....tz.d.t..d..tg.scsz.f...........d.........y..lb.y..ds....y.....b.e...d...y........"
+    "...q.y.......zz......z.........by................y.d..............xn..b...x...yh.q...s...z.l...."
+    ".y........j...l..z...........h...j.....yb....g......c...d....d....e......................b......"
+    ".........................................y.qzp....j....x..f..yt....h.s....l.c.t..j...jmks......n"
+    ".......c.z.c......x.......mq...........................................c.ys.lzyl.j..........f..."
+    "................................................................................................"
+    "....................................................j..........................................."
+    "................................................................................................"
+    "................................................................................................"
+    "................................................................................................"
+    "................................................................................................"
+    "................................................................................................"
+    "........zd....q...fd.....g...dcznbg..yqjwg....n..q.q.b.....z..j.ytbl.qm.....................tl.."
+    ".z.x........gm..jyc...y.z.p...l.xs..cg..x..fx...rt.....z.cm......x.lczj.x....djjm........q.d...."
+    "dm.....z..n..n..gb..........j......l.........l..l.....x........c................................"
+    "........................................................................m.s..bwcr.x.j..mzngw.m.."
+    "fgh..y...y....y.cl..k.......f..d..............r...fyyzj....z...at...fjllc..lmj..x....s.....b...."
+    ".dy.c...yxp..........ltx.............yl....s...sy...g...ax..z..........s..............l.......n."
+    "qy..xyjg....cy.c.....d..................y.x...........ll.b....w.x...x..z.m...h.....n..l.....s.x."
+    "..................l.....bp........................q...j..j.d..f.kmm......g.........jx.b........."
+    "...........x.a..........q.......j............b.................................................."
+    "......wr.h...j.....y.ys........................................................................."
+    ".....................................................ydq.xsx.wgd.bs.yllpj.j.....yp.t..ykt...ye.."
+    "d...c..q......................................f.........p.....fs................................"
+    "................c..............................................................................."
+    ".....j.......fyjsbs..er...j.b..e.n...xg.k..c...l..m...s..x......................................"
+    "................................................................................................"
+    "............................................................................mytxcq.bl.s..j.zt.j."
+    "..m.j.lh...cy..j.q.....p..s......l..z...g...............h..........................s....g......."
+    "...................................z........................................................g..."
+    ".kh.p..........w....m..........................................................................."
+    "................................................................................................"
+    "................................................................................................"
+    "............................y....l...........b..............x.......l...................j......."
+    "...s..................b.......l................................................................."
+    "................................................................................................"
+    "................................................................................................"
+    "...............................................................n.j.m.oy......y.y...y.t.......g.h"
+    "...j.e....q....p....................h...........y..............l...................l............"
+    "......m....................m........h........sl..h..q...m......................................."
+    "..............d....g............s..........................b....................q..............."
+    "...............................c....l......q.............lg....g......";
+
+static_assert(sizeof(kInitials) == kLast - kFirst + 2, "pinyin table size mismatch");
+
+} // namespace
+
+char Pinyin::initial(char32_t ch)
+{
+    if (ch < kFirst || ch > kLast) return 0;
+    const char c = kInitials[ch - kFirst];
+    return c == '.' ? 0 : c;
+}
+
+QString Pinyin::initials(const QString &text)
+{
+    QString out;
+    const QList<uint> ucs4 = text.toUcs4();
+    out.reserve(ucs4.size());
+    for (uint cp : ucs4) {
+        if (const char c = initial(cp)) {
+            out.append(QLatin1Char(c));
+        } else if (cp < 0x80 && QChar::isLetterOrNumber(cp)) {
+            out.append(QChar(cp).toLower());
+        }
+    }
+    return out;
+}
+
+bool Pinyin::containsHan(const QString &text)
+{
+    for (QChar c : text) {
+        if (c.unicode() >= kFirst && c.unicode() <= kLast) return true;
+    }
+    return false;
+}
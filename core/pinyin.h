@@ -0,0 +1,18 @@
+// core/pinyin.h
+#ifndef CORE_PINYIN_H
+#define CORE_PINYIN_H
+
+// 汉字拼音首字母：覆盖 GB2312 一级汉字（按拼音排序的 3755 个常用字）
+// 二级汉字按部首排序，无法由码位推出读音，查不到时返回 0；多音字只取码表中的读音
+#include <QString>
+
+class Pinyin
+{
+public:
+    static char initial(char32_t ch);
+    // 依次取每个汉字的首字母，ASCII 字母数字原样（小写）保留，其余字符跳过
+    static QString initials(const QString &text);
+    static bool containsHan(const QString &text);
+};
+
+#endif // CORE_PINYIN_H
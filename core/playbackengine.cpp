@@ -0,0 +1,835 @@
+// 实现文件：PlaybackEngine —— 解码环形缓冲、拉取式混音与样本级衔接
+#include "core/playbackengine.h"
+#include "core/loudnessanalyzer.h"
+#include "core/metadataservice.h"
+
+#include <QAudioBuffer>
+#include <QAudioDecoder>
+#include <QAudioSink>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QMediaDevices>
+#include <QTimer>
+#include <QUrl>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <limits>
+
+namespace {
+
+const int kCacheSeconds = 600;         // 每首曲目保留的已解码 PCM 上限；超出时先释放播放点之前最旧的部分
+const int kDeviceBufferMs = 100;       // 设备缓冲：也是手动切歌/跳转后旧音频残留的上限
+const int kServiceIntervalMs = 40;
+const int kMaxCrossfadeMs = 5000;      // 小于预解码余量，保证淡化开始时下一首已就绪
+const qint64 kMaxLatencyMs = 500;
+const int kGainRampMs = 50;            // 播放中途得到响度结果时的增益过渡时长
+const float kHalfPi = 1.57079632679f;
+
+QUrl sourceUrl(const QString &path)
+{
+    if (path.startsWith(QLatin1String("qrc:/"))) return QUrl(path);
+    if (path.startsWith(QLatin1String(":/"))) return QUrl(QStringLiteral("qrc") + path);
+    return QUrl::fromLocalFile(path);
+}
+
+// 解码端若未按请求格式输出，在此统一转为交错浮点并对齐声道数
+void toInterleaved(const QAudioBuffer &buffer, int channels, std::vector<float> &out)
+{
+    const QAudioFormat format = buffer.format();
+    const int srcChannels = std::max(1, format.channelCount());
+    const qsizetype frames = buffer.frameCount();
+    out.resize(size_t(frames) * size_t(channels));
+
+    auto convert = [&](auto sampleAt) {
+        float *dst = out.data();
+        for (qsizetype f = 0; f < frames; ++f, dst += channels) {
+            const qsizetype base = f * srcChannels;
+            if (channels == 1 && srcChannels > 1) {
+                float sum = 0.0f;
+                for (int c = 0; c < srcChannels; ++c) sum += sampleAt(base + c);
+                dst[0] = sum / float(srcChannels);
+            } else {
+                // 单声道复制到各声道；多声道取前几路（5.1 取 FL/FR）
+                for (int c = 0; c < channels; ++c) dst[c] = sampleAt(base + std::min(c, srcChannels - 1));
+            }
+        }
+    };
+    switch (format.sampleFormat()) {
+    case QAudioFormat::Float: {
+        const float *data = buffer.constData<float>();
+        if (srcChannels == channels) {
+            std::memcpy(out.data(), data, out.size() * sizeof(float));
+        } else {
+            convert([data](qsizetype i) { return data[i]; });
+        }
+        break;
+    }
+    case QAudioFormat::Int16: {
+        const qint16 *data = buffer.constData<qint16>();
+        convert([data](qsizetype i) { return data[i] / 32768.0f; });
+        break;
+    }
+    case QAudioFormat::Int32: {
+        const qint32 *data = buffer.constData<qint32>();
+        convert([data](qsizetype i) { return float(data[i] / 2147483648.0); });
+        break;
+    }
+    case QAudioFormat::UInt8: {
+        const quint8 *data = buffer.constData<quint8>();
+        convert([data](qsizetype i) { return (int(data[i]) - 128) / 128.0f; });
+        break;
+    }
+    default:
+        out.clear();
+        break;
+    }
+}
+
+// 曲目已解码的交错 PCM：按 1 秒分块追加，只从头部整块释放，混音读取时不会遇到重新分配
+// 存为 16 位整数以减半内存，按 ±2.0 量化给有损解码的过冲留出余量
+// 跳转落在 [base, end) 内时直接移动读取位置，不必重新解码
+struct PcmCache
+{
+    static constexpr float SCALE = 16384.0f;
+
+    int channels = 2;
+    qint64 chunkFrames = 48000;
+    std::deque<std::unique_ptr<qint16[]>> chunks;
+    qint64 base = 0;        // 首个保存帧的序号
+    qint64 end = 0;         // 已保存帧之后的序号
+
+    qint64 frames() const { return end - base; }
+
+    void reset(qint64 frame)
+    {
+        chunks.clear();
+        base = end = frame;
+    }
+
+    void dropFront()
+    {
+        chunks.pop_front();
+        base += chunkFrames;
+    }
+
+    void append(const float *src, qint64 n)
+    {
+        while (n > 0) {
+            const qint64 offset = (end - base) % chunkFrames;
+            if (offset == 0) chunks.push_back(std::make_unique<qint16[]>(size_t(chunkFrames * channels)));
+            const qint64 count = std::min(n, chunkFrames - offset);
+            qint16 *dst = chunks.back().get() + offset * channels;
+            const qint64 samples = count * channels;
+            for (qint64 i = 0; i < samples; ++i)
+                dst[i] = qint16(std::lround(std::clamp(src[i] * SCALE, -32768.0f, 32767.0f)));
+            src += samples;
+            end += count;
+            n -= count;
+        }
+    }
+
+    void read(qint64 from, float *dst, qint64 n) const
+    {
+        const float scale = 1.0f / SCALE;
+        while (n > 0) {
+            const qint64 index = (from - base) / chunkFrames;
+            const qint64 offset = (from - base) % chunkFrames;
+            const qint64 count = std::min(n, chunkFrames - offset);
+            const qint16 *src = chunks[size_t(index)].get() + offset * channels;
+            const qint64 samples = count * channels;
+            for (qint64 i = 0; i < samples; ++i) dst[i] = src[i] * scale;
+            dst += samples;
+            from += count;
+            n -= count;
+        }
+    }
+};
+
+} // namespace
+
+struct PlaybackEngine::Track
+{
+    QString source;
+    std::unique_ptr<QAudioDecoder> decoder;     // 仅 GUI 线程访问
+    bool rateWarned = false;                    // 仅 GUI 线程访问
+    bool gainResolved = false;                  // 仅 GUI 线程访问：已按分析结果（或确定无结果）设置增益
+    bool decoderIdle = false;                   // 仅 GUI 线程访问：stop() 后解码器停着，播放时再从头解码
+    // 以下由 m_mutex 保护
+    PcmCache pcm;
+    qint64 consumed = 0;    // 已交给混音的帧数（含跳转越过的部分），即播放进度
+    qint64 decodedFrames = 0;   // 解码器已输出的帧数
+    qint64 skip = 0;        // 跳转到已解码范围之后时，尚需丢弃的解码帧数
+    qint64 durationMs = 0;
+    qint64 fadeFrames = 0;  // 交叉淡化开始时确定的长度
+    bool decoded = false;   // 解码完毕，缓冲中为曲尾
+    bool audible = false;   // 已有样本交给混音
+    float gain = 1.0f;      // 响度归一化的线性增益，向 targetGain 逐帧逼近
+    float targetGain = 1.0f;
+    float gainStep = 0.0f;
+
+    // 移动播放位置（m_mutex 内调用）：已保存的范围内直接移动；目标尚未解码到时解码器接着往下走并丢弃到目标
+    // 只有目标早于保存范围（超长曲目的开头已释放）时返回 false，需从头重新解码
+    bool seekTo(qint64 frame)
+    {
+        fadeFrames = 0;
+        if (decoded) frame = std::min(frame, pcm.end);
+        if (frame >= pcm.base && frame <= pcm.end) {
+            consumed = frame;
+            return true;
+        }
+        pcm.reset(frame);
+        consumed = frame;
+        if (frame >= decodedFrames) {
+            skip = frame - decodedFrames;
+            return true;
+        }
+        skip = frame;
+        decodedFrames = 0;
+        decoded = false;
+        return false;
+    }
+};
+
+// 拉取式数据源：QAudioSink 在音频线程读取；始终返回满额数据（无内容时补静音），设备不会进入空闲
+class PlaybackEngine::Stream : public QIODevice
+{
+public:
+    explicit Stream(PlaybackEngine *engine) : QIODevice(engine), m_engine(engine) {}
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    {
+        return m_engine->m_format.bytesForDuration(1000000) + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override { return m_engine->render(data, maxlen); }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    PlaybackEngine *m_engine;
+};
+
+PlaybackEngine::PlaybackEngine(QObject *parent)
+    : QObject(parent)
+    , m_devices(new QMediaDevices(this))
+    , m_stream(new Stream(this))
+    , m_serviceTimer(new QTimer(this))
+{
+    chooseFormat();
+    m_retired.reserve(4);
+    m_stream->open(QIODevice::ReadOnly);
+    m_serviceTimer->setInterval(kServiceIntervalMs);
+    connect(m_serviceTimer, &QTimer::timeout, this, [this]() { service(); });
+    // 跟随系统默认输出设备；这是唯一会重开设备的情形
+    connect(m_devices, &QMediaDevices::audioOutputsChanged, this, [this]() {
+        if (QMediaDevices::defaultAudioOutput().id() != m_device.id()) resetOutput();
+    });
+    connect(&LoudnessAnalyzer::instance(), &LoudnessAnalyzer::ready, this, &PlaybackEngine::onLoudnessReady);
+}
+
+PlaybackEngine::~PlaybackEngine()
+{
+    // 先停设备，保证音频线程不再进入 render
+    if (m_sink) m_sink->stop();
+}
+
+void PlaybackEngine::chooseFormat()
+{
+    m_device = QMediaDevices::defaultAudioOutput();
+    QAudioFormat format = m_device.preferredFormat();
+    if (format.sampleRate() <= 0) format.setSampleRate(48000);
+    format.setChannelCount(format.channelCount() == 1 ? 1 : 2);
+    format.setSampleFormat(QAudioFormat::Float);
+    if (!m_device.isNull() && !m_device.isFormatSupported(format)) format.setSampleFormat(QAudioFormat::Int16);
+
+    QMutexLocker lock(&m_mutex);
+    m_format = format;
+    // 单次回调最多输出 1 秒
+    const size_t samples = size_t(format.sampleRate()) * size_t(format.channelCount());
+    m_mix.assign(samples, 0.0f);
+    m_fade.assign(samples, 0.0f);
+    m_crossfadeFrames = qint64(m_crossfade) * format.sampleRate() / 1000;
+}
+
+std::unique_ptr<PlaybackEngine::Track> PlaybackEngine::createTrack(const QString &source, qint64 startMs)
+{
+    auto track = std::make_unique<Track>();
+    track->source = source;
+    track->pcm.channels = m_format.channelCount();
+    track->pcm.chunkFrames = m_format.sampleRate();
+    track->consumed = track->skip = startMs * m_format.sampleRate() / 1000;
+    track->pcm.reset(track->consumed);
+
+    // 各曲目都解码为设备的采样率与声道数，衔接处无需重采样
+    QAudioFormat format = m_format;
+    format.setSampleFormat(QAudioFormat::Float);
+    track->decoder = std::make_unique<QAudioDecoder>();
+    track->decoder->setAudioFormat(format);
+    track->decoder->setSource(sourceUrl(source));
+
+    Track *t = track.get();
+    QAudioDecoder *decoder = t->decoder.get();
+    connect(decoder, &QAudioDecoder::bufferReady, this, [this, t]() { refill(t); });
+    connect(decoder, &QAudioDecoder::finished, this, [this, t]() { onDecoded(t, QString()); });
+    connect(decoder, qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), this, [this, t]() {
+        onDecoded(t, t->decoder->errorString());
+    });
+    connect(decoder, &QAudioDecoder::durationChanged, this, [this, t](qint64 ms) {
+        {
+            QMutexLocker lock(&m_mutex);
+            t->durationMs = ms;
+        }
+        updateDuration();
+    });
+    decoder->start();
+    updateGain(t);
+    return track;
+}
+
+void PlaybackEngine::updateGain(Track *track)
+{
+    LoudnessAnalyzer &analyzer = LoudnessAnalyzer::instance();
+    double gainDb = 0.0;
+    double peak = 1.0;
+    track->gainResolved = true;
+    if (m_normalization != NoNormalization) {
+        LoudnessInfo info;
+        if (!analyzer.lookup(track->source, &info)) {
+            // 尚未分析：先按原音量播放，结果到达后由 onLoudnessReady 过渡过去
+            analyzer.request(track->source);
+            track->gainResolved = false;
+        } else {
+            if (!(m_normalization == AlbumGain && analyzer.albumGain(track->source, &gainDb, &peak))) {
+                gainDb = info.trackGain();
+                peak = info.peak;
+            }
+            // 防削波：增益后的真峰值不超过上限；无法测量（整首静音）时增益为 0，不作处理
+            if (gainDb != 0.0 && peak > 0.0)
+                gainDb = std::min(gainDb, LoudnessAnalyzer::PEAK_CEILING_DB - 20.0 * std::log10(peak));
+        }
+    }
+    const float gain = float(std::pow(10.0, gainDb / 20.0));
+
+    QMutexLocker lock(&m_mutex);
+    track->targetGain = gain;
+    if (!track->audible) {
+        track->gain = gain;
+    } else {
+        const qint64 rampFrames = std::max<qint64>(1, qint64(kGainRampMs) * m_format.sampleRate() / 1000);
+        track->gainStep = (gain - track->gain) / float(rampFrames);
+    }
+}
+
+void PlaybackEngine::onLoudnessReady(const QString &path)
+{
+    Track *current = nullptr;
+    Track *next = nullptr;
+    {
+        QMutexLocker lock(&m_mutex);
+        current = m_current.get();
+        next = m_next.get();
+    }
+    // 曲目对象只在 GUI 线程释放，锁外使用指针是安全的
+    const QString dir = QFileInfo(path).absolutePath();
+    for (Track *track : { current, next }) {
+        if (!track) continue;
+        const QString source = MetadataService::normalizePath(track->source);
+        bool audible = false;
+        {
+            QMutexLocker lock(&m_mutex);
+            audible = track->audible;
+        }
+        // 本曲结果到达；或专辑模式下同目录曲目完成、本曲尚未出声，专辑增益可能已经齐备
+        if ((!track->gainResolved && source == path)
+            || (m_normalization == AlbumGain && !audible && QFileInfo(source).absolutePath() == dir)) {
+            updateGain(track);
+        }
+    }
+}
+
+void PlaybackEngine::installTrack(std::unique_ptr<Track> track)
+{
+    std::unique_ptr<Track> oldCurrent;
+    std::unique_ptr<Track> oldNext;
+    std::vector<std::unique_ptr<Track>> retired;
+    {
+        QMutexLocker lock(&m_mutex);
+        oldCurrent = std::move(m_current);
+        oldNext = std::move(m_next);
+        m_current = std::move(track);
+        for (auto &t : m_retired) retired.push_back(std::move(t));
+        m_retired.clear();
+        m_switchFrame = m_endFrame = -1;
+        m_ended = false;
+    }
+    // 换下的曲目在此（锁外、GUI 线程）连同解码器一起释放
+}
+
+void PlaybackEngine::setSource(const QString &source)
+{
+    if (m_source == source) return;
+    m_source = source;
+    pause();
+    // 手动切到已预解码的下一首（下一曲、随机跳转）：直接接管，不重新解码
+    std::unique_ptr<Track> track;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_next && m_next->source == source) {
+            track = std::move(m_next);
+            track->seekTo(0);   // 交叉淡化中途切换时已消耗了开头，回到起点
+        }
+    }
+    if (!track && !source.isEmpty()) track = createTrack(source);
+    installTrack(std::move(track));
+    m_lastPosition = 0;
+    emit sourceChanged();
+    emit positionChanged();
+    updateDuration();
+    prerollNext();
+}
+
+void PlaybackEngine::setNextSource(const QString &source)
+{
+    if (m_nextSource == source) return;
+    m_nextSource = source;
+    std::unique_ptr<Track> old;
+    {
+        QMutexLocker lock(&m_mutex);
+        old = std::move(m_next);
+    }
+    emit nextSourceChanged();
+    prerollNext();
+}
+
+void PlaybackEngine::prerollNext()
+{
+    if (m_nextSource.isEmpty()) return;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (!m_current || !m_current->decoded || m_next) return;
+    }
+    std::unique_ptr<Track> next = createTrack(m_nextSource);
+    QMutexLocker lock(&m_mutex);
+    m_next = std::move(next);
+}
+
+void PlaybackEngine::refill(Track *track, bool drain)
+{
+    QAudioDecoder *decoder = track->decoder.get();
+    const size_t channels = size_t(m_format.channelCount());
+    const qint64 limit = qint64(kCacheSeconds) * m_format.sampleRate();
+    while (decoder->bufferAvailable()) {
+        if (!drain) {
+            // 超出上限：释放播放点之前最旧的块；仍然超出（全在播放点之后）则暂不读取，解码端随之暂停
+            QMutexLocker lock(&m_mutex);
+            PcmCache &pcm = track->pcm;
+            while (pcm.frames() >= limit && pcm.base + pcm.chunkFrames <= track->consumed) pcm.dropFront();
+            if (pcm.frames() >= limit) return;
+        }
+        const QAudioBuffer buffer = decoder->read();
+        if (!buffer.isValid()) continue;
+        if (buffer.format().sampleRate() != m_format.sampleRate() && !track->rateWarned) {
+            track->rateWarned = true;
+            qWarning("PlaybackEngine: decoder ignored requested rate %d Hz (got %d Hz) for %s",
+                     m_format.sampleRate(), buffer.format().sampleRate(), qPrintable(track->source));
+        }
+        toInterleaved(buffer, int(channels), m_decodeScratch);
+
+        QMutexLocker lock(&m_mutex);
+        const qint64 frames = qint64(m_decodeScratch.size() / channels);
+        track->decodedFrames += frames;
+        const qint64 skipped = std::min(track->skip, frames);
+        track->skip -= skipped;
+        track->pcm.append(m_decodeScratch.data() + size_t(skipped) * channels, frames - skipped);
+    }
+}
+
+void PlaybackEngine::onDecoded(Track *track, const QString &error)
+{
+    refill(track, true);
+    bool isCurrent = false;
+    {
+        QMutexLocker lock(&m_mutex);
+        track->decoded = true;
+        if (track->durationMs <= 0 && error.isEmpty()) {
+            track->durationMs = track->decodedFrames * 1000 / m_format.sampleRate();
+        }
+        isCurrent = track == m_current.get();
+    }
+    if (!error.isEmpty()) emit errorOccurred(track->source, error);
+    if (isCurrent) {
+        updateDuration();
+        prerollNext();
+    }
+}
+
+void PlaybackEngine::startSink()
+{
+    m_sink = new QAudioSink(m_device, m_format, this);
+    m_sink->setBufferSize(m_format.bytesForDuration(qint64(kDeviceBufferMs) * 1000));
+    m_sink->setVolume(m_volume);
+    m_framesWritten = 0;
+    m_sink->start(m_stream);
+}
+
+void PlaybackEngine::resetOutput()
+{
+    const bool wasPlaying = m_playing;
+    service(true);
+    const qint64 positionMs = position();
+    if (m_sink) {
+        m_sink->stop();
+        delete m_sink;
+        m_sink = nullptr;
+    }
+    const QAudioFormat previous = m_format;
+    chooseFormat();
+    if (m_format != previous) {
+        // 采样率或声道数变化：已解码的数据不再适用，按原进度重新解码
+        installTrack(m_source.isEmpty() ? nullptr : createTrack(m_source, positionMs));
+    }
+    setPlaying(false);
+    if (wasPlaying) play();
+}
+
+qint64 PlaybackEngine::latencyFrames() const
+{
+    if (!m_sink) return 0;
+    const qint64 played = m_sink->processedUSecs() * m_format.sampleRate() / 1000000;
+    return std::clamp<qint64>(m_framesWritten.load() - played, 0, kMaxLatencyMs * m_format.sampleRate() / 1000);
+}
+
+qint64 PlaybackEngine::position() const
+{
+    QMutexLocker lock(&m_mutex);
+    if (!m_current) return 0;
+    // 已衔接但尚未出声：进度停在上一首末尾
+    if (m_switchFrame >= 0) return m_lastPosition;
+    const qint64 frames = std::max<qint64>(0, m_current->consumed - latencyFrames());
+    return frames * 1000 / m_format.sampleRate();
+}
+
+void PlaybackEngine::service(bool flush)
+{
+    const qint64 played = flush ? std::numeric_limits<qint64>::max() : m_framesWritten.load() - latencyFrames();
+    bool advanced = false;
+    bool ended = false;
+    Track *current = nullptr;
+    Track *next = nullptr;
+    std::vector<std::unique_ptr<Track>> retired;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_switchFrame >= 0 && played >= m_switchFrame) {
+            m_switchFrame = -1;
+            advanced = true;
+        }
+        for (auto &t : m_retired) retired.push_back(std::move(t));
+        m_retired.clear();
+        if (m_endFrame >= 0 && m_switchFrame < 0 && played >= m_endFrame) {
+            m_endFrame = -1;
+            ended = true;
+        }
+        current = m_current.get();
+        next = m_next.get();
+    }
+    retired.clear();
+
+    if (current) refill(current);
+    if (next) refill(next);
+
+    if (advanced && current) {
+        // nextSource 保持不变：QML 随即按新的当前曲重新设置；单曲循环时它恰好就是同一首
+        m_source = current->source;
+        emit sourceChanged();
+        updateDuration();
+        emit trackAdvanced();
+        prerollNext();
+    }
+    const qint64 pos = position();
+    if (pos != m_lastPosition) {
+        m_lastPosition = pos;
+        emit positionChanged();
+    }
+    if (ended) {
+        pause();
+        emit endOfMedia();
+    }
+}
+
+void PlaybackEngine::updateDuration()
+{
+    qint64 duration = 0;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_current) duration = m_current->durationMs;
+    }
+    if (duration == m_duration) return;
+    m_duration = duration;
+    emit durationChanged();
+}
+
+void PlaybackEngine::setPlaying(bool playing)
+{
+    if (m_playing == playing) return;
+    m_playing = playing;
+    emit playingChanged();
+}
+
+void PlaybackEngine::play()
+{
+    bool restart = false;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (!m_current) return;
+        restart = m_ended && !m_next;
+    }
+    // 播完后再次播放：从头开始
+    if (restart) seek(0);
+    Track *current = nullptr;
+    {
+        QMutexLocker lock(&m_mutex);
+        current = m_current.get();
+    }
+    // stop() 停下的解码器在真正播放时才重新启动
+    if (current && current->decoderIdle) {
+        current->decoderIdle = false;
+        current->decoder->start();
+    }
+    if (m_sink && m_sink->state() == QAudio::StoppedState) {
+        // 设备出错停止（如被拔出）后重新打开
+        delete m_sink;
+        m_sink = nullptr;
+    }
+    if (!m_sink) {
+        startSink();
+    } else if (m_sink->state() == QAudio::SuspendedState) {
+        m_sink->resume();
+    }
+    m_serviceTimer->start();
+    setPlaying(true);
+}
+
+void PlaybackEngine::pause()
+{
+    if (m_sink && m_sink->state() != QAudio::StoppedState) m_sink->suspend();
+    m_serviceTimer->stop();
+    setPlaying(false);
+}
+
+void PlaybackEngine::stop()
+{
+    pause();
+    moveTo(0, false);
+}
+
+void PlaybackEngine::seek(qint64 positionMs)
+{
+    moveTo(positionMs, true);
+}
+
+void PlaybackEngine::moveTo(qint64 positionMs, bool decodeNow)
+{
+    // 先上报尚未出声的衔接，避免把跳转作用到界面尚未切换过去的曲目上
+    service(true);
+    Track *track = nullptr;
+    bool restart = false;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (!m_current) return;
+        track = m_current.get();
+        restart = !track->seekTo(std::max<qint64>(0, positionMs) * m_format.sampleRate() / 1000);
+        m_ended = false;
+        m_endFrame = -1;
+    }
+    // QAudioDecoder 不支持定位：仅当目标早于保存范围时才从头重新解码，丢弃目标之前的帧
+    if (restart) {
+        track->decoder->stop();
+        track->decoderIdle = true;
+    }
+    if (decodeNow && track->decoderIdle) {
+        track->decoderIdle = false;
+        track->decoder->start();
+    }
+    m_lastPosition = std::max<qint64>(0, positionMs);
+    emit positionChanged();
+}
+
+void PlaybackEngine::setVolume(qreal volume)
+{
+    volume = std::clamp<qreal>(volume, 0.0, 1.0);
+    if (qFuzzyCompare(m_volume, volume)) return;
+    m_volume = volume;
+    if (m_sink) m_sink->setVolume(volume);
+    emit volumeChanged();
+}
+
+void PlaybackEngine::setCrossfade(int ms)
+{
+    ms = std::clamp(ms, 0, kMaxCrossfadeMs);
+    if (m_crossfade == ms) return;
+    m_crossfade = ms;
+    {
+        QMutexLocker lock(&m_mutex);
+        m_crossfadeFrames = qint64(ms) * m_format.sampleRate() / 1000;
+    }
+    emit crossfadeChanged();
+}
+
+void PlaybackEngine::setNormalization(Normalization mode)
+{
+    if (m_normalization == mode) return;
+    m_normalization = mode;
+    Track *current = nullptr;
+    Track *next = nullptr;
+    {
+        QMutexLocker lock(&m_mutex);
+        current = m_current.get();
+        next = m_next.get();
+    }
+    if (current) updateGain(current);
+    if (next) updateGain(next);
+    emit normalizationChanged();
+}
+
+int PlaybackEngine::analysisThreads() const
+{
+    return LoudnessAnalyzer::instance().maxThreads();
+}
+
+void PlaybackEngine::setAnalysisThreads(int count)
+{
+    LoudnessAnalyzer &analyzer = LoudnessAnalyzer::instance();
+    count = std::max(1, count);
+    if (analyzer.maxThreads() == count) return;
+    analyzer.setMaxThreads(count);
+    emit analysisThreadsChanged();
+}
+
+void PlaybackEngine::addTap(AudioTap *tap)
+{
+    QMutexLocker lock(&m_mutex);
+    if (std::find(m_taps.begin(), m_taps.end(), tap) == m_taps.end()) m_taps.push_back(tap);
+}
+
+void PlaybackEngine::removeTap(AudioTap *tap)
+{
+    QMutexLocker lock(&m_mutex);
+    m_taps.erase(std::remove(m_taps.begin(), m_taps.end(), tap), m_taps.end());
+}
+
+qint64 PlaybackEngine::render(char *data, qint64 maxlen)
+{
+    const int channels = m_format.channelCount();
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    const qint64 frames = std::min<qint64>(maxlen / bytesPerFrame, qint64(m_mix.size()) / channels);
+    if (frames <= 0) return 0;
+    {
+        QMutexLocker lock(&m_mutex);
+        mix(m_mix.data(), frames);
+        for (AudioTap *tap : m_taps) tap->process(m_mix.data(), frames, channels, m_format.sampleRate());
+    }
+    const float *src = m_mix.data();
+    const qint64 samples = frames * channels;
+    if (m_format.sampleFormat() == QAudioFormat::Float) {
+        std::memcpy(data, src, size_t(samples) * sizeof(float));
+    } else {
+        qint16 *dst = reinterpret_cast<qint16 *>(data);
+        for (qint64 i = 0; i < samples; ++i)
+            dst[i] = qint16(std::lround(std::clamp(src[i], -1.0f, 1.0f) * 32767.0f));
+    }
+    m_framesWritten += frames;
+    return frames * bytesPerFrame;
+}
+
+void PlaybackEngine::mix(float *out, qint64 frames)
+{
+    const int channels = m_format.channelCount();
+    qint64 done = 0;
+    while (done < frames && m_current) {
+        Track &cur = *m_current;
+        float *dst = out + done * channels;
+        const qint64 want = frames - done;
+        const qint64 avail = cur.pcm.end - cur.consumed;
+        if (avail == 0) {
+            if (!cur.decoded) break;    // 解码跟不上：本次余下部分补静音
+            if (!m_next) {
+                if (!m_ended) {
+                    m_ended = true;
+                    m_endFrame = m_framesWritten.load() + done;
+                }
+                break;
+            }
+            // 样本级衔接：同一次回调内紧接着输出下一首，设备与输出格式都不变
+            m_retired.push_back(std::move(m_current));
+            m_current = std::move(m_next);
+            m_switchFrame = m_framesWritten.load() + done;
+            m_ended = false;
+            m_endFrame = -1;
+            continue;
+        }
+
+        Track *next = m_next.get();
+        const qint64 nextAvail = next ? next->pcm.end - next->consumed : 0;
+        // 下一首有数据时才开始淡变；一旦开始就沿曲线淡出到底，下一首供不上时以静音代替，不回到满增益
+        const bool fading = cur.decoded && m_crossfadeFrames > 0
+                && (cur.fadeFrames > 0 || (nextAvail > 0 && avail <= m_crossfadeFrames));
+        if (!fading) {
+            const qint64 n = std::min(want, avail);
+            cur.pcm.read(cur.consumed, dst, n);
+            applyGain(cur, dst, n);
+            cur.consumed += n;
+            done += n;
+            continue;
+        }
+
+        if (cur.fadeFrames == 0) cur.fadeFrames = avail;
+        const qint64 n = std::min(want, avail);
+        const qint64 incoming = std::min(n, nextAvail);
+        cur.pcm.read(cur.consumed, dst, n);
+        if (incoming > 0) {
+            next->pcm.read(next->consumed, m_fade.data(), incoming);
+            applyGain(*next, m_fade.data(), incoming);
+        }
+        std::fill(m_fade.data() + incoming * channels, m_fade.data() + n * channels, 0.0f);
+        applyGain(cur, dst, n);
+        // 等功率：当前曲按 sin 淡出，下一首按 cos 淡入，剩余帧数决定相位
+        const float *in = m_fade.data();
+        for (qint64 f = 0; f < n; ++f) {
+            const float phase = float(avail - f) / float(cur.fadeFrames) * kHalfPi;
+            const float a = std::sin(phase);
+            const float b = std::cos(phase);
+            for (int c = 0; c < channels; ++c) {
+                const qint64 i = f * channels + c;
+                dst[i] = dst[i] * a + in[i] * b;
+            }
+        }
+        cur.consumed += n;
+        if (incoming > 0) next->consumed += incoming;
+        done += n;
+    }
+    std::fill(out + done * channels, out + frames * channels, 0.0f);
+}
+
+void PlaybackEngine::applyGain(Track &track, float *samples, qint64 frames)
+{
+    const int channels = m_format.channelCount();
+    track.audible = true;
+    qint64 f = 0;
+    // 过渡段逐帧逼近目标值，到达后余下部分为常数增益
+    float gain = track.gain;
+    const float target = track.targetGain;
+    for (; f < frames && gain != target; ++f) {
+        gain += track.gainStep;
+        if ((track.gainStep >= 0.0f && gain >= target) || (track.gainStep < 0.0f && gain <= target)) gain = target;
+        for (int c = 0; c < channels; ++c) samples[f * channels + c] *= gain;
+    }
+    track.gain = gain;
+    if (gain == 1.0f) return;
+    float *p = samples + f * channels;
+    const qint64 n = (frames - f) * channels;
+    for (qint64 i = 0; i < n; ++i) p[i] *= gain;
+}
@@ -0,0 +1,158 @@
+// core/playbackengine.h
+#ifndef CORE_PLAYBACKENGINE_H
+#define CORE_PLAYBACKENGINE_H
+
+// 无缝播放引擎：QAudioSink 整个会话只打开一次，由拉取式混音流供数
+// 当前曲与下一首各由一个 QAudioDecoder 解码为设备格式的 PCM，分块保存整首（有上限），跳转到已解码处无需重新解码
+// 当前曲解码完毕即预解码下一首；混音在样本级衔接两首，可选等功率交叉淡化
+// 只负责播放，不读取标签：标题、封面等仍由 AudioMetadata 提供
+// 响度归一化：每首曲目按 LoudnessAnalyzer 的结果乘以固定增益（受真峰值上限约束），结果晚到时平滑过渡
+#include <QObject>
+#include <QAudioDevice>
+#include <QAudioFormat>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QAudioSink;
+class QMediaDevices;
+class QTimer;
+
+// 输出监听：在音频线程收到混音后的交错浮点 PCM（响度增益之后、音量之前）；实现方不得阻塞或分配内存
+class AudioTap
+{
+public:
+    virtual ~AudioTap() = default;
+    virtual void process(const float *samples, qint64 frames, int channels, int sampleRate) = 0;
+};
+
+class PlaybackEngine : public QObject
+{
+    Q_OBJECT
+    // 设置新音源即停止当前播放（与 MediaPlayer 一致）；自动衔接到下一首时由引擎自行更新
+    Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
+    // 预备的下一首：当前曲播完时无缝衔接；为空则播完后发出 endOfMedia
+    Q_PROPERTY(QString nextSource READ nextSource WRITE setNextSource NOTIFY nextSourceChanged)
+    Q_PROPERTY(bool playing READ isPlaying NOTIFY playingChanged)
+    // 毫秒，已扣除设备缓冲中尚未出声的部分
+    Q_PROPERTY(qint64 position READ position NOTIFY positionChanged)
+    Q_PROPERTY(qint64 duration READ duration NOTIFY durationChanged)
+    Q_PROPERTY(qreal volume READ volume WRITE setVolume NOTIFY volumeChanged)
+    // 交叉淡化时长（毫秒），0 为直接拼接
+    Q_PROPERTY(int crossfade READ crossfade WRITE setCrossfade NOTIFY crossfadeChanged)
+    // 响度归一化方式；专辑增益在整张专辑分析完成前退回单曲增益
+    Q_PROPERTY(Normalization normalization READ normalization WRITE setNormalization NOTIFY normalizationChanged)
+    // 后台响度分析同时处理的曲目数（进程内共享，默认等于 CPU 核数）
+    Q_PROPERTY(int analysisThreads READ analysisThreads WRITE setAnalysisThreads NOTIFY analysisThreadsChanged)
+
+public:
+    enum Normalization { NoNormalization, TrackGain, AlbumGain };
+    Q_ENUM(Normalization)
+
+    explicit PlaybackEngine(QObject *parent = nullptr);
+    ~PlaybackEngine() override;
+
+    QString source() const { return m_source; }
+    void setSource(const QString &source);
+    QString nextSource() const { return m_nextSource; }
+    void setNextSource(const QString &source);
+    bool isPlaying() const { return m_playing; }
+    qint64 position() const;
+    qint64 duration() const { return m_duration; }
+    qreal volume() const { return m_volume; }
+    void setVolume(qreal volume);
+    int crossfade() const { return m_crossfade; }
+    void setCrossfade(int ms);
+    Normalization normalization() const { return m_normalization; }
+    void setNormalization(Normalization mode);
+    int analysisThreads() const;
+    void setAnalysisThreads(int count);
+
+    Q_INVOKABLE void play();
+    Q_INVOKABLE void pause();
+    Q_INVOKABLE void stop();
+    Q_INVOKABLE void seek(qint64 positionMs);
+
+    // removeTap 返回后音频线程不会再调用该监听
+    void addTap(AudioTap *tap);
+    void removeTap(AudioTap *tap);
+
+signals:
+    void sourceChanged();
+    void nextSourceChanged();
+    void playingChanged();
+    void positionChanged();
+    void durationChanged();
+    void volumeChanged();
+    void crossfadeChanged();
+    void normalizationChanged();
+    void analysisThreadsChanged();
+    // 已衔接到 nextSource，且设备已播到衔接点
+    void trackAdvanced();
+    // 当前曲播完且没有预备下一首
+    void endOfMedia();
+    void errorOccurred(const QString &source, const QString &message);
+
+private:
+    struct Track;
+    class Stream;
+
+    void chooseFormat();
+    std::unique_ptr<Track> createTrack(const QString &source, qint64 startMs = 0);
+    void installTrack(std::unique_ptr<Track> track);
+    // 按当前归一化方式求曲目增益；已出声的曲目在音频线程中平滑过渡到新值
+    void updateGain(Track *track);
+    void onLoudnessReady(const QString &path);
+    // drain 为真时忽略缓冲上限，把解码端剩余数据全部取走
+    void refill(Track *track, bool drain = false);
+    void onDecoded(Track *track, const QString &error);
+    void prerollNext();
+    void startSink();
+    void resetOutput();
+    // 定时在 GUI 线程执行：补充解码、上报进度/衔接/结束；flush 为真时不等设备播到即上报
+    void service(bool flush = false);
+    void updateDuration();
+    void setPlaying(bool playing);
+    // decodeNow 为假时（stop）需要从头解码的曲目只停下解码器，等 play() 再启动
+    void moveTo(qint64 positionMs, bool decodeNow);
+    qint64 latencyFrames() const;
+    // 以下两个在音频线程调用
+    qint64 render(char *data, qint64 maxlen);
+    void mix(float *out, qint64 frames);
+    void applyGain(Track &track, float *samples, qint64 frames);
+
+    QMediaDevices *m_devices;
+    QAudioDevice m_device;
+    QAudioFormat m_format;
+    QAudioSink *m_sink = nullptr;
+    Stream *m_stream;
+    QTimer *m_serviceTimer;
+
+    QString m_source;
+    QString m_nextSource;
+    bool m_playing = false;
+    qreal m_volume = 1.0;
+    int m_crossfade = 0;
+    Normalization m_normalization = TrackGain;
+    qint64 m_duration = 0;
+    qint64 m_lastPosition = 0;
+    std::vector<float> m_decodeScratch;             // GUI 线程
+
+    mutable QMutex m_mutex;                         // 保护以下成员与 Track 中的缓冲字段
+    std::unique_ptr<Track> m_current;
+    std::unique_ptr<Track> m_next;
+    std::vector<std::unique_ptr<Track>> m_retired;  // 音频线程换下的曲目，回到 GUI 线程再释放
+    qint64 m_crossfadeFrames = 0;
+    qint64 m_switchFrame = -1;      // 衔接发生在输出的第几帧，设备播到该处才通知
+    qint64 m_endFrame = -1;
+    bool m_ended = false;
+    std::vector<float> m_mix;       // 音频线程暂存，随格式预分配，回调中不再分配
+    std::vector<float> m_fade;
+    std::vector<AudioTap *> m_taps;
+    std::atomic<qint64> m_framesWritten { 0 };
+};
+
+#endif // CORE_PLAYBACKENGINE_H
@@ -0,0 +1,251 @@
+// 实现文件：PlaylistModel —— 批量增删 + 路径索引 + 元数据回填
+#include "core/playlistmodel.h"
+#include "core/covercache.h"
+
+#include <QFileInfo>
+#include <QUrl>
+
+#include <algorithm>
+
+PlaylistModel::PlaylistModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int PlaylistModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_tracks.size());
+}
+
+QVariant PlaylistModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_tracks.size()) return QVariant();
+    const Track &track = m_tracks.at(index.row());
+    switch (role) {
+    case SourceRole: return track.source;
+    case Qt::DisplayRole:
+    case TitleRole: return track.title.isEmpty() ? track.fileName : track.title;
+    case ArtistRole: return track.artist;
+    case AlbumRole: return track.album;
+    case DurationRole: return track.durationMs;
+    case CoverRole: return track.cover;
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> PlaylistModel::roleNames() const
+{
+    return {
+        { SourceRole, "source" },
+        { TitleRole, "title" },
+        { ArtistRole, "artist" },
+        { AlbumRole, "album" },
+        { DurationRole, "duration" },
+        { CoverRole, "cover" }
+    };
+}
+
+void PlaylistModel::setLibrary(MusicLibrary *library)
+{
+    if (m_library == library) return;
+    if (m_library) disconnect(m_library, nullptr, this, nullptr);
+    m_library = library;
+    if (m_library) {
+        connect(m_library, &MusicLibrary::metadataReady, this, &PlaylistModel::onMetadataReady);
+        // 换绑后用新库的缓存补齐已有行
+        for (int row = 0; row < m_tracks.size(); ++row) {
+            Track &track = m_tracks[row];
+            if (track.hasMeta) continue;
+            applyMeta(track, m_library->getMetadata(track.source));
+        }
+        if (!m_tracks.isEmpty()) emit dataChanged(index(0), index(int(m_tracks.size()) - 1));
+    }
+    emit libraryChanged();
+}
+
+QVariantMap PlaylistModel::get(int row) const
+{
+    QVariantMap item;
+    if (row < 0 || row >= m_tracks.size()) return item;
+    const QModelIndex idx = index(row);
+    const QHash<int, QByteArray> roles = roleNames();
+    for (auto it = roles.cbegin(); it != roles.cend(); ++it) {
+        item.insert(QString::fromLatin1(it.value()), data(idx, it.key()));
+    }
+    return item;
+}
+
+QString PlaylistModel::sourceAt(int row) const
+{
+    return (row >= 0 && row < m_tracks.size()) ? m_tracks.at(row).source : QString();
+}
+
+int PlaylistModel::indexOf(const QString &source) const
+{
+    return m_rows.value(normalize(source), -1);
+}
+
+QStringList PlaylistModel::sources() const
+{
+    QStringList out;
+    out.reserve(m_tracks.size());
+    for (const Track &track : m_tracks) out.append(track.source);
+    return out;
+}
+
+void PlaylistModel::setSources(const QStringList &sources)
+{
+    // 整体替换走一次 reset，避免逐行信号
+    beginResetModel();
+    m_tracks.clear();
+    m_rows.clear();
+    m_tracks.reserve(sources.size());
+    for (const QString &s : sources) {
+        const QString source = normalize(s);
+        if (source.isEmpty() || m_rows.contains(source)) continue;
+        m_rows.insert(source, int(m_tracks.size()));
+        m_tracks.append(makeTrack(source));
+    }
+    endResetModel();
+    emit countChanged();
+}
+
+void PlaylistModel::appendSources(const QStringList &sources)
+{
+    QList<Track> added;
+    QHash<QString, int> addedRows;
+    const int first = int(m_tracks.size());
+    for (const QString &s : sources) {
+        const QString source = normalize(s);
+        if (source.isEmpty() || m_rows.contains(source) || addedRows.contains(source)) continue;
+        addedRows.insert(source, first + int(added.size()));
+        added.append(makeTrack(source));
+    }
+    if (added.isEmpty()) return;
+    beginInsertRows(QModelIndex(), first, first + int(added.size()) - 1);
+    m_tracks.append(added);
+    m_rows.insert(addedRows);
+    endInsertRows();
+    emit countChanged();
+}
+
+void PlaylistModel::remove(int row, int count)
+{
+    if (row < 0 || count <= 0 || row >= m_tracks.size()) return;
+    const int last = std::min(row + count, int(m_tracks.size())) - 1;
+    beginRemoveRows(QModelIndex(), row, last);
+    for (int i = row; i <= last; ++i) m_rows.remove(m_tracks.at(i).source);
+    m_tracks.remove(row, last - row + 1);
+    reindexFrom(row);
+    endRemoveRows();
+    emit countChanged();
+}
+
+bool PlaylistModel::removeSource(const QString &source)
+{
+    const int row = indexOf(source);
+    if (row < 0) return false;
+    remove(row);
+    return true;
+}
+
+void PlaylistModel::removeSources(const QStringList &sources)
+{
+    QList<int> rows;
+    for (const QString &s : sources) {
+        const int row = indexOf(s);
+        if (row >= 0) rows.append(row);
+    }
+    if (rows.isEmpty()) return;
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // 从后往前按连续区间删除，每个区间一次 beginRemoveRows，最后统一重建行号
+    int end = int(rows.size()) - 1;
+    while (end >= 0) {
+        int start = end;
+        while (start > 0 && rows.at(start - 1) == rows.at(start) - 1) --start;
+        const int first = rows.at(start);
+        const int last = rows.at(end);
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int i = first; i <= last; ++i) m_rows.remove(m_tracks.at(i).source);
+        m_tracks.remove(first, last - first + 1);
+        endRemoveRows();
+        end = start - 1;
+    }
+    reindexFrom(rows.first());
+    emit countChanged();
+}
+
+void PlaylistModel::clear()
+{
+    if (m_tracks.isEmpty()) return;
+    beginResetModel();
+    m_tracks.clear();
+    m_rows.clear();
+    endResetModel();
+    emit countChanged();
+}
+
+void PlaylistModel::setViewport(int first, int last)
+{
+    if (!m_library) return;
+    first = std::max(0, first);
+    last = std::min(last, int(m_tracks.size()) - 1);
+    const int span = std::max(0, last - first + 1);
+    QStringList visible;
+    QStringList nearby;
+    for (int row = std::max(0, first - span); row <= std::min(last + span, int(m_tracks.size()) - 1); ++row) {
+        const Track &track = m_tracks.at(row);
+        if (track.hasMeta) continue;
+        if (row >= first && row <= last) visible.append(track.source);
+        else nearby.append(track.source);
+    }
+    // 即使为空也要提交：上一次视口中的请求据此取消
+    m_library->prefetchViewport(visible, nearby);
+}
+
+void PlaylistModel::onMetadataReady(const QString &source, const QVariantMap &meta)
+{
+    const int row = m_rows.value(source, -1);
+    if (row < 0) return;
+    applyMeta(m_tracks[row], meta);
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx, { TitleRole, ArtistRole, AlbumRole, DurationRole, CoverRole, Qt::DisplayRole });
+}
+
+PlaylistModel::Track PlaylistModel::makeTrack(const QString &source) const
+{
+    Track track;
+    track.source = source;
+    track.fileName = QFileInfo(source).completeBaseName();
+    // 内存缓存或持久化索引中已有的元数据直接填入，无需等待预取
+    if (m_library) applyMeta(track, m_library->getMetadata(source));
+    return track;
+}
+
+void PlaylistModel::applyMeta(Track &track, const QVariantMap &meta)
+{
+    if (meta.isEmpty()) return;
+    track.title = meta.value("title").toString();
+    track.artist = meta.value("artist").toString();
+    track.album = meta.value("album").toString();
+    track.durationMs = meta.value("duration").toLongLong();
+    // 封面经 image://cover 提供器按内容哈希读取
+    track.cover = CoverCache::urlFor(meta.value("coverHash").toString());
+    track.hasMeta = true;
+}
+
+QString PlaylistModel::normalize(const QString &source)
+{
+    if (source.startsWith("file:")) {
+        const QUrl u(source);
+        if (u.isValid()) return u.toLocalFile();
+    }
+    return source;
+}
+
+void PlaylistModel::reindexFrom(int row)
+{
+    for (int i = row; i < m_tracks.size(); ++i) m_rows[m_tracks.at(i).source] = i;
+}
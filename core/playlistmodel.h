@@ -0,0 +1,91 @@
+// core/playlistmodel.h
+#ifndef CORE_PLAYLISTMODEL_H
+#define CORE_PLAYLISTMODEL_H
+
+// 播放列表模型：EMusicPlayer / EPlaylist / MusicWindow 共用同一实例
+// 批量插入一次 beginInsertRows，路径 -> 行号哈希 O(1) 定位，元数据由 MusicLibrary 直接回填
+#include <QAbstractListModel>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVariantMap>
+#include <QPointer>
+
+#include "core/music.h"
+
+class PlaylistModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(MusicLibrary *library READ library WRITE setLibrary NOTIFY libraryChanged)
+
+public:
+    enum Roles {
+        SourceRole = Qt::UserRole + 1,
+        TitleRole,
+        ArtistRole,
+        AlbumRole,
+        DurationRole,
+        CoverRole
+    };
+    Q_ENUM(Roles)
+
+    explicit PlaylistModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return int(m_tracks.size()); }
+    MusicLibrary *library() const { return m_library; }
+    void setLibrary(MusicLibrary *library);
+
+    // 与 ListModel.get 兼容：返回 { source, title, artist, album, duration, cover }
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE QString sourceAt(int row) const;
+    Q_INVOKABLE int indexOf(const QString &source) const;
+    Q_INVOKABLE bool contains(const QString &source) const { return indexOf(source) >= 0; }
+    Q_INVOKABLE QStringList sources() const;
+
+    // 批量操作：已存在的路径自动跳过
+    Q_INVOKABLE void setSources(const QStringList &sources);
+    Q_INVOKABLE void appendSources(const QStringList &sources);
+    Q_INVOKABLE void remove(int row, int count = 1);
+    Q_INVOKABLE bool removeSource(const QString &source);
+    Q_INVOKABLE void removeSources(const QStringList &sources);
+    Q_INVOKABLE void clear();
+    // 可见行为 [first, last]：其中尚无元数据的条目优先读取，上下各一屏作为附近行；
+    // 滚出范围的请求被取消。列表为空时传 first > last 撤销视口
+    Q_INVOKABLE void setViewport(int first, int last);
+
+signals:
+    void countChanged();
+    void libraryChanged();
+
+private slots:
+    void onMetadataReady(const QString &source, const QVariantMap &meta);
+
+private:
+    struct Track
+    {
+        QString source;
+        QString fileName;   // 无标题时的显示名
+        QString title;
+        QString artist;
+        QString album;
+        qint64 durationMs = 0;
+        QString cover;
+        bool hasMeta = false;
+    };
+
+    Track makeTrack(const QString &source) const;
+    static void applyMeta(Track &track, const QVariantMap &meta);
+    static QString normalize(const QString &source);
+    void reindexFrom(int row);
+
+    QList<Track> m_tracks;
+    QHash<QString, int> m_rows;     // 路径 -> 行号
+    QPointer<MusicLibrary> m_library;
+};
+
+#endif // CORE_PLAYLISTMODEL_H
@@ -0,0 +1,41 @@
+// 实现文件：QmlTypes —— AudioMetadata、MusicLibrary 与 EvolveUI.Core 模块的类型注册
+#include "core/qmltypes.h"
+#include "core/music.h"
+#include "core/musicsearch.h"
+#include "core/playlistmodel.h"
+#include "core/coverpalette.h"
+#include "core/lyricsdocument.h"
+#include "core/waveformitem.h"
+#include "core/chartitem.h"
+#include "core/chartseries.h"
+#include "core/datatablemodel.h"
+#include "core/blurbackdrop.h"
+#include "core/networkresource.h"
+#include "core/playbackengine.h"
+#include "core/spectrumitem.h"
+#include "core/trace.h"
+
+#include <QtQml>
+
+void QmlTypes::registerAll()
+{
+    qmlRegisterType<AudioMetadata>("AudioMetadata", 1, 0, "AudioMetadata");
+    qmlRegisterType<MusicLibrary>("MusicLibrary", 1, 0, "MusicLibrary");
+    qmlRegisterType<MusicSearch>("MusicLibrary", 1, 0, "MusicSearch");
+    qmlRegisterType<PlaylistModel>("MusicLibrary", 1, 0, "PlaylistModel");
+    qmlRegisterType<CoverPalette>("MusicLibrary", 1, 0, "CoverPalette");
+    qmlRegisterType<LyricsDocument>("MusicLibrary", 1, 0, "LyricsDocument");
+    qmlRegisterType<WaveformItem>("MusicLibrary", 1, 0, "WaveformItem");
+    qmlRegisterType<PlaybackEngine>("MusicLibrary", 1, 0, "PlaybackEngine");
+    qmlRegisterType<SpectrumItem>("MusicLibrary", 1, 0, "SpectrumItem");
+
+    // 通用的图表、表格、毛玻璃、网络与追踪类型，组件不必依赖音乐模块的名字
+    qmlRegisterType<ChartItem>("EvolveUI.Core", 1, 0, "ChartItem");
+    qmlRegisterType<ChartSeries>("EvolveUI.Core", 1, 0, "ChartSeries");
+    qmlRegisterType<DataTableModel>("EvolveUI.Core", 1, 0, "DataTableModel");
+    qmlRegisterType<BlurBackdrop>("EvolveUI.Core", 1, 0, "BlurBackdrop");
+    qmlRegisterType<NetworkResource>("EvolveUI.Core", 1, 0, "NetworkResource");
+    qmlRegisterSingletonType<TraceObject>("EvolveUI.Core", 1, 0, "Trace", [](QQmlEngine *, QJSEngine *) -> QObject * {
+        return new TraceObject;
+    });
+}
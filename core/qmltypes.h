@@ -0,0 +1,13 @@
+// core/qmltypes.h
+#ifndef CORE_QMLTYPES_H
+#define CORE_QMLTYPES_H
+
+// C++ 类型到 QML 的注册表：应用与渲染基准共用同一份，组件在两处看到的类型完全一致
+class QmlTypes
+{
+public:
+    // 须在加载任何 QML 之前调用一次
+    static void registerAll();
+};
+
+#endif // CORE_QMLTYPES_H
@@ -0,0 +1,205 @@
+// 实现文件：SpectrumAnalyzer —— 单声道化输入、加窗 FFT 与对数频带合并
+#include "core/spectrumanalyzer.h"
+
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+const float kLowHz = 40.0f;
+const float kHighHz = 16000.0f;
+const float kFloorDb = -72.0f;        // 映射为 0 的电平
+const int kMaxCallbackFrames = 192000;
+
+} // namespace
+
+const int SpectrumFrame::MAX_BANDS;
+const int SpectrumAnalyzer::FFT_SIZE;
+const int SpectrumAnalyzer::HOP;
+
+SpectrumAnalyzer::SpectrumAnalyzer(int bandCount)
+    : m_bandCount(std::clamp(bandCount, 1, int(SpectrumFrame::MAX_BANDS)))
+    , m_input(size_t(FFT_SIZE) * 8)
+    , m_output(8)
+    , m_mono(size_t(kMaxCallbackFrames))
+    , m_history(size_t(FFT_SIZE), 0.0f)
+{
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->start();
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    m_stopping = true;
+    m_wake.release();
+    m_thread->wait();
+    delete m_thread;
+}
+
+void SpectrumAnalyzer::process(const float *samples, qint64 frames, int channels, int sampleRate)
+{
+    m_sampleRate.store(sampleRate, std::memory_order_relaxed);
+    const float scale = 1.0f / float(channels);
+    while (frames > 0) {
+        const qint64 n = std::min<qint64>(frames, qint64(m_mono.size()));
+        float *mono = m_mono.data();
+        for (qint64 f = 0; f < n; ++f) {
+            float sum = 0.0f;
+            for (int c = 0; c < channels; ++c) sum += samples[f * channels + c];
+            mono[f] = sum * scale;
+        }
+        m_input.push(mono, size_t(n));
+        samples += n * channels;
+        frames -= n;
+    }
+    // 每次回调至多唤醒一次；分析线程醒来后处理全部积压
+    if (m_input.readAvailable() >= size_t(HOP)) m_wake.release();
+}
+
+void SpectrumAnalyzer::setBandCount(int count)
+{
+    m_bandCount.store(std::clamp(count, 1, int(SpectrumFrame::MAX_BANDS)));
+}
+
+bool SpectrumAnalyzer::takeLatest(SpectrumFrame &frame)
+{
+    bool got = false;
+    while (m_output.pop(frame)) got = true;
+    return got;
+}
+
+void SpectrumAnalyzer::run()
+{
+    const size_t fftSize = size_t(FFT_SIZE);
+    const size_t hop = size_t(HOP);
+    for (;;) {
+        m_wake.acquire();
+        // 合并积攒的唤醒
+        m_wake.tryAcquire(m_wake.available());
+        if (m_stopping.load()) break;
+        const int rate = m_sampleRate.load(std::memory_order_relaxed);
+        const int bands = m_bandCount.load(std::memory_order_relaxed);
+        if (rate > 0 && (rate != m_rate || bands != m_bands)) configure(rate, bands);
+
+        // 积压过多（线程被抢占等）时跳到最新数据，保持显示延迟在一个窗口以内
+        const size_t backlog = m_input.readAvailable();
+        if (backlog > fftSize * 2) m_input.skip(backlog - fftSize);
+
+        while (m_rate > 0 && m_input.readAvailable() >= hop) {
+            std::memmove(m_history.data(), m_history.data() + hop, (fftSize - hop) * sizeof(float));
+            m_input.pop(m_history.data() + (fftSize - hop), hop);
+            analyze(m_frame);
+            m_output.push(m_frame);
+        }
+    }
+}
+
+void SpectrumAnalyzer::configure(int sampleRate, int bandCount)
+{
+    m_rate = sampleRate;
+    m_bands = bandCount;
+    const int n = FFT_SIZE;
+
+    m_window.resize(size_t(n));
+    double windowSum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        m_window[size_t(i)] = float(0.5 - 0.5 * std::cos(2.0 * kPi * i / (n - 1)));
+        windowSum += m_window[size_t(i)];
+    }
+    // 满幅正弦在峰值频点的幅度为 sum(w)/2，据此归一化到 0 dB
+    m_powerScale = float(4.0 / (windowSum * windowSum));
+
+    int bits = 0;
+    while ((1 << bits) < n) ++bits;
+    m_bitReverse.resize(size_t(n));
+    for (int i = 0; i < n; ++i) {
+        int r = 0;
+        for (int b = 0; b < bits; ++b) r |= ((i >> b) & 1) << (bits - 1 - b);
+        m_bitReverse[size_t(i)] = r;
+    }
+    m_twiddleRe.clear();
+    m_twiddleIm.clear();
+    for (int half = 1; half < n; half *= 2) {
+        for (int j = 0; j < half; ++j) {
+            const double angle = -kPi * j / half;
+            m_twiddleRe.push_back(float(std::cos(angle)));
+            m_twiddleIm.push_back(float(std::sin(angle)));
+        }
+    }
+    m_re.assign(size_t(n), 0.0f);
+    m_im.assign(size_t(n), 0.0f);
+    m_power.assign(size_t(n / 2 + 1), 0.0f);
+
+    // 频带按对数均分 40 Hz ~ min(16 kHz, 奈奎斯特)；低频带不足一个频点时至少取一个
+    const float high = std::min(kHighHz, sampleRate / 2.0f);
+    const float binHz = float(sampleRate) / n;
+    m_bandStart.resize(size_t(bandCount));
+    m_bandEnd.resize(size_t(bandCount));
+    for (int b = 0; b < bandCount; ++b) {
+        const float f0 = kLowHz * std::pow(high / kLowHz, float(b) / bandCount);
+        const float f1 = kLowHz * std::pow(high / kLowHz, float(b + 1) / bandCount);
+        const int k0 = std::clamp(int(std::floor(f0 / binHz)), 1, n / 2);
+        const int k1 = std::clamp(int(std::ceil(f1 / binHz)), k0 + 1, n / 2 + 1);
+        m_bandStart[size_t(b)] = k0;
+        m_bandEnd[size_t(b)] = k1;
+    }
+}
+
+void SpectrumAnalyzer::fft()
+{
+    const int n = FFT_SIZE;
+    float *re = m_re.data();
+    float *im = m_im.data();
+    size_t offset = 0;
+    for (int half = 1; half < n; half *= 2) {
+        const float *wr = m_twiddleRe.data() + offset;
+        const float *wi = m_twiddleIm.data() + offset;
+        for (int start = 0; start < n; start += 2 * half) {
+            float *ar = re + start;
+            float *ai = im + start;
+            float *br = ar + half;
+            float *bi = ai + half;
+            // 实部/虚部分开存放（SoA），无分支，编译器可映射为 SIMD 乘加
+            for (int j = 0; j < half; ++j) {
+                const float tr = br[j] * wr[j] - bi[j] * wi[j];
+                const float ti = br[j] * wi[j] + bi[j] * wr[j];
+                br[j] = ar[j] - tr;
+                bi[j] = ai[j] - ti;
+                ar[j] += tr;
+                ai[j] += ti;
+            }
+        }
+        offset += size_t(half);
+    }
+}
+
+void SpectrumAnalyzer::analyze(SpectrumFrame &frame)
+{
+    const int n = FFT_SIZE;
+    const float *history = m_history.data();
+    const float *window = m_window.data();
+    for (int i = 0; i < n; ++i) {
+        const int r = m_bitReverse[size_t(i)];
+        m_re[size_t(r)] = history[i] * window[i];
+        m_im[size_t(r)] = 0.0f;
+    }
+    fft();
+
+    const int bins = n / 2 + 1;
+    const float *re = m_re.data();
+    const float *im = m_im.data();
+    float *power = m_power.data();
+    for (int k = 0; k < bins; ++k) power[k] = re[k] * re[k] + im[k] * im[k];
+
+    frame.count = m_bands;
+    for (int b = 0; b < m_bands; ++b) {
+        float peak = 0.0f;
+        for (int k = m_bandStart[size_t(b)]; k < m_bandEnd[size_t(b)]; ++k) peak = std::max(peak, power[k]);
+        const float db = 10.0f * std::log10(peak * m_powerScale + 1e-12f);
+        frame.bands[size_t(b)] = std::clamp((db - kFloorDb) / -kFloorDb, 0.0f, 1.0f);
+    }
+}
@@ -0,0 +1,76 @@
+// core/spectrumanalyzer.h
+#ifndef CORE_SPECTRUMANALYZER_H
+#define CORE_SPECTRUMANALYZER_H
+
+// 实时频谱分析：作为 PlaybackEngine 的输出监听接收混音 PCM，单声道化后经无锁队列交给分析线程
+// 分析线程做 Hann 窗 2048 点 FFT（步长 512，48 kHz 下约 94 次/秒），按对数间隔合并为频带
+// 结果再经无锁队列交给渲染线程；所有缓冲在配置时分配，预热后每帧不再分配内存
+// 分析线程阻塞在信号量上，由音频线程攒够一个步长后唤醒；从引擎摘下后不再被唤醒，不占 CPU
+#include <QSemaphore>
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "core/playbackengine.h"
+#include "core/spscring.h"
+
+class QThread;
+
+struct SpectrumFrame
+{
+    static const int MAX_BANDS = 64;
+    std::array<float, MAX_BANDS> bands {};   // 0~1，按 dB 线性映射
+    int count = 0;
+};
+
+class SpectrumAnalyzer : public AudioTap
+{
+public:
+    explicit SpectrumAnalyzer(int bandCount = 32);
+    ~SpectrumAnalyzer() override;
+
+    // 音频线程：单声道化后写入输入队列，队列满时丢弃
+    void process(const float *samples, qint64 frames, int channels, int sampleRate) override;
+    // 任意线程：下一次分析起生效
+    void setBandCount(int count);
+    // 唯一消费者（渲染线程）：取出最新一帧，没有新结果时返回 false
+    bool takeLatest(SpectrumFrame &frame);
+
+    static const int FFT_SIZE = 2048;
+    static const int HOP = 512;
+
+private:
+    void run();
+    void configure(int sampleRate, int bandCount);
+    void analyze(SpectrumFrame &frame);
+    void fft();
+
+    QThread *m_thread;
+    std::atomic_bool m_stopping { false };
+    QSemaphore m_wake;
+    std::atomic_int m_sampleRate { 0 };
+    std::atomic_int m_bandCount;
+    SpscRing<float> m_input;
+    SpscRing<SpectrumFrame> m_output;
+    std::vector<float> m_mono;              // 音频线程暂存
+
+    // 以下仅分析线程访问
+    int m_rate = 0;
+    int m_bands = 0;
+    SpectrumFrame m_frame;
+    std::vector<float> m_history;           // 最近 FFT_SIZE 个样本
+    std::vector<float> m_window;
+    std::vector<float> m_re;
+    std::vector<float> m_im;
+    std::vector<float> m_twiddleRe;         // 按级连续存放，蝶形内层循环为单位步长，可直接向量化
+    std::vector<float> m_twiddleIm;
+    std::vector<int> m_bitReverse;
+    std::vector<float> m_power;
+    std::vector<int> m_bandStart;
+    std::vector<int> m_bandEnd;
+    float m_powerScale = 1.0f;
+};
+
+#endif // CORE_SPECTRUMANALYZER_H
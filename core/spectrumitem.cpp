@@ -0,0 +1,169 @@
+// 实现文件：SpectrumItem —— 频带平滑与单节点竖条绘制
+#include "core/spectrumitem.h"
+
+#include <QQuickWindow>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+
+#include <algorithm>
+
+namespace {
+
+const float kAttackPerSecond = 30.0f;   // 上升：指数逼近，约 1/30 秒到位
+const float kFallPerSecond = 1.6f;      // 回落：线性，满高约 0.6 秒落完
+const float kSettledLevel = 0.002f;
+
+} // namespace
+
+SpectrumItem::SpectrumItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_analyzer(std::make_unique<SpectrumAnalyzer>(32))
+{
+    setFlag(ItemHasContents, true);
+}
+
+SpectrumItem::~SpectrumItem()
+{
+    // 先从引擎摘下监听，再释放分析器
+    if (m_attached && m_engine) m_engine->removeTap(m_analyzer.get());
+}
+
+void SpectrumItem::setEngine(PlaybackEngine *engine)
+{
+    if (m_engine == engine) return;
+    if (m_attached && m_engine) m_engine->removeTap(m_analyzer.get());
+    m_attached = false;
+    disconnect(m_playingConnection);
+    m_engine = engine;
+    if (m_engine) {
+        m_playingConnection = connect(m_engine, &PlaybackEngine::playingChanged, this, [this]() { update(); });
+    }
+    updateAttachment();
+    emit engineChanged();
+    update();
+}
+
+void SpectrumItem::setBandCount(int count)
+{
+    count = std::clamp(count, 1, int(SpectrumFrame::MAX_BANDS));
+    if (m_bandCount == count) return;
+    m_bandCount = count;
+    m_analyzer->setBandCount(count);
+    emit bandCountChanged();
+    update();
+}
+
+void SpectrumItem::setColor(const QColor &color)
+{
+    if (m_color == color) return;
+    m_color = color;
+    emit colorChanged();
+    update();
+}
+
+void SpectrumItem::setSpacing(qreal spacing)
+{
+    spacing = std::max<qreal>(0.0, spacing);
+    if (qFuzzyCompare(m_spacing, spacing)) return;
+    m_spacing = spacing;
+    emit spacingChanged();
+    update();
+}
+
+void SpectrumItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    QQuickItem::itemChange(change, value);
+    if (change == ItemSceneChange) {
+        disconnect(m_frameConnection);
+        if (value.window) {
+            m_frameConnection = connect(value.window, &QQuickWindow::afterAnimating, this, &SpectrumItem::onAfterAnimating);
+        }
+    }
+    if (change == ItemSceneChange || change == ItemVisibleHasChanged) updateAttachment();
+}
+
+void SpectrumItem::updateAttachment()
+{
+    const bool want = m_engine && window() && isVisible();
+    if (want == m_attached) return;
+    if (want) {
+        m_engine->addTap(m_analyzer.get());
+    } else if (m_engine) {
+        m_engine->removeTap(m_analyzer.get());
+    }
+    m_attached = want;
+    update();
+}
+
+void SpectrumItem::onAfterAnimating()
+{
+    // 每帧动画阶段后请求下一帧，形成随刷新率的更新循环；静止后自然停止
+    if (m_attached && ((m_engine && m_engine->isPlaying()) || !m_settled.load())) update();
+}
+
+QSGNode *SpectrumItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!m_attached || width() <= 0 || height() <= 0) {
+        m_levels.clear();
+        m_settled = true;
+        delete node;
+        return nullptr;
+    }
+
+    const float dt = m_clock.isValid() ? std::min(0.1f, m_clock.restart() / 1000.0f) : 0.0f;
+    if (!m_clock.isValid()) m_clock.start();
+    m_analyzer->takeLatest(m_frame);
+    const bool playing = m_engine && m_engine->isPlaying();
+    const int bands = m_bandCount;
+    m_levels.resize(size_t(bands), 0.0f);
+
+    bool settled = true;
+    for (int b = 0; b < bands; ++b) {
+        const float target = playing && b < m_frame.count ? m_frame.bands[size_t(b)] : 0.0f;
+        float &level = m_levels[size_t(b)];
+        if (target > level) {
+            level += (target - level) * std::min(1.0f, dt * kAttackPerSecond);
+        } else {
+            level = std::max(target, level - kFallPerSecond * dt);
+        }
+        if (level > kSettledLevel) settled = false;
+    }
+    m_settled = settled && !playing;
+
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGFlatColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+    auto *material = static_cast<QSGFlatColorMaterial *>(node->material());
+    if (material->color() != m_color) {
+        material->setColor(m_color);
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+
+    QSGGeometry *geometry = node->geometry();
+    if (geometry->vertexCount() != bands * 6) geometry->allocate(bands * 6);
+    QSGGeometry::Point2D *v = geometry->vertexDataAsPoint2D();
+    const float h = float(height());
+    const float gap = float(m_spacing);
+    const float bw = std::max(1.0f, (float(width()) - gap * (bands - 1)) / bands);
+    for (int b = 0; b < bands; ++b) {
+        const float x0 = b * (bw + gap);
+        const float x1 = x0 + bw;
+        const float y0 = h - m_levels[size_t(b)] * h;
+        v[0].set(x0, y0);
+        v[1].set(x1, y0);
+        v[2].set(x0, h);
+        v[3].set(x1, y0);
+        v[4].set(x1, h);
+        v[5].set(x0, h);
+        v += 6;
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
@@ -0,0 +1,71 @@
+// core/spectrumitem.h
+#ifndef CORE_SPECTRUMITEM_H
+#define CORE_SPECTRUMITEM_H
+
+// 频谱条：从 SpectrumAnalyzer 取最新频带，快升慢落平滑后画成一排竖条（单个几何节点）
+// 播放中或竖条尚未落回时每帧请求重绘，即随显示刷新率更新；停止且落回后不再占用渲染
+// 仅在可见时挂接到播放引擎，隐藏时音频线程不做任何额外工作
+#include <QQuickItem>
+#include <QColor>
+#include <QElapsedTimer>
+#include <QPointer>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "core/playbackengine.h"
+#include "core/spectrumanalyzer.h"
+
+class SpectrumItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(PlaybackEngine *engine READ engine WRITE setEngine NOTIFY engineChanged)
+    Q_PROPERTY(int bandCount READ bandCount WRITE setBandCount NOTIFY bandCountChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(qreal spacing READ spacing WRITE setSpacing NOTIFY spacingChanged)
+
+public:
+    explicit SpectrumItem(QQuickItem *parent = nullptr);
+    ~SpectrumItem() override;
+
+    PlaybackEngine *engine() const { return m_engine; }
+    void setEngine(PlaybackEngine *engine);
+    int bandCount() const { return m_bandCount; }
+    void setBandCount(int count);
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color);
+    qreal spacing() const { return m_spacing; }
+    void setSpacing(qreal spacing);
+
+signals:
+    void engineChanged();
+    void bandCountChanged();
+    void colorChanged();
+    void spacingChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private:
+    void updateAttachment();
+    void onAfterAnimating();
+
+    QPointer<PlaybackEngine> m_engine;
+    std::unique_ptr<SpectrumAnalyzer> m_analyzer;
+    bool m_attached = false;
+    QMetaObject::Connection m_frameConnection;
+    QMetaObject::Connection m_playingConnection;
+    int m_bandCount = 32;
+    QColor m_color = QColor(255, 255, 255, 90);
+    qreal m_spacing = 2.0;
+
+    // 以下仅在渲染线程（同步阶段）访问
+    SpectrumFrame m_frame;
+    std::vector<float> m_levels;        // 平滑后的显示高度 0~1
+    QElapsedTimer m_clock;
+    std::atomic_bool m_settled { true };
+};
+
+#endif // CORE_SPECTRUMITEM_H
@@ -0,0 +1,82 @@
+// core/spscring.h
+#ifndef CORE_SPSCRING_H
+#define CORE_SPSCRING_H
+
+// 单生产者/单消费者无锁环形队列：容量取 2 的幂，读写两端各持一个原子计数，互不加锁、不分配
+// 用于音频线程 -> 分析线程、分析线程 -> 渲染线程这类实时路径
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+    {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        m_data.resize(cap);
+        m_mask = cap - 1;
+    }
+
+    size_t capacity() const { return m_data.size(); }
+
+    // ---- 生产者端 ----
+    size_t writeAvailable() const
+    {
+        return m_data.size() - (m_write.load(std::memory_order_relaxed) - m_read.load(std::memory_order_acquire));
+    }
+
+    // 空间不足时只写入能容纳的部分，返回写入个数
+    size_t push(const T *src, size_t n)
+    {
+        const size_t w = m_write.load(std::memory_order_relaxed);
+        n = std::min(n, m_data.size() - (w - m_read.load(std::memory_order_acquire)));
+        const size_t at = w & m_mask;
+        const size_t first = std::min(n, m_data.size() - at);
+        std::copy(src, src + first, m_data.begin() + at);
+        std::copy(src + first, src + n, m_data.begin());
+        m_write.store(w + n, std::memory_order_release);
+        return n;
+    }
+
+    bool push(const T &value) { return push(&value, 1) == 1; }
+
+    // ---- 消费者端 ----
+    size_t readAvailable() const
+    {
+        return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_relaxed);
+    }
+
+    size_t pop(T *dst, size_t n)
+    {
+        const size_t r = m_read.load(std::memory_order_relaxed);
+        n = std::min(n, m_write.load(std::memory_order_acquire) - r);
+        const size_t at = r & m_mask;
+        const size_t first = std::min(n, m_data.size() - at);
+        std::copy(m_data.begin() + at, m_data.begin() + at + first, dst);
+        std::copy(m_data.begin(), m_data.begin() + (n - first), dst + first);
+        m_read.store(r + n, std::memory_order_release);
+        return n;
+    }
+
+    bool pop(T &out) { return pop(&out, 1) == 1; }
+
+    void skip(size_t n)
+    {
+        const size_t r = m_read.load(std::memory_order_relaxed);
+        n = std::min(n, m_write.load(std::memory_order_acquire) - r);
+        m_read.store(r + n, std::memory_order_release);
+    }
+
+private:
+    std::vector<T> m_data;
+    size_t m_mask = 0;
+    // 分处不同缓存行，避免两端互相使对方的缓存失效
+    alignas(64) std::atomic<size_t> m_write { 0 };
+    alignas(64) std::atomic<size_t> m_read { 0 };
+};
+
+#endif // CORE_SPSCRING_H
@@ -0,0 +1,840 @@
+// 实现文件：TagReader —— 只读取文件头/尾的标签区与流头，按需 seek 跳过封面等大块数据
+#include "core/tagreader.h"
+
+#include <QFile>
+#include <QBuffer>
+#include <QStringDecoder>
+#include <QStringList>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+const qint64 kMaxBlockBytes = 16 * 1024 * 1024;  // 单个帧/块读取上限，防御损坏文件
+const qint64 kMpegProbeBytes = 64 * 1024;        // MPEG/ADTS 首帧探测范围
+const qint64 kOggHeadBytes = 64 * 1024;          // Ogg 头部读取量（含注释包）
+const qint64 kOggCoverHeadBytes = 2 * 1024 * 1024;
+const qint64 kOggTailBytes = 64 * 1024;          // Ogg 尾部读取量（取最后一页 granule）
+
+inline quint32 be24(const char *p)
+{
+    const uchar *u = reinterpret_cast<const uchar *>(p);
+    return (quint32(u[0]) << 16) | (quint32(u[1]) << 8) | quint32(u[2]);
+}
+inline quint32 be32(const char *p) { return qFromBigEndian<quint32>(p); }
+inline quint64 be64(const char *p) { return qFromBigEndian<quint64>(p); }
+inline quint16 le16(const char *p) { return qFromLittleEndian<quint16>(p); }
+inline quint32 le32(const char *p) { return qFromLittleEndian<quint32>(p); }
+inline quint64 le64(const char *p) { return qFromLittleEndian<quint64>(p); }
+inline quint32 syncsafe32(const char *p)
+{
+    const uchar *u = reinterpret_cast<const uchar *>(p);
+    return (quint32(u[0] & 0x7f) << 21) | (quint32(u[1] & 0x7f) << 14)
+         | (quint32(u[2] & 0x7f) << 7) | quint32(u[3] & 0x7f);
+}
+
+// 读取 [pos, pos+len)，越界或超过上限返回空
+QByteArray readAt(QIODevice *dev, qint64 pos, qint64 len)
+{
+    if (len <= 0 || len > kMaxBlockBytes || !dev->seek(pos)) return QByteArray();
+    QByteArray data = dev->read(len);
+    return data.size() == len ? data : QByteArray();
+}
+
+// 非 Unicode 的旧式文本：合法 UTF-8 优先，否则按系统代码页（中文 Windows 下即 GBK）
+QString decodeLegacy(const QByteArray &bytes)
+{
+    QStringDecoder utf8(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+    const QString text = utf8.decode(bytes);
+    if (!utf8.hasError()) return text;
+#ifdef Q_OS_WIN
+    return QString::fromLocal8Bit(bytes);
+#else
+    return QString::fromLatin1(bytes);
+#endif
+}
+
+QString decodeUtf16(const char *p, qsizetype n, bool bigEndian)
+{
+    QStringDecoder dec(bigEndian ? QStringDecoder::Utf16BE : QStringDecoder::Utf16LE);
+    return dec.decode(QByteArrayView(p, n & ~qsizetype(1)));
+}
+
+// 多值以 \0 分隔（ID3v2.4），去掉 BOM 与空白后以 "/" 连接
+QString cleanValue(const QString &raw)
+{
+    QStringList parts = raw.split(QChar(u'\0'), Qt::SkipEmptyParts);
+    QStringList out;
+    for (QString part : parts) {
+        part.remove(QChar(0xFEFF));
+        part = part.trimmed();
+        if (!part.isEmpty()) out.append(part);
+    }
+    return out.join(QStringLiteral("/"));
+}
+
+void appendValue(QString &field, const QString &value)
+{
+    if (value.isEmpty()) return;
+    if (field.isEmpty()) field = value;
+    else if (!field.split(QLatin1Char('/')).contains(value)) field += QLatin1Char('/') + value;
+}
+
+// ReplayGain 键（不区分大小写）：值形如 "-6.54 dB"，峰值为线性值；其他键忽略
+void replayGainValue(const QString &key, const QString &value, TagInfo &info)
+{
+    const QString k = key.toUpper();
+    if (!k.startsWith(QLatin1String("REPLAYGAIN_")) && !k.startsWith(QLatin1String("R128_"))) return;
+    QString text = value.trimmed();
+    if (text.endsWith(QLatin1String("dB"), Qt::CaseInsensitive)) text.chop(2);
+    bool ok = false;
+    const double number = text.trimmed().toDouble(&ok);
+    if (!ok || !qIsFinite(number)) return;
+    if (k == QLatin1String("REPLAYGAIN_TRACK_GAIN")) info.trackGain = number;
+    else if (k == QLatin1String("REPLAYGAIN_TRACK_PEAK")) info.trackPeak = number;
+    else if (k == QLatin1String("REPLAYGAIN_ALBUM_GAIN")) info.albumGain = number;
+    else if (k == QLatin1String("REPLAYGAIN_ALBUM_PEAK")) info.albumPeak = number;
+    // Opus：Q7.8 定点，参考 -23 LUFS；只在没有 ReplayGain 标签时采用
+    else if (k == QLatin1String("R128_TRACK_GAIN") && qIsNaN(info.trackGain)) info.trackGain = number / 256.0 + 5.0;
+    else if (k == QLatin1String("R128_ALBUM_GAIN") && qIsNaN(info.albumGain)) info.albumGain = number / 256.0 + 5.0;
+}
+
+// ---------------------- ID3v2 ----------------------
+QByteArray removeUnsync(const QByteArray &in)
+{
+    QByteArray out;
+    out.reserve(in.size());
+    for (qsizetype i = 0; i < in.size(); ++i) {
+        out.append(in.at(i));
+        if (uchar(in.at(i)) == 0xFF && i + 1 < in.size() && in.at(i + 1) == 0) ++i;
+    }
+    return out;
+}
+
+QString id3Text(const QByteArray &body)
+{
+    if (body.isEmpty()) return QString();
+    const int enc = uchar(body.at(0));
+    const char *p = body.constData() + 1;
+    qsizetype n = body.size() - 1;
+    QString text;
+    switch (enc) {
+    case 1: {
+        bool bigEndian = false;
+        if (n >= 2) {
+            const uchar a = uchar(p[0]), b = uchar(p[1]);
+            if (a == 0xFE && b == 0xFF) { bigEndian = true; p += 2; n -= 2; }
+            else if (a == 0xFF && b == 0xFE) { p += 2; n -= 2; }
+        }
+        text = decodeUtf16(p, n, bigEndian);
+        break;
+    }
+    case 2:
+        text = decodeUtf16(p, n, true);
+        break;
+    case 3:
+        text = QString::fromUtf8(p, n);
+        break;
+    default:
+        text = decodeLegacy(QByteArray(p, n));
+        break;
+    }
+    return cleanValue(text);
+}
+
+// 跳过按编码结尾的描述字符串，返回其后偏移；失败返回 -1
+qsizetype skipEncodedString(const QByteArray &body, qsizetype pos, int enc)
+{
+    if (enc == 1 || enc == 2) {
+        for (qsizetype i = pos; i + 1 < body.size(); i += 2) {
+            if (body.at(i) == 0 && body.at(i + 1) == 0) return i + 2;
+        }
+        return -1;
+    }
+    const qsizetype end = body.indexOf('\0', pos);
+    return end < 0 ? -1 : end + 1;
+}
+
+// APIC(v2.3/2.4) 与 PIC(v2.2)：优先保留封面类型 3（Front Cover）
+void id3Picture(const QByteArray &body, bool v22, TagInfo &info, bool *isFront)
+{
+    if (body.size() < 4) return;
+    const int enc = uchar(body.at(0));
+    qsizetype pos = 1;
+    QString mime;
+    if (v22) {
+        const QByteArray fmt = body.mid(1, 3).toUpper();
+        mime = fmt == "PNG" ? QStringLiteral("image/png") : QStringLiteral("image/jpeg");
+        pos = 4;
+    } else {
+        const qsizetype end = body.indexOf('\0', pos);
+        if (end < 0) return;
+        mime = QString::fromLatin1(body.constData() + pos, end - pos);
+        pos = end + 1;
+    }
+    if (pos >= body.size()) return;
+    const bool front = uchar(body.at(pos)) == 3;
+    pos = skipEncodedString(body, pos + 1, enc);
+    if (pos < 0 || pos >= body.size()) return;
+    if (!info.coverData.isEmpty() && (*isFront || !front)) return;
+    info.coverData = body.mid(pos);
+    info.coverMime = mime;
+    *isFront = front;
+}
+
+// 在 dev 的 start 处解析 ID3v2；返回标签结束位置（无标签返回 start）
+qint64 parseId3v2(QIODevice *dev, qint64 start, TagInfo &info, bool readCover)
+{
+    const QByteArray header = readAt(dev, start, 10);
+    if (header.size() != 10 || !header.startsWith("ID3")) return start;
+    const int major = uchar(header.at(3));
+    const int flags = uchar(header.at(5));
+    const qint64 size = syncsafe32(header.constData() + 6);
+    const qint64 tagEnd = start + 10 + size + ((flags & 0x10) ? 10 : 0);
+    if (major < 2 || major > 4) return tagEnd;
+
+    // v2.2/2.3 的全局反同步：整体读入并还原后再遍历
+    QIODevice *src = dev;
+    QBuffer unsynced;
+    qint64 pos = start + 10;
+    qint64 end = start + 10 + size;
+    if ((flags & 0x80) && major < 4) {
+        unsynced.setData(removeUnsync(readAt(dev, pos, size)));
+        unsynced.open(QIODevice::ReadOnly);
+        src = &unsynced;
+        pos = 0;
+        end = unsynced.size();
+    }
+
+    if ((flags & 0x40) && major >= 3) {
+        const QByteArray ext = readAt(src, pos, 4);
+        if (ext.size() != 4) return tagEnd;
+        pos += major == 4 ? qint64(syncsafe32(ext.constData())) : qint64(be32(ext.constData())) + 4;
+    }
+
+    const bool v22 = major == 2;
+    const int frameHeader = v22 ? 6 : 10;
+    bool coverIsFront = false;
+    while (pos + frameHeader <= end) {
+        const QByteArray fh = readAt(src, pos, frameHeader);
+        if (fh.size() != frameHeader || fh.at(0) == 0) break; // 进入填充区
+        const QByteArray id = fh.left(v22 ? 3 : 4);
+        qint64 frameSize = 0;
+        int formatFlags = 0;
+        if (v22) {
+            frameSize = be24(fh.constData() + 3);
+        } else {
+            frameSize = major == 4 ? syncsafe32(fh.constData() + 4) : be32(fh.constData() + 4);
+            formatFlags = uchar(fh.at(9));
+        }
+        const qint64 bodyPos = pos + frameHeader;
+        pos = bodyPos + frameSize;
+        if (frameSize <= 0) continue;
+        if (pos > end) break;
+
+        enum FrameKind { SkipFrame, TitleFrame, ArtistFrame, AlbumArtistFrame, AlbumFrame, LengthFrame, PictureFrame,
+                         UserTextFrame };
+        FrameKind kind = SkipFrame;
+        if (id == "TIT2" || id == "TT2") kind = TitleFrame;
+        else if (id == "TPE1" || id == "TP1") kind = ArtistFrame;
+        else if (id == "TPE2" || id == "TP2") kind = AlbumArtistFrame;
+        else if (id == "TALB" || id == "TAL") kind = AlbumFrame;
+        else if (id == "TLEN" || id == "TLE") kind = LengthFrame;
+        else if (id == "APIC" || id == "PIC") kind = readCover ? PictureFrame : SkipFrame;
+        else if (id == "TXXX" || id == "TXX") kind = UserTextFrame;
+        if (kind == SkipFrame) continue;
+
+        QByteArray body = readAt(src, bodyPos, frameSize);
+        if (body.isEmpty()) continue;
+        if (major == 4) {
+            if (formatFlags & 0x0C) continue;            // 压缩/加密帧不处理
+            if (formatFlags & 0x02) body = removeUnsync(body);
+            if (formatFlags & 0x01) body.remove(0, 4);   // 数据长度指示
+        } else if (major == 3) {
+            if (formatFlags & 0xC0) continue;
+            if (formatFlags & 0x20) body.remove(0, 1);   // 分组标识
+        }
+
+        switch (kind) {
+        case TitleFrame: if (info.title.isEmpty()) info.title = id3Text(body); break;
+        case ArtistFrame: if (info.artist.isEmpty()) info.artist = id3Text(body); break;
+        case AlbumArtistFrame: if (info.albumArtist.isEmpty()) info.albumArtist = id3Text(body); break;
+        case AlbumFrame: if (info.album.isEmpty()) info.album = id3Text(body); break;
+        case LengthFrame: if (info.durationMs <= 0) info.durationMs = id3Text(body).toLongLong(); break;
+        case PictureFrame: id3Picture(body, v22, info, &coverIsFront); break;
+        case UserTextFrame: {
+            // 描述与值以 \0 分隔，id3Text 将其合并为 "描述/值"
+            const QString text = id3Text(body);
+            const qsizetype slash = text.indexOf(QLatin1Char('/'));
+            if (slash > 0) replayGainValue(text.left(slash), text.mid(slash + 1), info);
+            break;
+        }
+        case SkipFrame: break;
+        }
+    }
+    return tagEnd;
+}
+
+// ---------------------- ID3v1 ----------------------
+bool parseId3v1(QIODevice *dev, TagInfo &info)
+{
+    if (dev->size() < 128) return false;
+    const QByteArray tag = readAt(dev, dev->size() - 128, 128);
+    if (!tag.startsWith("TAG")) return false;
+    auto field = [&tag](int offset) {
+        QByteArray raw = tag.mid(offset, 30);
+        const qsizetype nul = raw.indexOf('\0');
+        if (nul >= 0) raw.truncate(nul);
+        return decodeLegacy(raw).trimmed();
+    };
+    if (info.title.isEmpty()) info.title = field(3);
+    if (info.artist.isEmpty()) info.artist = field(33);
+    if (info.album.isEmpty()) info.album = field(63);
+    return true;
+}
+
+// ---------------------- MPEG 音频 / ADTS 时长估算 ----------------------
+qint64 mpegDurationMs(QIODevice *dev, qint64 audioStart, qint64 audioEnd)
+{
+    static const int kBitrates[2][3][15] = {
+        { // MPEG-1：Layer I / II / III
+            { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448 },
+            { 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384 },
+            { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 },
+        },
+        { // MPEG-2 / 2.5
+            { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 },
+            { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 },
+            { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 },
+        },
+    };
+    static const int kMpegRates[3][3] = {
+        { 44100, 48000, 32000 }, { 22050, 24000, 16000 }, { 11025, 12000, 8000 },
+    };
+    static const int kAdtsRates[13] = {
+        96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350,
+    };
+
+    if (audioEnd <= audioStart || !dev->seek(audioStart)) return 0;
+    const QByteArray probe = dev->read(qMin(kMpegProbeBytes, audioEnd - audioStart));
+    const char *d = probe.constData();
+    const qsizetype n = probe.size();
+    const qint64 audioBytes = audioEnd - audioStart;
+
+    for (qsizetype i = 0; i + 4 <= n; ++i) {
+        const uchar b0 = uchar(d[i]), b1 = uchar(d[i + 1]), b2 = uchar(d[i + 2]), b3 = uchar(d[i + 3]);
+        if (b0 != 0xFF || (b1 & 0xE0) != 0xE0) continue;
+
+        // ADTS：layer 位恒为 00，每帧 1024 个采样，按前若干帧平均帧长估算
+        if ((b1 & 0xF6) == 0xF0) {
+            const int rateIndex = (b2 >> 2) & 0x0F;
+            if (rateIndex >= 13 || i + 7 > n) continue;
+            qsizetype pos = i;
+            qint64 frames = 0;
+            while (pos + 7 <= n && uchar(d[pos]) == 0xFF && (uchar(d[pos + 1]) & 0xF6) == 0xF0) {
+                const int len = ((uchar(d[pos + 3]) & 0x03) << 11) | (uchar(d[pos + 4]) << 3) | (uchar(d[pos + 5]) >> 5);
+                if (len < 7) break;
+                pos += len;
+                ++frames;
+            }
+            if (frames < 2) continue;
+            const double avgFrame = double(pos - i) / double(frames);
+            const double totalFrames = double(audioBytes - i) / avgFrame;
+            return qint64(totalFrames * 1024.0 * 1000.0 / kAdtsRates[rateIndex]);
+        }
+
+        const int version = (b1 >> 3) & 0x03;   // 3=MPEG1 2=MPEG2 0=MPEG2.5
+        const int layer = (b1 >> 1) & 0x03;     // 3=I 2=II 1=III
+        const int bitrateIndex = b2 >> 4;
+        const int rateIndex = (b2 >> 2) & 0x03;
+        if (version == 1 || layer == 0 || bitrateIndex == 0 || bitrateIndex == 15 || rateIndex == 3) continue;
+
+        const bool mpeg1 = version == 3;
+        const int sampleRate = kMpegRates[mpeg1 ? 0 : (version == 2 ? 1 : 2)][rateIndex];
+        const int bitrate = kBitrates[mpeg1 ? 0 : 1][3 - layer][bitrateIndex];
+        const int samplesPerFrame = layer == 3 ? 384 : ((layer == 1 && !mpeg1) ? 576 : 1152);
+        const bool mono = ((b3 >> 6) & 0x03) == 3;
+
+        // Xing/Info（VBR 帧数）与 VBRI 头
+        const qsizetype xing = i + 4 + (mpeg1 ? (mono ? 17 : 32) : (mono ? 9 : 17));
+        if (xing + 12 <= n && (qstrncmp(d + xing, "Xing", 4) == 0 || qstrncmp(d + xing, "Info", 4) == 0)) {
+            if (be32(d + xing + 4) & 0x01) {
+                const quint32 frames = be32(d + xing + 8);
+                if (frames > 0) return qint64(frames) * samplesPerFrame * 1000 / sampleRate;
+            }
+        }
+        const qsizetype vbri = i + 36;
+        if (vbri + 18 <= n && qstrncmp(d + vbri, "VBRI", 4) == 0) {
+            const quint32 frames = be32(d + vbri + 14);
+            if (frames > 0) return qint64(frames) * samplesPerFrame * 1000 / sampleRate;
+        }
+        // CBR：kbps 即每毫秒比特数
+        return (audioBytes - i) * 8 / bitrate;
+    }
+    return 0;
+}
+
+// ---------------------- Vorbis Comment / FLAC PICTURE ----------------------
+void parseFlacPicture(const QByteArray &block, TagInfo &info)
+{
+    const char *p = block.constData();
+    const qsizetype n = block.size();
+    qsizetype pos = 4; // 图片类型
+    if (pos + 4 > n) return;
+    const quint32 mimeLen = be32(p + pos); pos += 4;
+    if (pos + qint64(mimeLen) + 4 > n) return;
+    const QString mime = QString::fromLatin1(p + pos, mimeLen); pos += mimeLen;
+    const quint32 descLen = be32(p + pos); pos += 4 + descLen;
+    pos += 16; // 宽/高/色深/索引色数
+    if (pos + 4 > n) return;
+    const quint32 dataLen = be32(p + pos); pos += 4;
+    if (pos + qint64(dataLen) > n) return;
+    info.coverData = block.mid(pos, dataLen);
+    info.coverMime = mime;
+}
+
+// 容忍截断：解析到数据末尾为止
+void parseVorbisComments(const char *p, qsizetype n, TagInfo &info, bool readCover)
+{
+    qsizetype pos = 0;
+    if (pos + 4 > n) return;
+    pos += 4 + le32(p + pos);
+    if (pos + 4 > n) return;
+    const quint32 count = le32(p + pos);
+    pos += 4;
+    for (quint32 i = 0; i < count && pos + 4 <= n; ++i) {
+        const quint32 len = le32(p + pos);
+        pos += 4;
+        if (pos + qint64(len) > n) break;
+        const QByteArray entry(p + pos, len);
+        pos += len;
+        const qsizetype eq = entry.indexOf('=');
+        if (eq <= 0) continue;
+        const QByteArray key = entry.left(eq).toUpper();
+        if (key == "METADATA_BLOCK_PICTURE") {
+            if (readCover && info.coverData.isEmpty())
+                parseFlacPicture(QByteArray::fromBase64(entry.mid(eq + 1)), info);
+            continue;
+        }
+        const QString value = QString::fromUtf8(entry.constData() + eq + 1, entry.size() - eq - 1).trimmed();
+        if (key == "TITLE") appendValue(info.title, value);
+        else if (key == "ARTIST") appendValue(info.artist, value);
+        else if (key == "ALBUMARTIST" || key == "ALBUM ARTIST") appendValue(info.albumArtist, value);
+        else if (key == "ALBUM") appendValue(info.album, value);
+        else replayGainValue(QString::fromLatin1(key), value, info);
+    }
+}
+
+// ---------------------- FLAC ----------------------
+bool parseFlac(QIODevice *dev, qint64 start, TagInfo &info, bool readCover)
+{
+    if (readAt(dev, start, 4) != "fLaC") return false;
+    qint64 pos = start + 4;
+    for (;;) {
+        const QByteArray header = readAt(dev, pos, 4);
+        if (header.size() != 4) break;
+        const bool last = uchar(header.at(0)) & 0x80;
+        const int type = uchar(header.at(0)) & 0x7F;
+        const qint64 len = be24(header.constData() + 1);
+        const qint64 body = pos + 4;
+        pos = body + len;
+
+        if (type == 0 && len >= 18) {
+            const QByteArray si = readAt(dev, body, 18);
+            if (si.size() == 18) {
+                const uchar *u = reinterpret_cast<const uchar *>(si.constData());
+                const quint32 sampleRate = (quint32(u[10]) << 12) | (quint32(u[11]) << 4) | (u[12] >> 4);
+                const quint64 totalSamples = (quint64(u[13] & 0x0F) << 32) | be32(si.constData() + 14);
+                if (sampleRate > 0) info.durationMs = qint64(totalSamples * 1000 / sampleRate);
+            }
+        } else if (type == 4) {
+            const QByteArray vc = readAt(dev, body, len);
+            parseVorbisComments(vc.constData(), vc.size(), info, readCover);
+        } else if (type == 6 && readCover && info.coverData.isEmpty()) {
+            parseFlacPicture(readAt(dev, body, len), info);
+        }
+        if (last) break;
+    }
+    return true;
+}
+
+// ---------------------- Ogg Vorbis / Opus ----------------------
+// 从页序列中重组首个逻辑流的前 maxPackets 个包
+QList<QByteArray> oggPackets(const QByteArray &data, int maxPackets, quint32 *serialOut)
+{
+    QList<QByteArray> packets;
+    QByteArray current;
+    const char *d = data.constData();
+    const qsizetype n = data.size();
+    qsizetype pos = 0;
+    bool haveSerial = false;
+    quint32 serial = 0;
+    while (pos + 27 <= n && packets.size() < maxPackets) {
+        if (qstrncmp(d + pos, "OggS", 4) != 0) break;
+        const quint32 pageSerial = le32(d + pos + 14);
+        const int segments = uchar(d[pos + 26]);
+        if (pos + 27 + segments > n) break;
+        const uchar *lacing = reinterpret_cast<const uchar *>(d + pos + 27);
+        qsizetype body = pos + 27 + segments;
+        qsizetype pageLen = 0;
+        for (int s = 0; s < segments; ++s) pageLen += lacing[s];
+        if (!haveSerial) { serial = pageSerial; haveSerial = true; }
+        if (pageSerial == serial) {
+            for (int s = 0; s < segments && packets.size() < maxPackets; ++s) {
+                const qsizetype take = qMin<qsizetype>(lacing[s], n - body);
+                if (take > 0) current.append(d + body, take);
+                body += lacing[s];
+                if (lacing[s] < 255) {
+                    packets.append(current);
+                    current.clear();
+                }
+            }
+        }
+        pos += 27 + segments + pageLen;
+    }
+    // 注释包可能因读取量被截断：仍交给调用方做容错解析
+    if (packets.size() < maxPackets && !current.isEmpty()) packets.append(current);
+    if (serialOut) *serialOut = serial;
+    return packets;
+}
+
+bool parseOgg(QIODevice *dev, TagInfo &info, bool readCover)
+{
+    if (!dev->seek(0)) return false;
+    const QByteArray head = dev->read(readCover ? kOggCoverHeadBytes : kOggHeadBytes);
+    quint32 serial = 0;
+    const QList<QByteArray> packets = oggPackets(head, 2, &serial);
+    if (packets.isEmpty()) return false;
+
+    const QByteArray &ident = packets.at(0);
+    qint64 sampleRate = 0;
+    qint64 preSkip = 0;
+    bool opus = false;
+    if (ident.size() >= 16 && ident.startsWith("\x01vorbis")) {
+        sampleRate = le32(ident.constData() + 12);
+    } else if (ident.size() >= 19 && ident.startsWith("OpusHead")) {
+        opus = true;
+        sampleRate = 48000; // Opus 的 granule 始终以 48kHz 计
+        preSkip = le16(ident.constData() + 10);
+    } else {
+        return false;
+    }
+
+    if (packets.size() > 1) {
+        const QByteArray &comments = packets.at(1);
+        const QByteArray magic = opus ? QByteArrayLiteral("OpusTags") : QByteArrayLiteral("\x03vorbis");
+        if (comments.startsWith(magic))
+            parseVorbisComments(comments.constData() + magic.size(), comments.size() - magic.size(), info, readCover);
+    }
+
+    // 时长：尾部最后一个本流页的 granule position
+    const qint64 size = dev->size();
+    const qint64 tailStart = qMax<qint64>(0, size - kOggTailBytes);
+    if (sampleRate > 0 && dev->seek(tailStart)) {
+        const QByteArray tail = dev->read(size - tailStart);
+        for (qsizetype i = tail.lastIndexOf("OggS"); i >= 0; i = i > 0 ? tail.lastIndexOf("OggS", i - 1) : -1) {
+            if (i + 27 > tail.size() || le32(tail.constData() + i + 14) != serial) continue;
+            const qint64 granule = qint64(le64(tail.constData() + i + 6));
+            if (granule > preSkip) info.durationMs = (granule - preSkip) * 1000 / sampleRate;
+            break;
+        }
+    }
+    return true;
+}
+
+// ---------------------- MP4 / M4A ----------------------
+struct Mp4Atom { QByteArray type; qint64 start = 0; qint64 body = 0; qint64 end = 0; };
+
+bool readMp4Atom(QIODevice *dev, qint64 pos, qint64 limit, Mp4Atom *atom)
+{
+    if (pos + 8 > limit) return false;
+    const QByteArray h = readAt(dev, pos, 8);
+    if (h.size() != 8) return false;
+    qint64 size = be32(h.constData());
+    qint64 header = 8;
+    if (size == 1) {
+        const QByteArray large = readAt(dev, pos + 8, 8);
+        if (large.size() != 8) return false;
+        size = qint64(be64(large.constData()));
+        header = 16;
+    } else if (size == 0) {
+        size = limit - pos;
+    }
+    if (size < header || pos + size > limit) return false;
+    atom->type = h.mid(4, 4);
+    atom->start = pos;
+    atom->body = pos + header;
+    atom->end = pos + size;
+    return true;
+}
+
+// iTunes 自定义项（----）：mean/name/data 三个子原子，ReplayGain 以文本形式存放
+void parseFreeform(QIODevice *dev, const Mp4Atom &item, TagInfo &info)
+{
+    QString name;
+    QString value;
+    Mp4Atom child;
+    for (qint64 pos = item.body; readMp4Atom(dev, pos, item.end, &child); pos = child.end) {
+        if (child.type != "name" && child.type != "data") continue;
+        const qint64 skip = child.type == "name" ? 4 : 8;    // 版本/标志；data 另有 4 字节区域码
+        if (child.end - child.body <= skip || child.end - child.body > 4096) continue;
+        const QString text = QString::fromUtf8(readAt(dev, child.body + skip, child.end - child.body - skip)).trimmed();
+        if (child.type == "name") name = text;
+        else value = text;
+    }
+    if (!name.isEmpty() && !value.isEmpty()) replayGainValue(name, value, info);
+}
+
+void parseIlst(QIODevice *dev, const Mp4Atom &ilst, TagInfo &info, bool readCover)
+{
+    Mp4Atom item;
+    for (qint64 pos = ilst.body; readMp4Atom(dev, pos, ilst.end, &item); pos = item.end) {
+        QString *field = nullptr;
+        if (item.type == "\xA9nam") field = &info.title;
+        else if (item.type == "\xA9" "ART") field = &info.artist;
+        else if (item.type == "aART") field = &info.albumArtist;
+        else if (item.type == "\xA9" "alb") field = &info.album;
+        else if (item.type == "----") {
+            parseFreeform(dev, item, info);
+            continue;
+        }
+        else if (!(item.type == "covr" && readCover)) continue;
+
+        Mp4Atom data;
+        for (qint64 dpos = item.body; readMp4Atom(dev, dpos, item.end, &data); dpos = data.end) {
+            if (data.type != "data" || data.end - data.body < 8) continue;
+            const QByteArray payload = readAt(dev, data.body, data.end - data.body);
+            if (payload.size() < 8) continue;
+            const quint32 dataType = be32(payload.constData()) & 0x00FFFFFF;
+            if (field) {
+                if (field->isEmpty()) *field = QString::fromUtf8(payload.constData() + 8, payload.size() - 8).trimmed();
+            } else if (info.coverData.isEmpty()) {
+                info.coverData = payload.mid(8);
+                info.coverMime = dataType == 14 ? QStringLiteral("image/png") : QStringLiteral("image/jpeg");
+            }
+            break;
+        }
+    }
+}
+
+void parseMp4Container(QIODevice *dev, qint64 pos, qint64 end, TagInfo &info, bool readCover)
+{
+    Mp4Atom atom;
+    for (; readMp4Atom(dev, pos, end, &atom); pos = atom.end) {
+        if (atom.type == "mvhd") {
+            const QByteArray mvhd = readAt(dev, atom.body, qMin<qint64>(32, atom.end - atom.body));
+            if (mvhd.size() < 20) continue;
+            const bool v1 = mvhd.at(0) == 1;
+            if (v1 && mvhd.size() < 32) continue;
+            const quint32 timescale = be32(mvhd.constData() + (v1 ? 20 : 12));
+            const quint64 duration = v1 ? be64(mvhd.constData() + 24) : be32(mvhd.constData() + 16);
+            if (timescale > 0) info.durationMs = qint64(duration * 1000 / timescale);
+        } else if (atom.type == "udta") {
+            parseMp4Container(dev, atom.body, atom.end, info, readCover);
+        } else if (atom.type == "meta") {
+            // ISO 的 meta 带 4 字节 version/flags；QuickTime 风格直接跟 hdlr
+            const QByteArray peek = readAt(dev, atom.body, 8);
+            const qint64 children = (peek.size() == 8 && peek.mid(4, 4) == "hdlr") ? atom.body : atom.body + 4;
+            parseMp4Container(dev, children, atom.end, info, readCover);
+        } else if (atom.type == "ilst") {
+            parseIlst(dev, atom, info, readCover);
+        }
+    }
+}
+
+bool parseMp4(QIODevice *dev, TagInfo &info, bool readCover)
+{
+    Mp4Atom atom;
+    // 顶层只进入 moov；mdat 等大块直接按尺寸跳过（moov 在文件尾也只是一次 seek）
+    for (qint64 pos = 0; readMp4Atom(dev, pos, dev->size(), &atom); pos = atom.end) {
+        if (atom.type == "moov") {
+            parseMp4Container(dev, atom.body, atom.end, info, readCover);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------- WAV (RIFF) ----------------------
+bool parseRiff(QIODevice *dev, TagInfo &info, bool readCover)
+{
+    const qint64 size = dev->size();
+    qint64 pos = 12;
+    quint32 byteRate = 0;
+    qint64 dataBytes = 0;
+    while (pos + 8 <= size) {
+        const QByteArray h = readAt(dev, pos, 8);
+        if (h.size() != 8) break;
+        const QByteArray id = h.left(4);
+        const qint64 len = le32(h.constData() + 4);
+        const qint64 body = pos + 8;
+        pos = body + len + (len & 1);
+
+        if (id == "fmt " && len >= 12) {
+            const QByteArray fmt = readAt(dev, body, 12);
+            if (fmt.size() == 12) byteRate = le32(fmt.constData() + 8);
+        } else if (id == "data") {
+            dataBytes = qMin(len, size - body);
+        } else if (id == "LIST") {
+            const QByteArray list = readAt(dev, body, len);
+            if (!list.startsWith("INFO")) continue;
+            qsizetype p = 4;
+            while (p + 8 <= list.size()) {
+                const QByteArray sub = list.mid(p, 4);
+                const qsizetype subLen = le32(list.constData() + p + 4);
+                QByteArray value = list.mid(p + 8, subLen);
+                const qsizetype nul = value.indexOf('\0');
+                if (nul >= 0) value.truncate(nul);
+                if (sub == "INAM" && info.title.isEmpty()) info.title = decodeLegacy(value).trimmed();
+                else if (sub == "IART" && info.artist.isEmpty()) info.artist = decodeLegacy(value).trimmed();
+                else if (sub == "IPRD" && info.album.isEmpty()) info.album = decodeLegacy(value).trimmed();
+                p += 8 + subLen + (subLen & 1);
+            }
+        } else if (id == "id3 " || id == "ID3 ") {
+            parseId3v2(dev, body, info, readCover);
+        }
+    }
+    if (byteRate > 0 && dataBytes > 0) info.durationMs = dataBytes * 1000 / byteRate;
+    return true;
+}
+
+// ---------------------- WMA (ASF) ----------------------
+const char kAsfHeader[16] = { '\x30', '\x26', '\xB2', '\x75', '\x8E', '\x66', '\xCF', '\x11',
+                              '\xA6', '\xD9', '\x00', '\xAA', '\x00', '\x62', '\xCE', '\x6C' };
+const char kAsfContent[16] = { '\x33', '\x26', '\xB2', '\x75', '\x8E', '\x66', '\xCF', '\x11',
+                               '\xA6', '\xD9', '\x00', '\xAA', '\x00', '\x62', '\xCE', '\x6C' };
+const char kAsfFileProps[16] = { '\xA1', '\xDC', '\xAB', '\x8C', '\x47', '\xA9', '\xCF', '\x11',
+                                 '\x8E', '\xE4', '\x00', '\xC0', '\x0C', '\x20', '\x53', '\x65' };
+const char kAsfExtContent[16] = { '\x40', '\xA4', '\xD0', '\xD2', '\x07', '\xE3', '\xD2', '\x11',
+                                  '\x97', '\xF0', '\x00', '\xA0', '\xC9', '\x5E', '\xA8', '\x50' };
+
+QString asfString(const char *p, qsizetype n)
+{
+    return cleanValue(decodeUtf16(p, n, false));
+}
+
+void parseAsfPicture(const QByteArray &value, TagInfo &info)
+{
+    // 图片类型(1) 数据长度(4) MIME(UTF-16 \0\0) 描述(UTF-16 \0\0) 数据
+    if (value.size() < 5) return;
+    const quint32 dataLen = le32(value.constData() + 1);
+    qsizetype pos = skipEncodedString(value, 5, 1);
+    if (pos < 0) return;
+    const QString mime = decodeUtf16(value.constData() + 5, pos - 7, false);
+    pos = skipEncodedString(value, pos, 1);
+    if (pos < 0 || pos + qint64(dataLen) > value.size()) return;
+    info.coverData = value.mid(pos, dataLen);
+    info.coverMime = mime;
+}
+
+bool parseAsf(QIODevice *dev, TagInfo &info, bool readCover)
+{
+    const QByteArray header = readAt(dev, 0, 30);
+    if (header.size() != 30 || memcmp(header.constData(), kAsfHeader, 16) != 0) return false;
+    const qint64 headerEnd = qint64(le64(header.constData() + 16));
+    const quint32 objects = le32(header.constData() + 24);
+    qint64 pos = 30;
+    for (quint32 i = 0; i < objects && pos + 24 <= headerEnd; ++i) {
+        const QByteArray oh = readAt(dev, pos, 24);
+        if (oh.size() != 24) break;
+        const qint64 objSize = qint64(le64(oh.constData() + 16));
+        if (objSize < 24) break;
+        const qint64 body = pos + 24;
+        const qint64 bodyLen = objSize - 24;
+        pos += objSize;
+
+        if (memcmp(oh.constData(), kAsfFileProps, 16) == 0) {
+            const QByteArray fp = readAt(dev, body, qMin<qint64>(64, bodyLen));
+            if (fp.size() < 64) continue;
+            const quint64 play100ns = le64(fp.constData() + 40);
+            const quint64 prerollMs = le64(fp.constData() + 56);
+            info.durationMs = qMax<qint64>(0, qint64(play100ns / 10000) - qint64(prerollMs));
+        } else if (memcmp(oh.constData(), kAsfContent, 16) == 0) {
+            const QByteArray cd = readAt(dev, body, bodyLen);
+            if (cd.size() < 10) continue;
+            const quint16 titleLen = le16(cd.constData());
+            const quint16 authorLen = le16(cd.constData() + 2);
+            if (10 + titleLen + authorLen > cd.size()) continue;
+            if (info.title.isEmpty()) info.title = asfString(cd.constData() + 10, titleLen);
+            if (info.artist.isEmpty()) info.artist = asfString(cd.constData() + 10 + titleLen, authorLen);
+        } else if (memcmp(oh.constData(), kAsfExtContent, 16) == 0) {
+            const QByteArray ec = readAt(dev, body, bodyLen);
+            if (ec.size() < 2) continue;
+            const int count = le16(ec.constData());
+            qsizetype p = 2;
+            for (int k = 0; k < count && p + 2 <= ec.size(); ++k) {
+                const quint16 nameLen = le16(ec.constData() + p);
+                if (p + 2 + nameLen + 4 > ec.size()) break;
+                const QString name = asfString(ec.constData() + p + 2, nameLen);
+                p += 2 + nameLen;
+                const quint16 valueType = le16(ec.constData() + p);
+                const quint16 valueLen = le16(ec.constData() + p + 2);
+                p += 4;
+                if (p + valueLen > ec.size()) break;
+                const QByteArray value = ec.mid(p, valueLen);
+                p += valueLen;
+                if (name == QLatin1String("WM/AlbumTitle") && valueType == 0 && info.album.isEmpty())
+                    info.album = asfString(value.constData(), value.size());
+                else if (name == QLatin1String("WM/AlbumArtist") && valueType == 0 && info.albumArtist.isEmpty())
+                    info.albumArtist = asfString(value.constData(), value.size());
+                else if (name == QLatin1String("WM/Picture") && valueType == 1 && readCover && info.coverData.isEmpty())
+                    parseAsfPicture(value, info);
+                else if (valueType == 0)
+                    replayGainValue(name, asfString(value.constData(), value.size()), info);
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+QVariantMap TagInfo::toVariantMap() const
+{
+    QVariantMap meta;
+    meta.insert("title", title);
+    // 与原 QMediaPlayer 读取逻辑一致：专辑艺术家优先
+    meta.insert("artist", albumArtist.isEmpty() ? artist : albumArtist);
+    meta.insert("album", album);
+    meta.insert("duration", durationMs);
+    return meta;
+}
+
+TagInfo TagReader::read(const QString &filePath, bool readCover)
+{
+    TagInfo info;
+    QString local = filePath;
+    if (local.startsWith("qrc:/")) local = local.mid(3);
+
+    QFile file(local);
+    if (!file.open(QIODevice::ReadOnly)) return info;
+
+    const QByteArray magic = file.read(16);
+    if (magic.size() < 12) return info;
+
+    if (magic.startsWith("fLaC")) {
+        info.valid = parseFlac(&file, 0, info, readCover);
+    } else if (magic.startsWith("OggS")) {
+        info.valid = parseOgg(&file, info, readCover);
+    } else if (magic.mid(4, 4) == "ftyp") {
+        info.valid = parseMp4(&file, info, readCover);
+    } else if (magic.startsWith("RIFF") && magic.mid(8, 4) == "WAVE") {
+        info.valid = parseRiff(&file, info, readCover);
+    } else if (magic.size() == 16 && memcmp(magic.constData(), kAsfHeader, 16) == 0) {
+        info.valid = parseAsf(&file, info, readCover);
+    } else {
+        // MP3/AAC：可选 ID3v2 头（FLAC 偶尔也带 ID3v2 前缀），随后是帧流，末尾可能有 ID3v1
+        const qint64 audioStart = parseId3v2(&file, 0, info, readCover);
+        if (readAt(&file, audioStart, 4) == "fLaC") {
+            info.valid = parseFlac(&file, audioStart, info, readCover);
+            return info;
+        }
+        const bool hasV1 = parseId3v1(&file, info);
+        const qint64 audioEnd = file.size() - (hasV1 ? 128 : 0);
+        const qint64 frameDuration = mpegDurationMs(&file, audioStart, audioEnd);
+        if (frameDuration > 0) info.durationMs = frameDuration;
+        info.valid = audioStart > 0 || hasV1 || frameDuration > 0;
+    }
+    return info;
+}
@@ -0,0 +1,42 @@
+// core/tagreader.h
+#ifndef CORE_TAGREADER_H
+#define CORE_TAGREADER_H
+
+// 轻量标签读取：直接解析文件头/尾的标签区，不解码音频、不打开音频设备
+// 支持 ID3v2/ID3v1(MP3/AAC)、FLAC、MP4/M4A(ilst)、Ogg Vorbis/Opus、WAV(RIFF INFO)、WMA(ASF)
+#include <QString>
+#include <QByteArray>
+#include <QVariantMap>
+#include <QtNumeric>
+
+struct TagInfo
+{
+    QString title;
+    QString artist;
+    QString albumArtist;
+    QString album;
+    qint64 durationMs = 0;
+    QByteArray coverData;   // 原始封面字节（JPEG/PNG），仅在 readCover 为 true 时填充
+    QString coverMime;
+    bool valid = false;     // 是否识别出容器格式
+    // ReplayGain：增益为 dB（相对 -18 LUFS），峰值为线性值；标签中没有时为 NaN
+    // Opus 的 R128_*_GAIN 已换算到同一参考电平
+    double trackGain = qQNaN();
+    double trackPeak = qQNaN();
+    double albumGain = qQNaN();
+    double albumPeak = qQNaN();
+
+    bool hasReplayGain() const { return !qIsNaN(trackGain); }
+
+    // 转为 MusicLibrary 元数据缓存使用的键：title/artist/album/duration(毫秒)
+    QVariantMap toVariantMap() const;
+};
+
+class TagReader
+{
+public:
+    // 读取标签；readCover 为 false 时封面帧只 seek 跳过，不读入内存
+    static TagInfo read(const QString &filePath, bool readCover = false);
+};
+
+#endif // CORE_TAGREADER_H
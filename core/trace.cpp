@@ -0,0 +1,307 @@
+// 实现文件：Trace —— 线程分块缓冲、Chrome trace JSON 写出、窗口渲染阶段挂接
+#include "core/trace.h"
+
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQuickWindow>
+#include <QSaveFile>
+#include <QThread>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+struct Event
+{
+    const char *name;
+    qint64 ts;          // 纳秒
+    qint64 value;       // X：持续时间；C：计数值；b/e：异步 id
+    char phase;         // X / B / E / C / b / e
+};
+
+// 单生产者分块链表：生产者写满一块后挂上新块并以 release 发布；写出线程按 acquire 读到的数量读取
+struct Chunk
+{
+    static const int CAPACITY = 4096;
+    Event events[CAPACITY];
+    std::atomic_int count { 0 };
+    std::atomic<Chunk *> next { nullptr };
+};
+
+struct ThreadBuffer
+{
+    int tid = 0;
+    QString name;
+    Chunk *head = nullptr;
+    Chunk *tail = nullptr;
+};
+
+struct Registry
+{
+    QMutex mutex;                                   // 保护 buffers 与 interned
+    std::vector<ThreadBuffer *> buffers;            // 线程退出后缓冲区仍保留到写出
+    std::unordered_set<std::string> interned;
+    QString outputPath;
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+};
+
+Registry &registry()
+{
+    static Registry *r = new Registry;              // 有意不释放：退出阶段仍可能有线程在记录
+    return *r;
+}
+
+ThreadBuffer *threadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (buffer) return buffer;
+    buffer = new ThreadBuffer;
+    buffer->head = buffer->tail = new Chunk;
+    QThread *thread = QThread::currentThread();
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+        buffer->name = QStringLiteral("GUI");
+    } else if (thread && !thread->objectName().isEmpty()) {
+        buffer->name = thread->objectName();
+    } else if (thread) {
+        buffer->name = QString::fromLatin1(thread->metaObject()->className());
+    }
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+    buffer->tid = int(r.buffers.size()) + 1;
+    r.buffers.push_back(buffer);
+    return buffer;
+}
+
+void record(const char *name, char phase, qint64 ts, qint64 value)
+{
+    ThreadBuffer *buffer = threadBuffer();
+    Chunk *chunk = buffer->tail;
+    int n = chunk->count.load(std::memory_order_relaxed);
+    if (n == Chunk::CAPACITY) {
+        Chunk *fresh = new Chunk;
+        chunk->next.store(fresh, std::memory_order_release);
+        buffer->tail = chunk = fresh;
+        n = 0;
+    }
+    chunk->events[n] = Event { name, ts, value, phase };
+    chunk->count.store(n + 1, std::memory_order_release);
+}
+
+void appendEscaped(QByteArray &out, const char *text)
+{
+    for (const char *p = text; *p; ++p) {
+        const char c = *p;
+        if (c == '"' || c == '\\') {
+            out.append('\\').append(c);
+        } else if (uchar(c) < 0x20) {
+            out.append(' ');
+        } else {
+            out.append(c);
+        }
+    }
+}
+
+void appendMicros(QByteArray &out, qint64 ns)
+{
+    // 微秒，保留三位小数
+    out.append(QByteArray::number(ns / 1000)).append('.');
+    const qint64 frac = ns % 1000;
+    if (frac < 100) out.append('0');
+    if (frac < 10) out.append('0');
+    out.append(QByteArray::number(frac));
+}
+
+} // namespace
+
+std::atomic_bool Trace::s_active { false };
+
+void Trace::initialize()
+{
+#ifdef EVOLVEUI_TRACING
+    const QString path = qEnvironmentVariable("EVOLVEUI_TRACE_FILE");
+    if (path.isEmpty()) return;
+    Registry &r = registry();
+    r.outputPath = path;
+    r.origin = std::chrono::steady_clock::now();
+    s_active = true;
+    if (auto *app = qobject_cast<QGuiApplication *>(QCoreApplication::instance())) {
+        // 延迟创建的窗口首次获得焦点时挂接
+        QObject::connect(app, &QGuiApplication::focusWindowChanged, app, [](QWindow *window) {
+            instrumentWindow(qobject_cast<QQuickWindow *>(window));
+        });
+        QObject::connect(app, &QCoreApplication::aboutToQuit, app, []() { save(); });
+    }
+#endif
+}
+
+qint64 Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - registry().origin).count();
+}
+
+void Trace::complete(const char *name, qint64 startNs, qint64 endNs)
+{
+    if (!isActive()) return;
+    record(name, 'X', startNs, endNs - startNs);
+}
+
+void Trace::begin(const char *name)
+{
+    if (!isActive()) return;
+    record(name, 'B', now(), 0);
+}
+
+void Trace::end(const char *name)
+{
+    if (!isActive()) return;
+    record(name, 'E', now(), 0);
+}
+
+void Trace::counter(const char *name, qint64 value)
+{
+    if (!isActive()) return;
+    record(name, 'C', now(), value);
+}
+
+void Trace::asyncBegin(const char *name, quint64 id)
+{
+    if (!isActive()) return;
+    record(name, 'b', now(), qint64(id));
+}
+
+void Trace::asyncEnd(const char *name, quint64 id)
+{
+    if (!isActive()) return;
+    record(name, 'e', now(), qint64(id));
+}
+
+const char *Trace::intern(const QString &name)
+{
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+    return r.interned.insert(name.toStdString()).first->c_str();
+}
+
+void Trace::instrumentWindow(QQuickWindow *window)
+{
+    if (!window || !isActive() || window->property("_evolveui_traced").toBool()) return;
+    window->setProperty("_evolveui_traced", true);
+
+    QString label = window->objectName();
+    if (label.isEmpty()) label = window->title();
+    if (label.isEmpty()) label = QString::fromLatin1(window->metaObject()->className());
+    const char *frame = intern(QStringLiteral("frame:") + label);
+    const char *interval = intern(QStringLiteral("frameIntervalUs:") + label);
+    auto lastSwap = std::make_shared<qint64>(-1);
+
+    // 渲染线程上直接记录：帧区间包住同步与渲染两个阶段，按线程正确嵌套
+    QObject::connect(window, &QQuickWindow::beforeSynchronizing, window, [frame]() {
+        begin(frame);
+        begin("sg.sync");
+    }, Qt::DirectConnection);
+    QObject::connect(window, &QQuickWindow::afterSynchronizing, window, []() { end("sg.sync"); },
+                     Qt::DirectConnection);
+    QObject::connect(window, &QQuickWindow::beforeRendering, window, []() { begin("sg.render"); },
+                     Qt::DirectConnection);
+    QObject::connect(window, &QQuickWindow::afterRendering, window, []() { end("sg.render"); },
+                     Qt::DirectConnection);
+    QObject::connect(window, &QQuickWindow::frameSwapped, window, [frame, interval, lastSwap]() {
+        end(frame);
+        const qint64 t = now();
+        if (*lastSwap >= 0) counter(interval, (t - *lastSwap) / 1000);
+        *lastSwap = t;
+    }, Qt::DirectConnection);
+}
+
+bool Trace::save(const QString &path)
+{
+    Registry &r = registry();
+    const QString target = path.isEmpty() ? r.outputPath : path;
+    if (target.isEmpty()) return false;
+
+    std::vector<ThreadBuffer *> buffers;
+    {
+        QMutexLocker lock(&r.mutex);
+        buffers = r.buffers;
+    }
+
+    QSaveFile file(target);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    QByteArray out("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    out.append("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"EvolveUI\"}}");
+    for (ThreadBuffer *buffer : buffers) {
+        out.append(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":")
+           .append(QByteArray::number(buffer->tid)).append(",\"args\":{\"name\":\"");
+        appendEscaped(out, buffer->name.toUtf8().constData());
+        out.append("\"}}");
+        for (Chunk *chunk = buffer->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            const int n = chunk->count.load(std::memory_order_acquire);
+            for (int i = 0; i < n; ++i) {
+                const Event &e = chunk->events[i];
+                out.append(",\n{\"name\":\"");
+                appendEscaped(out, e.name);
+                out.append("\",\"ph\":\"").append(e.phase).append("\",\"pid\":1,\"tid\":")
+                   .append(QByteArray::number(buffer->tid)).append(",\"ts\":");
+                appendMicros(out, e.ts);
+                switch (e.phase) {
+                case 'X':
+                    out.append(",\"dur\":");
+                    appendMicros(out, e.value);
+                    break;
+                case 'C':
+                    out.append(",\"args\":{\"value\":").append(QByteArray::number(e.value)).append('}');
+                    break;
+                case 'b':
+                case 'e':
+                    out.append(",\"cat\":\"async\",\"id\":\"0x").append(QByteArray::number(quint64(e.value), 16))
+                       .append('"');
+                    break;
+                default:
+                    break;
+                }
+                out.append('}');
+            }
+            // 分块写出，避免长时间记录后在内存中拼出整份文件
+            if (out.size() > (1 << 20)) {
+                file.write(out);
+                out.clear();
+            }
+        }
+    }
+    out.append("\n]}\n");
+    file.write(out);
+    return file.commit();
+}
+
+// ---------------------- TraceObject ----------------------
+TraceObject::TraceObject(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void TraceObject::begin(const QString &name)
+{
+    if (Trace::isActive()) Trace::begin(Trace::intern(name));
+}
+
+void TraceObject::end(const QString &name)
+{
+    if (Trace::isActive()) Trace::end(Trace::intern(name));
+}
+
+void TraceObject::counter(const QString &name, double value)
+{
+    if (Trace::isActive()) Trace::counter(Trace::intern(name), qint64(value));
+}
+
+bool TraceObject::save(const QString &path)
+{
+    return Trace::isActive() && Trace::save(path);
+}
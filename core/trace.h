@@ -0,0 +1,98 @@
+// core/trace.h
+#ifndef CORE_TRACE_H
+#define CORE_TRACE_H
+
+// 热路径追踪：输出 Chrome trace 事件格式（chrome://tracing 与 ui.perfetto.dev 均可直接打开）
+// 只有以 EVOLVEUI_TRACING 编译时宏才生效，否则全部展开为空语句；运行时还需设置
+// EVOLVEUI_TRACE_FILE=<输出路径> 才开始记录，退出时（或 QML 调用 Trace.save()）写出
+// 事件写入各线程自己的分块缓冲区：记录时无锁，写出时只读已发布的部分，互不阻塞
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+class QQuickWindow;
+
+class Trace
+{
+public:
+    // 读取 EVOLVEUI_TRACE_FILE，设置后开始记录并在退出时写出；未以 EVOLVEUI_TRACING 编译时什么也不做
+    static void initialize();
+    static bool isActive() { return s_active.load(std::memory_order_relaxed); }
+
+    // 单调时钟，纳秒，起点为 initialize()
+    static qint64 now();
+    // name 须在程序生命周期内有效（字符串字面量或 intern() 的结果）
+    static void complete(const char *name, qint64 startNs, qint64 endNs);
+    static void begin(const char *name);
+    static void end(const char *name);
+    static void counter(const char *name, qint64 value);
+    static void asyncBegin(const char *name, quint64 id);
+    static void asyncEnd(const char *name, quint64 id);
+    static const char *intern(const QString &name);
+
+    // 渲染线程上的同步/渲染阶段与逐帧间隔（每个窗口只挂接一次）
+    static void instrumentWindow(QQuickWindow *window);
+    // path 为空时写到 EVOLVEUI_TRACE_FILE
+    static bool save(const QString &path = QString());
+
+private:
+    static std::atomic_bool s_active;
+};
+
+// 作用域计时：构造时取时间，析构时记一个完整事件；未在记录时只多一次原子读
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name)
+        : m_name(Trace::isActive() ? name : nullptr)
+        , m_start(m_name ? Trace::now() : 0)
+    {
+    }
+    ~TraceScope()
+    {
+        if (m_name) Trace::complete(m_name, m_start, Trace::now());
+    }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *m_name;
+    qint64 m_start;
+};
+
+// QML 单例 Trace：组件代码中的 Trace.begin("name") / Trace.end("name")
+class TraceObject : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool active READ active CONSTANT)
+
+public:
+    explicit TraceObject(QObject *parent = nullptr);
+
+    bool active() const { return Trace::isActive(); }
+
+    Q_INVOKABLE void begin(const QString &name);
+    Q_INVOKABLE void end(const QString &name);
+    Q_INVOKABLE void counter(const QString &name, double value);
+    Q_INVOKABLE bool save(const QString &path = QString());
+};
+
+#ifdef EVOLVEUI_TRACING
+#define EVOLVEUI_TRACE_CONCAT_(a, b) a##b
+#define EVOLVEUI_TRACE_CONCAT(a, b) EVOLVEUI_TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope EVOLVEUI_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_COUNTER(name, value) \
+    do { if (Trace::isActive()) Trace::counter(name, qint64(value)); } while (0)
+#define TRACE_ASYNC_BEGIN(name, id) \
+    do { if (Trace::isActive()) Trace::asyncBegin(name, quint64(id)); } while (0)
+#define TRACE_ASYNC_END(name, id) \
+    do { if (Trace::isActive()) Trace::asyncEnd(name, quint64(id)); } while (0)
+#else
+#define TRACE_SCOPE(name) do {} while (0)
+#define TRACE_COUNTER(name, value) do {} while (0)
+#define TRACE_ASYNC_BEGIN(name, id) do {} while (0)
+#define TRACE_ASYNC_END(name, id) do {} while (0)
+#endif
+
+#endif // CORE_TRACE_H
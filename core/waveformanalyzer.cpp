@@ -0,0 +1,313 @@
+// 实现文件：WaveformAnalyzer —— 解码、分桶峰值与二进制旁路缓存
+#include "core/waveformanalyzer.h"
+#include "core/trace.h"
+
+#include <QAudioBuffer>
+#include <QAudioDecoder>
+#include <QAudioFormat>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QPointer>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QUrl>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const char kMagic[4] = { 'E', 'W', 'F', '1' };
+const int kHeaderSize = 4 + 4 + 8 + 4;     // magic, bucketsPerSecond, durationMs, count
+const int kAnalysisRate = 22050;           // 峰值显示无需全采样率，解码端顺带降采样
+const qint64 kEdgeBytes = 64 * 1024;
+const int kLanes = 8;
+
+// 分桶累加器：当前桶的 min/max/平方和
+struct Accumulator
+{
+    float lo = 0.0f;
+    float hi = 0.0f;
+    float sumSq = 0.0f;
+    int count = 0;
+    int perBucket = 0;
+    qint64 total = 0;
+    std::vector<WaveformPeak> peaks;
+
+    void flush()
+    {
+        if (count == 0) return;
+        auto quantize = [](float v) { return qint8(std::lround(std::clamp(v, -1.0f, 1.0f) * 127.0f)); };
+        const float rms = std::sqrt(sumSq / float(count));
+        peaks.push_back(WaveformPeak { quantize(lo), quantize(hi), quint8(std::lround(std::min(rms, 1.0f) * 255.0f)) });
+        lo = hi = sumSq = 0.0f;
+        count = 0;
+    }
+};
+
+// 8 路独立累加，无分支，编译器可直接映射为 SIMD min/max/乘加
+void reduceBlock(const float *p, qsizetype n, float &lo, float &hi, float &sumSq)
+{
+    float l[kLanes], h[kLanes], s[kLanes];
+    for (int k = 0; k < kLanes; ++k) {
+        l[k] = lo;
+        h[k] = hi;
+        s[k] = 0.0f;
+    }
+    qsizetype i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        for (int k = 0; k < kLanes; ++k) {
+            const float v = p[i + k];
+            l[k] = v < l[k] ? v : l[k];
+            h[k] = v > h[k] ? v : h[k];
+            s[k] += v * v;
+        }
+    }
+    for (; i < n; ++i) {
+        const float v = p[i];
+        l[0] = v < l[0] ? v : l[0];
+        h[0] = v > h[0] ? v : h[0];
+        s[0] += v * v;
+    }
+    for (int k = 0; k < kLanes; ++k) {
+        lo = std::min(lo, l[k]);
+        hi = std::max(hi, h[k]);
+        sumSq += s[k];
+    }
+}
+
+// 解码端若未按请求格式输出，在此统一转换为单声道浮点
+void toMono(const QAudioBuffer &buffer, std::vector<float> &out)
+{
+    const QAudioFormat format = buffer.format();
+    const int channels = std::max(1, format.channelCount());
+    const qsizetype frames = buffer.frameCount();
+    out.resize(size_t(frames));
+    const float scale = 1.0f / float(channels);
+
+    auto mix = [&](auto sampleAt) {
+        for (qsizetype f = 0; f < frames; ++f) {
+            float sum = 0.0f;
+            for (int c = 0; c < channels; ++c) sum += sampleAt(f * channels + c);
+            out[size_t(f)] = sum * scale;
+        }
+    };
+    switch (format.sampleFormat()) {
+    case QAudioFormat::Float: {
+        const float *data = buffer.constData<float>();
+        if (channels == 1) {
+            std::memcpy(out.data(), data, size_t(frames) * sizeof(float));
+        } else {
+            mix([data](qsizetype i) { return data[i]; });
+        }
+        break;
+    }
+    case QAudioFormat::Int16: {
+        const qint16 *data = buffer.constData<qint16>();
+        mix([data](qsizetype i) { return data[i] / 32768.0f; });
+        break;
+    }
+    case QAudioFormat::Int32: {
+        const qint32 *data = buffer.constData<qint32>();
+        mix([data](qsizetype i) { return float(data[i] / 2147483648.0); });
+        break;
+    }
+    case QAudioFormat::UInt8: {
+        const quint8 *data = buffer.constData<quint8>();
+        mix([data](qsizetype i) { return (int(data[i]) - 128) / 128.0f; });
+        break;
+    }
+    default:
+        out.clear();
+        break;
+    }
+}
+
+void consume(Accumulator &acc, const float *samples, qsizetype n)
+{
+    qsizetype i = 0;
+    while (i < n) {
+        if (acc.count == 0) acc.lo = acc.hi = samples[i];
+        const qsizetype take = std::min<qsizetype>(n - i, acc.perBucket - acc.count);
+        reduceBlock(samples + i, take, acc.lo, acc.hi, acc.sumSq);
+        acc.count += int(take);
+        i += take;
+        if (acc.count >= acc.perBucket) acc.flush();
+    }
+    acc.total += n;
+}
+
+} // namespace
+
+WaveformAnalyzer &WaveformAnalyzer::instance()
+{
+    static QPointer<WaveformAnalyzer> analyzer;
+    if (!analyzer) analyzer = new WaveformAnalyzer(QCoreApplication::instance());
+    return *analyzer;
+}
+
+WaveformAnalyzer::WaveformAnalyzer(QObject *parent)
+    : QObject(parent)
+{
+    // 后台低优先级，最多两首并行，避免与播放解码争抢 CPU
+    m_pool.setMaxThreadCount(2);
+    m_pool.setThreadPriority(QThread::LowPriority);
+    QDir().mkpath(cacheDirectory());
+}
+
+WaveformAnalyzer::~WaveformAnalyzer()
+{
+    m_stopping = true;
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+WaveformPtr WaveformAnalyzer::peaks(const QString &path) const
+{
+    return m_peaks.value(path);
+}
+
+void WaveformAnalyzer::request(const QString &path)
+{
+    if (path.isEmpty() || m_peaks.contains(path) || m_pending.contains(path)) return;
+    m_pending.insert(path);
+    m_pool.start([this, path]() {
+        const QString key = contentKey(path);
+        const QString file = key.isEmpty() ? QString() : cacheDirectory() + QLatin1Char('/') + key + QStringLiteral(".peaks");
+        WaveformPtr data = file.isEmpty() ? nullptr : readCache(file);
+        if (!data) {
+            data = analyze(path, &m_stopping);
+            if (data && !file.isEmpty()) writeCache(file, *data);
+        }
+        if (m_stopping) return;
+        QMetaObject::invokeMethod(this, [this, path, data]() { finish(path, data); }, Qt::QueuedConnection);
+    });
+}
+
+void WaveformAnalyzer::finish(const QString &path, const WaveformPtr &data)
+{
+    m_pending.remove(path);
+    if (data) {
+        if (m_peaks.size() >= MEMORY_LIMIT) m_peaks.erase(m_peaks.begin());
+        m_peaks.insert(path, data);
+    }
+    emit ready(path);
+}
+
+QString WaveformAnalyzer::cacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/waveforms");
+}
+
+QString WaveformAnalyzer::contentKey(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QString();
+    const qint64 size = file.size();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(&size), sizeof(size)));
+    hash.addData(file.read(kEdgeBytes));
+    if (size > 2 * kEdgeBytes && file.seek(size - kEdgeBytes)) hash.addData(file.read(kEdgeBytes));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+WaveformPtr WaveformAnalyzer::analyze(const QString &path, const std::atomic_bool *cancelled)
+{
+    TRACE_SCOPE("waveform.analyze");
+    // QAudioDecoder 依赖事件循环回送数据，在工作线程内开一个局部事件循环
+    QAudioDecoder decoder;
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Float);
+    format.setChannelCount(1);
+    format.setSampleRate(kAnalysisRate);
+    decoder.setAudioFormat(format);
+    decoder.setSource(path.startsWith(QLatin1String(":/")) ? QUrl(QStringLiteral("qrc") + path) : QUrl::fromLocalFile(path));
+
+    Accumulator acc;
+    std::vector<float> mono;
+    int rate = 0;
+    bool failed = false;
+    QEventLoop loop;
+    QObject::connect(&decoder, &QAudioDecoder::bufferReady, &loop, [&]() {
+        while (decoder.bufferAvailable()) {
+            const QAudioBuffer buffer = decoder.read();
+            if (!buffer.isValid()) continue;
+            if (rate == 0) {
+                rate = buffer.format().sampleRate();
+                acc.perBucket = std::max(1, rate / BUCKETS_PER_SECOND);
+                acc.peaks.reserve(size_t(std::max<qint64>(0, decoder.duration()) / 1000 + 1) * BUCKETS_PER_SECOND);
+            }
+            toMono(buffer, mono);
+            consume(acc, mono.data(), qsizetype(mono.size()));
+        }
+        if (cancelled && cancelled->load()) {
+            decoder.stop();
+            failed = true;
+            loop.quit();
+        }
+    });
+    QObject::connect(&decoder, &QAudioDecoder::finished, &loop, &QEventLoop::quit);
+    QObject::connect(&decoder, qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), &loop, [&]() {
+        failed = true;
+        loop.quit();
+    });
+    decoder.start();
+    loop.exec();
+
+    if (failed || rate <= 0) return nullptr;
+    acc.flush();
+    if (acc.peaks.empty()) return nullptr;
+    auto data = std::make_shared<WaveformData>();
+    data->bucketsPerSecond = BUCKETS_PER_SECOND;
+    data->durationMs = acc.total * 1000 / rate;
+    data->peaks = std::move(acc.peaks);
+    data->peaks.shrink_to_fit();
+    return data;
+}
+
+WaveformPtr WaveformAnalyzer::readCache(const QString &file)
+{
+    QFile in(file);
+    if (!in.open(QIODevice::ReadOnly)) return nullptr;
+    const QByteArray bytes = in.readAll();
+    if (bytes.size() < kHeaderSize || std::memcmp(bytes.constData(), kMagic, 4) != 0) return nullptr;
+    const char *p = bytes.constData();
+    const quint32 count = qFromLittleEndian<quint32>(p + 16);
+    if (bytes.size() != kHeaderSize + qint64(count) * 3) return nullptr;
+
+    auto data = std::make_shared<WaveformData>();
+    data->bucketsPerSecond = int(qFromLittleEndian<quint32>(p + 4));
+    data->durationMs = qFromLittleEndian<qint64>(p + 8);
+    data->peaks.resize(count);
+    const char *src = p + kHeaderSize;
+    for (quint32 i = 0; i < count; ++i, src += 3) {
+        data->peaks[i] = WaveformPeak { qint8(src[0]), qint8(src[1]), quint8(src[2]) };
+    }
+    return data;
+}
+
+bool WaveformAnalyzer::writeCache(const QString &file, const WaveformData &data)
+{
+    QByteArray bytes(kHeaderSize + qsizetype(data.peaks.size()) * 3, Qt::Uninitialized);
+    char *p = bytes.data();
+    std::memcpy(p, kMagic, 4);
+    qToLittleEndian<quint32>(quint32(data.bucketsPerSecond), p + 4);
+    qToLittleEndian<qint64>(data.durationMs, p + 8);
+    qToLittleEndian<quint32>(quint32(data.peaks.size()), p + 16);
+    char *dst = p + kHeaderSize;
+    for (const WaveformPeak &peak : data.peaks) {
+        *dst++ = char(peak.min);
+        *dst++ = char(peak.max);
+        *dst++ = char(peak.rms);
+    }
+    QSaveFile out(file);
+    if (!out.open(QIODevice::WriteOnly)) return false;
+    out.write(bytes);
+    return out.commit();
+}
@@ -0,0 +1,69 @@
+// core/waveformanalyzer.h
+#ifndef CORE_WAVEFORMANALYZER_H
+#define CORE_WAVEFORMANALYZER_H
+
+// 波形峰值分析：工作线程用 QAudioDecoder 解码为单声道浮点，按固定时间分桶求 min/max/RMS
+// 结果量化为每桶 3 字节写入 CacheLocation/waveforms/<内容哈希>.peaks，再次播放时直接读取
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct WaveformPeak
+{
+    qint8 min;      // -127..127
+    qint8 max;
+    quint8 rms;     // 0..255
+};
+
+struct WaveformData
+{
+    int bucketsPerSecond = 0;
+    qint64 durationMs = 0;
+    std::vector<WaveformPeak> peaks;
+};
+
+using WaveformPtr = std::shared_ptr<const WaveformData>;
+
+class WaveformAnalyzer : public QObject
+{
+    Q_OBJECT
+public:
+    static WaveformAnalyzer &instance();
+    ~WaveformAnalyzer() override;
+
+    // 内存中已有的结果；没有时返回空指针
+    WaveformPtr peaks(const QString &path) const;
+    // 内存 -> 磁盘缓存 -> 后台解码；同一路径并发请求只解码一次，完成后发出 ready
+    void request(const QString &path);
+
+    static QString cacheDirectory();
+    // 文件大小 + 首尾各 64KB 的 SHA-1：重命名/移动后仍能命中，且无需读完整个文件
+    static QString contentKey(const QString &path);
+    // 纯计算，可在任意线程调用：解码整首并生成峰值
+    static WaveformPtr analyze(const QString &path, const std::atomic_bool *cancelled = nullptr);
+    static WaveformPtr readCache(const QString &file);
+    static bool writeCache(const QString &file, const WaveformData &data);
+
+    static const int BUCKETS_PER_SECOND = 50;
+
+signals:
+    void ready(const QString &path);
+
+private:
+    explicit WaveformAnalyzer(QObject *parent = nullptr);
+    void finish(const QString &path, const WaveformPtr &data);
+
+    QThreadPool m_pool;
+    QHash<QString, WaveformPtr> m_peaks;   // 仅 GUI 线程访问
+    QSet<QString> m_pending;
+    std::atomic_bool m_stopping { false };
+    static const int MEMORY_LIMIT = 64;    // 内存保留的曲目数
+};
+
+#endif // CORE_WAVEFORMANALYZER_H
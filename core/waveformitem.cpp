@@ -0,0 +1,186 @@
+// 实现文件：WaveformItem —— 峰值合并 + 单节点顶点着色绘制
+#include "core/waveformitem.h"
+
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+#include <QUrl>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 顶点颜色材质要求预乘 alpha
+void setVertex(QSGGeometry::ColoredPoint2D &v, float x, float y, const QColor &c)
+{
+    const float a = float(c.alphaF());
+    v.set(x, y, uchar(c.red() * a), uchar(c.green() * a), uchar(c.blue() * a), uchar(c.alpha()));
+}
+
+} // namespace
+
+WaveformItem::WaveformItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    connect(&WaveformAnalyzer::instance(), &WaveformAnalyzer::ready, this, &WaveformItem::onWaveformReady);
+}
+
+void WaveformItem::setSource(const QString &source)
+{
+    if (m_source == source) return;
+    m_source = source;
+    m_path = source.startsWith(QLatin1String("file:")) ? QUrl(source).toLocalFile()
+           : source.startsWith(QLatin1String("qrc:")) ? source.mid(3)
+           : source;
+    emit sourceChanged();
+
+    WaveformAnalyzer &analyzer = WaveformAnalyzer::instance();
+    const WaveformPtr data = analyzer.peaks(m_path);
+    setData(data);
+    if (!data) analyzer.request(m_path);
+}
+
+void WaveformItem::setProgress(qreal progress)
+{
+    progress = std::clamp(progress, 0.0, 1.0);
+    if (qFuzzyCompare(m_progress, progress)) return;
+    m_progress = progress;
+    emit progressChanged();
+    if (m_data) update();
+}
+
+void WaveformItem::setColor(const QColor &color)
+{
+    if (m_color == color) return;
+    m_color = color;
+    emit colorChanged();
+    update();
+}
+
+void WaveformItem::setPlayedColor(const QColor &color)
+{
+    if (m_playedColor == color) return;
+    m_playedColor = color;
+    emit playedColorChanged();
+    update();
+}
+
+void WaveformItem::setBarWidth(qreal width)
+{
+    width = std::max<qreal>(0.5, width);
+    if (qFuzzyCompare(m_barWidth, width)) return;
+    m_barWidth = width;
+    m_barsDirty = true;
+    emit barWidthChanged();
+    update();
+}
+
+void WaveformItem::setBarSpacing(qreal spacing)
+{
+    spacing = std::max<qreal>(0.0, spacing);
+    if (qFuzzyCompare(m_barSpacing + 1.0, spacing + 1.0)) return;
+    m_barSpacing = spacing;
+    m_barsDirty = true;
+    emit barSpacingChanged();
+    update();
+}
+
+void WaveformItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.width() != oldGeometry.width()) m_barsDirty = true;
+    if (newGeometry.size() != oldGeometry.size()) update();
+}
+
+void WaveformItem::onWaveformReady(const QString &path)
+{
+    if (path != m_path || m_data) return;
+    setData(WaveformAnalyzer::instance().peaks(path));
+}
+
+void WaveformItem::setData(const WaveformPtr &data)
+{
+    if (m_data == data) return;
+    const bool wasReady = isReady();
+    m_data = data;
+    m_barsDirty = true;
+    if (wasReady != isReady()) emit readyChanged();
+    update();
+}
+
+void WaveformItem::rebuildBars()
+{
+    m_barsDirty = false;
+    m_bars.clear();
+    if (!m_data || m_data->peaks.empty() || width() <= 0) return;
+
+    const int bars = std::max(1, int((width() + m_barSpacing) / (m_barWidth + m_barSpacing)));
+    const std::vector<WaveformPeak> &peaks = m_data->peaks;
+    const size_t n = peaks.size();
+    m_bars.resize(size_t(bars));
+    float loudest = 0.0f;
+    for (int i = 0; i < bars; ++i) {
+        // 每根竖条覆盖的桶区间：取区间峰值，避免短促的瞬态被平均掉
+        const size_t first = size_t(i) * n / size_t(bars);
+        const size_t last = std::max(first + 1, size_t(i + 1) * n / size_t(bars));
+        int peak = 0;
+        int rms = 0;
+        for (size_t b = first; b < last && b < n; ++b) {
+            peak = std::max({ peak, int(peaks[b].max), -int(peaks[b].min) });
+            rms = std::max(rms, int(peaks[b].rms));
+        }
+        // 峰值与 RMS 混合，观感更接近响度而不是削顶的矩形
+        const float value = 0.6f * (peak / 127.0f) + 0.4f * (rms / 255.0f);
+        m_bars[size_t(i)] = value;
+        loudest = std::max(loudest, value);
+    }
+    if (loudest > 0.0f) {
+        for (float &value : m_bars) value /= loudest;
+    }
+}
+
+QSGNode *WaveformItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    if (m_barsDirty) rebuildBars();
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (m_bars.empty() || height() <= 0) {
+        delete node;
+        return nullptr;
+    }
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGVertexColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+
+    QSGGeometry *geometry = node->geometry();
+    const int bars = int(m_bars.size());
+    if (geometry->vertexCount() != bars * 6) geometry->allocate(bars * 6);
+    QSGGeometry::ColoredPoint2D *v = geometry->vertexDataAsColoredPoint2D();
+
+    const float h = float(height());
+    const float mid = h / 2.0f;
+    const float step = float(m_barWidth + m_barSpacing);
+    const float bw = float(m_barWidth);
+    const float playedX = float(width() * m_progress);
+    for (int i = 0; i < bars; ++i) {
+        const float x0 = i * step;
+        const float x1 = x0 + bw;
+        const float half = std::max(0.5f, m_bars[size_t(i)] * mid);
+        const QColor &c = (x0 + bw / 2.0f) <= playedX ? m_playedColor : m_color;
+        setVertex(v[0], x0, mid - half, c);
+        setVertex(v[1], x1, mid - half, c);
+        setVertex(v[2], x0, mid + half, c);
+        setVertex(v[3], x1, mid - half, c);
+        setVertex(v[4], x1, mid + half, c);
+        setVertex(v[5], x0, mid + half, c);
+        v += 6;
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
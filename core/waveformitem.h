@@ -0,0 +1,76 @@
+// core/waveformitem.h
+#ifndef CORE_WAVEFORMITEM_H
+#define CORE_WAVEFORMITEM_H
+
+// 波形进度条：WaveformAnalyzer 的峰值按像素宽度合并成竖条，整条波形为单个几何节点
+// 已播放/未播放部分用顶点颜色区分，进度变化只重写顶点缓冲，不新增节点
+#include <QQuickItem>
+#include <QColor>
+#include <QString>
+
+#include <vector>
+
+#include "core/waveformanalyzer.h"
+
+class WaveformItem : public QQuickItem
+{
+    Q_OBJECT
+    // 音频路径（本地路径或 file: URL）
+    Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(qreal progress READ progress WRITE setProgress NOTIFY progressChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor playedColor READ playedColor WRITE setPlayedColor NOTIFY playedColorChanged)
+    Q_PROPERTY(qreal barWidth READ barWidth WRITE setBarWidth NOTIFY barWidthChanged)
+    Q_PROPERTY(qreal barSpacing READ barSpacing WRITE setBarSpacing NOTIFY barSpacingChanged)
+    Q_PROPERTY(bool ready READ isReady NOTIFY readyChanged)
+
+public:
+    explicit WaveformItem(QQuickItem *parent = nullptr);
+
+    QString source() const { return m_source; }
+    void setSource(const QString &source);
+    qreal progress() const { return m_progress; }
+    void setProgress(qreal progress);
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color);
+    QColor playedColor() const { return m_playedColor; }
+    void setPlayedColor(const QColor &color);
+    qreal barWidth() const { return m_barWidth; }
+    void setBarWidth(qreal width);
+    qreal barSpacing() const { return m_barSpacing; }
+    void setBarSpacing(qreal spacing);
+    bool isReady() const { return m_data != nullptr; }
+
+signals:
+    void sourceChanged();
+    void progressChanged();
+    void colorChanged();
+    void playedColorChanged();
+    void barWidthChanged();
+    void barSpacingChanged();
+    void readyChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private slots:
+    void onWaveformReady(const QString &path);
+
+private:
+    void setData(const WaveformPtr &data);
+    void rebuildBars();
+
+    QString m_source;
+    QString m_path;
+    WaveformPtr m_data;
+    std::vector<float> m_bars;      // 每根竖条的归一化高度 0~1
+    bool m_barsDirty = true;
+    qreal m_progress = 0.0;
+    QColor m_color = QColor(255, 255, 255, 80);
+    QColor m_playedColor = QColor(255, 255, 255);
+    qreal m_barWidth = 2.0;
+    qreal m_barSpacing = 1.0;
+};
+
+#endif // CORE_WAVEFORMITEM_H
@@ -3,14 +3,29 @@
 #include <QtQml>
 #include <QIcon>
 #include <QLoggingCategory>
-#include "core/music.h"
+#include <QElapsedTimer>
+#include <QQuickWindow>
+#include <QTimer>
+#include <QtQml/QQmlExtensionPlugin>
+#include "core/qmltypes.h"
+#include "core/networkfetcher.h"
+#include "core/coverimageprovider.h"
+#include "core/trace.h"
+
+// 组件库为静态 QML 插件，需显式导入
+Q_IMPORT_QML_PLUGIN(EvolveUI_ComponentsPlugin)
 
 int main(int argc, char *argv[])
 {
+    // 冷启动计时：进入 main 到首帧呈现，用于跟踪启动耗时回归
+    QElapsedTimer startupTimer;
+    startupTimer.start();
 
 
 
     QGuiApplication app(argc, argv);
+    // 以 EVOLVEUI_TRACING 编译且设置了 EVOLVEUI_TRACE_FILE 时开始记录，退出时写出
+    Trace::initialize();
 
     QLoggingCategory::setFilterRules(QStringLiteral(
         "qt.multimedia.ffmpeg.*=false\n"
@@ -23,17 +38,37 @@ int main(int argc, char *argv[])
     app.setWindowIcon(QIcon(":/new/prefix1/fonts/icon.ico"));
 
     // 注册C++类型到QML
-    qmlRegisterType<AudioMetadata>("AudioMetadata", 1, 0, "AudioMetadata");
-    qmlRegisterType<MusicLibrary>("MusicLibrary", 1, 0, "MusicLibrary");
+    QmlTypes::registerAll();
 
+    // 须比引擎活得久：引擎析构时仍会释放由它创建的网络访问对象
+    CachedNetworkAccessManagerFactory networkFactory;
     QQmlApplicationEngine engine;
+    // 远程图片（Bing 壁纸、随机插画等）走磁盘缓存
+    engine.setNetworkAccessManagerFactory(&networkFactory);
+    // 封面缩略图：image://cover/<hash>[/<size>]，在后台线程解码
+    engine.addImageProvider(QStringLiteral("cover"), new CoverImageProvider);
     QObject::connect(
         &engine,
         &QQmlApplicationEngine::objectCreationFailed,
         &app,
         []() { QCoreApplication::exit(-1); },
         Qt::QueuedConnection);
-    engine.loadFromModule("EvolveUI", "Main");
+    {
+        TRACE_SCOPE("startup.loadQml");
+        engine.loadFromModule("EvolveUI", "Main");
+    }
+    const qint64 loadedMs = startupTimer.elapsed();
+
+    if (auto *window = qobject_cast<QQuickWindow *>(engine.rootObjects().value(0))) {
+        Trace::instrumentWindow(window);
+        // frameSwapped 在渲染线程发出，经 app 排队回到 GUI 线程后只处理一次
+        QObject::connect(window, &QQuickWindow::frameSwapped, &app, [&startupTimer, loadedMs]() {
+            qInfo("startup: qml loaded in %lld ms, first frame at %lld ms", loadedMs, startupTimer.elapsed());
+            // 自动化测量：呈现首帧后立即退出
+            if (qEnvironmentVariableIsSet("EVOLVEUI_EXIT_AFTER_FIRST_FRAME"))
+                QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+        }, Qt::SingleShotConnection);
+    }
 
     return app.exec();
 }
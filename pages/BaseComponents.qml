@@ -1,6 +1,6 @@
 import QtQuick
 import QtQuick.Layouts
-import "../components" as Components
+import EvolveUI.Components as Components
 
 Flow {
     property var theme
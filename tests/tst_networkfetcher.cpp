@@ -0,0 +1,368 @@
+// 实现文件：NetworkFetcher / NetworkResource 测试 —— 本地 QTcpServer 充当 HTTP 服务端
+// 覆盖请求合并、按 Date 与 Cache-Control 计算的新鲜期、过期先行 + 304 重新验证、离线回退磁盘缓存
+#include "core/networkfetcher.h"
+#include "core/networkresource.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QLocale>
+#include <QPointer>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTimer>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const int kWaitMs = 5000;
+
+// 最小的 HTTP/1.1 服务端：每个连接处理一个 GET 后关闭，记录每次命中与条件请求头
+class StandInServer : public QTcpServer
+{
+public:
+    struct Route
+    {
+        QByteArray body;
+        QByteArray etag;
+        QByteArray cacheControl;
+        qint64 dateOffsetSecs = 0;  // 响应头 Date 相对当前时间的偏移
+        int delayMs = 0;
+    };
+    struct Hit
+    {
+        QByteArray path;
+        QByteArray ifNoneMatch;
+        int status = 0;
+    };
+
+    explicit StandInServer(QObject *parent = nullptr)
+        : QTcpServer(parent)
+    {
+        connect(this, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+            }
+        });
+    }
+
+    QHash<QByteArray, Route> routes;
+    std::vector<Hit> hits;
+
+    // 首次监听时分配端口，close() 后重新监听沿用同一端口，缓存键保持不变
+    bool start()
+    {
+        if (!listen(QHostAddress::LocalHost, m_port)) return false;
+        m_port = serverPort();
+        return true;
+    }
+
+    QUrl url(const QByteArray &path) const
+    {
+        return QUrl(QStringLiteral("http://127.0.0.1:%1%2").arg(m_port).arg(QString::fromLatin1(path)));
+    }
+
+    int hitCount(const QByteArray &path) const
+    {
+        return int(std::count_if(hits.cbegin(), hits.cend(), [&](const Hit &hit) { return hit.path == path; }));
+    }
+
+private:
+    static QByteArray httpDate(const QDateTime &time)
+    {
+        return QLocale::c().toString(time.toUTC(), QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'")).toLatin1();
+    }
+
+    void onReadyRead(QTcpSocket *socket)
+    {
+        QByteArray &buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        const qsizetype end = buffer.indexOf("\r\n\r\n");
+        if (end < 0) return;
+        const QList<QByteArray> lines = buffer.left(end).split('\n');
+        m_buffers.remove(socket);
+
+        Hit hit;
+        const QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+        hit.path = requestLine.value(1);
+        for (qsizetype i = 1; i < lines.size(); ++i) {
+            const QByteArray line = lines.at(i).trimmed();
+            const qsizetype colon = line.indexOf(':');
+            if (colon > 0 && line.left(colon).trimmed().toLower() == "if-none-match") hit.ifNoneMatch = line.mid(colon + 1).trimmed();
+        }
+
+        QByteArray response;
+        int delayMs = 0;
+        const auto it = routes.constFind(hit.path);
+        if (it == routes.constEnd()) {
+            hit.status = 404;
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        } else {
+            const Route &route = *it;
+            delayMs = route.delayMs;
+            const bool notModified = !route.etag.isEmpty() && hit.ifNoneMatch == route.etag;
+            hit.status = notModified ? 304 : 200;
+            response = notModified ? "HTTP/1.1 304 Not Modified\r\n" : "HTTP/1.1 200 OK\r\n";
+            response += "Date: " + httpDate(QDateTime::currentDateTimeUtc().addSecs(route.dateOffsetSecs)) + "\r\n";
+            if (!route.etag.isEmpty()) response += "ETag: " + route.etag + "\r\n";
+            if (!route.cacheControl.isEmpty()) response += "Cache-Control: " + route.cacheControl + "\r\n";
+            if (notModified) {
+                response += "Connection: close\r\n\r\n";
+            } else {
+                response += "Content-Type: application/json\r\n";
+                response += "Content-Length: " + QByteArray::number(route.body.size()) + "\r\n";
+                response += "Connection: close\r\n\r\n";
+                response += route.body;
+            }
+        }
+        hits.push_back(hit);
+
+        QPointer<QTcpSocket> guard(socket);
+        QTimer::singleShot(delayMs, this, [guard, response]() {
+            if (!guard) return;
+            guard->write(response);
+            guard->disconnectFromHost();
+        });
+    }
+
+    QHash<QTcpSocket *, QByteArray> m_buffers;
+    quint16 m_port = 0;
+};
+
+} // namespace
+
+class NetworkFetcherTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void coalescesIdenticalRequests();
+    void coalescesResourcesWithSameUrl();
+    void freshWithinTtlFromDate();
+    void freshWithinServerMaxAge();
+    void staleThenRevalidatedWith304();
+    void offlineFallsBackToDiskCache();
+    void offlineResourceKeepsCachedValue();
+
+private:
+    using Results = std::shared_ptr<std::vector<NetworkFetcher::Result>>;
+    Results fetch(const QByteArray &path, qint64 ttlMs);
+
+    StandInServer m_server;
+    std::unique_ptr<QTemporaryDir> m_cacheDir;
+};
+
+NetworkFetcherTest::Results NetworkFetcherTest::fetch(const QByteArray &path, qint64 ttlMs)
+{
+    auto results = std::make_shared<std::vector<NetworkFetcher::Result>>();
+    NetworkFetcher::Request request;
+    request.url = m_server.url(path);
+    request.ttlMs = ttlMs;
+    NetworkFetcher::instance().fetch(request, this, [results](const NetworkFetcher::Result &result) {
+        results->push_back(result);
+    });
+    return results;
+}
+
+void NetworkFetcherTest::initTestCase()
+{
+    QVERIFY(m_server.start());
+}
+
+void NetworkFetcherTest::init()
+{
+    // 每个用例使用独立的磁盘缓存
+    m_cacheDir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_cacheDir->isValid());
+    NetworkFetcher::instance().setCacheDirectory(m_cacheDir->path());
+    m_server.routes.clear();
+    m_server.hits.clear();
+}
+
+void NetworkFetcherTest::cleanup()
+{
+    if (!m_server.isListening()) QVERIFY(m_server.start());
+}
+
+void NetworkFetcherTest::coalescesIdenticalRequests()
+{
+    m_server.routes.insert("/coalesce", { R"({"value": 1})", "\"c1\"", QByteArray(), 0, 200 });
+
+    const Results first = fetch("/coalesce", 0);
+    const Results second = fetch("/coalesce", 0);
+    // 前一个请求仍在途（服务端延迟应答）时再发起同样的请求
+    QTest::qWait(50);
+    const Results third = fetch("/coalesce", 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(third->size(), size_t(1), kWaitMs);
+    QCOMPARE(first->size(), size_t(1));
+    QCOMPARE(second->size(), size_t(1));
+    QCOMPARE(m_server.hitCount("/coalesce"), 1);
+    for (const Results &results : { first, second, third }) {
+        const NetworkFetcher::Result &result = results->front();
+        QVERIFY(result.ok);
+        QCOMPARE(result.status, 200);
+        QCOMPARE(result.data.toMap().value("value").toInt(), 1);
+    }
+}
+
+void NetworkFetcherTest::coalescesResourcesWithSameUrl()
+{
+    m_server.routes.insert("/resource", { R"({"value": 2})", "\"r1\"", QByteArray(), 0, 100 });
+
+    NetworkResource a;
+    NetworkResource b;
+    QSignalSpy loadedA(&a, &NetworkResource::loaded);
+    QSignalSpy loadedB(&b, &NetworkResource::loaded);
+    a.setUrl(m_server.url("/resource").toString());
+    b.setUrl(m_server.url("/resource").toString());
+
+    QTRY_COMPARE_WITH_TIMEOUT(loadedA.size(), 1, kWaitMs);
+    QTRY_COMPARE_WITH_TIMEOUT(loadedB.size(), 1, kWaitMs);
+    QCOMPARE(m_server.hitCount("/resource"), 1);
+    QCOMPARE(a.status(), NetworkResource::Ready);
+    QCOMPARE(b.value().toMap().value("value").toInt(), 2);
+}
+
+void NetworkFetcherTest::freshWithinTtlFromDate()
+{
+    m_server.routes.insert("/fresh", { R"({"value": 3})", "\"f1\"" });
+
+    const Results first = fetch("/fresh", 60 * 1000);
+    QTRY_COMPARE_WITH_TIMEOUT(first->size(), size_t(1), kWaitMs);
+    QVERIFY(first->front().ok);
+
+    // Date 为刚才，仍在 ttl 内：直接读缓存，不访问网络
+    const Results second = fetch("/fresh", 60 * 1000);
+    QTRY_COMPARE_WITH_TIMEOUT(second->size(), size_t(1), kWaitMs);
+    QVERIFY(second->front().ok);
+    QVERIFY(second->front().fromCache);
+    QVERIFY(!second->front().stale);
+    QCOMPARE(second->front().data.toMap().value("value").toInt(), 3);
+    QCOMPARE(m_server.hitCount("/fresh"), 1);
+
+    // 同一条缓存按更短的 ttl 已过期：先给出旧内容，再访问网络
+    QTest::qWait(20);
+    const Results third = fetch("/fresh", 1);
+    QTRY_COMPARE_WITH_TIMEOUT(third->size(), size_t(2), kWaitMs);
+    QVERIFY(third->front().stale);
+    QCOMPARE(m_server.hitCount("/fresh"), 2);
+}
+
+void NetworkFetcherTest::freshWithinServerMaxAge()
+{
+    // 端点未设 ttl 时按服务端 Cache-Control: max-age 判断新鲜期
+    m_server.routes.insert("/max-age", { R"({"value": 4})", "\"m1\"", "max-age=3600" });
+
+    const Results first = fetch("/max-age", 0);
+    QTRY_COMPARE_WITH_TIMEOUT(first->size(), size_t(1), kWaitMs);
+    const Results second = fetch("/max-age", 0);
+    QTRY_COMPARE_WITH_TIMEOUT(second->size(), size_t(1), kWaitMs);
+    QVERIFY(second->front().fromCache);
+    QVERIFY(!second->front().stale);
+    QCOMPARE(m_server.hitCount("/max-age"), 1);
+
+    // Date 早于 max-age：已过期，重新访问网络
+    m_server.routes.insert("/max-age-old", { R"({"value": 5})", "\"m2\"", "max-age=60", -3600 });
+    const Results third = fetch("/max-age-old", 0);
+    QTRY_COMPARE_WITH_TIMEOUT(third->size(), size_t(1), kWaitMs);
+    const Results fourth = fetch("/max-age-old", 0);
+    QTRY_COMPARE_WITH_TIMEOUT(fourth->size(), size_t(2), kWaitMs);
+    QVERIFY(fourth->front().stale);
+    QCOMPARE(m_server.hitCount("/max-age-old"), 2);
+}
+
+void NetworkFetcherTest::staleThenRevalidatedWith304()
+{
+    // 响应头 Date 为两小时前：按 1 分钟 ttl 已过期
+    m_server.routes.insert("/stale", { R"({"value": 6})", "\"s1\"", QByteArray(), -2 * 3600 });
+    const Results first = fetch("/stale", 60 * 1000);
+    QTRY_COMPARE_WITH_TIMEOUT(first->size(), size_t(1), kWaitMs);
+    QCOMPARE(m_server.hitCount("/stale"), 1);
+
+    // 之后的应答带当前 Date，304 会刷新缓存记录
+    m_server.routes["/stale"].dateOffsetSecs = 0;
+    const Results second = fetch("/stale", 60 * 1000);
+    QTRY_COMPARE_WITH_TIMEOUT(second->size(), size_t(2), kWaitMs);
+
+    // 先行交付的旧内容
+    const NetworkFetcher::Result &stale = second->at(0);
+    QVERIFY(stale.ok);
+    QVERIFY(stale.stale);
+    QVERIFY(stale.fromCache);
+    QCOMPARE(stale.data.toMap().value("value").toInt(), 6);
+
+    // 条件请求得到 304，沿用缓存正文
+    QCOMPARE(m_server.hitCount("/stale"), 2);
+    QCOMPARE(m_server.hits.back().ifNoneMatch, QByteArray("\"s1\""));
+    QCOMPARE(m_server.hits.back().status, 304);
+    const NetworkFetcher::Result &revalidated = second->at(1);
+    QVERIFY(revalidated.ok);
+    QVERIFY(!revalidated.stale);
+    QVERIFY(revalidated.fromCache);
+    QCOMPARE(revalidated.data.toMap().value("value").toInt(), 6);
+
+    // 304 更新了 Date，缓存重新进入新鲜期
+    const Results third = fetch("/stale", 60 * 1000);
+    QTRY_COMPARE_WITH_TIMEOUT(third->size(), size_t(1), kWaitMs);
+    QVERIFY(!third->front().stale);
+    QCOMPARE(m_server.hitCount("/stale"), 2);
+}
+
+void NetworkFetcherTest::offlineFallsBackToDiskCache()
+{
+    m_server.routes.insert("/offline", { R"({"value": 7})", "\"o1\"" });
+    const Results first = fetch("/offline", 0);
+    QTRY_COMPARE_WITH_TIMEOUT(first->size(), size_t(1), kWaitMs);
+    QVERIFY(first->front().ok);
+
+    // 服务端下线：连接被拒绝后交付磁盘缓存中的内容
+    m_server.close();
+    const Results second = fetch("/offline", 0);
+    QTRY_COMPARE_WITH_TIMEOUT(second->size(), size_t(2), kWaitMs);
+    const NetworkFetcher::Result &fallback = second->back();
+    QVERIFY(fallback.ok);
+    QVERIFY(fallback.stale);
+    QVERIFY(fallback.fromCache);
+    QVERIFY(!fallback.error.isEmpty());
+    QCOMPARE(fallback.data.toMap().value("value").toInt(), 7);
+
+    // 没有缓存的地址在离线时报错
+    const Results missing = fetch("/offline-missing", 0);
+    QTRY_COMPARE_WITH_TIMEOUT(missing->size(), size_t(1), kWaitMs);
+    QVERIFY(!missing->front().ok);
+    QVERIFY(!missing->front().error.isEmpty());
+}
+
+void NetworkFetcherTest::offlineResourceKeepsCachedValue()
+{
+    m_server.routes.insert("/offline-resource", { R"({"value": 8})", "\"o2\"" });
+    const Results first = fetch("/offline-resource", 0);
+    QTRY_COMPARE_WITH_TIMEOUT(first->size(), size_t(1), kWaitMs);
+
+    m_server.close();
+    NetworkResource resource;
+    QSignalSpy loaded(&resource, &NetworkResource::loaded);
+    resource.setUrl(m_server.url("/offline-resource").toString());
+    QTRY_COMPARE_WITH_TIMEOUT(loaded.size(), 2, kWaitMs);
+    QCOMPARE(resource.status(), NetworkResource::Ready);
+    QVERIFY(resource.isStale());
+    QVERIFY(resource.isFromCache());
+    QVERIFY(!resource.errorString().isEmpty());
+    QCOMPARE(resource.value().toMap().value("value").toInt(), 8);
+}
+
+QTEST_GUILESS_MAIN(NetworkFetcherTest)
+
+#include "tst_networkfetcher.moc"